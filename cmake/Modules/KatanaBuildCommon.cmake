@@ -23,6 +23,7 @@ endif ()
 ###### General features ######
 set(GALOIS_ENABLE_PAPI OFF CACHE BOOL "Use PAPI counters for profiling")
 set(GALOIS_ENABLE_VTUNE OFF CACHE BOOL "Use VTune for profiling")
+set(GALOIS_ENABLE_TRACE OFF CACHE BOOL "Record per-thread timeline traces (see galois/Trace.h)")
 set(GALOIS_STRICT_CONFIG OFF CACHE BOOL "Instead of falling back gracefully, fail")
 set(GALOIS_GRAPH_LOCATION "" CACHE PATH "Location of inputs for tests if downloaded/stored separately.")
 set(CXX_CLANG_TIDY "" CACHE STRING "Semi-colon separated list of clang-tidy command and arguments")
@@ -203,6 +204,10 @@ if (GALOIS_ENABLE_PAPI)
   add_definitions(-DGALOIS_ENABLE_PAPI)
 endif ()
 
+if (GALOIS_ENABLE_TRACE)
+  add_definitions(-DGALOIS_ENABLE_TRACE)
+endif ()
+
 find_package(NUMA)
 
 find_package(Threads REQUIRED)
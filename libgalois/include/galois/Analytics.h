@@ -1,7 +1,17 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_H_
 #define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_H_
 
+#include <galois/analytics/betweenness_centrality/betweenness_centrality.h>
 #include <galois/analytics/bfs/bfs.h>
+#include <galois/analytics/closeness_centrality/closeness_centrality.h>
+#include <galois/analytics/community_detection/community_detection.h>
+#include <galois/analytics/connected_components/connected_components.h>
+#include <galois/analytics/k_core/k_core.h>
+#include <galois/analytics/k_shortest_paths/k_shortest_paths.h>
+#include <galois/analytics/pagerank/pagerank.h>
+#include <galois/analytics/similarity/similarity.h>
 #include <galois/analytics/sssp/sssp.h>
+#include <galois/analytics/strongly_connected_components/strongly_connected_components.h>
+#include <galois/analytics/triangle_count/triangle_count.h>
 
 #endif
@@ -0,0 +1,65 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ARROWMEMORYPOOL_H_
+#define GALOIS_LIBGALOIS_GALOIS_ARROWMEMORYPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <arrow/memory_pool.h>
+#include <arrow/status.h>
+
+#include "galois/config.h"
+
+namespace galois {
+
+/// ArrowMemoryPool is an arrow::MemoryPool that places large buffers, e.g.,
+/// property columns, with the Galois NUMA allocators instead of the Arrow
+/// default allocator.
+///
+/// Requests of at least kLargeAllocation bytes are allocated in whole huge
+/// pages with substrate::largeMallocInterleaved or largeMallocBlocked,
+/// depending on the placement, so that they are spread over the memory of the
+/// active threads. When the allocation cannot start a parallel section (e.g.,
+/// it happens inside a parallel loop or on an I/O thread), the pages are
+/// faulted in by the calling thread instead. Smaller requests are forwarded to
+/// arrow::default_memory_pool().
+class GALOIS_EXPORT ArrowMemoryPool : public arrow::MemoryPool {
+public:
+  enum class Placement {
+    /// Pages are distributed round robin over threads
+    kInterleaved,
+    /// Each thread gets a contiguous block of pages
+    kBlocked,
+  };
+
+  explicit ArrowMemoryPool(Placement placement = Placement::kInterleaved)
+      : placement_(placement) {}
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  /// Bytes currently allocated from this pool, including small requests
+  int64_t bytes_allocated() const override { return bytes_allocated_; }
+  int64_t max_memory() const override { return max_memory_; }
+  std::string backend_name() const override { return "galois"; }
+
+  static constexpr int64_t kLargeAllocation = 1 << 21;
+
+private:
+  void* AllocateLarge(int64_t size);
+  void UpdateAllocated(int64_t diff);
+
+  Placement placement_;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+};
+
+/// Returns the pool used for Galois property tables. It is never destroyed,
+/// so buffers may outlive the runtime.
+GALOIS_EXPORT ArrowMemoryPool* GetArrowMemoryPool();
+
+}  // namespace galois
+
+#endif
@@ -26,8 +26,10 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_DYNAMICBITSET_H_
 #define GALOIS_LIBGALOIS_GALOIS_DYNAMICBITSET_H_
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstring>
 #include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
@@ -48,6 +50,8 @@ class GALOIS_EXPORT DynamicBitset {
 
 public:
   static constexpr uint32_t bits_uint64 = sizeof(uint64_t) * CHAR_BIT;
+  //! Number of words handled by one task of parallel bitset operations
+  static constexpr size_t kWordsPerBlock = 1024;
 
   //! Constructor which initializes to an empty bitset.
   DynamicBitset() = default;
@@ -105,7 +109,7 @@ public:
   /**
    * Unset every bit in the bitset.
    */
-  void reset() { std::fill(bitvec.begin(), bitvec.end(), 0); }
+  void reset();
 
   /**
    * Unset a range of bits given an inclusive range
@@ -140,7 +144,11 @@ public:
       vec_end = (end + 1) / bits_uint64;  // floor
 
     if (vec_begin < vec_end) {
-      std::fill(bitvec.begin() + vec_begin, bitvec.begin() + vec_end, 0);
+      // words are layout compatible with uint64_t; clearing them with plain
+      // stores avoids a fenced atomic store per word
+      std::memset(
+          static_cast<void*>(bitvec.begin() + vec_begin), 0,
+          (vec_end - vec_begin) * sizeof(uint64_t));
     }
 
     vec_begin *= bits_uint64;
@@ -259,6 +267,23 @@ public:
    */
   void bitwise_and(const DynamicBitset& other1, const DynamicBitset& other2);
 
+  /**
+   * Does an IN-PLACE bitwise and of this bitset and the complement of another
+   * bitset, i.e., clears every bit that is set in other
+   *
+   * @param other Bitset whose set bits are cleared from this bitset
+   */
+  void bitwise_andnot(const DynamicBitset& other);
+
+  /**
+   * Does an IN-PLACE bitwise and of other1 and the complement of other2 and
+   * saves to this bitset
+   *
+   * @param other1 Bitset to and with the complement of other2
+   * @param other2 Bitset whose set bits are cleared from other1
+   */
+  void bitwise_andnot(const DynamicBitset& other1, const DynamicBitset& other2);
+
   /**
    * Does an IN-PLACE bitwise xor of this bitset and another bitset
    *
@@ -285,13 +310,41 @@ public:
   /**
    * Returns a vector containing the set bits in this bitset in order
    * from left to right.
-   * Do NOT call in a parallel region as it uses galois::on_each.
+   * Do NOT call in a parallel region as it uses galois::do_all.
    *
    * @returns vector with offsets into set bits
    */
   template <typename integer>
   std::vector<integer> getOffsets() const;
 
+  /**
+   * Calls fn(index) in parallel for every set bit in the bitset. Blocks of
+   * words are distributed among threads, and set bits within a word are
+   * found with count-trailing-zeros, so the cost is proportional to the
+   * number of words plus the number of set bits.
+   * Assumes the bitset is not updated in parallel.
+   *
+   * @param fn Function to call on the index of each set bit
+   */
+  template <typename F>
+  void for_each_set_bit(const F& fn) const {
+    const size_t num_words = bitvec.size();
+    galois::do_all(
+        galois::iterate(
+            size_t{0}, (num_words + kWordsPerBlock - 1) / kWordsPerBlock),
+        [&](size_t block) {
+          size_t begin = block * kWordsPerBlock;
+          size_t end = std::min(num_words, begin + kWordsPerBlock);
+          for (size_t w = begin; w < end; ++w) {
+            uint64_t word = bitvec[w].load(std::memory_order_relaxed);
+            for (; word != 0; word &= word - 1) {
+              fn(w * bits_uint64 + __builtin_ctzll(word));
+            }
+          }
+        },
+        galois::steal(), galois::no_stats());
+  }
+
   //! this is defined to
   using tt_is_copyable = int;
 };
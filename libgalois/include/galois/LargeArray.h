@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "galois/Galois.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/ParallelSTL.h"
 #include "galois/config.h"
 #include "galois/substrate/NumaMem.h"
@@ -42,6 +43,7 @@ class LargeArray {
   substrate::LAptr real_data_;
   T* data_{};
   size_t size_{};
+  MemoryCategory category_{MemoryCategory::kScratch};
 
   void Allocate(size_t n, AllocType t) {
     assert(!data_);
@@ -66,6 +68,7 @@ class LargeArray {
     };
 
     data_ = reinterpret_cast<T*>(real_data_.get());
+    MemoryAdd(category_, n * sizeof(T));
   }
 
 public:
@@ -93,8 +96,17 @@ public:
 
   LargeArray() = default;
 
+  /**
+   * Creates an empty array whose memory is accounted to category (see
+   * galois/MemoryAccounting.h) once it is allocated.
+   */
+  explicit LargeArray(MemoryCategory category) : category_(category) {}
+
   LargeArray(LargeArray&& o) noexcept
-      : real_data_(std::move(o.real_data_)), data_(o.data_), size_(o.size_) {
+      : real_data_(std::move(o.real_data_)),
+        data_(o.data_),
+        size_(o.size_),
+        category_(o.category_) {
     o.data_ = nullptr;
     o.size_ = 0;
   }
@@ -104,6 +116,7 @@ public:
     std::swap(real_data_, tmp.real_data_);
     std::swap(data_, tmp.data_);
     std::swap(size_, tmp.size_);
+    std::swap(category_, tmp.category_);
     return *this;
   }
 
@@ -126,6 +139,21 @@ public:
   iterator end() { return data_ + size_; }
   const_iterator end() const { return data_ + size_; }
 
+  MemoryCategory memory_category() const { return category_; }
+
+  /**
+   * Sets the category that the memory of the array is accounted to. The
+   * default is MemoryCategory::kScratch. Memory that is already allocated is
+   * moved to the new category.
+   */
+  void set_memory_category(MemoryCategory category) {
+    if (real_data_) {
+      MemoryRelease(category_, size_ * sizeof(T));
+      MemoryAdd(category, size_ * sizeof(T));
+    }
+    category_ = category;
+  }
+
   //! [allocatefunctions]
   //! Allocates interleaved across NUMA (memory) nodes.
   void allocateInterleaved(size_type n) { Allocate(n, AllocType::Interleaved); }
@@ -170,6 +198,7 @@ public:
 
     size_ = num;
     data_ = reinterpret_cast<T*>(real_data_.get());
+    MemoryAdd(category_, num * sizeof(T));
   }
   //! [allocatefunctions]
 
@@ -193,6 +222,9 @@ public:
   }
 
   void deallocate() {
+    if (real_data_) {
+      MemoryRelease(category_, size_ * sizeof(T));
+    }
     real_data_.reset();
     data_ = 0;
     size_ = 0;
@@ -216,6 +248,7 @@ class LargeArray<void> {
 public:
   LargeArray(void*, size_t) {}
   LargeArray() = default;
+  explicit LargeArray(MemoryCategory) {}
   ~LargeArray() = default;
 
   LargeArray(const LargeArray&) = delete;
@@ -250,6 +283,9 @@ public:
   iterator end() { return nullptr; }
   const_iterator end() const { return nullptr; }
 
+  MemoryCategory memory_category() const { return MemoryCategory::kScratch; }
+  void set_memory_category(MemoryCategory) {}
+
   void allocateInterleaved(size_type) {}
   void allocateBlocked(size_type) {}
   void allocateLocal(size_type) {}
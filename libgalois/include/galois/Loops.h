@@ -28,6 +28,7 @@
 #include "galois/runtime/Executor_OnEach.h"
 #include "galois/runtime/Executor_Ordered.h"
 #include "galois/runtime/Executor_ParaMeter.h"
+#include "galois/runtime/Executor_Reservations.h"
 #include "galois/worklists/WorkList.h"
 
 namespace galois {
@@ -71,6 +72,87 @@ do_all(const Range& range, FunctionTy&& fn, Args&&... args) {
   runtime::do_all_gen(range, std::forward<FunctionTy>(fn), tpl);
 }
 
+/**
+ * A phase of {@link do_all_fused()}. Operator should conform to
+ * <code>fn(item)</code> where item is a value from the iteration range.
+ *
+ * By default, a thread runs a phase over its block of the range right after
+ * it finished the previous phase over the same block, so the phase may only
+ * depend on results of earlier phases for items of the same block, e.g., for
+ * the same item. With {@link after_barrier}, all threads finish the earlier
+ * phases first. With {@link steal}, threads that finish their block early
+ * help others with theirs; the following phase must then use after_barrier.
+ *
+ * @param fn operator, which is moved into the phase
+ * @param args optional arguments to phase, i.e., {@link after_barrier} or
+ * {@link steal}
+ */
+template <typename FunctionTy, typename... Args>
+auto
+phase(FunctionTy&& fn, Args&&...) {
+  return runtime::FusedPhase<std::decay_t<FunctionTy>, std::tuple<Args...>>{
+      std::forward<FunctionTy>(fn)};
+}
+
+/**
+ * Runs a sequence of do-all loops over the same range in a single parallel
+ * section. Each thread works on the same block of the range in every phase,
+ * so its items stay in cache between phases, and threads only wait for each
+ * other at phases marked {@link after_barrier}. This saves a thread pool
+ * dispatch and barrier for each phase over a chain of do_all calls.
+ *
+ * @param range a random access range typically returned by
+ * @ref galois::iterate
+ * @param phases phases returned by @ref galois::phase, in order
+ * @param args optional arguments to loop, e.g., {@see loopname},
+ * {@see chunk_size} for stealing phases
+ */
+template <typename Range, typename... Phases, typename... Args>
+void
+do_all_fused(const Range& range, std::tuple<Phases...> phases, Args&&... args) {
+  auto tpl = std::make_tuple(std::forward<Args>(args)...);
+  runtime::do_all_fused_gen(range, phases, tpl);
+}
+
+/**
+ * Deterministic loop over items that may conflict, using deterministic
+ * reservations. Items are processed in rounds over a window of the
+ * remaining items in range order; the window grows while few items conflict
+ * and shrinks when many do. Each round runs two steps with a barrier between
+ * them:
+ *
+ * - <code>bool reserve(item)</code> may read shared state and reserve the
+ *   locations the item needs (see {@link Reservation}) or compute its
+ *   update into item-private storage, but must not modify shared state.
+ *   Returns false if the item is done without a commit.
+ * - <code>bool commit(item)</code> applies the update of the item if it holds
+ *   its reservations and returns true, or returns false to retry the item in
+ *   the next round. It may only modify locations that no other item in the
+ *   round reads or modifies, e.g., those it holds reservations on.
+ *
+ * The item with the smallest priority in a round always commits, so the loop
+ * terminates, and the result only depends on the order of range, not on the
+ * number of threads. Unlike for_each with a deterministic worklist, there is
+ * no per-item context or lock.
+ *
+ * @param range a random access range typically returned by
+ * @ref galois::iterate
+ * @param reserve reserve step
+ * @param commit commit step
+ * @param args optional arguments to loop, e.g., {@see loopname}
+ */
+template <
+    typename Range, typename ReserveFn, typename CommitFn, typename... Args>
+void
+deterministic_for(
+    const Range& range, ReserveFn&& reserve, CommitFn&& commit,
+    Args&&... args) {
+  auto tpl = std::make_tuple(std::forward<Args>(args)...);
+  runtime::deterministic_for_gen(
+      range, std::forward<ReserveFn>(reserve), std::forward<CommitFn>(commit),
+      tpl);
+}
+
 /**
  * Low-level parallel loop. Operator is applied for each running thread.
  * Operator should confirm to <code>fn(tid, numThreads)</code> where tid is
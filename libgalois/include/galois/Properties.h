@@ -10,6 +10,7 @@
 #include <arrow/type_fwd.h>
 #include <arrow/type_traits.h>
 
+#include "galois/ArrowMemoryPool.h"
 #include "galois/ErrorCode.h"
 #include "galois/Logging.h"
 #include "galois/Result.h"
@@ -353,9 +354,8 @@ AllocateTable(uint64_t num_rows, const std::vector<std::string>& names) {
   std::shared_ptr<arrow::Table> table;
   std::vector<galois::PropertyArrowTuple<Props>> rows(num_rows);
   GALOIS_ASSERT(names.size() == num_tuple_elem);
-  // TODO(gill): Replace this with NUMA allocated buffers.
   if (auto r = arrow::stl::TableFromTupleRange(
-          arrow::default_memory_pool(), std::move(rows), names, &table);
+          GetArrowMemoryPool(), std::move(rows), names, &table);
       !r.ok()) {
     GALOIS_LOG_DEBUG("arrow error: {}", r);
     return galois::ErrorCode::ArrowError;
@@ -20,8 +20,12 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_REDUCTION_H_
 #define GALOIS_LIBGALOIS_GALOIS_REDUCTION_H_
 
+#include <algorithm>
+#include <cassert>
 #include <functional>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "galois/config.h"
 #include "galois/substrate/PerThreadStorage.h"
@@ -60,10 +64,23 @@ namespace galois {
  *   T u = ...
  *   r.update(std::move(u));
  *   T& result = r.reduce();
+ *
+ * reduce() walks the values of all threads serially. To spread that work
+ * over the threads, every thread of a parallel region can call combine()
+ * after the last update, which merges the values of each socket into the
+ * value of its leader; reduce() then only merges one value per socket. Loops
+ * do this inside their final barrier with the galois::combine_reducers
+ * trait.
  */
 template <typename T, typename MergeFunc, typename IdFunc>
 class Reducible : public MergeFunc, public IdFunc {
-  galois::substrate::PerThreadStorage<T> data_;
+  struct Slot {
+    T value;
+    //! Set on socket leaders whose socket has been merged by combine()
+    bool combined{false};
+  };
+
+  galois::substrate::PerThreadStorage<Slot> data_;
 
   void merge(T& lhs, T&& rhs) {
     T v{std::move(MergeFunc::operator()(lhs, std::move(rhs)))};
@@ -78,7 +95,7 @@ public:
   Reducible(MergeFunc merge_func, IdFunc id_func)
       : MergeFunc(merge_func), IdFunc(id_func) {
     for (unsigned i = 0; i < data_.size(); ++i) {
-      *(data_.getRemote(i)) = IdFunc::operator()();
+      data_.getRemote(i)->value = IdFunc::operator()();
     }
   }
 
@@ -86,24 +103,58 @@ public:
    * Updates the thread local value by applying the reduction operator to
    * current and newly provided value
    */
-  void update(T&& rhs) { merge(*data_.getLocal(), std::move(rhs)); }
+  void update(T&& rhs) { merge(data_.getLocal()->value, std::move(rhs)); }
 
-  void update(const T& rhs) { merge(*data_.getLocal(), rhs); }
+  void update(const T& rhs) { merge(data_.getLocal()->value, rhs); }
 
   /**
    * Returns a reference to the local value of T.
    */
-  T& getLocal() { return *data_.getLocal(); }
+  T& getLocal() { return data_.getLocal()->value; }
+
+  /**
+   * Merges the values of the threads of the calling thread's socket into the
+   * value of the socket leader. Called by every thread of a parallel region
+   * once all threads are done updating (e.g., after a barrier). There must be
+   * no further updates until reduce().
+   */
+  void combine() {
+    auto& tp = substrate::GetThreadPool();
+    unsigned tid = substrate::ThreadPool::getTID();
+    if (!tp.isLeader(tid)) {
+      return;
+    }
+    Slot& lhs = *data_.getLocal();
+    for (unsigned i = tid + 1; i < data_.size(); ++i) {
+      if (tp.getLeader(i) == tid) {
+        Slot& rhs = *data_.getRemote(i);
+        merge(lhs.value, std::move(rhs.value));
+        rhs.value = IdFunc::operator()();
+      }
+    }
+    lhs.combined = true;
+  }
 
   /**
    * Returns the final reduction value. Only valid outside the parallel region.
    */
   T& reduce() {
-    T& lhs = *data_.getLocal();
+    auto& tp = substrate::GetThreadPool();
+    Slot& local = *data_.getLocal();
+    T& lhs = local.value;
     for (unsigned int i = 1; i < data_.size(); ++i) {
-      T& rhs = *data_.getRemote(i);
-      merge(lhs, std::move(rhs));
-      rhs = IdFunc::operator()();
+      unsigned leader = tp.getLeader(i);
+      if (leader != i && data_.getRemote(leader)->combined) {
+        continue;
+      }
+      Slot& rhs = *data_.getRemote(i);
+      merge(lhs, std::move(rhs.value));
+      rhs.value = IdFunc::operator()();
+    }
+    for (unsigned int i = 0; i < data_.size(); ++i) {
+      if (tp.isLeader(i)) {
+        data_.getRemote(i)->combined = false;
+      }
     }
 
     return lhs;
@@ -111,7 +162,9 @@ public:
 
   void reset() {
     for (unsigned int i = 0; i < data_.size(); ++i) {
-      *data_.getRemote(i) = IdFunc::operator()();
+      Slot& slot = *data_.getRemote(i);
+      slot.value = IdFunc::operator()();
+      slot.combined = false;
     }
   }
 };
@@ -226,5 +279,155 @@ public:
       : base_type(std::logical_or<bool>(), identity_value<bool, false>()) {}
 };
 
+namespace internal {
+
+//! Merges two vectors of the same size element by element
+template <typename T, typename MergeFunc>
+struct ElementwiseMerge : public MergeFunc {
+  explicit ElementwiseMerge(const MergeFunc& merge_func)
+      : MergeFunc(merge_func) {}
+
+  std::vector<T>& operator()(std::vector<T>& lhs, std::vector<T>&& rhs) {
+    assert(lhs.size() == rhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i) {
+      lhs[i] = MergeFunc::operator()(lhs[i], rhs[i]);
+    }
+    return lhs;
+  }
+};
+
+template <typename T, typename IdFunc>
+struct VectorIdentity : public IdFunc {
+  size_t size;
+
+  VectorIdentity(size_t s, const IdFunc& id_func) : IdFunc(id_func), size(s) {}
+
+  std::vector<T> operator()() const {
+    return std::vector<T>(size, IdFunc::operator()());
+  }
+};
+
+//! Keeps the k best values seen as a heap whose front is the worst of them
+template <typename T, typename Compare>
+struct TopKMerge : public Compare {
+  size_t k;
+
+  TopKMerge(size_t k_, const Compare& compare) : Compare(compare), k(k_) {}
+
+  //! Returns true if lhs ranks above rhs
+  bool better(const T& lhs, const T& rhs) const {
+    return Compare::operator()(rhs, lhs);
+  }
+
+  void push(std::vector<T>& heap, const T& value) const {
+    auto cmp = [this](const T& lhs, const T& rhs) { return better(lhs, rhs); };
+    if (heap.size() < k) {
+      heap.push_back(value);
+      std::push_heap(heap.begin(), heap.end(), cmp);
+    } else if (k > 0 && Compare::operator()(heap.front(), value)) {
+      std::pop_heap(heap.begin(), heap.end(), cmp);
+      heap.back() = value;
+      std::push_heap(heap.begin(), heap.end(), cmp);
+    }
+  }
+
+  std::vector<T>& operator()(std::vector<T>& lhs, std::vector<T>&& rhs) {
+    for (const T& value : rhs) {
+      push(lhs, value);
+    }
+    return lhs;
+  }
+};
+
+template <typename T>
+struct EmptyVector {
+  std::vector<T> operator()() const { return std::vector<T>(); }
+};
+
+}  // namespace internal
+
+/**
+ * A Reducible of fixed-size vectors merged element by element, e.g., for
+ * histograms. Each element is reduced with MergeFunc and starts at IdFunc().
+ *
+ *   auto hist = make_vector_reducible<size_t>(
+ *       num_buckets, std::plus<size_t>(), identity_value_zero<size_t>());
+ *   do_all(..., [&](auto n) { hist.update(bucket(n), 1); });
+ *   std::vector<size_t>& counts = hist.reduce();
+ */
+template <typename T, typename MergeFunc, typename IdFunc>
+class VectorReducible
+    : public Reducible<
+          std::vector<T>, internal::ElementwiseMerge<T, MergeFunc>,
+          internal::VectorIdentity<T, IdFunc>> {
+  using base_type = Reducible<
+      std::vector<T>, internal::ElementwiseMerge<T, MergeFunc>,
+      internal::VectorIdentity<T, IdFunc>>;
+
+public:
+  VectorReducible(size_t size, MergeFunc merge_func, IdFunc id_func)
+      : base_type(
+            internal::ElementwiseMerge<T, MergeFunc>(merge_func),
+            internal::VectorIdentity<T, IdFunc>(size, id_func)) {}
+
+  size_t size() const { return internal::VectorIdentity<T, IdFunc>::size; }
+
+  //! Merges value into element index of the thread local vector
+  void update(size_t index, const T& value) {
+    T& element = base_type::getLocal()[index];
+    element = MergeFunc::operator()(element, value);
+  }
+};
+
+template <typename T, typename MergeFn, typename IdFn>
+auto
+make_vector_reducible(size_t size, const MergeFn& mergeFn, const IdFn& idFn) {
+  return VectorReducible<T, MergeFn, IdFn>(size, mergeFn, idFn);
+}
+
+//! Vector of counters where accumulation is plus, e.g., a histogram
+template <typename T>
+class GVectorAccumulator
+    : public VectorReducible<T, std::plus<T>, identity_value_zero<T>> {
+  using base_type = VectorReducible<T, std::plus<T>, identity_value_zero<T>>;
+
+public:
+  explicit GVectorAccumulator(size_t size)
+      : base_type(size, std::plus<T>(), identity_value_zero<T>()) {}
+};
+
+/**
+ * Keeps the k largest values according to Compare, e.g., the k nodes with
+ * the highest score when T is a (score, node) pair.
+ */
+template <typename T, typename Compare = std::less<T>>
+class GReduceTopK : public Reducible<
+                        std::vector<T>, internal::TopKMerge<T, Compare>,
+                        internal::EmptyVector<T>> {
+  using base_type = Reducible<
+      std::vector<T>, internal::TopKMerge<T, Compare>,
+      internal::EmptyVector<T>>;
+
+public:
+  explicit GReduceTopK(size_t k, Compare compare = Compare())
+      : base_type(
+            internal::TopKMerge<T, Compare>(k, compare),
+            internal::EmptyVector<T>()) {}
+
+  void update(const T& value) {
+    internal::TopKMerge<T, Compare>::push(base_type::getLocal(), value);
+  }
+
+  //! Returns the (at most) k largest values, largest first. Only valid
+  //! outside the parallel region.
+  std::vector<T> reduce() {
+    std::vector<T> ret = base_type::reduce();
+    std::sort(ret.begin(), ret.end(), [this](const T& lhs, const T& rhs) {
+      return internal::TopKMerge<T, Compare>::better(lhs, rhs);
+    });
+    return ret;
+  }
+};
+
 }  // namespace galois
 #endif
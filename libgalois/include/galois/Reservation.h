@@ -0,0 +1,79 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_LIBGALOIS_GALOIS_RESERVATION_H_
+#define GALOIS_LIBGALOIS_GALOIS_RESERVATION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include "galois/config.h"
+
+namespace galois {
+
+/**
+ * A location that items of {@link deterministic_for()} compete for. During
+ * the reserve step, every item that wants the location calls Reserve with its
+ * priority and the item with the smallest priority wins; during the commit
+ * step, an item checks IsReservedBy before acting on the location.
+ *
+ * Priorities must be unique among the items of a loop, e.g., the position of
+ * the item or its node id. An item must Release every location it reserved
+ * when it commits or gives up, so that a stale reservation does not block
+ * later items.
+ */
+class Reservation {
+public:
+  static constexpr uint64_t kFree = std::numeric_limits<uint64_t>::max();
+
+  Reservation() = default;
+  Reservation(const Reservation&) = delete;
+  Reservation& operator=(const Reservation&) = delete;
+
+  void Reserve(uint64_t priority) {
+    uint64_t current = owner_.load(std::memory_order_relaxed);
+    while (priority < current &&
+           !owner_.compare_exchange_weak(
+               current, priority, std::memory_order_relaxed)) {
+    }
+  }
+
+  bool IsReservedBy(uint64_t priority) const {
+    return owner_.load(std::memory_order_relaxed) == priority;
+  }
+
+  bool IsFree() const {
+    return owner_.load(std::memory_order_relaxed) == kFree;
+  }
+
+  //! Clears the reservation if it is held by priority
+  void Release(uint64_t priority) {
+    if (IsReservedBy(priority)) {
+      owner_.store(kFree, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::atomic<uint64_t> owner_{kFree};
+};
+
+}  // namespace galois
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+/**
+ * @file galois/SetIntersection.h
+ *
+ * Intersection of sorted sets, e.g., the sorted adjacency lists of two nodes.
+ *
+ * Which kernel is fastest depends on the sizes of the sets:
+ *  - similar sizes: vectorized merge (IntersectCountSimd)
+ *  - very different sizes: galloping search in the larger set
+ *    (IntersectCountGalloping)
+ *  - one set intersected with many others, e.g., the neighbors of a hub node
+ *    with those of each of its neighbors: IntersectionBitmap, which costs
+ *    O(size of the other set) per intersection
+ *
+ * IntersectCount chooses between the first two by the ratio of the sizes.
+ */
+
+#ifndef GALOIS_LIBGALOIS_GALOIS_SETINTERSECTION_H_
+#define GALOIS_LIBGALOIS_GALOIS_SETINTERSECTION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "galois/config.h"
+
+namespace galois {
+
+//! Galloping is used when the larger set is at least this many times larger
+//! than the smaller one
+constexpr size_t kGallopingRatio = 64;
+
+/// Calls fn(x) for every x in both [a, a + a_size) and [b, b + b_size) by
+/// merging them. Both ranges must be sorted and free of duplicates.
+template <typename T, typename F>
+void
+IntersectMerge(const T* a, size_t a_size, const T* b, size_t b_size, F fn) {
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a_size && j < b_size) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      fn(a[i]);
+      ++i;
+      ++j;
+    }
+  }
+}
+
+/// Calls fn(x) for every x in both [small, small + small_size) and
+/// [large, large + large_size) by exponential search in large for each item of
+/// small, which costs O(small_size * log(large_size / small_size)). Both
+/// ranges must be sorted and free of duplicates.
+template <typename T, typename F>
+void
+IntersectGalloping(
+    const T* small, size_t small_size, const T* large, size_t large_size,
+    F fn) {
+  size_t j = 0;
+  for (size_t i = 0; i < small_size && j < large_size; ++i) {
+    const T& x = small[i];
+    size_t step = 1;
+    size_t lo = j;
+    while (lo + step < large_size && large[lo + step] < x) {
+      lo += step;
+      step <<= 1;
+    }
+    size_t hi = std::min(lo + step + 1, large_size);
+    j = std::lower_bound(large + lo, large + hi, x) - large;
+    if (j < large_size && !(x < large[j])) {
+      fn(x);
+      ++j;
+    }
+  }
+}
+
+/// Calls fn(x) for every x in both sorted, duplicate-free ranges, galloping
+/// through the larger range when the sizes are very different and merging
+/// otherwise
+template <typename T, typename F>
+void
+Intersect(const T* a, size_t a_size, const T* b, size_t b_size, F fn) {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  if (a_size * kGallopingRatio <= b_size) {
+    IntersectGalloping(a, a_size, b, b_size, fn);
+  } else {
+    IntersectMerge(a, a_size, b, b_size, fn);
+  }
+}
+
+/// Returns the number of items in both [a, a + a_size) and [b, b + b_size),
+/// which must be sorted and free of duplicates. Galloping is used when the
+/// sizes differ by at least kGallopingRatio, otherwise a vectorized merge for
+/// the widest instruction set the processor supports.
+GALOIS_EXPORT uint64_t IntersectCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size);
+
+//! Scalar merge of IntersectCount
+GALOIS_EXPORT uint64_t IntersectCountMerge(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size);
+
+//! Galloping search of IntersectCount; either range may be the smaller one
+GALOIS_EXPORT uint64_t IntersectCountGalloping(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size);
+
+//! Vectorized merge of IntersectCount (SSE4.2 or AVX2, and AVX-512 for
+//! ranges whose sizes differ by at least 2x, if supported)
+GALOIS_EXPORT uint64_t IntersectCountSimd(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size);
+
+/// A set of IDs less than a fixed universe size stored as a bitmap, i.e., a
+/// direct-mapped hash set of dense IDs. Building it costs O(set size), after
+/// which counting the items of another range that are in the set costs
+/// O(range size) independently of the size of the set, and the range need not
+/// be sorted. This beats merging when one large set is intersected with many
+/// smaller ones.
+///
+/// Erase the inserted items again before reusing the bitmap for another set;
+/// this is cheaper than clearing it when the universe is large.
+class GALOIS_EXPORT IntersectionBitmap {
+  std::vector<uint64_t> words_;
+
+public:
+  IntersectionBitmap() = default;
+  explicit IntersectionBitmap(size_t universe) { Resize(universe); }
+
+  //! Allocates space for IDs less than universe and empties the set
+  void Resize(size_t universe);
+
+  //! Returns the number of IDs the bitmap can hold
+  size_t universe() const { return words_.size() * 64; }
+
+  void Insert(const uint32_t* a, size_t a_size);
+
+  void Erase(const uint32_t* a, size_t a_size);
+
+  bool Contains(uint32_t x) const {
+    return (words_[x / 64] >> (x % 64)) & 1;
+  }
+
+  //! Returns the number of items of [b, b + b_size) that are in the set
+  uint64_t Count(const uint32_t* b, size_t b_size) const;
+};
+
+}  // namespace galois
+
+#endif
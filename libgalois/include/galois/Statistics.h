@@ -20,10 +20,12 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_STATISTICS_H_
 #define GALOIS_LIBGALOIS_GALOIS_STATISTICS_H_
 
+#include <iosfwd>
 #include <limits>
 #include <string>
 #include <type_traits>
 
+#include "galois/Result.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/gstl.h"
@@ -197,6 +199,8 @@ public:
   const_iterator cbegin() const { return statMap.cbegin(); }
   const_iterator cend() const { return statMap.cend(); }
 
+  void clear() { statMap.clear(); }
+
   const Str& region(const const_iterator& i) const {
     return *(std::get<0>(i->first));
   }
@@ -360,6 +364,20 @@ public:
       const std::string& region, const std::string& category, const Str& val);
 
   void Print();
+
+  /// SetMetadata adds a key and value to every record written by
+  /// WriteJsonLines, e.g., the name and version of the input graph.
+  void SetMetadata(const std::string& key, const std::string& value);
+
+  /// WriteJsonLines writes the statistics recorded so far as JSON Lines, one
+  /// object per statistic with the run metadata (host, threads, version,
+  /// command line and SetMetadata values), the total and the per-thread
+  /// values. Unlike Print, it can be called repeatedly during a run; if reset
+  /// is true, the statistics written are cleared afterwards so that the next
+  /// call only reports what was recorded in between. Parameters (see
+  /// ReportParam) are never cleared. It must be called outside of parallel
+  /// sections.
+  void WriteJsonLines(std::ostream& out, bool reset);
 };
 
 namespace internal {
@@ -437,12 +455,43 @@ GALOIS_EXPORT void reportRUsage(const std::string& id);
 //! Reports Galois system memory stats for all threads
 GALOIS_EXPORT void reportPageAlloc(const char* category);
 
+//! Reports the bytes currently allocated and the peak for each memory
+//! category (see galois/MemoryAccounting.h) and in total
+//! @param region Region to report the stats under
+GALOIS_EXPORT void reportMemoryUsage(const std::string& region);
+
 /// Prints statistics out to standard out or to the file indicated by
 /// SetStatFile
 GALOIS_EXPORT void PrintStats();
 
+/// Adds key and value to the metadata of machine-readable statistics
+GALOIS_EXPORT void SetStatMetadata(
+    const std::string& key, const std::string& value);
+
+/// Returns the statistics recorded so far as JSON Lines (see
+/// StatManager::WriteJsonLines), or nothing if the runtime is not running
+GALOIS_EXPORT std::string SnapshotStats(bool reset = false);
+
+/// Writes the statistics recorded so far as JSON Lines to uri, which may be a
+/// local path or any URI supported by tsuba. If the environment variable
+/// GALOIS_STATS_JSONL is set, the statistics are also written to it when the
+/// runtime shuts down. Returns ErrorCode::NotFound if the runtime is not
+/// running.
+GALOIS_EXPORT Result<void> WriteStatsJsonLines(
+    const std::string& uri, bool reset = false);
+
 GALOIS_EXPORT void SetStatFile(const std::string& f);
 
+/// If enable is true, every StatTimer stopped from now on also reports its
+/// time in microseconds as <name>Usec, so that short regions (e.g., a single
+/// query in a long-running service) are not rounded down to nothing. It is
+/// off by default.
+GALOIS_EXPORT void SetStatTimerMicroseconds(bool enable);
+
+/// Returns whether StatTimer reports microseconds (see
+/// SetStatTimerMicroseconds)
+GALOIS_EXPORT bool StatTimerMicroseconds();
+
 }  // end namespace galois
 
 #endif
@@ -219,6 +219,14 @@ struct loopname : public trait_has_value<const char*>, loopname_tag {
 struct steal_tag {};
 struct steal : public trait_has_type<bool>, steal_tag {};
 
+/**
+ * Indicate that a phase of {@link do_all_fused()} may read results of earlier
+ * phases for any item, so all threads must finish the earlier phases before
+ * it starts. Optional argument to {@link phase()}.
+ */
+struct after_barrier_tag {};
+struct after_barrier : public trait_has_type<bool>, after_barrier_tag {};
+
 /**
  * Indicates worklist to use. Optional argument to {@link for_each()} loops.
  */
@@ -268,6 +276,14 @@ struct no_stats : public trait_has_type<bool>, no_stats_tag {};
 struct more_stats_tag {};
 struct more_stats : public trait_has_type<bool>, more_stats_tag {};
 
+/**
+ * Indicates the operator's hardware counters (cycles, instructions, LLC and
+ * dTLB misses) should be recorded per thread, see runtime/PerfCounters.h.
+ * Must provide loopname to enable this flag
+ */
+struct profile_counters_tag {};
+struct profile_counters : public trait_has_type<bool>, profile_counters_tag {};
+
 /**
  * Indicates the operator doesn't need abort support
  */
@@ -275,6 +291,31 @@ struct disable_conflict_detection_tag {};
 struct disable_conflict_detection : public trait_has_type<bool>,
                                     disable_conflict_detection_tag {};
 
+/**
+ * Indicates conflicts should be detected with a shared table of striped
+ * locks (runtime::StripedLockTable) instead of the owner word of each
+ * Lockable. Iterations that abort repeatedly gain priority and aborted
+ * iterations back off, which avoids livelock under high contention. The
+ * abort rate and contention per stripe are reported as statistics of the
+ * loop.
+ */
+struct striped_locks_tag {};
+struct striped_locks : public trait_has_type<bool>, striped_locks_tag {};
+
+/**
+ * Indicates the given Reducibles should be combined per socket (see
+ * Reducible::combine) inside the final barrier of a do_all or do_all_fused,
+ * so that reduce() after the loop only merges one value per socket. They must
+ * not be updated again before reduce().
+ */
+struct combine_reducers_tag {};
+template <typename... Rs>
+struct combine_reducers : public trait_has_value<std::tuple<Rs*...>>,
+                          combine_reducers_tag {
+  explicit combine_reducers(Rs&... rs)
+      : trait_has_value<std::tuple<Rs*...>>(std::make_tuple(&rs...)) {}
+};
+
 /**
  * Indicates that the neighborhood set does not change through out i.e. is not
  * dependent on computed values. Examples of such fixed neighborhood is e.g.
@@ -0,0 +1,279 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_EDGEMAP_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_EDGEMAP_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "galois/Bag.h"
+#include "galois/DynamicBitset.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+#include "galois/config.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace galois::analytics {
+
+/// The incoming edges of every node of a PropertyFileGraph in CSR form. For
+/// symmetric graphs the view aliases the outgoing edges and costs nothing to
+/// build; otherwise it holds a transposed copy of the topology in which the
+/// incoming edges of each node are sorted by source.
+class GALOIS_EXPORT InEdgeView {
+  const graphs::GraphTopology* topology_{nullptr};
+  bool symmetric_{false};
+  galois::LargeArray<uint64_t> in_indices_;
+  galois::LargeArray<uint32_t> in_sources_;
+  galois::LargeArray<uint64_t> out_edges_;
+
+public:
+  /// Builds the transpose of the topology of pfg.
+  static InEdgeView Make(const graphs::PropertyFileGraph& pfg);
+
+  /// Uses the outgoing edges of pfg as its incoming edges. pfg must be
+  /// symmetric.
+  static InEdgeView MakeSymmetric(const graphs::PropertyFileGraph& pfg);
+
+  bool symmetric() const { return symmetric_; }
+
+  uint64_t num_nodes() const { return topology_->num_nodes(); }
+  uint64_t num_edges() const { return topology_->num_edges(); }
+
+  std::pair<uint64_t, uint64_t> edge_range(uint32_t node) const {
+    if (symmetric_) {
+      return topology_->edge_range(node);
+    }
+    return std::make_pair(
+        node > 0 ? in_indices_[node - 1] : 0, in_indices_[node]);
+  }
+
+  /// Returns the source of incoming edge edge.
+  uint32_t GetEdgeSource(uint64_t edge) const {
+    if (symmetric_) {
+      return topology_->out_dests->Value(edge);
+    }
+    return in_sources_[edge];
+  }
+
+  /// Returns the id of the outgoing edge that incoming edge edge was built
+  /// from, which can be used to look up edge properties. For symmetric views
+  /// this is the reverse edge, i.e., edge itself.
+  uint64_t GetOutEdge(uint64_t edge) const {
+    if (symmetric_) {
+      return edge;
+    }
+    return out_edges_[edge];
+  }
+};
+
+/// A set of active nodes for frontier-based algorithms. A frontier is stored
+/// either as a sparse list of nodes, which is cheap to build and iterate when
+/// few nodes are active, or as a dense bitset, which supports constant time
+/// membership tests when many nodes are active. EdgeMap converts between the
+/// two as needed.
+class GALOIS_EXPORT Frontier {
+  uint64_t num_nodes_{0};
+  uint64_t size_{0};
+  bool dense_{false};
+  // InsertBag only supports iteration through non-const local ranges
+  mutable galois::InsertBag<uint32_t> sparse_;
+  galois::DynamicBitset bits_;
+
+public:
+  /// Constructs an empty frontier over num_nodes nodes.
+  explicit Frontier(uint64_t num_nodes) : num_nodes_(num_nodes) {}
+
+  /// Constructs a sparse frontier from a bag of size distinct nodes.
+  Frontier(
+      uint64_t num_nodes, galois::InsertBag<uint32_t>&& nodes, uint64_t size)
+      : num_nodes_(num_nodes), size_(size), sparse_(std::move(nodes)) {}
+
+  /// Constructs a dense frontier from a bitset with size set bits.
+  Frontier(uint64_t num_nodes, galois::DynamicBitset&& nodes, uint64_t size)
+      : num_nodes_(num_nodes),
+        size_(size),
+        dense_(true),
+        bits_(std::move(nodes)) {}
+
+  Frontier(Frontier&&) = default;
+  Frontier& operator=(Frontier&&) = default;
+
+  /// Returns a sparse frontier that holds only node.
+  static Frontier FromNode(uint64_t num_nodes, uint32_t node);
+
+  /// Returns a dense frontier that holds every node.
+  static Frontier All(uint64_t num_nodes);
+
+  uint64_t num_nodes() const { return num_nodes_; }
+  uint64_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool is_dense() const { return dense_; }
+
+  /// Returns true if node is in the frontier. The frontier must be dense.
+  bool Contains(uint32_t node) const {
+    assert(dense_);
+    return bits_.test(node);
+  }
+
+  /// Converts the frontier to a bitset.
+  void ToDense();
+
+  /// Converts the frontier to a list of nodes.
+  void ToSparse();
+
+  /// Calls fn(node) in parallel for every node in the frontier.
+  template <typename F>
+  void ForEach(const F& fn) const {
+    if (dense_) {
+      bits_.for_each_set_bit([&](size_t node) { fn(node); });
+    } else {
+      galois::do_all(
+          galois::iterate(sparse_), [&](uint32_t node) { fn(node); },
+          galois::steal(), galois::no_stats());
+    }
+  }
+};
+
+/// Controls how EdgeMap chooses between pushing updates along the outgoing
+/// edges of the frontier and pulling them along the incoming edges of
+/// candidate destinations.
+struct EdgeMapPolicy {
+  enum Direction { kAutomatic, kPush, kPull };
+
+  Direction direction{kAutomatic};
+  /// A sparse frontier switches to pull when its nodes and outgoing edges
+  /// exceed num_edges / alpha.
+  uint32_t alpha{15};
+  /// A dense frontier switches back to push when it has fewer than
+  /// num_nodes / beta nodes.
+  uint32_t beta{18};
+};
+
+namespace internal {
+
+/// Returns true if the next EdgeMap over frontier should pull.
+template <typename Topology>
+bool
+ShouldPull(
+    const Topology& topology, const Frontier& frontier,
+    const EdgeMapPolicy& policy) {
+  switch (policy.direction) {
+  case EdgeMapPolicy::kPush:
+    return false;
+  case EdgeMapPolicy::kPull:
+    return true;
+  default:
+    break;
+  }
+
+  if (frontier.is_dense()) {
+    return frontier.size() >= topology.num_nodes() / policy.beta;
+  }
+
+  galois::GAccumulator<uint64_t> out_degrees;
+  frontier.ForEach([&](uint32_t node) {
+    auto [begin, end] = topology.edge_range(node);
+    out_degrees += end - begin;
+  });
+  return frontier.size() + out_degrees.reduce() >
+         topology.num_edges() / policy.alpha;
+}
+
+}  // namespace internal
+
+/// Applies update_fn(src, dst, edge) to the edges whose source src is in
+/// frontier and whose destination dst satisfies cond_fn(dst), and returns the
+/// frontier of destinations for which update_fn returned true. edge is the id
+/// of the outgoing edge, so edge properties can be read through it.
+///
+/// Each round either pushes along the outgoing edges of a sparse frontier or,
+/// if in_edges is given, pulls along the incoming edges of every node that
+/// satisfies cond_fn, testing sources against a dense frontier. Pulling stops
+/// scanning the incoming edges of dst as soon as cond_fn(dst) becomes false,
+/// which makes it much cheaper than pushing when most edges lead to nodes
+/// that are already done (e.g., visited nodes in BFS).
+///
+/// When pushing, update_fn may be called concurrently for the same dst and
+/// must therefore update dst atomically; it should return true at most once
+/// per dst, or dst will appear in the next frontier more than once. When
+/// pulling, all updates of dst happen on one thread.
+template <typename UpdateFn, typename CondFn>
+Frontier
+EdgeMap(
+    const graphs::GraphTopology& topology, const InEdgeView* in_edges,
+    Frontier* frontier, const UpdateFn& update_fn, const CondFn& cond_fn,
+    const EdgeMapPolicy& policy = EdgeMapPolicy()) {
+  const uint64_t num_nodes = topology.num_nodes();
+  galois::GAccumulator<uint64_t> next_size;
+
+  if (in_edges && internal::ShouldPull(topology, *frontier, policy)) {
+    frontier->ToDense();
+
+    galois::DynamicBitset next;
+    next.resize(num_nodes);
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint32_t dst) {
+          if (!cond_fn(dst)) {
+            return;
+          }
+          bool added = false;
+          auto [begin, end] = in_edges->edge_range(dst);
+          for (auto e = begin; e != end; ++e) {
+            uint32_t src = in_edges->GetEdgeSource(e);
+            if (frontier->Contains(src) &&
+                update_fn(src, dst, in_edges->GetOutEdge(e))) {
+              added = true;
+            }
+            if (!cond_fn(dst)) {
+              break;
+            }
+          }
+          if (added) {
+            next.set(dst);
+            next_size += 1;
+          }
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("EdgeMapPull"));
+
+    return Frontier(num_nodes, std::move(next), next_size.reduce());
+  }
+
+  frontier->ToSparse();
+
+  galois::InsertBag<uint32_t> next;
+  frontier->ForEach([&](uint32_t src) {
+    auto [begin, end] = topology.edge_range(src);
+    for (auto e = begin; e != end; ++e) {
+      uint32_t dst = topology.out_dests->Value(e);
+      if (cond_fn(dst) && update_fn(src, dst, e)) {
+        next.push(dst);
+        next_size += 1;
+      }
+    }
+  });
+
+  return Frontier(num_nodes, std::move(next), next_size.reduce());
+}
+
+}  // namespace galois::analytics
+
+#endif
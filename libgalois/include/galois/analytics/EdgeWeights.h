@@ -0,0 +1,27 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_EDGEWEIGHTS_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_EDGEWEIGHTS_H_
+
+#include <string>
+
+#include "galois/LargeArray.h"
+#include "galois/Result.h"
+#include "galois/config.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace galois::analytics {
+
+/// Reads the weight of every edge of pfg as a double into weights, which must
+/// have room for every edge and is indexed by edge id. The weights are taken
+/// from the edge property named edge_weight_property_name, which may be a 32-
+/// or 64-bit signed or unsigned int, float or double; if
+/// edge_weight_property_name is empty, every edge has weight 1. Returns
+/// PropertyNotFound if there is no such property, TypeError if it has another
+/// type and InvalidArgument if any weight is negative.
+GALOIS_EXPORT Result<void> ReadEdgeWeights(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    galois::LargeArray<double>* weights);
+
+}  // namespace galois::analytics
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_MULTISOURCEBFS_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_MULTISOURCEBFS_H_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "galois/Bag.h"
+#include "galois/DynamicBitset.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+#include "galois/analytics/EdgeMap.h"
+#include "galois/config.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace galois::analytics {
+
+/// A set of the concurrent searches of a MultiSourceBfs with one bit (lane)
+/// per search.
+template <size_t kLanes>
+class LaneSet {
+  static_assert(kLanes > 0 && kLanes % 64 == 0, "lanes come in 64-bit words");
+
+public:
+  static constexpr size_t kWords = kLanes / 64;
+
+private:
+  std::array<uint64_t, kWords> words_{};
+
+public:
+  uint64_t& word(size_t w) { return words_[w]; }
+  uint64_t word(size_t w) const { return words_[w]; }
+
+  void Set(size_t lane) { words_[lane / 64] |= uint64_t{1} << (lane % 64); }
+
+  bool Test(size_t lane) const {
+    return (words_[lane / 64] >> (lane % 64)) & 1;
+  }
+
+  bool Any() const {
+    uint64_t any = 0;
+    for (size_t w = 0; w < kWords; ++w) {
+      any |= words_[w];
+    }
+    return any != 0;
+  }
+
+  size_t Count() const {
+    size_t count = 0;
+    for (size_t w = 0; w < kWords; ++w) {
+      count += __builtin_popcountll(words_[w]);
+    }
+    return count;
+  }
+
+  /// Calls fn(lane) for every lane in the set in increasing order.
+  template <typename F>
+  void ForEach(const F& fn) const {
+    for (size_t w = 0; w < kWords; ++w) {
+      for (uint64_t word = words_[w]; word != 0; word &= word - 1) {
+        fn(w * 64 + __builtin_ctzll(word));
+      }
+    }
+  }
+
+  /// Returns the lanes of this set that are not in other.
+  LaneSet AndNot(const LaneSet& other) const {
+    LaneSet ret;
+    for (size_t w = 0; w < kWords; ++w) {
+      ret.words_[w] = words_[w] & ~other.words_[w];
+    }
+    return ret;
+  }
+
+  LaneSet& operator|=(const LaneSet& other) {
+    for (size_t w = 0; w < kWords; ++w) {
+      words_[w] |= other.words_[w];
+    }
+    return *this;
+  }
+
+  friend LaneSet operator&(const LaneSet& a, const LaneSet& b) {
+    LaneSet ret;
+    for (size_t w = 0; w < kWords; ++w) {
+      ret.words_[w] = a.words_[w] & b.words_[w];
+    }
+    return ret;
+  }
+
+  friend LaneSet operator~(const LaneSet& a) {
+    LaneSet ret;
+    for (size_t w = 0; w < kWords; ++w) {
+      ret.words_[w] = ~a.words_[w];
+    }
+    return ret;
+  }
+
+  friend bool operator==(const LaneSet& a, const LaneSet& b) {
+    return a.words_ == b.words_;
+  }
+};
+
+/// Breadth-first searches from up to kLanes sources at once (MS-BFS). Every
+/// node keeps one bit per search, so a traversal step advances all searches
+/// that share a frontier node with a few word operations instead of once per
+/// search, and nodes and edges are loaded once per level rather than once
+/// per source.
+///
+/// Like EdgeMap, each level either pushes along the outgoing edges of the
+/// nodes in the frontier or, if incoming edges are given and the frontier is
+/// large, pulls along the incoming edges of every node that some search has
+/// not reached yet.
+///
+/// After Run, level(d) holds every node that is first reached at distance d
+/// by some search together with the set of those searches. This is enough to
+/// answer reachability and distance questions for many sources and to
+/// process nodes in reverse order of distance, as in Brandes' algorithm.
+template <size_t kLanes>
+class MultiSourceBfs {
+public:
+  using Lanes = LaneSet<kLanes>;
+
+  struct Visit {
+    uint32_t node;
+    Lanes lanes;
+  };
+
+  using Level = galois::InsertBag<Visit>;
+
+private:
+  /// An edge function for searches that only need the levels
+  struct NoEdgeFn {
+    void operator()(uint32_t, uint32_t, const Lanes&) const {}
+  };
+
+  const graphs::GraphTopology& topology_;
+  const InEdgeView* in_edges_;
+  EdgeMapPolicy policy_;
+
+  /// Searches that have reached each node
+  galois::LargeArray<Lanes> seen_;
+  /// Searches that reached each node in the last level
+  galois::LargeArray<Lanes> visit_;
+  /// Searches that reach each node in the next level when pushing
+  galois::LargeArray<Lanes> next_;
+  galois::DynamicBitset queued_;
+
+  std::vector<std::unique_ptr<Level>> levels_;
+
+  /// Makes level the last level and returns the number of its nodes and of
+  /// their outgoing edges.
+  std::pair<uint64_t, uint64_t> Advance(std::unique_ptr<Level> level) {
+    if (!levels_.empty()) {
+      galois::do_all(
+          galois::iterate(*levels_.back()),
+          [&](const Visit& v) { visit_[v.node] = Lanes(); },
+          galois::no_stats());
+    }
+
+    galois::GAccumulator<uint64_t> nodes;
+    galois::GAccumulator<uint64_t> out_edges;
+    galois::do_all(
+        galois::iterate(*level),
+        [&](const Visit& v) {
+          nodes += 1;
+          seen_[v.node] |= v.lanes;
+          visit_[v.node] = v.lanes;
+          next_[v.node] = Lanes();
+          queued_.reset(v.node);
+          auto [begin, end] = topology_.edge_range(v.node);
+          out_edges += end - begin;
+        },
+        galois::no_stats());
+
+    levels_.emplace_back(std::move(level));
+    return std::make_pair(nodes.reduce(), out_edges.reduce());
+  }
+
+  bool ShouldPull(uint64_t frontier_size, uint64_t frontier_edges) const {
+    if (!in_edges_) {
+      return false;
+    }
+    switch (policy_.direction) {
+    case EdgeMapPolicy::kPush:
+      return false;
+    case EdgeMapPolicy::kPull:
+      return true;
+    default:
+      return frontier_size + frontier_edges >
+             topology_.num_edges() / policy_.alpha;
+    }
+  }
+
+  template <bool kAllEdges, typename EdgeFn>
+  void Push(Level* next_level, const EdgeFn& edge_fn) {
+    galois::InsertBag<uint32_t> reached;
+    galois::do_all(
+        galois::iterate(*levels_.back()),
+        [&](const Visit& v) {
+          auto [begin, end] = topology_.edge_range(v.node);
+          for (auto e = begin; e != end; ++e) {
+            uint32_t dst = topology_.out_dests->Value(e);
+            // seen_ only changes between levels
+            Lanes lanes = v.lanes.AndNot(seen_[dst]);
+            if (!lanes.Any()) {
+              continue;
+            }
+            if constexpr (kAllEdges) {
+              edge_fn(v.node, dst, lanes);
+            }
+            Lanes& next = next_[dst];
+            for (size_t w = 0; w < Lanes::kWords; ++w) {
+              if (lanes.word(w) & ~next.word(w)) {
+                __sync_fetch_and_or(&next.word(w), lanes.word(w));
+              }
+            }
+            if (!queued_.set(dst)) {
+              reached.push(dst);
+            }
+          }
+        },
+        galois::steal(), galois::no_stats(),
+        galois::loopname("MultiSourceBfsPush"));
+
+    galois::do_all(
+        galois::iterate(reached),
+        [&](uint32_t node) {
+          next_level->push(Visit{node, next_[node]});
+        },
+        galois::no_stats());
+  }
+
+  template <bool kAllEdges, typename EdgeFn>
+  void Pull(Level* next_level, const EdgeFn& edge_fn) {
+    galois::do_all(
+        galois::iterate(uint64_t{0}, topology_.num_nodes()),
+        [&](uint32_t dst) {
+          Lanes unseen = ~seen_[dst];
+          if (!unseen.Any()) {
+            return;
+          }
+          Lanes reached;
+          auto [begin, end] = in_edges_->edge_range(dst);
+          for (auto e = begin; e != end; ++e) {
+            uint32_t src = in_edges_->GetEdgeSource(e);
+            Lanes lanes = visit_[src] & unseen;
+            if (!lanes.Any()) {
+              continue;
+            }
+            reached |= lanes;
+            if constexpr (kAllEdges) {
+              edge_fn(src, dst, lanes);
+            } else if (reached == unseen) {
+              break;
+            }
+          }
+          if (reached.Any()) {
+            next_level->push(Visit{dst, reached});
+          }
+        },
+        galois::steal(), galois::no_stats(),
+        galois::loopname("MultiSourceBfsPull"));
+  }
+
+  template <bool kAllEdges, typename EdgeFn>
+  size_t RunImpl(
+      const uint32_t* sources, size_t num_sources, const EdgeFn& edge_fn) {
+    assert(num_sources <= kLanes);
+    Clear();
+
+    // Lanes without a search count as having reached every node
+    Lanes unused;
+    for (size_t lane = num_sources; lane < kLanes; ++lane) {
+      unused.Set(lane);
+    }
+    galois::do_all(
+        galois::iterate(uint64_t{0}, topology_.num_nodes()),
+        [&](uint64_t node) { seen_[node] = unused; }, galois::no_stats());
+
+    // Several searches may start from the same node
+    std::vector<uint32_t> roots;
+    for (size_t lane = 0; lane < num_sources; ++lane) {
+      if (!next_[sources[lane]].Any()) {
+        roots.emplace_back(sources[lane]);
+      }
+      next_[sources[lane]].Set(lane);
+    }
+    auto level = std::make_unique<Level>();
+    for (uint32_t root : roots) {
+      level->push(Visit{root, next_[root]});
+    }
+    auto [frontier_size, frontier_edges] = Advance(std::move(level));
+
+    while (true) {
+      level = std::make_unique<Level>();
+      if (ShouldPull(frontier_size, frontier_edges)) {
+        Pull<kAllEdges>(level.get(), edge_fn);
+      } else {
+        Push<kAllEdges>(level.get(), edge_fn);
+      }
+      if (level->empty()) {
+        break;
+      }
+      std::tie(frontier_size, frontier_edges) = Advance(std::move(level));
+    }
+
+    return levels_.size();
+  }
+
+public:
+  /// Prepares searches over topology. If in_edges is given, large frontiers
+  /// pull along incoming edges; policy selects the direction as in EdgeMap.
+  explicit MultiSourceBfs(
+      const graphs::GraphTopology& topology,
+      const InEdgeView* in_edges = nullptr,
+      const EdgeMapPolicy& policy = EdgeMapPolicy())
+      : topology_(topology), in_edges_(in_edges), policy_(policy) {
+    const uint64_t num_nodes = topology.num_nodes();
+    seen_.allocateBlocked(num_nodes);
+    visit_.allocateBlocked(num_nodes);
+    next_.allocateBlocked(num_nodes);
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t node) {
+          visit_.constructAt(node);
+          next_.constructAt(node);
+        },
+        galois::no_stats());
+    queued_.resize(num_nodes);
+  }
+
+  /// Searches from sources[0], ..., sources[num_sources - 1] (at most kLanes)
+  /// with search i in lane i, and returns the number of levels.
+  ///
+  /// edge_fn(src, dst, lanes) is called for every edge from a node src of one
+  /// level to a node dst of the next, with the searches that reach dst for
+  /// the first time through that edge. Together these calls enumerate the
+  /// shortest path DAG of every search. When pushing, edge_fn may be called
+  /// concurrently for the same dst; when pulling, all calls for dst happen
+  /// on one thread.
+  template <typename EdgeFn>
+  size_t Run(
+      const uint32_t* sources, size_t num_sources, const EdgeFn& edge_fn) {
+    return RunImpl<true>(sources, num_sources, edge_fn);
+  }
+
+  /// Searches from sources without visiting the edges of the shortest path
+  /// DAGs, which lets pulling stop at the first incoming edge that reaches a
+  /// node for all remaining searches.
+  size_t Run(const uint32_t* sources, size_t num_sources) {
+    return RunImpl<false>(sources, num_sources, NoEdgeFn());
+  }
+
+  size_t num_levels() const { return levels_.size(); }
+
+  /// Returns the nodes first reached at distance d by some search of the
+  /// last Run, with the searches that reach them.
+  Level& level(size_t d) { return *levels_[d]; }
+
+  /// Releases the levels of the last Run.
+  void Clear() {
+    if (!levels_.empty()) {
+      galois::do_all(
+          galois::iterate(*levels_.back()),
+          [&](const Visit& v) { visit_[v.node] = Lanes(); },
+          galois::no_stats());
+    }
+    levels_.clear();
+  }
+};
+
+/// The smallest and largest supported numbers of MultiSourceBfs lanes
+constexpr size_t kMinMultiSourceBfsLanes = 64;
+constexpr size_t kMaxMultiSourceBfsLanes = 512;
+
+/// Returns the largest supported number of MultiSourceBfs lanes that is at
+/// most max_lanes, or 0 if max_lanes is less than kMinMultiSourceBfsLanes.
+/// Use it to bound a batch by memory that is allocated per lane, since
+/// WithMultiSourceBfsLanes rounds a batch up to a supported number of lanes.
+inline size_t
+MultiSourceBfsLanesAtMost(size_t max_lanes) {
+  size_t lanes = 0;
+  for (size_t l = kMinMultiSourceBfsLanes; l <= kMaxMultiSourceBfsLanes;
+       l *= 2) {
+    if (l <= max_lanes) {
+      lanes = l;
+    }
+  }
+  return lanes;
+}
+
+/// Calls fn(std::integral_constant<size_t, kLanes>()) with the smallest
+/// supported number of MultiSourceBfs lanes that holds batch_size searches.
+template <typename F>
+void
+WithMultiSourceBfsLanes(size_t batch_size, const F& fn) {
+  if (batch_size <= 64) {
+    fn(std::integral_constant<size_t, 64>());
+  } else if (batch_size <= 128) {
+    fn(std::integral_constant<size_t, 128>());
+  } else if (batch_size <= 256) {
+    fn(std::integral_constant<size_t, 256>());
+  } else {
+    fn(std::integral_constant<size_t, 512>());
+  }
+}
+
+}  // namespace galois::analytics
+
+#endif
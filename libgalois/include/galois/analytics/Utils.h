@@ -5,6 +5,7 @@
 #include <random>
 
 #include "galois/ErrorCode.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/Result.h"
 #include "galois/graphs/PropertyGraph.h"
 
@@ -65,6 +66,21 @@ isApproximateDegreeDistributionPowerLaw(const Graph& graph) {
   return sample_average / 1.3 > sample_median;
 }
 
+//! Returns how many items of item_bytes each fit in the given fraction of the
+//! remaining memory budget, clamped to [1, max_items]. Use it to size tiles,
+//! batches and chunk buffers so that an algorithm degrades to smaller steps
+//! instead of exceeding the budget.
+inline uint64_t
+ItemsWithinMemoryBudget(
+    uint64_t item_bytes, uint64_t max_items, double fraction = 0.5) {
+  uint64_t remaining = MemoryRemaining();
+  if (remaining == kNoMemoryBudget || item_bytes == 0) {
+    return max_items;
+  }
+  auto items = static_cast<uint64_t>(remaining * fraction) / item_bytes;
+  return std::clamp<uint64_t>(items, 1, std::max<uint64_t>(max_items, 1));
+}
+
 template <typename Props>
 std::vector<std::string>
 DefaultPropertyNames() {
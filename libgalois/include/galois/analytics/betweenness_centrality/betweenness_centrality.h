@@ -0,0 +1,98 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_BETWEENNESSCENTRALITY_BETWEENNESSCENTRALITY_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_BETWEENNESSCENTRALITY_BETWEENNESSCENTRALITY_H_
+
+#include <vector>
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for betweenness centrality, specifying the algorithm
+/// and any parameters associated with it.
+class BetweennessCentralityPlan : Plan {
+public:
+  enum Algorithm { kOuter = 0, kMultiSource };
+
+  static constexpr uint32_t kDefaultBatchSize = 64;
+
+private:
+  Algorithm algorithm_;
+  uint32_t batch_size_;
+
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t batch_size)
+      : Plan(architecture), algorithm_(algorithm), batch_size_(batch_size) {}
+
+public:
+  BetweennessCentralityPlan()
+      : BetweennessCentralityPlan{kCPU, kMultiSource, kDefaultBatchSize} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The number of sources searched together by MultiSource, rounded up to
+  /// 64, 128, 256 or 512
+  uint32_t batch_size() const { return batch_size_; }
+
+  /// Brandes' algorithm with one sequential search per source and sources
+  /// processed in parallel. Each thread needs scratch space for every node.
+  static BetweennessCentralityPlan Outer() { return {kCPU, kOuter, 0}; }
+
+  /// Brandes' algorithm on a multi-source BFS that searches from batch_size
+  /// sources at once with one bit per source and node. Every level of the
+  /// batch is processed in parallel and the searches share their traversal
+  /// of the graph, which pays off when there are many sources (e.g., for
+  /// approximate centrality from a sample of sources). The batch is reduced
+  /// if the shortest path counts of every node and source in it do not fit in
+  /// the memory budget; if not even the smallest batch of 64 sources fits,
+  /// the computation fails with ErrorCode::OutOfMemory.
+  static BetweennessCentralityPlan MultiSource(
+      uint32_t batch_size = kDefaultBatchSize) {
+    return {kCPU, kMultiSource, batch_size};
+  }
+
+  static BetweennessCentralityPlan Automatic() { return {}; }
+
+  static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kOuter:
+      return Outer();
+    case kMultiSource:
+      return MultiSource();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// The tag for the output property of BetweennessCentrality in
+/// PropertyGraphs.
+struct BetweennessCentralityNodeValue {
+  using ArrowType = arrow::CTypeTraits<double>::ArrowType;
+  using ViewType = galois::PODPropertyView<double>;
+};
+
+/// Compute the betweenness centrality of every node of pfg, i.e., the sum
+/// over the ordered pairs of other nodes (s, t) with s in sources of the
+/// fraction of shortest paths from s to t that pass through the node. Edges
+/// are unweighted. If sources is empty, every node is a source; a sample of
+/// sources gives an approximation. The result is stored in a property named
+/// by output_property_name as double.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> BetweennessCentrality(
+    graphs::PropertyFileGraph* pfg, const std::vector<uint32_t>& sources,
+    const std::string& output_property_name,
+    BetweennessCentralityPlan plan = BetweennessCentralityPlan::Automatic());
+
+/// Compute the betweenness centrality of every node of pg with respect to
+/// sources. The result is stored in the node data of the graph.
+GALOIS_EXPORT Result<void> BetweennessCentrality(
+    graphs::PropertyGraph<
+        std::tuple<BetweennessCentralityNodeValue>, std::tuple<>>& pg,
+    const std::vector<uint32_t>& sources,
+    BetweennessCentralityPlan plan = BetweennessCentralityPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
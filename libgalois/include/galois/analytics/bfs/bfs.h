@@ -10,23 +10,30 @@ namespace galois::analytics {
 /// associated with it.
 class BfsPlan : Plan {
 public:
-  enum Algorithm { kAsyncTile = 0, kAsync, kSyncTile, kSync };
+  enum Algorithm { kAsyncTile = 0, kAsync, kSyncTile, kSync, kDirectionOpt };
 
 private:
   Algorithm algorithm_;
   ptrdiff_t edge_tile_size_;
+  uint32_t alpha_;
+  uint32_t beta_;
 
   BfsPlan(
-      Architecture architecture, Algorithm algorithm, ptrdiff_t edge_tile_size)
+      Architecture architecture, Algorithm algorithm, ptrdiff_t edge_tile_size,
+      uint32_t alpha = 15, uint32_t beta = 18)
       : Plan(architecture),
         algorithm_(algorithm),
-        edge_tile_size_(edge_tile_size) {}
+        edge_tile_size_(edge_tile_size),
+        alpha_(alpha),
+        beta_(beta) {}
 
 public:
   BfsPlan() : BfsPlan{kCPU, kSyncTile, 256} {}
 
   Algorithm algorithm() const { return algorithm_; }
   ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
+  uint32_t alpha() const { return alpha_; }
+  uint32_t beta() const { return beta_; }
 
   static BfsPlan AsyncTile(ptrdiff_t edge_tile_size = 256) {
     return {kCPU, kAsyncTile, edge_tile_size};
@@ -40,6 +47,16 @@ public:
 
   static BfsPlan Sync() { return {kCPU, kSync, 0}; }
 
+  /// Direction-optimizing BFS: expand small frontiers by pushing along
+  /// outgoing edges and large frontiers by pulling along incoming edges.
+  /// @param alpha Switch to pull when the frontier and its outgoing edges
+  ///     exceed num_edges / alpha.
+  /// @param beta Switch back to push when the frontier has fewer than
+  ///     num_nodes / beta nodes.
+  static BfsPlan DirectionOpt(uint32_t alpha = 15, uint32_t beta = 18) {
+    return {kCPU, kDirectionOpt, 0, alpha, beta};
+  }
+
   static BfsPlan Automatic() { return {}; }
 
   static BfsPlan FromAlgorithm(Algorithm algo) {
@@ -52,6 +69,8 @@ public:
       return Sync();
     case kSyncTile:
       return SyncTile();
+    case kDirectionOpt:
+      return DirectionOpt();
     default:
       return Automatic();
     }
@@ -0,0 +1,69 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_CLOSENESSCENTRALITY_CLOSENESSCENTRALITY_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_CLOSENESSCENTRALITY_CLOSENESSCENTRALITY_H_
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for closeness centrality, specifying the metric and
+/// any parameters associated with it. For a node u that reaches r other nodes
+/// along outgoing edges at distances d(u, v) in a graph of n nodes:
+///
+/// - Closeness: (r / (n - 1)) * (r / sum of d(u, v)), i.e., the inverse of
+///   the average distance to the nodes u reaches, scaled by the fraction of
+///   nodes it reaches (Wasserman and Faust) so that nodes in small
+///   components do not look central
+/// - Harmonic: sum of 1 / d(u, v)
+///
+/// Both are 0 for nodes that reach no other node. Distances are computed with
+/// a multi-source BFS from batch_size nodes at once.
+class ClosenessCentralityPlan : Plan {
+public:
+  enum Metric { kCloseness = 0, kHarmonic };
+
+  static constexpr uint32_t kDefaultBatchSize = 256;
+
+private:
+  Metric metric_;
+  uint32_t batch_size_;
+
+  ClosenessCentralityPlan(
+      Architecture architecture, Metric metric, uint32_t batch_size)
+      : Plan(architecture), metric_(metric), batch_size_(batch_size) {}
+
+public:
+  ClosenessCentralityPlan()
+      : ClosenessCentralityPlan{kCPU, kCloseness, kDefaultBatchSize} {}
+
+  Metric metric() const { return metric_; }
+
+  /// The number of nodes searched from at once, rounded up to 64, 128, 256
+  /// or 512
+  uint32_t batch_size() const { return batch_size_; }
+
+  static ClosenessCentralityPlan Closeness(
+      uint32_t batch_size = kDefaultBatchSize) {
+    return {kCPU, kCloseness, batch_size};
+  }
+
+  static ClosenessCentralityPlan Harmonic(
+      uint32_t batch_size = kDefaultBatchSize) {
+    return {kCPU, kHarmonic, batch_size};
+  }
+
+  static ClosenessCentralityPlan Automatic() { return {}; }
+};
+
+/// Compute the closeness centrality of every node of pfg with unweighted
+/// edges. The result is stored in a property named by output_property_name
+/// as double.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> ClosenessCentrality(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    ClosenessCentralityPlan plan = ClosenessCentralityPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_COMMUNITYDETECTION_COMMUNITYDETECTION_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_COMMUNITYDETECTION_COMMUNITYDETECTION_H_
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for community detection, specifying the algorithm
+/// and any parameters associated with it.
+///
+/// Both algorithms maximize modularity at the given resolution, where higher
+/// resolutions give more and smaller communities, over levels of coarsening.
+/// At each level, nodes move between communities in rounds until a round
+/// gains less than modularity_threshold_per_round, and then every community
+/// becomes a node of the next, coarser graph. This stops when a level gains
+/// less than modularity_threshold_total, after max_iterations levels, or when
+/// the graph has no more than min_graph_size nodes.
+class CommunityDetectionPlan : Plan {
+public:
+  enum Algorithm { kLouvain = 0, kLeiden };
+
+  static constexpr double kDefaultResolution = 1.0;
+  static constexpr double kDefaultModularityThresholdPerRound = 0.01;
+  static constexpr double kDefaultModularityThresholdTotal = 0.01;
+  static constexpr uint32_t kDefaultMaxIterations = 10;
+  static constexpr uint32_t kDefaultMinGraphSize = 100;
+  static constexpr double kDefaultRandomness = 0.01;
+
+private:
+  Algorithm algorithm_;
+  double resolution_;
+  double modularity_threshold_per_round_;
+  double modularity_threshold_total_;
+  uint32_t max_iterations_;
+  uint32_t min_graph_size_;
+  double randomness_;
+
+  CommunityDetectionPlan(
+      Architecture architecture, Algorithm algorithm, double resolution,
+      double modularity_threshold_per_round, double modularity_threshold_total,
+      uint32_t max_iterations, uint32_t min_graph_size, double randomness)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        resolution_(resolution),
+        modularity_threshold_per_round_(modularity_threshold_per_round),
+        modularity_threshold_total_(modularity_threshold_total),
+        max_iterations_(max_iterations),
+        min_graph_size_(min_graph_size),
+        randomness_(randomness) {}
+
+public:
+  CommunityDetectionPlan()
+      : CommunityDetectionPlan{
+            kCPU, kLouvain, kDefaultResolution,
+            kDefaultModularityThresholdPerRound,
+            kDefaultModularityThresholdTotal, kDefaultMaxIterations,
+            kDefaultMinGraphSize, 0} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  double resolution() const { return resolution_; }
+  double modularity_threshold_per_round() const {
+    return modularity_threshold_per_round_;
+  }
+  double modularity_threshold_total() const {
+    return modularity_threshold_total_;
+  }
+  uint32_t max_iterations() const { return max_iterations_; }
+  uint32_t min_graph_size() const { return min_graph_size_; }
+  double randomness() const { return randomness_; }
+
+  /// Louvain (Blondel et al., J. Stat. Mech. 2008), where the nodes of each
+  /// round move in a few batches: every node of a batch picks the
+  /// neighboring community of largest gain against the community weights
+  /// left by the previous batch, and each thread collects the resulting
+  /// weight changes in maps of its own, which are merged between batches, so
+  /// community weights are never updated atomically.
+  static CommunityDetectionPlan Louvain(
+      double resolution = kDefaultResolution,
+      double modularity_threshold_per_round =
+          kDefaultModularityThresholdPerRound,
+      double modularity_threshold_total = kDefaultModularityThresholdTotal,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      uint32_t min_graph_size = kDefaultMinGraphSize) {
+    return {
+        kCPU, kLouvain, resolution, modularity_threshold_per_round,
+        modularity_threshold_total, max_iterations, min_graph_size, 0};
+  }
+
+  /// Leiden (Traag, Waltman and van Eck, Sci. Rep. 2019): Louvain, except
+  /// that each community is refined before coarsening by merging its nodes
+  /// into well-connected subcommunities, which become the nodes of the next
+  /// level. This guarantees connected communities. Nodes choose among the
+  /// subcommunities that do not lower modularity at random, with the chance
+  /// of the best choice growing as randomness goes to 0. Communities that
+  /// are still disconnected when the levels stop early are split.
+  static CommunityDetectionPlan Leiden(
+      double resolution = kDefaultResolution,
+      double modularity_threshold_per_round =
+          kDefaultModularityThresholdPerRound,
+      double modularity_threshold_total = kDefaultModularityThresholdTotal,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      uint32_t min_graph_size = kDefaultMinGraphSize,
+      double randomness = kDefaultRandomness) {
+    return {
+        kCPU, kLeiden, resolution, modularity_threshold_per_round,
+        modularity_threshold_total, max_iterations, min_graph_size,
+        randomness};
+  }
+
+  static CommunityDetectionPlan Automatic() { return {}; }
+
+  static CommunityDetectionPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kLouvain:
+      return Louvain();
+    case kLeiden:
+      return Leiden();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// The tag for the output property of CommunityDetection in PropertyGraphs.
+struct CommunityDetectionNodeCommunity {
+  using ArrowType = arrow::CTypeTraits<uint64_t>::ArrowType;
+  using ViewType = galois::PODPropertyView<uint64_t>;
+};
+
+/// Detect the communities of pfg, which must be symmetric. The edge weights
+/// are taken from the property named edge_weight_property_name (which may be
+/// a 32- or 64-bit signed or unsigned int, float or double, and may not be
+/// negative); if edge_weight_property_name is empty, every edge has weight 1.
+/// Communities are numbered from 0 and the community of each node is stored
+/// in a property named by output_property_name as uint64_t. The modularity
+/// of the result is reported as the statistic Modularity.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> CommunityDetection(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    CommunityDetectionPlan plan = CommunityDetectionPlan::Automatic());
+
+/// Compute the modularity at the given resolution of the communities of pfg
+/// stored in the property named by community_property_name, e.g., by
+/// CommunityDetection. Edge weights are as for CommunityDetection, and
+/// communities must be numbered below the number of nodes.
+GALOIS_EXPORT Result<double> Modularity(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& community_property_name,
+    double resolution = CommunityDetectionPlan::kDefaultResolution);
+
+}  // namespace galois::analytics
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_CONNECTEDCOMPONENTS_CONNECTEDCOMPONENTS_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_CONNECTEDCOMPONENTS_CONNECTEDCOMPONENTS_H_
+
+#include <utility>
+#include <vector>
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for connected components, specifying the algorithm
+/// and any parameters associated with it.
+///
+/// Components are weakly connected, i.e., edge directions are ignored. If the
+/// plan is symmetric, the graph must contain the reverse of every edge, which
+/// lets the algorithms skip half of the edges (EdgeTiledAsync) or avoid
+/// building the transpose of the graph (Afforest).
+class ConnectedComponentsPlan : Plan {
+public:
+  enum Algorithm { kAfforest = 0, kEdgeTiledAsync };
+
+  static constexpr uint32_t kDefaultNeighborSamples = 2;
+  static constexpr uint32_t kDefaultComponentSamples = 1024;
+  static constexpr ptrdiff_t kDefaultEdgeTileSize = 512;
+
+private:
+  Algorithm algorithm_;
+  bool symmetric_;
+  uint32_t neighbor_samples_;
+  uint32_t component_samples_;
+  ptrdiff_t edge_tile_size_;
+
+  ConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm, bool symmetric,
+      uint32_t neighbor_samples, uint32_t component_samples,
+      ptrdiff_t edge_tile_size)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        symmetric_(symmetric),
+        neighbor_samples_(neighbor_samples),
+        component_samples_(component_samples),
+        edge_tile_size_(edge_tile_size) {}
+
+public:
+  ConnectedComponentsPlan()
+      : ConnectedComponentsPlan{
+            kCPU, kAfforest, false, kDefaultNeighborSamples,
+            kDefaultComponentSamples, kDefaultEdgeTileSize} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  bool symmetric() const { return symmetric_; }
+  uint32_t neighbor_samples() const { return neighbor_samples_; }
+  uint32_t component_samples() const { return component_samples_; }
+  ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
+
+  /// Afforest subgraph sampling (Sutton, Ben-Nun and Barak, IPDPS 2018):
+  /// first link every node to its first neighbor_samples neighbors, then
+  /// estimate the largest intermediate component from component_samples
+  /// random nodes and link the remaining edges in edge tiles, skipping the
+  /// nodes of that component. Usually most nodes end up in the skipped
+  /// component, so most edges are never visited. Graphs that are not
+  /// symmetric also need the incoming edges of the nodes outside the
+  /// component, which are read from a transposed copy of the topology.
+  /// component_samples must be positive.
+  static ConnectedComponentsPlan Afforest(
+      bool symmetric = false,
+      uint32_t neighbor_samples = kDefaultNeighborSamples,
+      uint32_t component_samples = kDefaultComponentSamples,
+      ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
+    return {
+        kCPU, kAfforest, symmetric, neighbor_samples, component_samples,
+        edge_tile_size};
+  }
+
+  /// Asynchronous union-find over every edge, where the edges of each node
+  /// are split into tiles of edge_tile_size for load balancing.
+  static ConnectedComponentsPlan EdgeTiledAsync(
+      bool symmetric = false, ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
+    return {kCPU, kEdgeTiledAsync, symmetric, 0, 0, edge_tile_size};
+  }
+
+  static ConnectedComponentsPlan Automatic() { return {}; }
+
+  static ConnectedComponentsPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kAfforest:
+      return Afforest();
+    case kEdgeTiledAsync:
+      return EdgeTiledAsync();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// The tag for the output property of ConnectedComponents in PropertyGraphs.
+struct ConnectedComponentsNodeComponent {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = galois::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+/// Compute the weakly connected components of pfg. The component of a node
+/// is labeled by the smallest node id in it, so labels do not depend on the
+/// plan or the number of threads. The result is stored in a property named by
+/// output_property_name as uint32_t.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> ConnectedComponents(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    ConnectedComponentsPlan plan = ConnectedComponentsPlan::Automatic());
+
+/// Compute the weakly connected components of pg. The result is stored in the
+/// node data of the graph.
+GALOIS_EXPORT Result<void> ConnectedComponents(
+    graphs::PropertyGraph<
+        std::tuple<ConnectedComponentsNodeComponent>, std::tuple<>>& pg,
+    ConnectedComponentsPlan plan = ConnectedComponentsPlan::Automatic());
+
+/// Update the component labels in the property named by property_name, as
+/// computed by ConnectedComponents, to account for new edges between the
+/// nodes of pfg. Only the components joined by edges are merged, so the cost
+/// is proportional to the number of new edges plus one pass over the labels
+/// rather than to the size of the graph. The topology of pfg is not changed.
+GALOIS_EXPORT Result<void> ConnectedComponentsAddEdges(
+    graphs::PropertyFileGraph* pfg, const std::string& property_name,
+    const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+
+/// Update the component labels in the node data of pg to account for new
+/// edges between its nodes.
+GALOIS_EXPORT Result<void> ConnectedComponentsAddEdges(
+    graphs::PropertyGraph<
+        std::tuple<ConnectedComponentsNodeComponent>, std::tuple<>>& pg,
+    const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+
+}  // namespace galois::analytics
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_KCORE_KCORE_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_KCORE_KCORE_H_
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for k-core decomposition, specifying the algorithm
+/// and any parameters associated with it.
+class KCorePlan : Plan {
+public:
+  enum Algorithm { kPeel = 0, kHIndex };
+
+private:
+  Algorithm algorithm_;
+
+  KCorePlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  KCorePlan() : KCorePlan{kCPU, kPeel} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Bucketed peeling: nodes are processed in order of their current degree
+  /// with an ordered worklist that finishes each degree before starting the
+  /// next, and a node gets the degree it has when it is removed as its core
+  /// number. Each edge is visited a constant number of times.
+  static KCorePlan Peel() { return {kCPU, kPeel}; }
+
+  /// Asynchronous h-index iteration: every node starts at its degree and
+  /// repeatedly lowers it to the h-index of its neighbors' values until
+  /// nothing changes. No ordering is needed, so it scales better when there
+  /// are few distinct degrees, but nodes may be visited several times.
+  static KCorePlan HIndex() { return {kCPU, kHIndex}; }
+
+  static KCorePlan Automatic() { return {}; }
+
+  static KCorePlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kPeel:
+      return Peel();
+    case kHIndex:
+      return HIndex();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// The tag for the output property of KCore in PropertyGraphs.
+struct KCoreNodeCoreness {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = galois::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+/// Compute the core number of every node in the graph pfg, i.e., the largest
+/// k such that the node belongs to the k-core (the maximal subgraph in which
+/// every node has degree at least k). The graph must be symmetric. The result
+/// is stored in a property named by output_property_name as uint32_t; the
+/// nodes of the k-core are those with a core number of at least k.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> KCore(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    KCorePlan plan = KCorePlan::Automatic());
+
+/// Compute the core number of every node in the symmetric graph pg. The
+/// result is stored in the node data of the graph.
+GALOIS_EXPORT Result<void> KCore(
+    graphs::PropertyGraph<std::tuple<KCoreNodeCoreness>, std::tuple<>>& pg,
+    KCorePlan plan = KCorePlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_KSHORTESTPATHS_KSHORTESTPATHS_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_KSHORTESTPATHS_KSHORTESTPATHS_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for k shortest simple paths, specifying the
+/// algorithm and any parameters associated with it.
+///
+/// If the plan is symmetric, the graph must contain the reverse of every
+/// edge with the same weight, which avoids building the transpose of the
+/// graph to find the shortest paths into each target.
+class KShortestPathsPlan : Plan {
+public:
+  enum Algorithm { kYen = 0 };
+
+private:
+  Algorithm algorithm_;
+  bool symmetric_;
+
+  KShortestPathsPlan(
+      Architecture architecture, Algorithm algorithm, bool symmetric)
+      : Plan(architecture), algorithm_(algorithm), symmetric_(symmetric) {}
+
+public:
+  KShortestPathsPlan() : KShortestPathsPlan{kCPU, kYen, false} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  bool symmetric() const { return symmetric_; }
+
+  /// Yen (Management Science, 1971) with Lawler's restriction of spur nodes
+  /// to the part of each path after its deviation. The shortest path tree
+  /// into each target is computed once for all of its queries, and the
+  /// distances in it guide every spur search as an A* heuristic: a search
+  /// stops as soon as it reaches a node whose path in the tree avoids the
+  /// root of the spur, and gives up once it cannot beat the candidates
+  /// already found. The spur searches of each path run in parallel, or, when
+  /// a target has at least as many queries as there are threads, its queries
+  /// do. Every thread keeps search state for every node of the graph.
+  static KShortestPathsPlan Yen(bool symmetric = false) {
+    return {kCPU, kYen, symmetric};
+  }
+
+  static KShortestPathsPlan Automatic() { return {}; }
+
+  static KShortestPathsPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kYen:
+      return Yen();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// Find the k shortest simple paths of pfg from the source to the target of
+/// every query, e.g., for route alternatives. The edge weights are taken from
+/// the property named edge_weight_property_name (which may be a 32- or 64-bit
+/// signed or unsigned int, float or double, and may not be negative); if
+/// edge_weight_property_name is empty, every edge has weight 1.
+///
+/// The result has a row per path with the columns query (uint32, the index
+/// of the query), length (double) and path (a list of uint32 node ids from
+/// source to target), ordered by query and then by length; paths of equal
+/// length come in an order that does not depend on the number of threads. A
+/// query has fewer than k paths if its target cannot be reached in more ways,
+/// and none if it cannot be reached at all; the only path from a node to
+/// itself is the node.
+GALOIS_EXPORT Result<std::shared_ptr<arrow::Table>> KShortestPaths(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::pair<uint32_t, uint32_t>>& queries, uint32_t k,
+    KShortestPathsPlan plan = KShortestPathsPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_PAGERANK_PAGERANK_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_PAGERANK_PAGERANK_H_
+
+#include <vector>
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for PageRank, specifying the algorithm and any
+/// parameters associated with it.
+///
+/// The rank of a node is the probability that a random walk is at the node,
+/// where each step follows a random outgoing edge with probability damping
+/// and otherwise jumps to a random node (or, for personalized PageRank, to a
+/// random source). Walks that reach a node without outgoing edges also jump,
+/// so the ranks sum to 1.
+///
+/// All algorithms stop once the ranks are within roughly tolerance of the
+/// fixed point in L1 distance, or after max_iterations rounds.
+class PageRankPlan : Plan {
+public:
+  enum Algorithm { kPull = 0, kPush, kDelta };
+
+  static constexpr float kDefaultDamping = 0.85;
+  static constexpr float kDefaultTolerance = 1.0e-6;
+  static constexpr uint32_t kDefaultMaxIterations = 1000;
+
+private:
+  Algorithm algorithm_;
+  float tolerance_;
+  uint32_t max_iterations_;
+  float damping_;
+
+  PageRankPlan(
+      Architecture architecture, Algorithm algorithm, float tolerance,
+      uint32_t max_iterations, float damping)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        tolerance_(tolerance),
+        max_iterations_(max_iterations),
+        damping_(damping) {}
+
+public:
+  PageRankPlan()
+      : PageRankPlan{
+            kCPU, kDelta, kDefaultTolerance, kDefaultMaxIterations,
+            kDefaultDamping} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  float tolerance() const { return tolerance_; }
+  uint32_t max_iterations() const { return max_iterations_; }
+  float damping() const { return damping_; }
+
+  /// Topology-driven power iteration: every round recomputes the rank of
+  /// every node from the ranks of its in-neighbors, without atomics, until
+  /// the ranks change by at most tolerance. Needs the transpose of the graph.
+  static PageRankPlan Pull(
+      float tolerance = kDefaultTolerance,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      float damping = kDefaultDamping) {
+    return {kCPU, kPull, tolerance, max_iterations, damping};
+  }
+
+  /// Asynchronous residual push: a node whose residual (the rank it has
+  /// received but not yet passed on) grows past tolerance / num_nodes is
+  /// scheduled on a worklist and pushes the residual to its out-neighbors.
+  /// There are no rounds, so max_iterations is not used.
+  static PageRankPlan Push(
+      float tolerance = kDefaultTolerance, float damping = kDefaultDamping) {
+    return {kCPU, kPush, tolerance, 0, damping};
+  }
+
+  /// Round-based residual push: each round only the nodes whose residual
+  /// exceeds tolerance / num_nodes pass it on. Rounds with many such nodes
+  /// pull along the incoming edges instead of pushing, as in direction
+  /// optimizing BFS, and the rest only touch the edges of the active nodes.
+  static PageRankPlan Delta(
+      float tolerance = kDefaultTolerance,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      float damping = kDefaultDamping) {
+    return {kCPU, kDelta, tolerance, max_iterations, damping};
+  }
+
+  static PageRankPlan Automatic() { return {}; }
+
+  static PageRankPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kPull:
+      return Pull();
+    case kPush:
+      return Push();
+    case kDelta:
+      return Delta();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// The tag for the output property of PageRank in PropertyGraphs.
+struct PageRankNodeRank {
+  using ArrowType = arrow::CTypeTraits<float>::ArrowType;
+  using ViewType = galois::PODPropertyView<std::atomic<float>>;
+};
+
+/// Compute the PageRank of every node of pfg. The result is stored in a
+/// property named by output_property_name as float.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> PageRank(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    PageRankPlan plan = PageRankPlan::Automatic());
+
+/// Compute the PageRank of every node of pg. The result is stored in the node
+/// data of the graph.
+GALOIS_EXPORT Result<void> PageRank(
+    graphs::PropertyGraph<std::tuple<PageRankNodeRank>, std::tuple<>>& pg,
+    PageRankPlan plan = PageRankPlan::Automatic());
+
+/// Compute the personalized PageRank of every node of pfg with respect to
+/// sources, i.e., random walks jump to a random node of sources instead of a
+/// random node of the graph. Nodes that cannot be reached from sources get a
+/// rank of 0. The result is stored in a property named by
+/// output_property_name as float.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> PersonalizedPageRank(
+    graphs::PropertyFileGraph* pfg, const std::vector<uint32_t>& sources,
+    const std::string& output_property_name,
+    PageRankPlan plan = PageRankPlan::Automatic());
+
+/// Compute the personalized PageRank of every node of pg with respect to
+/// sources. The result is stored in the node data of the graph.
+GALOIS_EXPORT Result<void> PersonalizedPageRank(
+    graphs::PropertyGraph<std::tuple<PageRankNodeRank>, std::tuple<>>& pg,
+    const std::vector<uint32_t>& sources,
+    PageRankPlan plan = PageRankPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
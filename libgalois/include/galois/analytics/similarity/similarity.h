@@ -0,0 +1,97 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_SIMILARITY_SIMILARITY_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_SIMILARITY_SIMILARITY_H_
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for neighborhood similarity, specifying the similarity
+/// metric and any parameters associated with it. For nodes u and v with
+/// neighbor sets N(u) and N(v):
+///
+/// - Jaccard: |N(u) & N(v)| / |N(u) | N(v)|
+/// - Overlap: |N(u) & N(v)| / min(|N(u)|, |N(v)|)
+/// - Cosine: |N(u) & N(v)| / sqrt(|N(u)| * |N(v)|)
+/// - Adamic-Adar: sum of 1 / log(|N(w)|) over the common neighbors w
+///
+/// The similarity of a node without neighbors is 0.
+class SimilarityPlan : Plan {
+public:
+  enum Metric { kJaccard = 0, kOverlap, kCosine, kAdamicAdar };
+
+private:
+  Metric metric_;
+  uint32_t max_hub_degree_;
+
+  SimilarityPlan(
+      Architecture architecture, Metric metric, uint32_t max_hub_degree)
+      : Plan(architecture),
+        metric_(metric),
+        max_hub_degree_(max_hub_degree) {}
+
+public:
+  SimilarityPlan() : SimilarityPlan{kCPU, kJaccard, 0} {}
+
+  Metric metric() const { return metric_; }
+
+  /// Top-k candidates are not generated through common neighbors with more
+  /// than this many incoming edges (0 for no limit). Such hubs relate almost
+  /// every pair of nodes and dominate the cost of finding candidates; the
+  /// similarity of the candidates that are found still counts them.
+  uint32_t max_hub_degree() const { return max_hub_degree_; }
+
+  static SimilarityPlan Jaccard(uint32_t max_hub_degree = 0) {
+    return {kCPU, kJaccard, max_hub_degree};
+  }
+
+  static SimilarityPlan Overlap(uint32_t max_hub_degree = 0) {
+    return {kCPU, kOverlap, max_hub_degree};
+  }
+
+  static SimilarityPlan Cosine(uint32_t max_hub_degree = 0) {
+    return {kCPU, kCosine, max_hub_degree};
+  }
+
+  static SimilarityPlan AdamicAdar(uint32_t max_hub_degree = 0) {
+    return {kCPU, kAdamicAdar, max_hub_degree};
+  }
+
+  static SimilarityPlan Automatic() { return {}; }
+};
+
+/// Compute the similarity of every node of pfg to base_node. The result is
+/// stored in a node property named by output_property_name as double.
+/// Neighbor sets are the outgoing edges of each node; duplicate edges are not
+/// supported. The property named output_property_name is created by this
+/// function and may not exist before the call.
+GALOIS_EXPORT Result<void> Similarity(
+    graphs::PropertyFileGraph* pfg, size_t base_node,
+    const std::string& output_property_name,
+    SimilarityPlan plan = SimilarityPlan::Automatic());
+
+/// Compute the similarity of the endpoints of every edge of pfg, e.g., to
+/// rank existing links. The result is stored in an edge property named by
+/// output_property_name as double.
+GALOIS_EXPORT Result<void> EdgeSimilarity(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    SimilarityPlan plan = SimilarityPlan::Automatic());
+
+/// Find, for every node, the k most similar other nodes among the nodes that
+/// share a neighbor with it, e.g., for link prediction or recommendations.
+/// Neighbor sets are the outgoing edges of each node, so in a directed graph
+/// the candidates for u are the nodes with an edge to the same node as u.
+/// The results are stored as node properties of type list: the nodes are
+/// named by output_nodes_property_name (uint32) and their similarities by
+/// output_scores_property_name (double), best first with ties broken by the
+/// smaller node ID. A node has fewer than k entries if fewer nodes share a
+/// neighbor with it.
+GALOIS_EXPORT Result<void> TopKSimilarity(
+    graphs::PropertyFileGraph* pfg, uint32_t k,
+    const std::string& output_nodes_property_name,
+    const std::string& output_scores_property_name,
+    SimilarityPlan plan = SimilarityPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
@@ -26,6 +26,7 @@ public:
     kDijkstra,
     kTopo,
     kTopoTile,
+    kMultiQueue,
     kAutomatic,
   };
 
@@ -91,6 +92,10 @@ public:
     return {kCPU, kTopoTile, 0, edge_tile_size};
   }
 
+  /// Asynchronous Dijkstra-like ordering on a relaxed concurrent priority
+  /// queue instead of delta-stepping buckets; does not need a delta
+  static SsspPlan MultiQueue() { return {kCPU, kMultiQueue, 0, 0}; }
+
   static SsspPlan Automatic() { return {}; }
 
   static SsspPlan Automatic(const galois::graphs::PropertyFileGraph* pfg) {
@@ -190,6 +195,7 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
       galois::worklists::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
   using OBIMBarrier = typename galois::worklists::OrderedByIntegerMetric<
       UpdateRequestIndexer, PSchunk>::template with_barrier<true>::type;
+  using MQ = galois::worklists::MultiQueue<std::less<>>;
 
   template <typename T, typename OBIMTy = OBIM, typename P, typename R>
   static void DeltaStepAlgo(
@@ -205,6 +211,15 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
     galois::InsertBag<T> init_bag;
     pushWrap(init_bag, source, 0, "parallel");
 
+    // The MultiQueue orders items by T itself and takes no indexer
+    auto wl = [stepShift]() {
+      if constexpr (std::is_same_v<OBIMTy, MQ>) {
+        return galois::wl<OBIMTy>();
+      } else {
+        return galois::wl<OBIMTy>(UpdateRequestIndexer{stepShift});
+      }
+    }();
+
     galois::for_each(
         galois::iterate(init_bag),
         [&](const T& item, auto& ctx) {
@@ -234,8 +249,7 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
             }
           }
         },
-        galois::wl<OBIMTy>(UpdateRequestIndexer{stepShift}),
-        galois::disable_conflict_detection(), galois::loopname("SSSP"));
+        wl, galois::disable_conflict_detection(), galois::loopname("SSSP"));
 
     if (kTrackWork) {
       //! [report self-defined stats]
@@ -484,6 +498,10 @@ public:
       DeltaStepAlgo<UpdateRequest, OBIMBarrier>(
           &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph}, plan.delta());
       break;
+    case SsspPlan::kMultiQueue:
+      DeltaStepAlgo<UpdateRequest, MQ>(
+          &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph}, 0);
+      break;
     default:
       return galois::ErrorCode::InvalidArgument;
     }
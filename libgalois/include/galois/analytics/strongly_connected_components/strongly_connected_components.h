@@ -0,0 +1,95 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for strongly connected components, specifying the
+/// algorithm and any parameters associated with it.
+///
+/// Both algorithms first trim nodes without incoming or outgoing edges to
+/// other unfinished nodes, which are components of their own, and finish
+/// with rounds of coloring (Orzan): every node takes the largest priority, a
+/// hash of the node id, of the nodes that reach it along forward edges, and
+/// each node that keeps its own priority collects its component with a
+/// backward search restricted to its color. Every round finishes the
+/// components of all such nodes at once, so graphs with many small components
+/// need few rounds whatever the order of their node ids. Backward searches
+/// read the incoming edges from a transposed copy of the topology.
+class StronglyConnectedComponentsPlan : Plan {
+public:
+  enum Algorithm { kMultistep = 0, kColoring };
+
+private:
+  Algorithm algorithm_;
+
+  StronglyConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  StronglyConnectedComponentsPlan()
+      : StronglyConnectedComponentsPlan{kCPU, kMultistep} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Multistep (Slota, Rajamanickam and Madduri, IPDPS 2014): after
+  /// trimming, a forward and a backward search from the node with the
+  /// largest product of in and out degree find the component of that node,
+  /// which in most real graphs is a giant component holding a large share of
+  /// the nodes. Coloring then only works on the rest of the graph.
+  static StronglyConnectedComponentsPlan Multistep() {
+    return {kCPU, kMultistep};
+  }
+
+  /// Trimming and coloring only, which avoids the sequential phase of the
+  /// forward-backward search on graphs without a giant component.
+  static StronglyConnectedComponentsPlan Coloring() {
+    return {kCPU, kColoring};
+  }
+
+  static StronglyConnectedComponentsPlan Automatic() { return {}; }
+
+  static StronglyConnectedComponentsPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kMultistep:
+      return Multistep();
+    case kColoring:
+      return Coloring();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// The tag for the output property of StronglyConnectedComponents in
+/// PropertyGraphs.
+struct StronglyConnectedComponentsNodeComponent {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = galois::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+/// Compute the strongly connected components of pfg. The component of a node
+/// is labeled by the smallest node id in it, so labels do not depend on the
+/// plan or the number of threads. The result is stored in a property named by
+/// output_property_name as uint32_t.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> StronglyConnectedComponents(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan =
+        StronglyConnectedComponentsPlan::Automatic());
+
+/// Compute the strongly connected components of pg. The result is stored in
+/// the node data of the graph.
+GALOIS_EXPORT Result<void> StronglyConnectedComponents(
+    graphs::PropertyGraph<
+        std::tuple<StronglyConnectedComponentsNodeComponent>, std::tuple<>>& pg,
+    StronglyConnectedComponentsPlan plan =
+        StronglyConnectedComponentsPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
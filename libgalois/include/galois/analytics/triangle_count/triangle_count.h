@@ -0,0 +1,125 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ANALYTICS_TRIANGLECOUNT_TRIANGLECOUNT_H_
+#define GALOIS_LIBGALOIS_GALOIS_ANALYTICS_TRIANGLECOUNT_TRIANGLECOUNT_H_
+
+#include "galois/analytics/Plan.h"
+#include "galois/analytics/Utils.h"
+
+namespace galois::analytics {
+
+/// A computational plan for triangle counting, specifying the algorithm and
+/// any parameters associated with it.
+///
+/// Triangles are those of the undirected graph underlying the input, without
+/// self loops or duplicate edges. If the plan is symmetric, the graph must
+/// contain the reverse of every edge, which avoids building the transpose of
+/// the graph to find the neighbors of each node.
+///
+/// Both algorithms rank the nodes by degree and orient every edge towards
+/// the endpoint of lower rank, which bounds the work per node by the number of
+/// neighbors of lower rank, in a copy of the topology; the input graph is not
+/// relabeled.
+///
+/// If the plan is sorted, the graph must also have no self loops or
+/// duplicate edges and have the edges of every node sorted by destination
+/// (see SortAllEdgesByDest). Nodes are then ranked by their ids and their
+/// triangles are counted on the topology of the graph without a copy, so
+/// the nodes should already be sorted by degree (see SortNodesByDegree).
+class TriangleCountPlan : Plan {
+public:
+  enum Algorithm { kOrderedCount = 0, kEdgeIteration };
+
+private:
+  Algorithm algorithm_;
+  bool symmetric_;
+  bool sorted_;
+
+  TriangleCountPlan(
+      Architecture architecture, Algorithm algorithm, bool symmetric,
+      bool sorted)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        symmetric_(symmetric || sorted),
+        sorted_(sorted) {}
+
+public:
+  TriangleCountPlan() : TriangleCountPlan{kCPU, kOrderedCount, false, false} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  bool symmetric() const { return symmetric_; }
+  /// Sorted plans are symmetric
+  bool sorted() const { return sorted_; }
+
+  /// Ordered count (GAP benchmark suite): every triangle is found once, from
+  /// its node of highest rank, by intersecting the neighbors of lower rank of
+  /// that node with those of each of them. Nodes with many neighbors of lower
+  /// rank put them in a bitmap per thread, which takes up to 1 bit per rank
+  /// below the largest such neighbor, i.e., at most num_nodes / 8 bytes for
+  /// every thread. Counts of other nodes are accumulated in an array per
+  /// thread, which takes 8 bytes per node for every thread, and summed at the
+  /// end.
+  static TriangleCountPlan OrderedCount(
+      bool symmetric = false, bool sorted = false) {
+    return {kCPU, kOrderedCount, symmetric, sorted};
+  }
+
+  /// Every edge counts the common neighbors of its endpoints, and the count
+  /// of a node is half the sum of the counts of its edges. Each count is
+  /// written by a single thread, so no counts per thread are needed, but each
+  /// triangle is found three times rather than once. Nodes with many
+  /// neighbors of lower rank put all their neighbors in a bitmap per thread,
+  /// which takes num_nodes / 8 bytes for every thread.
+  static TriangleCountPlan EdgeIteration(
+      bool symmetric = false, bool sorted = false) {
+    return {kCPU, kEdgeIteration, symmetric, sorted};
+  }
+
+  static TriangleCountPlan Automatic() { return {}; }
+
+  static TriangleCountPlan FromAlgorithm(Algorithm algo) {
+    switch (algo) {
+    case kOrderedCount:
+      return OrderedCount();
+    case kEdgeIteration:
+      return EdgeIteration();
+    default:
+      return Automatic();
+    }
+  }
+};
+
+/// Count the triangles of pfg.
+GALOIS_EXPORT Result<uint64_t> TriangleCount(
+    graphs::PropertyFileGraph* pfg,
+    TriangleCountPlan plan = TriangleCountPlan::Automatic());
+
+/// Count the triangles of every node of pfg. The result is stored in a
+/// property named by output_property_name as uint64_t.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> NodeTriangleCount(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    TriangleCountPlan plan = TriangleCountPlan::Automatic());
+
+/// Count the triangles of every edge of pfg, i.e., the common neighbors of
+/// its endpoints, with edge iteration; self loops have none. The result is
+/// stored in an edge property named by output_property_name as uint32_t.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> EdgeTriangleCount(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    TriangleCountPlan plan = TriangleCountPlan::Automatic());
+
+/// Compute the local clustering coefficient of every node of pfg, i.e., the
+/// fraction of the pairs of its neighbors that are connected, from the
+/// triangles of every node. Nodes with fewer than two neighbors have a
+/// coefficient of 0. The result is stored in a property named by
+/// output_property_name as double.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+GALOIS_EXPORT Result<void> LocalClusteringCoefficient(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    TriangleCountPlan plan = TriangleCountPlan::Automatic());
+
+}  // namespace galois::analytics
+
+#endif
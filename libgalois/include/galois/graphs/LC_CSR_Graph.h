@@ -159,8 +159,8 @@ public:
 
 protected:
   NodeData nodeData;
-  EdgeIndData edgeIndData;
-  EdgeDst edgeDst;
+  EdgeIndData edgeIndData{MemoryCategory::kTopology};
+  EdgeDst edgeDst{MemoryCategory::kTopology};
   EdgeData edgeData;
 
   uint64_t numNodes;
@@ -805,6 +805,7 @@ public:
     constructNodes();
 
     edgeIndData = std::move(prefix_sum);
+    edgeIndData.set_memory_category(MemoryCategory::kTopology);
 
     galois::do_all(galois::iterate((uint32_t)0, numNodes), [&](uint32_t n) {
       if (n == 0) {
@@ -839,6 +840,7 @@ public:
     constructNodes();
 
     edgeIndData = std::move(prefix_sum);
+    edgeIndData.set_memory_category(MemoryCategory::kTopology);
 
     galois::do_all(galois::iterate((uint32_t)0, numNodes), [&](uint32_t n) {
       if (n == 0) {
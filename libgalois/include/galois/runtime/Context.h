@@ -20,8 +20,12 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_RUNTIME_CONTEXT_H_
 #define GALOIS_LIBGALOIS_GALOIS_RUNTIME_CONTEXT_H_
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <vector>
 
 #include <boost/utility.hpp>
 
@@ -33,6 +37,7 @@
 
 #include "galois/MethodFlags.h"
 #include "galois/gIO.h"
+#include "galois/substrate/CacheLineStorage.h"
 #include "galois/substrate/PtrLock.h"
 
 namespace galois {
@@ -177,6 +182,120 @@ public:
   unsigned commitIteration();
 };
 
+/**
+ * A fixed-size table of locks shared by all Lockables. A Lockable is guarded
+ * by the stripe its address hashes to, so acquiring it touches the table
+ * instead of the owner word embedded in the object. Unrelated objects that
+ * share a stripe conflict with each other; more stripes mean fewer false
+ * conflicts but a larger table.
+ *
+ * The table also counts, per stripe, how often an acquire found the stripe
+ * held by another iteration, and per thread how many iterations committed
+ * and aborted, so hot spots and abort rates of a loop can be reported.
+ */
+class GALOIS_EXPORT StripedLockTable : private boost::noncopyable {
+public:
+  static constexpr uint32_t kDefaultNumStripes = 1 << 16;
+
+  //! num_stripes is rounded up to a power of two
+  explicit StripedLockTable(uint32_t num_stripes = kDefaultNumStripes);
+
+  uint32_t NumStripes() const { return uint32_t(1) << (64 - shift_); }
+
+  uint32_t StripeOf(const Lockable* lockable) const {
+    // Fibonacci hashing; objects are at least 8 byte aligned
+    uint64_t key = reinterpret_cast<uintptr_t>(lockable) >> 3;
+    return (key * UINT64_C(0x9E3779B97F4A7C15)) >> shift_;
+  }
+
+  //! Returns the number of conflicts on the stripe of lockable since the
+  //! last Reset
+  uint32_t Contention(const Lockable* lockable) const {
+    return conflicts_[StripeOf(lockable)].load(std::memory_order_relaxed);
+  }
+
+  //! Returns the number of iterations that committed and aborted since the
+  //! last Reset
+  uint64_t NumCommits() const;
+  uint64_t NumAborts() const;
+
+  //! Reports the abort rate, number of contended stripes and conflicts on the
+  //! hottest stripe since the last Reset as statistics of loopname. Must be
+  //! called outside of parallel sections.
+  void ReportStats(const char* loopname) const;
+
+  //! Clears the counters. Must be called outside of parallel sections.
+  void Reset();
+
+private:
+  friend class StripedRuntimeContext;
+
+  struct ThreadStats {
+    //! Priority of the iteration the thread is running
+    std::atomic<int> priority{0};
+    //! Stripes whose conflict count went from zero to one on this thread
+    std::vector<uint32_t> contended;
+    uint64_t commits{0};
+    uint64_t aborts{0};
+  };
+
+  void RecordConflict(uint32_t stripe, ThreadStats& stats);
+
+  //! Owner of each stripe as thread id + 1, or zero if free
+  std::unique_ptr<std::atomic<uint32_t>[]> owners_;
+  std::unique_ptr<std::atomic<uint32_t>[]> conflicts_;
+  std::unique_ptr<substrate::CacheLineStorage<ThreadStats>[]> stats_;
+  unsigned num_threads_;
+  unsigned shift_;
+};
+
+//! Returns the table used by loops with the striped_locks trait
+GALOIS_EXPORT StripedLockTable& GetStripedLockTable();
+
+/**
+ * Conflict detection through a StripedLockTable.
+ *
+ * To avoid livelock, iterations are prioritized by how often their work item
+ * has already aborted. An iteration that finds a stripe held by an iteration
+ * of strictly lower priority briefly waits for it instead of aborting, so a
+ * repeatedly failing item eventually wins (waits always go from higher to
+ * lower priority, so they cannot deadlock). An aborted iteration backs off
+ * for a random, exponentially growing number of pauses before the thread
+ * continues, which breaks symmetric conflicts between equal priorities.
+ */
+class GALOIS_EXPORT StripedRuntimeContext : public SimpleRuntimeContext {
+  StripedLockTable& table_;
+  StripedLockTable::ThreadStats& stats_;
+  uint32_t id_;
+  uint64_t seed_;
+  std::vector<uint32_t> held_;
+
+  bool tryOwn(uint32_t stripe);
+  void releaseAll();
+
+protected:
+  void subAcquire(Lockable* lockable, galois::MethodFlag m) override;
+
+public:
+  //! Pause budget an iteration waits for a lower priority owner
+  static constexpr unsigned kMaxWaitPauses = 1 << 10;
+  //! Cap on the exponent of the backoff after an abort
+  static constexpr int kMaxBackoffShift = 10;
+
+  //! Must be constructed by the thread that uses it
+  explicit StripedRuntimeContext(
+      StripedLockTable& table = GetStripedLockTable());
+
+  //! retries is the number of times the item has aborted before
+  void startIteration(int retries = 0) {
+    assert(held_.empty());
+    stats_.priority.store(retries, std::memory_order_relaxed);
+  }
+
+  unsigned cancelIteration();
+  unsigned commitIteration();
+};
+
 //! get the current conflict detection class, may be null if not in parallel
 //! region
 GALOIS_EXPORT SimpleRuntimeContext* getThreadContext();
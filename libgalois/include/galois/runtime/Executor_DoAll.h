@@ -20,13 +20,24 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_RUNTIME_EXECUTORDOALL_H_
 #define GALOIS_LIBGALOIS_GALOIS_RUNTIME_EXECUTORDOALL_H_
 
+#include <atomic>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "galois/Statistics.h"
 #include "galois/Timer.h"
+#include "galois/Trace.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
+#include "galois/gstl.h"
 #include "galois/runtime/Executor_OnEach.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/PerfCounters.h"
 #include "galois/substrate/Barrier.h"
+#include "galois/substrate/CacheLineStorage.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/PaddedLock.h"
 #include "galois/substrate/PerThreadStorage.h"
@@ -410,6 +421,7 @@ public:
 
   void operator()(void) {
     ThreadContext& ctx = *workers.getLocal();
+    TraceScope trace(loopname, TraceCategory::kLoop);
     totalTime.start();
 
     while (true) {
@@ -426,7 +438,12 @@ public:
       assert(!ctx.hasWork());
 
       stealTime.start();
+      uint64_t steal_begin = kTraceEnabled ? TraceNow() : 0;
       bool stole = trySteal(ctx);
+      if (kTraceEnabled && stole) {
+        galois::internal::TraceRecord(
+            "Steal", TraceCategory::kSteal, steal_begin, TraceNow(), 0);
+      }
       stealTime.stop();
 
       if (stole) {
@@ -459,6 +476,19 @@ public:
   }
 };
 
+//! Run by every thread of a loop after its work; combines the Reducibles of
+//! the combine_reducers trait once all threads are done
+template <typename ArgsT>
+void
+CombineReducers(const ArgsT& argsTuple, substrate::Barrier& barrier) {
+  if constexpr (has_trait<combine_reducers_tag, ArgsT>()) {
+    barrier.Wait();
+    std::apply(
+        [](auto*... reducers) { (reducers->combine(), ...); },
+        get_trait_value<combine_reducers_tag>(argsTuple).value);
+  }
+}
+
 template <bool _STEAL>
 struct ChooseDoAllImpl {
   template <typename R, typename F, typename ArgsT>
@@ -471,7 +501,8 @@ struct ChooseDoAllImpl {
 
     substrate::GetThreadPool().run(
         activeThreads, [&exec]() { exec.initThread(); },
-        [&barrier]() { barrier.Wait(); }, std::ref(exec));
+        [&barrier]() { barrier.Wait(); }, std::ref(exec),
+        [&]() { CombineReducers(argsTuple, barrier); });
   }
 };
 
@@ -492,6 +523,7 @@ struct ChooseDoAllImpl<false> {
           PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
           PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
 
+          TraceScope trace(loopname, TraceCategory::kLoop);
           totalTime.start();
           initTime.start();
 
@@ -517,6 +549,8 @@ struct ChooseDoAllImpl<false> {
           if (NEED_STATS) {
             galois::ReportStatSum(loopname, "Iterations", iter);
           }
+
+          CombineReducers(argsTuple, substrate::GetBarrier(activeThreads));
         },
         std::make_tuple());
   }
@@ -541,6 +575,13 @@ do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
   constexpr bool TIME_IT = has_trait<loopname_tag, ArgsT>();
   CondStatTimer<TIME_IT> timer(galois::internal::getLoopName(argsT));
 
+  constexpr bool COUNT_IT =
+      galois::internal::NeedStats<ArgsT>::value &&
+      has_trait<profile_counters_tag, ArgsT>();
+  CondPerfCounterRegion<COUNT_IT> counters(
+      galois::internal::getLoopName(argsT));
+
+  counters.start();
   timer.start();
 
   constexpr bool STEAL = has_trait<steal_tag, ArgsT>();
@@ -549,6 +590,185 @@ do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
   internal::ChooseDoAllImpl<STEAL>::call(range, func_ref, argsT);
 
   timer.stop();
+  counters.stop();
+}
+
+//! A phase of do_all_fused, see galois::phase
+template <typename F, typename ArgsTuple>
+struct FusedPhase {
+  F fn;
+
+  static constexpr bool kSteal = has_trait<steal_tag, ArgsTuple>();
+  static constexpr bool kAfterBarrier =
+      has_trait<after_barrier_tag, ArgsTuple>();
+};
+
+namespace internal {
+
+//! Returns true if every phase after a stealing phase waits at a barrier.
+//! Without one, the next phase could run before the items of its block,
+//! which other threads may have stolen, are done.
+template <typename... Phases>
+constexpr bool
+StealingPhasesAreSynchronized(std::tuple<Phases...>*) {
+  constexpr bool steal[] = {Phases::kSteal...};
+  constexpr bool after_barrier[] = {Phases::kAfterBarrier...};
+  for (size_t i = 1; i < sizeof...(Phases); ++i) {
+    if (steal[i - 1] && !after_barrier[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename R, typename PhasesTuple, typename ArgsTuple>
+class DoAllFusedExec {
+  using Iter = typename R::iterator;
+
+  constexpr static const bool NEED_STATS =
+      galois::internal::NeedStats<ArgsTuple>::value;
+  constexpr static const size_t kNumPhases = std::tuple_size_v<PhasesTuple>;
+
+  using Cursor = substrate::CacheLineStorage<std::atomic<size_t>>;
+
+  Iter begin_;
+  size_t size_;
+  PhasesTuple& phases_;
+  const ArgsTuple& args_;
+  const char* loopname_;
+  size_t chunk_size_;
+  unsigned num_threads_;
+  substrate::Barrier& barrier_;
+  //! Next unclaimed item of each block for each stealing phase
+  std::vector<Cursor> cursors_;
+
+  std::pair<size_t, size_t> block(unsigned tid) const {
+    return galois::block_range(size_t{0}, size_, tid, num_threads_);
+  }
+
+  template <typename F>
+  size_t runBlock(F& fn, size_t first, size_t last) {
+    Iter it = begin_;
+    std::advance(it, first);
+    for (size_t i = first; i < last; ++i, ++it) {
+      fn(*it);
+    }
+    return last - first;
+  }
+
+  //! Work through our own block a chunk at a time and then help the
+  //! remaining threads with theirs
+  template <typename F>
+  size_t runStealing(F& fn, unsigned phase, unsigned tid) {
+    size_t iter = 0;
+    for (unsigned i = 0; i < num_threads_; ++i) {
+      unsigned victim = (tid + i) % num_threads_;
+      auto& cursor = cursors_[phase * num_threads_ + victim].data;
+      size_t last = block(victim).second;
+      for (size_t first = cursor.fetch_add(chunk_size_); first < last;
+           first = cursor.fetch_add(chunk_size_)) {
+        iter += runBlock(fn, first, std::min(first + chunk_size_, last));
+      }
+    }
+    return iter;
+  }
+
+  template <size_t I>
+  size_t runPhase(unsigned tid) {
+    using Phase = std::tuple_element_t<I, PhasesTuple>;
+    auto& fn = std::get<I>(phases_).fn;
+
+    if constexpr (I > 0 && Phase::kAfterBarrier) {
+      barrier_.Wait();
+    }
+    if constexpr (Phase::kSteal) {
+      return runStealing(fn, I, tid);
+    } else {
+      auto [first, last] = block(tid);
+      return runBlock(fn, first, last);
+    }
+  }
+
+  template <size_t... Is>
+  size_t runPhases(unsigned tid, std::index_sequence<Is...>) {
+    return (runPhase<Is>(tid) + ...);
+  }
+
+public:
+  DoAllFusedExec(
+      const R& range, PhasesTuple& phases, const ArgsTuple& argsTuple)
+      : begin_(range.begin()),
+        size_(std::distance(range.begin(), range.end())),
+        phases_(phases),
+        args_(argsTuple),
+        loopname_(galois::internal::getLoopName(argsTuple)),
+        chunk_size_(get_trait_value<chunk_size_tag>(argsTuple).value),
+        num_threads_(activeThreads),
+        barrier_(substrate::GetBarrier(activeThreads)),
+        cursors_(kNumPhases * num_threads_) {
+    for (unsigned phase = 0; phase < kNumPhases; ++phase) {
+      for (unsigned tid = 0; tid < num_threads_; ++tid) {
+        cursors_[phase * num_threads_ + tid].data = block(tid).first;
+      }
+    }
+  }
+
+  void operator()() {
+    TraceScope trace(loopname_, TraceCategory::kLoop);
+    size_t iter = runPhases(
+        substrate::ThreadPool::getTID(),
+        std::make_index_sequence<kNumPhases>());
+    if (NEED_STATS) {
+      galois::ReportStatSum(loopname_, "Iterations", iter);
+    }
+    CombineReducers(args_, barrier_);
+  }
+};
+
+}  // namespace internal
+
+template <typename R, typename PhasesTuple, typename ArgsTuple>
+void
+do_all_fused_gen(
+    const R& range, PhasesTuple& phases, const ArgsTuple& argsTuple) {
+  static_assert(!has_trait<char*, ArgsTuple>(), "old loopname");
+  static_assert(!has_trait<char const*, ArgsTuple>(), "old loopname");
+  static_assert(std::tuple_size_v<PhasesTuple> > 0, "no phases");
+  static_assert(
+      std::is_convertible_v<
+          typename std::iterator_traits<
+              typename R::iterator>::iterator_category,
+          std::random_access_iterator_tag>,
+      "do_all_fused requires a random access range");
+  static_assert(
+      internal::StealingPhasesAreSynchronized(
+          static_cast<PhasesTuple*>(nullptr)),
+      "a phase after a stealing phase must use galois::after_barrier");
+
+  auto argsT = std::tuple_cat(
+      argsTuple, get_default_trait_values(
+                     argsTuple, std::make_tuple(chunk_size_tag{}),
+                     std::make_tuple(chunk_size<>{})));
+
+  using ArgsT = decltype(argsT);
+
+  constexpr bool TIME_IT = has_trait<loopname_tag, ArgsT>();
+  CondStatTimer<TIME_IT> timer(galois::internal::getLoopName(argsT));
+
+  constexpr bool COUNT_IT =
+      galois::internal::NeedStats<ArgsT>::value &&
+      has_trait<profile_counters_tag, ArgsT>();
+  CondPerfCounterRegion<COUNT_IT> counters(
+      galois::internal::getLoopName(argsT));
+
+  counters.start();
+  timer.start();
+
+  internal::DoAllFusedExec<R, PhasesTuple, ArgsT> exec(range, phases, argsT);
+  substrate::GetThreadPool().run(activeThreads, std::ref(exec));
+
+  timer.stop();
+  counters.stop();
 }
 
 }  // namespace galois::runtime
@@ -30,12 +30,14 @@
 #include "galois/ThreadTimer.h"
 #include "galois/Threads.h"
 #include "galois/Timer.h"
+#include "galois/Trace.h"
 #include "galois/Traits.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/runtime/Context.h"
 #include "galois/runtime/LoopStatistics.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/PerfCounters.h"
 #include "galois/runtime/UserContextAccess.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/TerminationDetection.h"
@@ -126,6 +128,9 @@ public:
   value_type& value(Item& item) const { return item.val; }
   value_type& value(value_type& val) const { return val; }
 
+  int retries(const Item& item) const { return item.retries; }
+  int retries(const value_type&) const { return 0; }
+
   void push(const value_type& val) {
     Item item = {val, 1};
     queues.getLocal()->push(item);
@@ -151,6 +156,8 @@ public:
   static constexpr bool needsPush = !has_trait<no_pushes_tag, ArgsTy>();
   static constexpr bool needsAborts =
       !has_trait<disable_conflict_detection_tag, ArgsTy>();
+  static constexpr bool needsStripes =
+      needsAborts && has_trait<striped_locks_tag, ArgsTy>();
   static constexpr bool needsPia = has_trait<per_iter_alloc_tag, ArgsTy>();
   static constexpr bool needsBreak = has_trait<parallel_break_tag, ArgsTy>();
   static constexpr bool MORE_STATS =
@@ -159,10 +166,13 @@ public:
 protected:
   typedef typename WorkListTy::value_type value_type;
 
+  using ContextTy = std::conditional_t<
+      needsStripes, StripedRuntimeContext, SimpleRuntimeContext>;
+
   struct ThreadLocalBasics {
     UserContextAccess<value_type> facing;
     FunctionTy function;
-    SimpleRuntimeContext ctx;
+    ContextTy ctx;
 
     explicit ThreadLocalBasics(FunctionTy fn) : facing(), function(fn), ctx() {}
   };
@@ -231,8 +241,10 @@ protected:
       tld.facing.resetAlloc();
   }
 
-  inline void doProcess(value_type& val, ThreadLocalData& tld) {
-    if (needsAborts)
+  inline void doProcess(value_type& val, ThreadLocalData& tld, int retries) {
+    if constexpr (needsStripes)
+      tld.ctx.startIteration(retries);
+    else if (needsAborts)
       tld.ctx.startIteration();
 
     tld.inc_iterations();
@@ -245,7 +257,7 @@ protected:
     bool didWork = false;
     while ((p = wl.pop())) {
       didWork = true;
-      doProcess(*p, tld);
+      doProcess(*p, tld, 0);
     }
     return didWork;
   }
@@ -256,7 +268,7 @@ protected:
     if (setjmp(execFrame) == 0) {
       while ((!limit || s.num < limit) && (s.item = lwl.pop())) {
         ++s.num;
-        doProcess(aborted.value(*s.item), tld);
+        doProcess(aborted.value(*s.item), tld, aborted.retries(*s.item));
       }
     } else {
       clearConflictLock();
@@ -266,7 +278,7 @@ protected:
     try {
       while ((!limit || s.num < limit) && (s.item = lwl.pop())) {
         ++s.num;
-        doProcess(aborted.value(*s.item), tld);
+        doProcess(aborted.value(*s.item), tld, aborted.retries(*s.item));
       }
     } catch (ConflictFlag const& flag) {
       clearConflictLock();
@@ -302,6 +314,7 @@ protected:
 
   template <bool couldAbort, bool isLeader>
   void go() {
+    TraceScope trace(loopname, TraceCategory::kLoop);
     execTime.start();
 
     // Thread-local data goes on the local stack to be NUMA friendly
@@ -454,6 +467,12 @@ for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
       OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))>;
   typedef ForEachExecutor<WorkListTy, FuncRefType, ArgsTy> WorkTy;
 
+  constexpr bool kStripes =
+      !has_trait<disable_conflict_detection_tag, ArgsTy>() &&
+      has_trait<striped_locks_tag, ArgsTy>();
+  if constexpr (kStripes)
+    GetStripedLockTable().Reset();
+
   auto& barrier = substrate::GetBarrier(activeThreads);
   FuncRefType fn_ref = fn;
   WorkTy W(fn_ref, args);
@@ -461,6 +480,9 @@ for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
   substrate::GetThreadPool().run(
       activeThreads, [&W, &range]() { W.initThread(range); },
       [&barrier] { barrier.Wait(); }, std::ref(W));
+
+  if constexpr (kStripes && galois::internal::NeedStats<ArgsTy>::value)
+    GetStripedLockTable().ReportStats(galois::internal::getLoopName(args));
 }
 
 // TODO: Need to decide whether user should provide num_run tag or
@@ -484,11 +506,19 @@ for_each_gen(const RangeTy& r, FunctionTy&& fn, const TupleTy& tpl) {
   constexpr bool TIME_IT = has_trait<loopname_tag, decltype(xtpl)>();
   CondStatTimer<TIME_IT> timer(galois::internal::getLoopName(xtpl));
 
+  constexpr bool COUNT_IT =
+      galois::internal::NeedStats<decltype(xtpl)>::value &&
+      has_trait<profile_counters_tag, decltype(xtpl)>();
+  CondPerfCounterRegion<COUNT_IT> counters(
+      galois::internal::getLoopName(xtpl));
+
+  counters.start();
   timer.start();
 
   runtime::for_each_impl(r, std::forward<FunctionTy>(fn), xtpl);
 
   timer.stop();
+  counters.stop();
 }
 
 }  // end namespace runtime
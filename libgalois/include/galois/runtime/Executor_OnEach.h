@@ -23,10 +23,12 @@
 #include "galois/ThreadTimer.h"
 #include "galois/Threads.h"
 #include "galois/Timer.h"
+#include "galois/Trace.h"
 #include "galois/Traits.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/PerfCounters.h"
 #include "galois/substrate/ThreadPool.h"
 
 namespace galois {
@@ -48,6 +50,10 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
 
   CondStatTimer<NEEDS_STATS> timer(loopname);
 
+  CondPerfCounterRegion<
+      NEEDS_STATS && has_trait<profile_counters_tag, ArgsTy>()>
+      counters(loopname);
+
   PerThreadTimer<MORE_STATS> execTime(loopname, "Execute");
 
   const auto numT = getActiveThreads();
@@ -55,6 +61,7 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
 
   auto runFun = [&] {
+    TraceScope trace(loopname, TraceCategory::kLoop);
     execTime.start();
 
     fn_ref(substrate::ThreadPool::getTID(), numT);
@@ -62,9 +69,11 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
     execTime.stop();
   };
 
+  counters.start();
   timer.start();
   substrate::GetThreadPool().run(numT, runFun);
   timer.stop();
+  counters.stop();
 }
 
 }  // namespace internal
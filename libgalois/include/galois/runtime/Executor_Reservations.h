@@ -0,0 +1,238 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_LIBGALOIS_GALOIS_RUNTIME_EXECUTORRESERVATIONS_H_
+#define GALOIS_LIBGALOIS_GALOIS_RUNTIME_EXECUTORRESERVATIONS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "galois/Statistics.h"
+#include "galois/Threads.h"
+#include "galois/Timer.h"
+#include "galois/Trace.h"
+#include "galois/Traits.h"
+#include "galois/config.h"
+#include "galois/gstl.h"
+#include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/substrate/Barrier.h"
+#include "galois/substrate/ThreadPool.h"
+
+namespace galois::runtime {
+
+namespace internal {
+
+/// Deterministic reservations (Blelloch et al., "Internally Deterministic
+/// Parallel Algorithms Can Be Fast", PPoPP 2012).
+///
+/// Items are processed in rounds over a window, which is a prefix of the items
+/// that are not done yet, in their original order. Each round has a reserve
+/// step and a commit step separated by a barrier; items whose commit fails
+/// are carried, in order, to the front of the next window. All state is
+/// kept in flat arrays of item positions sized to the window, so there is no
+/// per-item context and no lock.
+///
+/// Because the outcome of a round only depends on the items in the window,
+/// and the window size starts at a constant and then only depends on the
+/// number of failed commits, the result does not depend on the number of
+/// threads or on scheduling.
+template <typename R, typename ReserveFn, typename CommitFn, typename ArgsTuple>
+class ReservationsExec {
+  using Iter = typename R::iterator;
+
+  constexpr static const bool NEED_STATS =
+      galois::internal::NeedStats<ArgsTuple>::value;
+
+  // Window adaptation: shrink the window if more than 1/kShrinkRatio of its
+  // items fail to commit, grow it if fewer than 1/kGrowRatio fail
+  constexpr static const size_t kShrinkRatio = 4;
+  constexpr static const size_t kGrowRatio = 16;
+  constexpr static const size_t kMinWindow = 64;
+  // Not scaled by the number of threads, which would change the rounds
+  constexpr static const size_t kInitialWindow = 4096;
+
+  Iter begin_;
+  size_t size_;
+  ReserveFn reserve_;
+  CommitFn commit_;
+  const char* loopname_;
+
+  //! positions of the items in the current window
+  std::vector<uint64_t> current_;
+  std::vector<uint64_t> next_;
+  //! whether each item of the window still needs a commit or a retry
+  std::vector<uint8_t> pending_;
+  //! number of items each thread carries to the next window
+  std::vector<size_t> carried_;
+
+  size_t window_;
+  size_t num_carried_{0};
+  size_t num_started_{0};
+
+  auto item(uint64_t pos) const { return *std::next(begin_, pos); }
+
+  //! Runs one round and returns the number of items that failed to commit
+  size_t round(size_t window_size) {
+    // If the window shrank, some carried items wait for a later round
+    size_t num_carried = std::min(num_carried_, window_size);
+    size_t first_new = num_started_;
+    substrate::Barrier& barrier = substrate::GetBarrier(activeThreads);
+
+    substrate::GetThreadPool().run(activeThreads, [&]() {
+      unsigned tid = substrate::ThreadPool::getTID();
+      auto [first, last] =
+          galois::block_range(size_t{0}, window_size, tid, activeThreads);
+
+      for (size_t i = first; i < last; ++i) {
+        if (i >= num_carried) {
+          current_[i] = first_new + (i - num_carried);
+        }
+        pending_[i] = reserve_(item(current_[i]));
+      }
+
+      barrier.Wait();
+
+      size_t carried = 0;
+      for (size_t i = first; i < last; ++i) {
+        if (pending_[i]) {
+          pending_[i] = !commit_(item(current_[i]));
+          carried += pending_[i];
+        }
+      }
+      carried_[tid] = carried;
+
+      barrier.Wait();
+
+      // Pack failed items to the front of the next window in order
+      size_t offset = 0;
+      for (unsigned t = 0; t < tid; ++t) {
+        offset += carried_[t];
+      }
+      for (size_t i = first; i < last; ++i) {
+        if (pending_[i]) {
+          next_[offset++] = current_[i];
+        }
+      }
+    });
+
+    size_t num_failed = 0;
+    for (unsigned t = 0; t < activeThreads; ++t) {
+      num_failed += carried_[t];
+    }
+    // Items that failed in this round precede those that did not run
+    std::copy(
+        current_.begin() + num_carried, current_.begin() + num_carried_,
+        next_.begin() + num_failed);
+
+    num_started_ += window_size - num_carried;
+    num_carried_ = num_failed + (num_carried_ - num_carried);
+    std::swap(current_, next_);
+    return num_failed;
+  }
+
+  void resize(size_t window) {
+    if (current_.size() < window) {
+      current_.resize(window);
+      next_.resize(window);
+      pending_.resize(window);
+    }
+  }
+
+public:
+  ReservationsExec(
+      const R& range, ReserveFn reserve, CommitFn commit,
+      const ArgsTuple& argsTuple)
+      : begin_(range.begin()),
+        size_(std::distance(range.begin(), range.end())),
+        reserve_(reserve),
+        commit_(commit),
+        loopname_(galois::internal::getLoopName(argsTuple)),
+        carried_(activeThreads),
+        window_(std::min(size_, kInitialWindow)) {}
+
+  void execute() {
+    size_t rounds = 0;
+    size_t retries = 0;
+
+    while (num_started_ < size_ || num_carried_ > 0) {
+      size_t window_size =
+          std::min(window_, num_carried_ + (size_ - num_started_));
+      resize(window_size);
+      size_t num_failed = round(window_size);
+
+      ++rounds;
+      retries += num_failed;
+
+      if (num_failed * kShrinkRatio > window_size) {
+        window_ = std::max(kMinWindow, window_ / 2);
+      } else if (
+          num_failed * kGrowRatio < window_size && window_size == window_) {
+        window_ = std::min(size_, window_ * 2);
+      }
+    }
+
+    if (NEED_STATS) {
+      galois::ReportStatSingle(loopname_, "Rounds", rounds);
+      galois::ReportStatSingle(loopname_, "Retries", retries);
+      galois::ReportStatSingle(loopname_, "Iterations", size_);
+    }
+  }
+};
+
+}  // namespace internal
+
+template <typename R, typename ReserveFn, typename CommitFn, typename ArgsTuple>
+void
+deterministic_for_gen(
+    const R& range, ReserveFn&& reserve, CommitFn&& commit,
+    const ArgsTuple& argsTuple) {
+  static_assert(!has_trait<char*, ArgsTuple>(), "old loopname");
+  static_assert(!has_trait<char const*, ArgsTuple>(), "old loopname");
+  static_assert(
+      std::is_convertible_v<
+          typename std::iterator_traits<
+              typename R::iterator>::iterator_category,
+          std::random_access_iterator_tag>,
+      "deterministic_for requires a random access range");
+
+  constexpr bool TIME_IT = has_trait<loopname_tag, ArgsTuple>();
+  CondStatTimer<TIME_IT> timer(galois::internal::getLoopName(argsTuple));
+  TraceScope trace(
+      galois::internal::getLoopName(argsTuple), TraceCategory::kLoop);
+
+  timer.start();
+
+  OperatorReferenceType<decltype(std::forward<ReserveFn>(reserve))>
+      reserve_ref = reserve;
+  OperatorReferenceType<decltype(std::forward<CommitFn>(commit))> commit_ref =
+      commit;
+  internal::ReservationsExec<
+      R, decltype(reserve_ref), decltype(commit_ref), ArgsTuple>
+      exec(range, reserve_ref, commit_ref, argsTuple);
+  exec.execute();
+
+  timer.stop();
+}
+
+}  // namespace galois::runtime
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_LIBGALOIS_GALOIS_RUNTIME_PERFCOUNTERS_H_
+#define GALOIS_LIBGALOIS_GALOIS_RUNTIME_PERFCOUNTERS_H_
+
+#include <array>
+#include <cstdint>
+
+#include "galois/config.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+namespace galois::runtime {
+
+/// Per-thread hardware counters read through the Linux perf_event_open
+/// interface. Unlike the PAPI support in Profile.h, this needs no external
+/// library and is always compiled in.
+///
+/// Counters are opened for each thread the first time it reads them and stay
+/// open for the life of the thread, so reading them costs one read(2) per
+/// counter. If perf events are not permitted (e.g., because of
+/// /proc/sys/kernel/perf_event_paranoid or a container seccomp profile) or a
+/// counter is not supported by the processor, a warning is logged once and
+/// that counter reads as zero.
+class GALOIS_EXPORT PerfCounters {
+public:
+  enum Counter {
+    kCycles = 0,
+    kInstructions,
+    kLLCMisses,
+    kDTLBMisses,
+    kNumCounters,
+  };
+
+  using Values = std::array<uint64_t, kNumCounters>;
+
+  /// Returns the statistic name for counter
+  static const char* Name(Counter counter);
+
+  /// Reads the counters of the calling thread. Returns false if no counter is
+  /// available.
+  static bool Read(Values* values);
+
+  /// Returns true if counter could be opened for the calling thread
+  static bool IsAvailable(Counter counter);
+};
+
+/// Reports the hardware counters of all active threads accumulated between
+/// start() and stop() as per-thread statistics of region (Cycles,
+/// Instructions, LLCMisses, DTLBMisses), next to the timers of the region.
+/// Counters that are not available are not reported.
+/// start() and stop() must be called outside of parallel sections.
+class GALOIS_EXPORT PerfCounterRegion {
+  const char* region_;
+  substrate::PerThreadStorage<PerfCounters::Values> begin_;
+
+public:
+  explicit PerfCounterRegion(const char* region);
+
+  void start();
+  void stop();
+};
+
+template <bool Enable>
+class CondPerfCounterRegion : public PerfCounterRegion {
+public:
+  explicit CondPerfCounterRegion(const char* region)
+      : PerfCounterRegion(region) {}
+};
+
+template <>
+class CondPerfCounterRegion<false> {
+public:
+  explicit CondPerfCounterRegion(const char*) {}
+
+  void start() const {}
+  void stop() const {}
+};
+
+}  // namespace galois::runtime
+
+#endif
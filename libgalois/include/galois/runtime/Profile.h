@@ -37,6 +37,7 @@ extern "C" {
 #include "galois/Timer.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
+#include "galois/runtime/PerfCounters.h"
 
 namespace galois::runtime {
 
@@ -230,6 +231,22 @@ profilePapi(const F& func, const char* region) {
 
 #endif
 
+/// Times func and reports the hardware counters of each thread during func
+/// (see PerfCounters) as statistics of region. Unlike profilePapi, this
+/// requires no build option and simply times func when perf events are not
+/// available.
+template <typename F>
+void
+profilePerf(const F& func, const char* region) {
+  region = region ? region : "(NULL)";
+
+  PerfCounterRegion counters(region);
+
+  counters.start();
+  timeThis(func, region);
+  counters.stop();
+}
+
 }  // namespace galois::runtime
 
 #endif
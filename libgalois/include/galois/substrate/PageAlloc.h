@@ -35,6 +35,18 @@ GALOIS_EXPORT void* allocPages(unsigned num, bool preFault);
 // free page range
 GALOIS_EXPORT void freePages(void* ptr, unsigned num);
 
+// reserve address space for num pages, aligned to allocSize(), without
+// backing it with memory; returns nullptr if the reservation fails. Release
+// it with freePages.
+GALOIS_EXPORT void* reservePages(unsigned num);
+
+// back reserved pages with memory, optionally faulting them in
+GALOIS_EXPORT void commitPages(void* ptr, unsigned num, bool preFault);
+
+// return the memory backing committed pages to the OS, keeping the
+// address space reserved
+GALOIS_EXPORT void decommitPages(void* ptr, unsigned num);
+
 }  // namespace galois::substrate
 
 #endif
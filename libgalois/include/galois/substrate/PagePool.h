@@ -20,13 +20,17 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_SUBSTRATE_PAGEPOOL_H_
 #define GALOIS_LIBGALOIS_GALOIS_SUBSTRATE_PAGEPOOL_H_
 
+#include <atomic>
 #include <cstddef>
 #include <deque>
+#include <limits>
 #include <mutex>
 #include <numeric>
 #include <unordered_map>
 #include <vector>
 
+#include "galois/Env.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/config.h"
 #include "galois/substrate/CacheLineStorage.h"
 #include "galois/substrate/PageAlloc.h"
@@ -42,11 +46,23 @@ GALOIS_EXPORT void* pagePoolAlloc();
 GALOIS_EXPORT void pagePoolFree(void*);
 GALOIS_EXPORT void pagePoolPreAlloc(unsigned);
 
+//! Returns free pages beyond keepPerThread on each thread to the OS. Returns
+//! the number of pages released.
+GALOIS_EXPORT size_t pagePoolTrim(size_t keepPerThread);
+
+//! Sets the number of free pages each thread may hold before pagePoolFree
+//! returns the excess to the OS. The default is unlimited unless the
+//! environment variable GALOIS_PAGE_POOL_WATERMARK is set.
+GALOIS_EXPORT void pagePoolSetWatermark(size_t pagesPerThread);
+
 //! Returns total large pages allocated by Galois memory management subsystem
 GALOIS_EXPORT int numPagePoolAllocTotal();
 //! Returns total large pages allocated for thread by Galois memory management
 //! subsystem
 GALOIS_EXPORT int numPagePoolAllocForThread(unsigned tid);
+//! Returns total large pages returned to the OS by pagePoolTrim or the
+//! watermark
+GALOIS_EXPORT int numPagePoolReleasedTotal();
 
 namespace internal {
 
@@ -55,68 +71,215 @@ struct FreeNode {
 };
 
 typedef galois::substrate::PtrLock<FreeNode> HeadPtr;
-typedef galois::substrate::CacheLineStorage<HeadPtr> HeadPtrStorage;
+
+//! Number of pages of address space to reserve for each thread's arena
+GALOIS_EXPORT size_t pageArenaSize(unsigned numThreads);
 
 // Tracks pages allocated
+//
+// Each thread commits pages from its own range of reserved address space, so
+// the owner of a page, whose free list it returns to, follows from its
+// address without a shared map. Only when an arena is exhausted (or address
+// space could not be reserved) are pages allocated individually and their
+// owners recorded in overflowMap under a lock.
 template <typename _UNUSED = void>
 class PageAllocState {
+  struct PerThread {
+    // The lock bit of head also protects the remaining fields
+    HeadPtr head;
+    size_t numFree{0};
+    // Pages of the arena returned to the OS, to be committed again before
+    // bumping next
+    std::vector<void*> released;
+    char* next{nullptr};
+    char* end{nullptr};
+  };
+
   std::deque<std::atomic<int>> counts;
-  std::vector<HeadPtrStorage> pool;
-  std::unordered_map<void*, int> ownerMap;
-  galois::substrate::SimpleLock mapLock;
+  std::atomic<int> numReleased{0};
+  std::vector<CacheLineStorage<PerThread>> pool;
+  char* arenaBase{nullptr};
+  size_t arenaBytes{0};
+  size_t arenaPages{0};
+  std::atomic<size_t> watermark{std::numeric_limits<size_t>::max()};
+  std::unordered_map<void*, int> overflowMap;
+  galois::substrate::SimpleLock overflowLock;
+
+  int owner(void* ptr) {
+    char* p = static_cast<char*>(ptr);
+    if (p >= arenaBase && p < arenaBase + arenaBytes * pool.size()) {
+      return (p - arenaBase) / arenaBytes;
+    }
+    std::lock_guard<galois::substrate::SimpleLock> lg(overflowLock);
+    assert(overflowMap.count(ptr));
+    return overflowMap[ptr];
+  }
 
   void* allocFromOS() {
-    void* ptr = galois::substrate::allocPages(1, true);
-    assert(ptr);
     auto tid = galois::substrate::ThreadPool::getTID();
+    PerThread& pt = pool[tid].data;
+
+    void* ptr = nullptr;
+    pt.head.lock();
+    if (!pt.released.empty()) {
+      ptr = pt.released.back();
+      pt.released.pop_back();
+    } else if (pt.next != pt.end) {
+      ptr = pt.next;
+      pt.next += galois::substrate::allocSize();
+    }
+    pt.head.unlock();
+
+    if (ptr) {
+      galois::substrate::commitPages(ptr, 1, true);
+    } else {
+      ptr = galois::substrate::allocPages(1, true);
+      assert(ptr);
+      std::lock_guard<galois::substrate::SimpleLock> lg(overflowLock);
+      overflowMap[ptr] = tid;
+    }
     counts[tid] += 1;
-    std::lock_guard<galois::substrate::SimpleLock> lg(mapLock);
-    ownerMap[ptr] = tid;
+    galois::MemoryAdd(
+        galois::MemoryCategory::kWorklists, galois::substrate::allocSize());
     return ptr;
   }
 
+  //! Returns pages beyond keep on the free list of thread i to the OS
+  size_t trim(unsigned i, size_t keep) {
+    PerThread& pt = pool[i].data;
+    pt.head.lock();
+    FreeNode* h = pt.head.getValue();
+    FreeNode* excess = nullptr;
+    while (pt.numFree > keep) {
+      FreeNode* n = h;
+      h = h->next;
+      n->next = excess;
+      excess = n;
+      --pt.numFree;
+    }
+    pt.head.unlock_and_set(h);
+
+    size_t num = 0;
+    std::vector<void*> decommitted;
+    while (excess) {
+      void* ptr = excess;
+      excess = excess->next;
+      ++num;
+      char* p = static_cast<char*>(ptr);
+      if (p >= arenaBase && p < arenaBase + arenaBytes * pool.size()) {
+        galois::substrate::decommitPages(ptr, 1);
+        decommitted.push_back(ptr);
+      } else {
+        {
+          std::lock_guard<galois::substrate::SimpleLock> lg(overflowLock);
+          overflowMap.erase(ptr);
+        }
+        galois::substrate::freePages(ptr, 1);
+      }
+    }
+
+    if (!decommitted.empty()) {
+      pt.head.lock();
+      pt.released.insert(
+          pt.released.end(), decommitted.begin(), decommitted.end());
+      pt.head.unlock();
+    }
+    numReleased += num;
+    galois::MemoryRelease(
+        galois::MemoryCategory::kWorklists,
+        num * galois::substrate::allocSize());
+    return num;
+  }
+
 public:
   PageAllocState() {
     auto num = galois::substrate::GetThreadPool().getMaxThreads();
     counts.resize(num);
     pool.resize(num);
+
+    arenaPages = pageArenaSize(num);
+    arenaBase = static_cast<char*>(
+        galois::substrate::reservePages(arenaPages * num));
+    if (arenaBase) {
+      arenaBytes = arenaPages * galois::substrate::allocSize();
+      for (unsigned i = 0; i < num; ++i) {
+        pool[i].data.next = arenaBase + i * arenaBytes;
+        pool[i].data.end = pool[i].data.next + arenaBytes;
+      }
+    }
+
+    int pages{};
+    if (galois::GetEnv("GALOIS_PAGE_POOL_WATERMARK", &pages) && pages >= 0) {
+      watermark = pages;
+    }
+  }
+
+  ~PageAllocState() {
+    galois::MemoryRelease(
+        galois::MemoryCategory::kWorklists,
+        (countAll() - countReleased()) * galois::substrate::allocSize());
+    if (arenaBase) {
+      galois::substrate::freePages(arenaBase, arenaPages * pool.size());
+    }
+    for (auto& kv : overflowMap) {
+      galois::substrate::freePages(kv.first, 1);
+    }
   }
 
+  PageAllocState(const PageAllocState&) = delete;
+  PageAllocState& operator=(const PageAllocState&) = delete;
+
   int count(unsigned tid) const { return counts[tid]; }
 
   int countAll() const {
     return std::accumulate(counts.begin(), counts.end(), 0);
   }
 
+  int countReleased() const { return numReleased; }
+
   void* pageAlloc() {
     auto tid = galois::substrate::ThreadPool::getTID();
-    HeadPtr& hp = pool[tid].data;
-    if (hp.getValue()) {
-      hp.lock();
-      FreeNode* h = hp.getValue();
+    PerThread& pt = pool[tid].data;
+    if (pt.head.getValue()) {
+      pt.head.lock();
+      FreeNode* h = pt.head.getValue();
       if (h) {
-        hp.unlock_and_set(h->next);
+        --pt.numFree;
+        pt.head.unlock_and_set(h->next);
         return h;
       }
-      hp.unlock();
+      pt.head.unlock();
     }
     return allocFromOS();
   }
 
   void pageFree(void* ptr) {
     assert(ptr);
-    mapLock.lock();
-    assert(ownerMap.count(ptr));
-    int i = ownerMap[ptr];
-    mapLock.unlock();
-    HeadPtr& hp = pool[i].data;
-    hp.lock();
+    int i = owner(ptr);
+    PerThread& pt = pool[i].data;
+    pt.head.lock();
     FreeNode* nh = reinterpret_cast<FreeNode*>(ptr);
-    nh->next = hp.getValue();
-    hp.unlock_and_set(nh);
+    nh->next = pt.head.getValue();
+    size_t numFree = ++pt.numFree;
+    pt.head.unlock_and_set(nh);
+
+    size_t keep = watermark.load(std::memory_order_relaxed);
+    if (numFree > keep) {
+      trim(i, keep);
+    }
   }
 
   void pagePreAlloc() { pageFree(allocFromOS()); }
+
+  size_t trimAll(size_t keep) {
+    size_t num = 0;
+    for (unsigned i = 0; i < pool.size(); ++i) {
+      num += trim(i, keep);
+    }
+    return num;
+  }
+
+  void setWatermark(size_t pages) { watermark = pages; }
 };
 
 //! Initialize PagePool, used by runtime::init();
@@ -22,7 +22,9 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <thread>
@@ -53,17 +55,38 @@ namespace galois::substrate {
 class GALOIS_EXPORT ThreadPool {
   friend class SharedMem;
 
+public:
+  //! how idle threads wait for the next parallel section (see burnPower for
+  //! busy waiting)
+  enum class IdlePolicy {
+    //! block on a condition variable until woken
+    kSleep,
+    //! spin for a window tuned from the observed gaps between parallel
+    //! sections, then park on a futex until woken
+    kAdaptive,
+  };
+
 protected:
+  enum class WaitMode { kSleep, kSpin, kAdaptive };
+
   struct shutdown_ty {};  //! type for shutting down thread
   struct fastmode_ty {
     bool mode;
   };  //! type for setting fastmode
+  struct idle_policy_ty {
+    IdlePolicy policy;
+  };  //! type for setting the idle policy
   struct dedicated_ty {
     std::function<void(void)> fn;
   };  //! type to switch to dedicated mode
 
   //! Per-thread mailboxes for notification
   struct per_signal {
+    //! states of fastRelease
+    static constexpr int kIdle = 0;
+    static constexpr int kReleased = 1;
+    static constexpr int kParked = 2;
+
     std::condition_variable cv;
     std::mutex m;
     unsigned wbegin, wend;
@@ -71,30 +94,14 @@ protected:
     std::atomic<int> fastRelease;
     ThreadTopoInfo topo;
 
-    void wakeup(bool fastmode) {
-      if (fastmode) {
-        done = 0;
-        fastRelease = 1;
-      } else {
-        std::lock_guard<std::mutex> lg(m);
-        done = 0;
-        cv.notify_one();
-        // start.release();
-      }
-    }
-
-    void wait(bool fastmode) {
-      if (fastmode) {
-        while (!fastRelease.load(std::memory_order_relaxed)) {
-          asmPause();
-        }
-        fastRelease = 0;
-      } else {
-        std::unique_lock<std::mutex> lg(m);
-        cv.wait(lg, [=] { return !done; });
-        // start.acquire();
-      }
-    }
+    void wakeup(WaitMode mode);
+
+    void wait(WaitMode mode, uint64_t spin_ns);
+
+  private:
+    void waitAdaptive(uint64_t spin_ns);
+    void park();
+    void unpark();
   };
 
   thread_local static per_signal my_box;
@@ -105,8 +112,15 @@ protected:
   unsigned reserved;
   unsigned masterFastmode;
   bool running;
+  IdlePolicy idlePolicy;
   std::function<void(void)> work;
 
+  //! estimate of the time between parallel sections
+  uint64_t gapEstimateNs;
+  std::chrono::steady_clock::time_point lastRunEnd;
+  //! how long idle threads spin before parking under IdlePolicy::kAdaptive
+  std::atomic<uint64_t> idleSpinNs;
+
   //! destroy all threads
   void destroyCommon();
 
@@ -116,8 +130,22 @@ protected:
   //! main thread loop
   void threadLoop(unsigned tid);
 
+  //! return how idle threads other than those in fastmode wait
+  WaitMode baseWaitMode() const {
+    return idlePolicy == IdlePolicy::kAdaptive ? WaitMode::kAdaptive
+                                               : WaitMode::kSleep;
+  }
+
+  //! return how the master thread should wake up threads
+  WaitMode masterWaitMode() const {
+    return masterFastmode ? WaitMode::kSpin : baseWaitMode();
+  }
+
+  //! update idleSpinNs from the time since the last parallel section
+  void updateIdleSpin();
+
   //! spin up for run
-  void cascade(bool fastmode);
+  void cascade(WaitMode mode);
 
   //! spin down after run
   void decascade();
@@ -169,8 +197,27 @@ public:
   // experimental: leave busy wait
   void beKind();
 
+  //! set how idle threads wait for work. Under IdlePolicy::kAdaptive, a thread
+  //! that finishes a parallel section keeps spinning if parallel sections have
+  //! recently followed each other closely (up to a bound), and otherwise parks
+  //! quickly so that a service waiting for its next request does not burn CPU.
+  //! The default is taken from GALOIS_IDLE_POLICY ("sleep" or "adaptive") or
+  //! is IdlePolicy::kSleep. Must be called outside of parallel sections.
+  void setIdlePolicy(IdlePolicy policy);
+
+  IdlePolicy getIdlePolicy() const { return idlePolicy; }
+
+  //! return the current spin window of IdlePolicy::kAdaptive in nanoseconds
+  uint64_t getIdleSpinNs() const {
+    return idleSpinNs.load(std::memory_order_relaxed);
+  }
+
   bool isRunning() const { return running; }
 
+  //! return true if called on the thread that created the pool, which is the
+  //! only thread that may call run
+  bool isMasterThread() const { return signals[0] == &my_box; }
+
   //! return the number of non-reserved threads in the pool
   unsigned getMaxUsableThreads() const { return mi.maxThreads - reserved; }
   //! return the number of threads supported by the thread pool on the current
@@ -216,6 +263,13 @@ public:
  */
 GALOIS_EXPORT ThreadPool& GetThreadPool();
 
+/**
+ * return true if the calling thread may start a parallel section now, i.e.,
+ * the system thread pool exists, this is its master thread and no parallel
+ * section is running
+ */
+GALOIS_EXPORT bool CanRunThreadPool();
+
 }  // namespace galois::substrate
 
 namespace galois::substrate::internal {
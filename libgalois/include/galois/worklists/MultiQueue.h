@@ -0,0 +1,277 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef GALOIS_LIBGALOIS_GALOIS_WORKLISTS_MULTIQUEUE_H_
+#define GALOIS_LIBGALOIS_GALOIS_WORKLISTS_MULTIQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "galois/Statistics.h"
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/substrate/CacheLineStorage.h"
+#include "galois/substrate/PaddedLock.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/ThreadPool.h"
+#include "galois/worklists/WLCompileCheck.h"
+
+namespace galois {
+namespace runtime {
+extern unsigned activeThreads;
+}
+namespace worklists {
+
+/**
+ * A relaxed concurrent priority queue (MultiQueue, Rihani, Sanders and
+ * Dementiev, SPAA 2015) for general priority orders that do not map to the
+ * integer buckets of OrderedByIntegerMetric, e.g., A* or best-first search
+ * over paths.
+ *
+ * Items are kept in queues_per_thread * (active threads) binary heaps, each
+ * behind its own lock. A push goes to a random heap; a pop looks at the tops
+ * of two random heaps and takes the better one. More heaps per thread mean
+ * less contention but a looser order; items are popped close to, but not
+ * exactly in, Compare order (smallest first, like OrderedList).
+ *
+ * Each thread counts priority inversions, i.e., pops that return an item
+ * ordered before the item the same thread popped previously. For monotone
+ * workloads such as Dijkstra's algorithm these are caused by the relaxation.
+ * The number of pops and inversions are reported as statistics of the
+ * MultiQueue region when the worklist is destroyed.
+ */
+template <typename Compare = std::less<>, typename T = int,
+          bool Concurrent = true>
+class MultiQueue : private boost::noncopyable {
+public:
+  static constexpr unsigned kDefaultQueuesPerThread = 4;
+
+  template <typename _T>
+  using retype = MultiQueue<Compare, _T, Concurrent>;
+
+  template <bool _concurrent>
+  using rethread = MultiQueue<Compare, T, _concurrent>;
+
+  typedef T value_type;
+
+private:
+  //! Number of random pairs of empty heaps a pop samples before it scans all
+  //! heaps for work
+  static constexpr unsigned kPopAttempts = 4;
+
+  struct alignas(substrate::GALOIS_CACHE_LINE_SIZE) Queue {
+    substrate::PaddedLock<Concurrent> lock;
+    std::atomic<size_t> size{0};
+    std::vector<T> heap;
+  };
+
+  struct ThreadData {
+    uint64_t seed{0};
+    galois::optional<T> last;
+    size_t num_pops{0};
+    size_t num_inversions{0};
+  };
+
+  Compare compare_;
+  unsigned num_queues_;
+  std::unique_ptr<Queue[]> queues_;
+  substrate::PerThreadStorage<ThreadData> data_;
+
+  //! Orders the heaps so that the front is the first item in Compare order
+  bool later(const T& lhs, const T& rhs) const { return compare_(rhs, lhs); }
+
+  unsigned randomQueue(ThreadData& td) {
+    if (!td.seed) {
+      td.seed = (substrate::ThreadPool::getTID() + 1) * 0x9E3779B97F4A7C15;
+    }
+    td.seed ^= td.seed << 13;
+    td.seed ^= td.seed >> 7;
+    td.seed ^= td.seed << 17;
+    return td.seed % num_queues_;
+  }
+
+  void pushLocked(Queue& q, const value_type& val) {
+    q.heap.push_back(val);
+    std::push_heap(
+        q.heap.begin(), q.heap.end(),
+        [this](const T& lhs, const T& rhs) { return later(lhs, rhs); });
+    q.size.store(q.heap.size(), std::memory_order_relaxed);
+  }
+
+  value_type popLocked(Queue& q) {
+    std::pop_heap(
+        q.heap.begin(), q.heap.end(),
+        [this](const T& lhs, const T& rhs) { return later(lhs, rhs); });
+    value_type val = std::move(q.heap.back());
+    q.heap.pop_back();
+    q.size.store(q.heap.size(), std::memory_order_relaxed);
+    return val;
+  }
+
+  //! Pops the better top of two random heaps. Returns false if both were
+  //! empty or busy.
+  bool tryPopTwo(ThreadData& td, galois::optional<value_type>& ret) {
+    Queue* a = &queues_[randomQueue(td)];
+    Queue* b = &queues_[randomQueue(td)];
+    if (a->size.load(std::memory_order_relaxed) == 0) {
+      std::swap(a, b);
+    }
+    if (a->size.load(std::memory_order_relaxed) == 0 || !a->lock.try_lock()) {
+      return false;
+    }
+    bool locked_b = a != b && b->size.load(std::memory_order_relaxed) != 0 &&
+                    b->lock.try_lock();
+
+    Queue* best = a;
+    if (locked_b && !b->heap.empty() &&
+        (a->heap.empty() || later(a->heap.front(), b->heap.front()))) {
+      best = b;
+    }
+    if (!best->heap.empty()) {
+      ret = popLocked(*best);
+    }
+
+    if (locked_b) {
+      b->lock.unlock();
+    }
+    a->lock.unlock();
+    return ret.is_initialized();
+  }
+
+  //! Pops from the first non-empty heap, starting at a random one
+  bool tryPopAny(ThreadData& td, galois::optional<value_type>& ret) {
+    unsigned first = randomQueue(td);
+    for (unsigned i = 0; i < num_queues_; ++i) {
+      Queue& q = queues_[(first + i) % num_queues_];
+      if (q.size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      q.lock.lock();
+      if (!q.heap.empty()) {
+        ret = popLocked(q);
+      }
+      q.lock.unlock();
+      if (ret) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+public:
+  explicit MultiQueue(
+      unsigned queues_per_thread = kDefaultQueuesPerThread,
+      const Compare& compare = Compare())
+      : compare_(compare),
+        num_queues_(
+            std::max(1U, queues_per_thread) *
+            (Concurrent ? runtime::activeThreads : 1)),
+        queues_(std::make_unique<Queue[]>(num_queues_)) {}
+
+  ~MultiQueue() {
+    size_t pops = numPops();
+    if (pops) {
+      galois::ReportStatSum("MultiQueue", "Pops", pops);
+      galois::ReportStatSum("MultiQueue", "Inversions", numInversions());
+    }
+  }
+
+  unsigned numQueues() const { return num_queues_; }
+
+  //! Returns the number of pops so far. Only valid outside parallel regions.
+  size_t numPops() const {
+    size_t ret = 0;
+    for (unsigned i = 0; i < data_.size(); ++i) {
+      ret += data_.getRemote(i)->num_pops;
+    }
+    return ret;
+  }
+
+  //! Returns the number of priority inversions so far. Only valid outside
+  //! parallel regions.
+  size_t numInversions() const {
+    size_t ret = 0;
+    for (unsigned i = 0; i < data_.size(); ++i) {
+      ret += data_.getRemote(i)->num_inversions;
+    }
+    return ret;
+  }
+
+  void push(const value_type& val) {
+    ThreadData& td = *data_.getLocal();
+    Queue* q = &queues_[randomQueue(td)];
+    while (!q->lock.try_lock()) {
+      q = &queues_[randomQueue(td)];
+    }
+    pushLocked(*q, val);
+    q->lock.unlock();
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    for (; b != e; ++b) {
+      push(*b);
+    }
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  galois::optional<value_type> pop() {
+    ThreadData& td = *data_.getLocal();
+    galois::optional<value_type> ret;
+
+    bool found = false;
+    for (unsigned i = 0; i < kPopAttempts && !found; ++i) {
+      found = tryPopTwo(td, ret);
+    }
+    if (!found && !tryPopAny(td, ret)) {
+      return ret;
+    }
+
+    ++td.num_pops;
+    if (td.last && compare_(*ret, *td.last)) {
+      ++td.num_inversions;
+    }
+    td.last = *ret;
+    return ret;
+  }
+
+  bool empty() const {
+    for (unsigned i = 0; i < num_queues_; ++i) {
+      if (queues_[i].size.load(std::memory_order_relaxed)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+GALOIS_WLCOMPILECHECK(MultiQueue)
+
+}  // end namespace worklists
+}  // end namespace galois
+
+#endif
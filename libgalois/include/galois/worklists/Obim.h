@@ -20,12 +20,20 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_WORKLISTS_OBIM_H_
 #define GALOIS_LIBGALOIS_GALOIS_WORKLISTS_OBIM_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "galois/FlatMap.h"
 #include "galois/substrate/Barrier.h"
+#include "galois/substrate/PaddedLock.h"
 #include "galois/substrate/PerThreadStorage.h"
 #include "galois/substrate/TerminationDetection.h"
 #include "galois/worklists/Chunk.h"
@@ -110,6 +118,257 @@ struct OrderedByIntegerMetricComparator<Index, true> {
         earliest(std::numeric_limits<Index>::max()) {}
 };
 
+/**
+ * Registry of the buckets of an OrderedByIntegerMetric worklist.
+ *
+ * Buckets are recorded in an append-only log made of geometrically growing
+ * segments, so publishing a bucket never moves or locks existing entries, and
+ * threads replay the log into their local ordered maps only when they need to
+ * scan for work. An open-addressed table over the log entries gives O(1)
+ * lookup of the bucket for an index. Creation of a bucket is serialized only
+ * among indices that hash to the same shard.
+ *
+ * Entries whose bucket has been drained can be retired so that lookups stop
+ * matching them and a new entry is created for their index. Each thread
+ * releases a retired entry once it has moved the items it still holds in the
+ * bucket elsewhere; the bucket may only be reused after every thread has
+ * released it.
+ */
+template <typename Index, typename CTy, bool Concurrent>
+class OrderedByIntegerMetricRegistry : private boost::noncopyable {
+public:
+  struct Entry {
+    Index index;
+    std::atomic<CTy*> bucket;
+    std::atomic<bool> retired;
+    //! Number of threads that have released the entry after it was retired
+    std::atomic<unsigned> released;
+  };
+
+private:
+  //! Log segment s holds 2^(s + kFirstSegmentShift) entries
+  static constexpr unsigned kFirstSegmentShift = 6;
+  static constexpr unsigned kNumSegments = 48;
+  static constexpr unsigned kNumShards = 64;
+  static constexpr size_t kInitialTableSize = 1024;
+
+  struct Table {
+    size_t mask;
+    Table* older;
+    std::atomic<size_t> used;
+    std::unique_ptr<std::atomic<Entry*>[]> slots;
+
+    Table(size_t size, Table* o)
+        : mask(size - 1),
+          older(o),
+          used(0),
+          slots(new std::atomic<Entry*>[size]) {
+      for (size_t i = 0; i < size; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  std::array<std::atomic<Entry*>, kNumSegments> segments_;
+  std::atomic<size_t> reserved_;
+  std::atomic<Table*> table_;
+  std::array<substrate::PaddedLock<Concurrent>, kNumShards> shards_;
+  std::atomic<size_t> num_buckets_;
+
+  //! Mixes the bits of std::hash, which is the identity for integers, so
+  //! that runs of consecutive indices do not form long probe sequences
+  static size_t Hash(Index i) {
+    uint64_t h = std::hash<Index>{}(i);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  static std::pair<unsigned, size_t> Locate(size_t pos) {
+    size_t j = pos + (size_t{1} << kFirstSegmentShift);
+    unsigned top = (sizeof(unsigned long long) * 8 - 1) -
+                   __builtin_clzll(static_cast<unsigned long long>(j));
+    return {top - kFirstSegmentShift, j - (size_t{1} << top)};
+  }
+
+  Entry* GetSegment(unsigned seg, bool create) {
+    Entry* s = segments_[seg].load(std::memory_order_acquire);
+    if (s || !create) {
+      return s;
+    }
+    Entry* fresh = new Entry[size_t{1} << (seg + kFirstSegmentShift)]();
+    if (segments_[seg].compare_exchange_strong(
+            s, fresh, std::memory_order_acq_rel)) {
+      return fresh;
+    }
+    delete[] fresh;
+    return s;
+  }
+
+  Entry* Append(Index i, CTy* bucket) {
+    auto [seg, off] = Locate(reserved_.fetch_add(1));
+    Entry* e = &GetSegment(seg, true)[off];
+    e->index = i;
+    e->retired.store(false, std::memory_order_relaxed);
+    e->released.store(0, std::memory_order_relaxed);
+    e->bucket.store(bucket, std::memory_order_release);
+    return e;
+  }
+
+  void Grow(Table* t) {
+    Table* bigger = new Table(2 * (t->mask + 1), t);
+    size_t copied = 0;
+    // Lookups skip retired entries, so they are not copied
+    for (size_t s = 0; s <= t->mask; ++s) {
+      Entry* e = t->slots[s].load(std::memory_order_acquire);
+      if (e && !e->retired.load(std::memory_order_relaxed)) {
+        InsertInto(bigger, e);
+        ++copied;
+      }
+    }
+    bigger->used.store(copied, std::memory_order_relaxed);
+    if (!table_.compare_exchange_strong(t, bigger, std::memory_order_acq_rel)) {
+      delete bigger;
+    }
+  }
+
+  static void InsertInto(Table* t, Entry* e) {
+    for (size_t probe = Hash(e->index);; ++probe) {
+      Entry* expected = nullptr;
+      if (t->slots[probe & t->mask].compare_exchange_strong(
+              expected, e, std::memory_order_acq_rel)) {
+        return;
+      }
+    }
+  }
+
+  void Insert(Entry* e) {
+    // Tables are kept at most half full so that probe sequences always reach
+    // an empty slot; entries inserted into a table that is concurrently being
+    // replaced remain reachable through the older chain.
+    for (;;) {
+      Table* t = table_.load(std::memory_order_acquire);
+      if (t->used.fetch_add(1) + 1 > (t->mask + 1) / 2) {
+        Grow(t);
+        continue;
+      }
+      InsertInto(t, e);
+      return;
+    }
+  }
+
+public:
+  OrderedByIntegerMetricRegistry()
+      : reserved_(0),
+        table_(new Table(kInitialTableSize, nullptr)),
+        num_buckets_(0) {
+    for (auto& s : segments_) {
+      s.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ~OrderedByIntegerMetricRegistry() {
+    // Deallocate buckets in LIFO order to give opportunity for simple garbage
+    // collection. The buckets of retired entries are owned by the threads
+    // that retired them or by the entry that reused them.
+    for (size_t pos = reserved_.load(); pos > 0; --pos) {
+      auto [seg, off] = Locate(pos - 1);
+      Entry& e = segments_[seg].load()[off];
+      if (!e.retired.load()) {
+        delete e.bucket.load();
+      }
+    }
+    for (auto& s : segments_) {
+      delete[] s.load();
+    }
+    for (Table* t = table_.load(); t;) {
+      Table* older = t->older;
+      delete t;
+      t = older;
+    }
+  }
+
+  //! Returns the live entry for index i or nullptr if there is no bucket
+  //! for it
+  Entry* Find(Index i) const {
+    size_t h = Hash(i);
+    for (Table* t = table_.load(std::memory_order_acquire); t; t = t->older) {
+      for (size_t probe = h;; ++probe) {
+        Entry* e = t->slots[probe & t->mask].load(std::memory_order_acquire);
+        if (!e) {
+          break;
+        }
+        if (e->index == i && !e->retired.load(std::memory_order_acquire)) {
+          return e;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  //! Returns the entry for index i, creating it with the bucket returned by
+  //! take() if needed
+  template <typename F>
+  Entry* FindOrCreate(Index i, F take) {
+    if (Entry* e = Find(i)) {
+      return e;
+    }
+    auto& shard = shards_[Hash(i) % kNumShards];
+    shard.lock();
+    Entry* e = Find(i);
+    if (!e) {
+      e = Append(i, take());
+      Insert(e);
+    }
+    shard.unlock();
+    return e;
+  }
+
+  //! Allocates a bucket for an index that cannot reuse a retired one
+  CTy* NewBucket() {
+    num_buckets_.fetch_add(1, std::memory_order_relaxed);
+    return new CTy();
+  }
+
+  //! Retires entry e so that lookups no longer return it. Returns false if
+  //! it was already retired.
+  static bool Retire(Entry* e) {
+    return !e->retired.exchange(true, std::memory_order_acq_rel);
+  }
+
+  //! Returns the number of buckets allocated so far
+  size_t num_buckets() const {
+    return num_buckets_.load(std::memory_order_relaxed);
+  }
+
+  //! Calls fn(entry) for each published entry at or after log position
+  //! from, including retired ones, stopping at the first entry that is not
+  //! yet published.
+  //! Returns the position after the last entry visited.
+  template <typename F>
+  size_t Replay(size_t from, F fn) {
+    size_t end = reserved_.load(std::memory_order_acquire);
+    for (; from < end; ++from) {
+      auto [seg, off] = Locate(from);
+      Entry* s = GetSegment(seg, false);
+      if (!s) {
+        break;
+      }
+      if (!s[off].bucket.load(std::memory_order_acquire)) {
+        break;
+      }
+      fn(&s[off]);
+    }
+    return from;
+  }
+
+  //! Returns true if there may be entries at or after log position pos
+  bool HasNewer(size_t pos) const {
+    return pos != reserved_.load(std::memory_order_relaxed);
+  }
+};
+
 }  // namespace internal
 
 /**
@@ -231,48 +490,190 @@ private:
   typedef typename Container::template rethread<Concurrent> CTy;
   typedef internal::OrderedByIntegerMetricComparator<Index, UseDescending>
       Comparator;
-  typedef typename Comparator::template with_local_map<CTy*>::type LMapTy;
+  typedef internal::OrderedByIntegerMetricRegistry<Index, CTy, Concurrent>
+      Registry;
+  typedef typename Registry::Entry Entry;
+  typedef typename Comparator::template with_local_map<Entry*>::type LMapTy;
+
+  //! Number of recently used buckets each thread can look up without
+  //! touching shared state; indices are mapped to slots by their low bits so
+  //! the cache covers a sliding window of nearby priorities.
+  static constexpr size_t kWindowSize = 256;
 
   struct ThreadData : public internal::OrderedByIntegerMetricData<
                           T, Index, UseBarrier>::ThreadData {
     LMapTy local;
     Index curIndex;
     Index scanStart;
-    CTy* current;
-    unsigned int lastMasterVersion;
+    //! Read by other threads, which do not retire the current entry of a
+    //! thread
+    std::atomic<Entry*> current;
+    size_t lastMasterVersion;
     unsigned int numPops;
+    std::array<Entry*, kWindowSize> window;
+    //! Entries retired by this thread, with their buckets, that other
+    //! threads may still use
+    std::vector<std::pair<Entry*, CTy*>> limbo;
+    //! Scratch space for updateLocal
+    std::vector<std::pair<Index, Entry*>> fresh;
+    //! Items moved out of retired buckets, to be pushed again
+    std::vector<T> rescued;
 
     ThreadData(Index initial)
         : curIndex(initial),
           scanStart(initial),
-          current(0),
+          current(nullptr),
           lastMasterVersion(0),
-          numPops(0) {}
+          numPops(0) {
+      window.fill(nullptr);
+    }
+
+    ~ThreadData() {
+      for (auto& e : limbo) {
+        delete e.second;
+      }
+    }
   };
 
-  typedef std::deque<std::pair<Index, CTy*>> MasterLog;
+  //! Buckets of released entries, reused before allocating new ones. They are
+  //! shared by the threads of a package since the threads that release
+  //! buckets are not necessarily the ones that need new ones.
+  struct FreeList {
+    substrate::PaddedLock<Concurrent> lock;
+    std::vector<CTy*> buckets;
+
+    ~FreeList() {
+      for (CTy* b : buckets) {
+        delete b;
+      }
+    }
+  };
 
-  // NB: Place dynamically growing masterLog after fixed-size PerThreadStorage
+  // NB: Place dynamically growing registry after fixed-size PerThreadStorage
   // members to give higher likelihood of reclaiming PerThreadStorage
   substrate::PerThreadStorage<ThreadData> data;
-  substrate::PaddedLock<Concurrent> masterLock;
-  MasterLog masterLog;
-
-  std::atomic<unsigned int> masterVersion;
+  substrate::PerSocketStorage<FreeList> freeLists;
+  Registry registry;
   Indexer indexer;
 
+  CTy* takeBucket() {
+    FreeList& f = *freeLists.getLocal();
+    CTy* b = nullptr;
+    f.lock.lock();
+    if (!f.buckets.empty()) {
+      b = f.buckets.back();
+      f.buckets.pop_back();
+    }
+    f.lock.unlock();
+    return b ? b : registry.NewBucket();
+  }
+
+  //! Stops this thread from using the retired entry e. Items this thread
+  //! still holds in its bucket, which other threads cannot pop, are moved to
+  //! the rescued list.
+  void release(ThreadData& p, Entry* e) {
+    if (p.current.load(std::memory_order_relaxed) == e) {
+      p.current.store(nullptr, std::memory_order_relaxed);
+    }
+    CTy* b = e->bucket.load(std::memory_order_relaxed);
+    while (galois::optional<value_type> item = b->pop()) {
+      p.rescued.push_back(*item);
+    }
+    e->released.fetch_add(1, std::memory_order_release);
+  }
+
+  //! Retires the drained entry e unless another thread is pushing to it as
+  //! its current entry. Returns whether e is retired.
+  bool retire(ThreadData& p, Entry* e) {
+    if (e->retired.load(std::memory_order_acquire)) {
+      return true;
+    }
+    for (unsigned i = 0; i < runtime::activeThreads; ++i) {
+      ThreadData& o = *data.getRemote(i);
+      if (&o != &p && o.current.load(std::memory_order_relaxed) == e) {
+        return false;
+      }
+    }
+    if (Registry::Retire(e)) {
+      p.limbo.emplace_back(e, e->bucket.load(std::memory_order_relaxed));
+    }
+    return true;
+  }
+
+  //! Moves the buckets of entries that every thread has released to the
+  //! free list and pushes rescued items again
+  void recycle(ThreadData& p) {
+    FreeList* f = nullptr;
+    for (size_t i = 0; i < p.limbo.size();) {
+      auto [e, bucket] = p.limbo[i];
+      if (e->released.load(std::memory_order_acquire) <
+          runtime::activeThreads) {
+        ++i;
+        continue;
+      }
+      if (!f) {
+        f = freeLists.getLocal();
+        f->lock.lock();
+      }
+      f->buckets.push_back(bucket);
+      p.limbo[i] = p.limbo.back();
+      p.limbo.pop_back();
+    }
+    if (f) {
+      f->lock.unlock();
+    }
+    while (!p.rescued.empty()) {
+      push(p.rescued.back());
+      p.rescued.pop_back();
+    }
+  }
+
   bool updateLocal(ThreadData& p) {
-    if (p.lastMasterVersion != masterVersion.load(std::memory_order_relaxed)) {
-      for (;
-           p.lastMasterVersion < masterVersion.load(std::memory_order_relaxed);
-           ++p.lastMasterVersion) {
-        std::pair<Index, CTy*> logEntry = masterLog[p.lastMasterVersion];
-        p.local[logEntry.first] = logEntry.second;
-        assert(logEntry.second);
+    if (!registry.HasNewer(p.lastMasterVersion)) {
+      return false;
+    }
+    p.fresh.clear();
+    p.lastMasterVersion =
+        registry.Replay(p.lastMasterVersion, [this, &p](Entry* e) {
+          if (e->retired.load(std::memory_order_acquire)) {
+            release(p, e);
+          } else {
+            p.fresh.emplace_back(e->index, e);
+          }
+        });
+    bool updated = !p.fresh.empty();
+    // An entry is only created for an index after its previous entry was
+    // retired, so an entry replaced by a newer one for the same index is
+    // released
+    if (p.fresh.size() < 16) {
+      for (auto& e : p.fresh) {
+        Entry*& slot = p.local[e.first];
+        if (slot) {
+          release(p, slot);
+        }
+        slot = e.second;
+      }
+    } else {
+      // Merging a large batch one entry at a time is quadratic in a flat map,
+      // so rebuild the map instead
+      p.fresh.insert(p.fresh.end(), p.local.begin(), p.local.end());
+      std::sort(p.fresh.begin(), p.fresh.end(), [this](auto& a, auto& b) {
+        return this->compare(a.first, b.first);
+      });
+      p.local.clear();
+      for (auto& e : p.fresh) {
+        if (p.local.empty() || p.local.rbegin()->first != e.first) {
+          p.local.emplace(e);
+          continue;
+        }
+        Entry*& slot = p.local.rbegin()->second;
+        if (slot->retired.load(std::memory_order_acquire)) {
+          std::swap(slot, e.second);
+        }
+        release(p, e.second);
       }
-      return true;
     }
-    return false;
+    return updated;
   }
 
   GALOIS_ATTRIBUTE_NOINLINE
@@ -297,65 +698,76 @@ private:
       }
     }
 
-    for (auto ii = p.local.lower_bound(msS), ei = p.local.end(); ii != ei;
-         ++ii) {
-      galois::optional<T> item;
-      if ((item = ii->second->pop())) {
-        p.current = ii->second;
-        p.curIndex = ii->first;
-        p.scanStart = ii->first;
-        return item;
+    // Retired entries are released and then removed from the local map.
+    // Entries before the scan start are not scanned for work, but retired
+    // ones are still released so that their buckets can be reused.
+    bool released = false;
+    auto first = p.local.lower_bound(msS);
+    for (auto ii = p.local.begin(); ii != first; ++ii) {
+      if (ii->second->retired.load(std::memory_order_acquire)) {
+        release(p, ii->second);
+        ii->second = nullptr;
+        released = true;
+      }
+    }
+
+    galois::optional<T> item;
+    Entry* found = nullptr;
+    for (auto ii = first, ei = p.local.end(); ii != ei; ++ii) {
+      Entry* e = ii->second;
+      if (!e->retired.load(std::memory_order_acquire) &&
+          (item = e->bucket.load(std::memory_order_relaxed)->pop())) {
+        found = e;
+        break;
       }
+      // Retire drained buckets so that later priorities reuse them. With a
+      // barrier, empty() still looks up stored indices in the local map, so
+      // buckets are kept.
+      if (!UseBarrier && retire(p, e)) {
+        release(p, e);
+        ii->second = nullptr;
+        released = true;
+      }
+    }
+    if (released) {
+      p.local.erase(
+          std::remove_if(
+              p.local.begin(), p.local.end(),
+              [](const auto& e) { return !e.second; }),
+          p.local.end());
     }
 
-    return galois::optional<value_type>();
+    if (found) {
+      p.current.store(found, std::memory_order_relaxed);
+      p.curIndex = found->index;
+      p.scanStart = found->index;
+    } else if (!p.rescued.empty()) {
+      item = p.rescued.back();
+      p.rescued.pop_back();
+    }
+    recycle(p);
+    return item;
   }
 
   GALOIS_ATTRIBUTE_NOINLINE
-  CTy* slowUpdateLocalOrCreate(ThreadData& p, Index i) {
-    // update local until we find it or we get the write lock
-    do {
-      updateLocal(p);
-      auto it = p.local.find(i);
-      if (it != p.local.end())
-        return it->second;
-    } while (!masterLock.try_lock());
-    // we have the write lock, update again then create
-    updateLocal(p);
-    auto it = p.local.find(i);
-    CTy* C2 = (it != p.local.end()) ? it->second : nullptr;
-    if (!C2) {
-      C2 = new CTy();
-      p.local[i] = C2;
-      p.lastMasterVersion = masterVersion.load(std::memory_order_relaxed) + 1;
-      masterLog.push_back(std::make_pair(i, C2));
-      masterVersion.fetch_add(1);
-    }
-    masterLock.unlock();
-    return C2;
+  Entry* slowUpdateLocalOrCreate(ThreadData& p, Index i) {
+    Entry* e = registry.FindOrCreate(i, [this] { return takeBucket(); });
+    p.window[std::hash<Index>{}(i) % kWindowSize] = e;
+    return e;
   }
 
-  inline CTy* updateLocalOrCreate(ThreadData& p, Index i) {
-    // Try local then try update then find again or else create and update the
-    // master log
-    auto it = p.local.find(i);
-    if (it != p.local.end())
-      return it->second;
+  inline Entry* updateLocalOrCreate(ThreadData& p, Index i) {
+    // Try the local window, then the shared registry, or else create
+    Entry* e = p.window[std::hash<Index>{}(i) % kWindowSize];
+    if (e && e->index == i && !e->retired.load(std::memory_order_relaxed))
+      return e;
     // slowpath
     return slowUpdateLocalOrCreate(p, i);
   }
 
 public:
   OrderedByIntegerMetric(const Indexer& x = Indexer())
-      : data(this->earliest), masterVersion(0), indexer(x) {}
-
-  ~OrderedByIntegerMetric() {
-    // Deallocate in LIFO order to give opportunity for simple garbage
-    // collection
-    for (auto ii = masterLog.rbegin(), ei = masterLog.rend(); ii != ei; ++ii) {
-      delete ii->second;
-    }
-  }
+      : data(this->earliest), indexer(x) {}
 
   void push(const value_type& val) {
     Index index = indexer(val);
@@ -364,23 +776,29 @@ public:
     assert(!UseMonotonic || this->compare(p.curIndex, index));
 
     // Fast path
-    if (index == p.curIndex && p.current) {
-      p.current->push(val);
+    Entry* C = p.current.load(std::memory_order_relaxed);
+    if (index == p.curIndex && C &&
+        !C->retired.load(std::memory_order_relaxed)) {
+      C->bucket.load(std::memory_order_relaxed)->push(val);
       return;
     }
 
     // Slow path
-    CTy* C = updateLocalOrCreate(p, index);
+    C = updateLocalOrCreate(p, index);
     if (BSP && this->compare(index, p.scanStart))
       p.scanStart = index;
     // Opportunistically move to higher priority work
-    if (!UseBarrier && this->compare(index, p.curIndex)) {
+    if (!UseBarrier && !this->compare(p.curIndex, index)) {
       p.curIndex = index;
-      p.current = C;
+      p.current.store(C, std::memory_order_relaxed);
     }
-    C->push(val);
+    C->bucket.load(std::memory_order_relaxed)->push(val);
   }
 
+  //! Returns the number of bucket containers allocated so far; drained
+  //! buckets are reused rather than counted again
+  size_t num_buckets() const { return registry.num_buckets(); }
+
   template <typename Iter>
   void push(Iter b, Iter e) {
     while (b != e)
@@ -395,7 +813,7 @@ public:
   galois::optional<value_type> pop() {
     // Find a successful pop
     ThreadData& p = *data.getLocal();
-    CTy* C = p.current;
+    Entry* C = p.current.load(std::memory_order_relaxed);
 
     if (this->hasStored(p, p.curIndex))
       return this->popStored(p, p.curIndex);
@@ -405,7 +823,7 @@ public:
       return slowPop(p);
 
     galois::optional<value_type> item;
-    if (C && (item = C->pop()))
+    if (C && (item = C->bucket.load(std::memory_order_relaxed)->pop()))
       return item;
 
     if (UseBarrier)
@@ -434,7 +852,7 @@ public:
         }
       }
       p.curIndex = storedIndex;
-      p.current = p.local[storedIndex];
+      p.current.store(p.local[storedIndex], std::memory_order_relaxed);
     }
     p.hasWork = !p.stored.empty();
 
@@ -443,20 +861,20 @@ public:
     // align with the earliest level from threads that have works
     bool hasWork = p.hasWork;
     Index curIndex = (hasWork) ? p.curIndex : this->identity;
-    CTy* C = (hasWork) ? p.current : nullptr;
+    Entry* C = (hasWork) ? p.current.load(std::memory_order_relaxed) : nullptr;
 
     for (unsigned i = 0; i < runtime::activeThreads; ++i) {
       ThreadData& o = *data.getRemote(i);
       if (o.hasWork && this->compare(o.curIndex, curIndex)) {
         curIndex = o.curIndex;
-        C = o.current;
+        C = o.current.load(std::memory_order_relaxed);
       }
       hasWork |= o.hasWork;
     }
 
     this->barrier.Wait();
 
-    p.current = C;
+    p.current.store(C, std::memory_order_relaxed);
     p.curIndex = curIndex;
 
     if (UseMonotonic) {
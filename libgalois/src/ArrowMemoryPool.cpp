@@ -0,0 +1,158 @@
+#include "galois/ArrowMemoryPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
+#include "galois/Threads.h"
+#include "galois/substrate/NumaMem.h"
+#include "galois/substrate/PageAlloc.h"
+#include "galois/substrate/ThreadPool.h"
+
+namespace {
+
+// Arrow hands out this address for empty buffers rather than a null pointer
+alignas(64) uint8_t zero_size_area[1];
+
+bool
+IsLarge(int64_t size) {
+  return size >= galois::ArrowMemoryPool::kLargeAllocation;
+}
+
+// Large allocations are made in whole huge pages
+size_t
+LargeCapacity(int64_t size) {
+  size_t page = galois::substrate::allocSize();
+  return (size + page - 1) / page * page;
+}
+
+}  // namespace
+
+void*
+galois::ArrowMemoryPool::AllocateLarge(int64_t size) {
+  substrate::LAptr ptr;
+  unsigned num_threads = galois::getActiveThreads();
+  if (num_threads > 1 && substrate::CanRunThreadPool()) {
+    if (placement_ == Placement::kBlocked) {
+      ptr = substrate::largeMallocBlocked(size, num_threads);
+    } else {
+      ptr = substrate::largeMallocInterleaved(size, num_threads);
+    }
+  } else {
+    ptr = substrate::largeMallocLocal(size);
+  }
+  // Freed by size in Free
+  return ptr.release();
+}
+
+void
+galois::ArrowMemoryPool::UpdateAllocated(int64_t diff) {
+  int64_t allocated = bytes_allocated_ += diff;
+  int64_t max = max_memory_.load(std::memory_order_relaxed);
+  while (allocated > max &&
+         !max_memory_.compare_exchange_weak(max, allocated)) {
+  }
+}
+
+arrow::Status
+galois::ArrowMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (size < 0) {
+    return arrow::Status::Invalid("negative allocation size");
+  }
+  if (size == 0) {
+    *out = zero_size_area;
+    return arrow::Status::OK();
+  }
+
+  if (auto res = MemoryReserve(MemoryCategory::kProperties, size); !res) {
+    return arrow::Status::OutOfMemory(
+        "allocating ", size, " bytes: ", res.error().message());
+  }
+
+  if (IsLarge(size)) {
+    void* ptr = AllocateLarge(size);
+    if (!ptr) {
+      MemoryRelease(MemoryCategory::kProperties, size);
+      return arrow::Status::OutOfMemory("failed to allocate ", size, " bytes");
+    }
+    *out = static_cast<uint8_t*>(ptr);
+  } else if (auto st = arrow::default_memory_pool()->Allocate(size, out);
+             !st.ok()) {
+    MemoryRelease(MemoryCategory::kProperties, size);
+    return st;
+  }
+
+  UpdateAllocated(size);
+  return arrow::Status::OK();
+}
+
+arrow::Status
+galois::ArrowMemoryPool::Reallocate(
+    int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  if (new_size < 0) {
+    return arrow::Status::Invalid("negative allocation size");
+  }
+
+  // Growing within the huge pages of a large allocation is free
+  bool in_place = IsLarge(old_size) && IsLarge(new_size) &&
+                  LargeCapacity(old_size) == LargeCapacity(new_size);
+  bool small = !IsLarge(old_size) && !IsLarge(new_size) && old_size > 0 &&
+               new_size > 0;
+  if (in_place || small) {
+    int64_t growth = new_size - old_size;
+    if (growth > 0) {
+      if (auto res = MemoryReserve(MemoryCategory::kProperties, growth); !res) {
+        return arrow::Status::OutOfMemory(
+            "allocating ", new_size, " bytes: ", res.error().message());
+      }
+    }
+
+    if (small) {
+      if (auto st = arrow::default_memory_pool()->Reallocate(
+              old_size, new_size, ptr);
+          !st.ok()) {
+        if (growth > 0) {
+          MemoryRelease(MemoryCategory::kProperties, growth);
+        }
+        return st;
+      }
+    }
+
+    if (growth < 0) {
+      MemoryRelease(MemoryCategory::kProperties, -growth);
+    }
+    UpdateAllocated(growth);
+    return arrow::Status::OK();
+  }
+
+  uint8_t* out{};
+  ARROW_RETURN_NOT_OK(Allocate(new_size, &out));
+  std::memcpy(out, *ptr, std::min(old_size, new_size));
+  Free(*ptr, old_size);
+  *ptr = out;
+  return arrow::Status::OK();
+}
+
+void
+galois::ArrowMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  if (size == 0) {
+    GALOIS_LOG_ASSERT(buffer == zero_size_area);
+    return;
+  }
+
+  if (IsLarge(size)) {
+    substrate::internal::largeFreer{LargeCapacity(size)}(buffer);
+  } else {
+    arrow::default_memory_pool()->Free(buffer, size);
+  }
+
+  MemoryRelease(MemoryCategory::kProperties, size);
+  UpdateAllocated(-size);
+}
+
+galois::ArrowMemoryPool*
+galois::GetArrowMemoryPool() {
+  static ArrowMemoryPool* pool = new ArrowMemoryPool();
+  return pool;
+}
@@ -17,6 +17,7 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include "galois/Trace.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/ThreadPool.h"
@@ -44,6 +45,7 @@ public:
   void Reinit(unsigned val) override { _reinit(val); }
 
   void Wait() override {
+    galois::TraceScope trace(name(), galois::TraceCategory::kBarrier);
     bool& lsense =
         local_sense_.at(galois::substrate::ThreadPool::getTID()).get();
     lsense = !lsense;
@@ -25,6 +25,7 @@
 #include <parquet/arrow/writer.h>
 
 #include "galois/ArrowInterchange.h"
+#include "galois/ArrowMemoryPool.h"
 #include "galois/ErrorCode.h"
 #include "galois/Galois.h"
 #include "galois/Logging.h"
@@ -97,7 +98,7 @@ AddNullArrays(
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* null_map,
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* lists_null_map,
     size_t elts) {
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetArrowMemoryPool();
 
   // the builder types are still added for the list types since the list type is
   // extraneous info
@@ -123,7 +124,7 @@ AddNullArrays(
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* null_map,
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* lists_null_map,
     size_t elts, std::shared_ptr<arrow::DataType> type) {
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetArrowMemoryPool();
 
   // the builder types are still added for the list types since the list type is
   // extraneous info
@@ -930,7 +931,7 @@ ArrowArrays
 RearrangeListArray(
     const std::shared_ptr<arrow::ChunkedArray>& list_chunked_array,
     const std::vector<size_t>& mapping, WriterProperties* properties) {
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetArrowMemoryPool();
   ArrowArrays chunks;
   auto list_type =
       std::static_pointer_cast<arrow::BaseListType>(list_chunked_array->type())
@@ -1064,7 +1065,7 @@ RearrangeTable(
         }
         case arrow::Type::TIMESTAMP: {
           auto tb = std::make_shared<arrow::TimestampBuilder>(
-              array->type(), arrow::default_memory_pool());
+              array->type(), galois::GetArrowMemoryPool());
           ca = RearrangeArray<arrow::TimestampBuilder, arrow::TimestampArray>(
               tb, array, mapping, properties);
           break;
@@ -1393,7 +1394,7 @@ galois::PropertyGraphBuilder::AddBuilder(const PropertyKey& key) {
   PropertiesState* properties =
       key.for_node ? &node_properties_ : &edge_properties_;
 
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetArrowMemoryPool();
   if (!key.is_list) {
     switch (key.type) {
     case ImportDataType::kString: {
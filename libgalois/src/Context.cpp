@@ -21,8 +21,13 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+
+#include "galois/Statistics.h"
 #include "galois/substrate/CacheLineStorage.h"
+#include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/SimpleLock.h"
+#include "galois/substrate/ThreadPool.h"
 
 //! Global thread context for each active thread
 static thread_local galois::runtime::SimpleRuntimeContext* thread_ctx = 0;
@@ -93,3 +98,178 @@ galois::runtime::SimpleRuntimeContext::subAcquire(
     galois::runtime::Lockable*, galois::MethodFlag) {
   GALOIS_DIE("unreachable");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// StripedLockTable & StripedRuntimeContext
+////////////////////////////////////////////////////////////////////////////////
+
+galois::runtime::StripedLockTable::StripedLockTable(uint32_t num_stripes)
+    : num_threads_(substrate::GetThreadPool().getMaxThreads()) {
+  unsigned bits = 1;
+  while ((uint32_t(1) << bits) < num_stripes) {
+    ++bits;
+  }
+  shift_ = 64 - bits;
+  owners_ = std::make_unique<std::atomic<uint32_t>[]>(NumStripes());
+  conflicts_ = std::make_unique<std::atomic<uint32_t>[]>(NumStripes());
+  for (uint32_t i = 0; i < NumStripes(); ++i) {
+    owners_[i].store(0, std::memory_order_relaxed);
+    conflicts_[i].store(0, std::memory_order_relaxed);
+  }
+  stats_ = std::make_unique<substrate::CacheLineStorage<ThreadStats>[]>(
+      num_threads_);
+}
+
+void
+galois::runtime::StripedLockTable::RecordConflict(
+    uint32_t stripe, ThreadStats& stats) {
+  if (conflicts_[stripe].fetch_add(1, std::memory_order_relaxed) == 0) {
+    stats.contended.push_back(stripe);
+  }
+}
+
+uint64_t
+galois::runtime::StripedLockTable::NumCommits() const {
+  uint64_t ret = 0;
+  for (unsigned i = 0; i < num_threads_; ++i) {
+    ret += stats_[i].data.commits;
+  }
+  return ret;
+}
+
+uint64_t
+galois::runtime::StripedLockTable::NumAborts() const {
+  uint64_t ret = 0;
+  for (unsigned i = 0; i < num_threads_; ++i) {
+    ret += stats_[i].data.aborts;
+  }
+  return ret;
+}
+
+void
+galois::runtime::StripedLockTable::ReportStats(const char* loopname) const {
+  uint64_t num_contended = 0;
+  uint32_t max_conflicts = 0;
+  for (unsigned i = 0; i < num_threads_; ++i) {
+    const auto& contended = stats_[i].data.contended;
+    num_contended += contended.size();
+    for (uint32_t stripe : contended) {
+      max_conflicts = std::max(
+          max_conflicts, conflicts_[stripe].load(std::memory_order_relaxed));
+    }
+  }
+
+  uint64_t commits = NumCommits();
+  uint64_t aborts = NumAborts();
+  double abort_rate =
+      commits + aborts ? double(aborts) / double(commits + aborts) : 0.0;
+
+  ReportStatSingle(loopname, "AbortRate", abort_rate);
+  ReportStatSingle(loopname, "ContendedStripes", num_contended);
+  ReportStatSingle(loopname, "MaxStripeConflicts", max_conflicts);
+}
+
+void
+galois::runtime::StripedLockTable::Reset() {
+  for (unsigned i = 0; i < num_threads_; ++i) {
+    auto& stats = stats_[i].data;
+    for (uint32_t stripe : stats.contended) {
+      conflicts_[stripe].store(0, std::memory_order_relaxed);
+    }
+    stats.contended.clear();
+    stats.commits = 0;
+    stats.aborts = 0;
+  }
+}
+
+galois::runtime::StripedLockTable&
+galois::runtime::GetStripedLockTable() {
+  static StripedLockTable table;
+  return table;
+}
+
+galois::runtime::StripedRuntimeContext::StripedRuntimeContext(
+    StripedLockTable& table)
+    : SimpleRuntimeContext(true),
+      table_(table),
+      stats_(table.stats_[substrate::ThreadPool::getTID()].data),
+      id_(substrate::ThreadPool::getTID() + 1),
+      seed_(0x9E3779B97F4A7C15 * id_) {}
+
+bool
+galois::runtime::StripedRuntimeContext::tryOwn(uint32_t stripe) {
+  uint32_t expected = 0;
+  if (table_.owners_[stripe].compare_exchange_strong(
+          expected, id_, std::memory_order_acquire)) {
+    held_.push_back(stripe);
+    return true;
+  }
+  return false;
+}
+
+void
+galois::runtime::StripedRuntimeContext::subAcquire(
+    galois::runtime::Lockable* lockable, galois::MethodFlag) {
+  uint32_t stripe = table_.StripeOf(lockable);
+  auto& owner = table_.owners_[stripe];
+  uint32_t cur = owner.load(std::memory_order_relaxed);
+  if (cur == id_ || (!cur && tryOwn(stripe))) {
+    return;
+  }
+
+  table_.RecordConflict(stripe, stats_);
+
+  // Wait-die: only wait on iterations of strictly lower priority
+  int priority = stats_.priority.load(std::memory_order_relaxed);
+  for (unsigned i = 0; i < kMaxWaitPauses; ++i) {
+    cur = owner.load(std::memory_order_relaxed);
+    if (!cur) {
+      if (tryOwn(stripe)) {
+        return;
+      }
+      continue;
+    }
+    auto& other = table_.stats_[cur - 1].data;
+    if (other.priority.load(std::memory_order_relaxed) >= priority) {
+      break;
+    }
+    substrate::asmPause();
+  }
+
+  signalConflict(lockable);
+}
+
+void
+galois::runtime::StripedRuntimeContext::releaseAll() {
+  for (uint32_t stripe : held_) {
+    table_.owners_[stripe].store(0, std::memory_order_release);
+  }
+  held_.clear();
+}
+
+unsigned
+galois::runtime::StripedRuntimeContext::commitIteration() {
+  unsigned num_locks = held_.size();
+  releaseAll();
+  ++stats_.commits;
+  return num_locks;
+}
+
+unsigned
+galois::runtime::StripedRuntimeContext::cancelIteration() {
+  unsigned num_locks = held_.size();
+  releaseAll();
+  ++stats_.aborts;
+
+  // Randomized exponential backoff (xorshift64)
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 7;
+  seed_ ^= seed_ << 17;
+  int shift = std::min(
+      stats_.priority.load(std::memory_order_relaxed) + 1, kMaxBackoffShift);
+  uint64_t pauses = seed_ & ((uint64_t(1) << shift) - 1);
+  for (uint64_t i = 0; i < pauses; ++i) {
+    substrate::asmPause();
+  }
+  return num_locks;
+}
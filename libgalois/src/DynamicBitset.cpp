@@ -23,26 +23,264 @@
 
 #include "galois/DynamicBitset.h"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define GALOIS_BITSET_X86_KERNELS
+#endif
+
 #include "galois/Galois.h"
 
 GALOIS_EXPORT galois::DynamicBitset galois::EmptyBitset;
 
+namespace {
+
+// Bulk operations view the atomic words as plain words. They all assume that
+// the bitset is not concurrently updated with set() or reset().
+static_assert(
+    sizeof(galois::CopyableAtomic<uint64_t>) == sizeof(uint64_t),
+    "bitset words must be layout compatible with uint64_t");
+
+enum class BitOp { kOr, kAnd, kXor, kAndNot };
+
+template <BitOp op>
+inline uint64_t
+Apply(uint64_t a, uint64_t b) {
+  switch (op) {
+  case BitOp::kOr:
+    return a | b;
+  case BitOp::kAnd:
+    return a & b;
+  case BitOp::kXor:
+    return a ^ b;
+  case BitOp::kAndNot:
+    return a & ~b;
+  }
+  return 0;
+}
+
+uint64_t
+PopcountScalar(const uint64_t* words, size_t n) {
+  uint64_t ret = 0;
+  for (size_t i = 0; i < n; ++i) {
+#ifdef __GNUC__
+    ret += __builtin_popcountll(words[i]);
+#else
+    uint64_t v = words[i];
+    v = v - ((v >> 1) & 0x5555555555555555UL);
+    v = (v & 0x3333333333333333UL) + ((v >> 2) & 0x3333333333333333UL);
+    ret += (((v + (v >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >> 56;
+#endif
+  }
+  return ret;
+}
+
+template <BitOp op>
+void
+BinaryScalar(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = Apply<op>(a[i], b[i]);
+  }
+}
+
+#ifdef GALOIS_BITSET_X86_KERNELS
+
+// Nibble lookup popcount (Mula et al.), summed per 64-bit lane with vpsadbw
+__attribute__((target("avx2"))) uint64_t
+PopcountAvx2(const uint64_t* words, size_t n) {
+  const __m256i lookup = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3,
+      1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+    __m256i hi = _mm256_shuffle_epi8(
+        lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+    acc = _mm256_add_epi64(
+        acc,
+        _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+  }
+  uint64_t ret = static_cast<uint64_t>(_mm256_extract_epi64(acc, 0)) +
+                 static_cast<uint64_t>(_mm256_extract_epi64(acc, 1)) +
+                 static_cast<uint64_t>(_mm256_extract_epi64(acc, 2)) +
+                 static_cast<uint64_t>(_mm256_extract_epi64(acc, 3));
+  return ret + PopcountScalar(words + i, n - i);
+}
+
+template <BitOp op>
+__attribute__((target("avx2"))) void
+BinaryAvx2(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i r;
+    switch (op) {
+    case BitOp::kOr:
+      r = _mm256_or_si256(x, y);
+      break;
+    case BitOp::kAnd:
+      r = _mm256_and_si256(x, y);
+      break;
+    case BitOp::kXor:
+      r = _mm256_xor_si256(x, y);
+      break;
+    case BitOp::kAndNot:
+      r = _mm256_andnot_si256(y, x);
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+  }
+  BinaryScalar<op>(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) uint64_t
+PopcountAvx512(const uint64_t* words, size_t n) {
+  __m512i acc = _mm512_setzero_si512();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm512_add_epi64(
+        acc, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+  }
+  uint64_t lanes[8];
+  _mm512_storeu_si512(lanes, acc);
+  uint64_t ret = 0;
+  for (uint64_t lane : lanes) {
+    ret += lane;
+  }
+  return ret + PopcountScalar(words + i, n - i);
+}
+
+template <BitOp op>
+__attribute__((target("avx512f"))) void
+BinaryAvx512(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    __m512i y = _mm512_loadu_si512(b + i);
+    __m512i r;
+    switch (op) {
+    case BitOp::kOr:
+      r = _mm512_or_si512(x, y);
+      break;
+    case BitOp::kAnd:
+      r = _mm512_and_si512(x, y);
+      break;
+    case BitOp::kXor:
+      r = _mm512_xor_si512(x, y);
+      break;
+    case BitOp::kAndNot:
+      r = _mm512_and_si512(x, _mm512_xor_si512(y, _mm512_set1_epi64(-1)));
+      break;
+    }
+    _mm512_storeu_si512(dst + i, r);
+  }
+  BinaryScalar<op>(dst + i, a + i, b + i, n - i);
+}
+
+#endif
+
+using PopcountFn = uint64_t (*)(const uint64_t*, size_t);
+using BinaryFn = void (*)(uint64_t*, const uint64_t*, const uint64_t*, size_t);
+
+//! Kernels for the widest instruction set supported by the running CPU
+struct Kernels {
+  PopcountFn popcount{PopcountScalar};
+  BinaryFn binary[4]{
+      BinaryScalar<BitOp::kOr>, BinaryScalar<BitOp::kAnd>,
+      BinaryScalar<BitOp::kXor>, BinaryScalar<BitOp::kAndNot>};
+
+  Kernels() {
+#ifdef GALOIS_BITSET_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      popcount = PopcountAvx2;
+      binary[0] = BinaryAvx2<BitOp::kOr>;
+      binary[1] = BinaryAvx2<BitOp::kAnd>;
+      binary[2] = BinaryAvx2<BitOp::kXor>;
+      binary[3] = BinaryAvx2<BitOp::kAndNot>;
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+      binary[0] = BinaryAvx512<BitOp::kOr>;
+      binary[1] = BinaryAvx512<BitOp::kAnd>;
+      binary[2] = BinaryAvx512<BitOp::kXor>;
+      binary[3] = BinaryAvx512<BitOp::kAndNot>;
+      if (__builtin_cpu_supports("avx512vpopcntdq")) {
+        popcount = PopcountAvx512;
+      }
+    }
+#endif
+  }
+};
+
+const Kernels&
+GetKernels() {
+  static Kernels kernels;
+  return kernels;
+}
+
+//! Number of words processed by one task of a parallel bitset operation
+constexpr size_t kBlockWords = galois::DynamicBitset::kWordsPerBlock;
+
+size_t
+NumBlocks(size_t num_words) {
+  return (num_words + kBlockWords - 1) / kBlockWords;
+}
+
+const uint64_t*
+Words(const galois::DynamicBitset& bitset) {
+  return reinterpret_cast<const uint64_t*>(bitset.get_vec().begin());
+}
+
+uint64_t*
+Words(galois::DynamicBitset& bitset) {
+  return reinterpret_cast<uint64_t*>(bitset.get_vec().begin());
+}
+
+void
+Binary(
+    BitOp op, galois::DynamicBitset* dst, const galois::DynamicBitset& a,
+    const galois::DynamicBitset& b) {
+  BinaryFn fn = GetKernels().binary[static_cast<int>(op)];
+  size_t num_words = dst->get_vec().size();
+  uint64_t* d = Words(*dst);
+  const uint64_t* x = Words(a);
+  const uint64_t* y = Words(b);
+  galois::do_all(
+      galois::iterate(size_t{0}, NumBlocks(num_words)),
+      [&](size_t block) {
+        size_t begin = block * kBlockWords;
+        size_t end = std::min(num_words, begin + kBlockWords);
+        fn(d + begin, x + begin, y + begin, end - begin);
+      },
+      galois::no_stats());
+}
+
+}  // namespace
+
+void
+galois::DynamicBitset::reset() {
+  if (!bitvec.empty()) {
+    std::memset(Words(*this), 0, bitvec.size() * sizeof(uint64_t));
+  }
+}
+
 void
 galois::DynamicBitset::bitwise_or(const DynamicBitset& other) {
   assert(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] |= other_bitvec[i]; }, galois::no_stats());
+  Binary(BitOp::kOr, this, *this, other);
 }
 
 void
 galois::DynamicBitset::bitwise_and(const DynamicBitset& other) {
   assert(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] &= other_bitvec[i]; }, galois::no_stats());
+  Binary(BitOp::kAnd, this, *this, other);
 }
 
 void
@@ -50,22 +288,27 @@ galois::DynamicBitset::bitwise_and(
     const DynamicBitset& other1, const DynamicBitset& other2) {
   assert(size() == other1.size());
   assert(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
+  Binary(BitOp::kAnd, this, other1, other2);
+}
 
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = other_bitvec1[i] & other_bitvec2[i]; },
-      galois::no_stats());
+void
+galois::DynamicBitset::bitwise_andnot(const DynamicBitset& other) {
+  assert(size() == other.size());
+  Binary(BitOp::kAndNot, this, *this, other);
+}
+
+void
+galois::DynamicBitset::bitwise_andnot(
+    const DynamicBitset& other1, const DynamicBitset& other2) {
+  assert(size() == other1.size());
+  assert(size() == other2.size());
+  Binary(BitOp::kAndNot, this, other1, other2);
 }
 
 void
 galois::DynamicBitset::bitwise_xor(const DynamicBitset& other) {
   assert(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] ^= other_bitvec[i]; }, galois::no_stats());
+  Binary(BitOp::kXor, this, *this, other);
 }
 
 void
@@ -73,29 +316,25 @@ galois::DynamicBitset::bitwise_xor(
     const DynamicBitset& other1, const DynamicBitset& other2) {
   assert(size() == other1.size());
   assert(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
-
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = other_bitvec1[i] ^ other_bitvec2[i]; },
-      galois::no_stats());
+  Binary(BitOp::kXor, this, other1, other2);
 }
 
 uint64_t
 galois::DynamicBitset::count() const {
+  PopcountFn fn = GetKernels().popcount;
+  size_t num_words = bitvec.size();
+  const uint64_t* words = Words(*this);
+  if (num_words <= kBlockWords) {
+    return fn(words, num_words);
+  }
+
   galois::GAccumulator<uint64_t> ret;
   galois::do_all(
-      galois::iterate(bitvec.begin(), bitvec.end()),
-      [&](uint64_t n) {
-#ifdef __GNUC__
-        ret += __builtin_popcountll(n);
-#else
-        n = n - ((n >> 1) & 0x5555555555555555UL);
-        n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
-        ret += (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >>
-               56;
-#endif
+      galois::iterate(size_t{0}, NumBlocks(num_words)),
+      [&](size_t block) {
+        size_t begin = block * kBlockWords;
+        size_t end = std::min(num_words, begin + kBlockWords);
+        ret += fn(words + begin, end - begin);
       },
       galois::no_stats());
   return ret.reduce();
@@ -105,61 +344,49 @@ namespace {
 template <typename Integer>
 std::vector<Integer>
 GetOffsets(const galois::DynamicBitset& bitset) {
-  // TODO uint32_t is somewhat dangerous; change in the future
-  uint32_t activeThreads = galois::getActiveThreads();
-  std::vector<Integer> tPrefixBitCounts(activeThreads);
-
-  // count how many bits are set on each thread
-  galois::on_each([&](unsigned tid, unsigned nthreads) {
-    auto [start, end] =
-        galois::block_range(size_t{0}, bitset.size(), tid, nthreads);
-
-    Integer count = 0;
-    for (Integer i = start; i < end; ++i) {
-      if (bitset.test(i)) {
-        ++count;
-      }
-    }
-
-    tPrefixBitCounts[tid] = count;
-  });
+  PopcountFn popcount = GetKernels().popcount;
+  const uint64_t* words = Words(bitset);
+  size_t num_words = bitset.get_vec().size();
+  size_t num_blocks = NumBlocks(num_words);
 
-  // calculate prefix sum of bits per thread
-  for (uint32_t i = 1; i < activeThreads; ++i) {
-    tPrefixBitCounts[i] += tPrefixBitCounts[i - 1];
+  // count how many bits are set in each block of words and compute the
+  // position of each block's first offset with an exclusive prefix sum
+  std::vector<uint64_t> block_starts(num_blocks + 1, 0);
+  galois::do_all(
+      galois::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        size_t begin = block * kBlockWords;
+        size_t end = std::min(num_words, begin + kBlockWords);
+        block_starts[block + 1] = popcount(words + begin, end - begin);
+      },
+      galois::no_stats());
+  for (size_t i = 1; i <= num_blocks; ++i) {
+    block_starts[i] += block_starts[i - 1];
   }
 
-  // total num of set bits
-  Integer bitsetCount = tPrefixBitCounts[activeThreads - 1];
-  std::vector<Integer> offsets;
-
-  // calculate the indices of the set bits and save them to the offset
-  // vector
-  if (bitsetCount > 0) {
-    offsets.resize(bitsetCount);
-    galois::on_each([&](unsigned tid, unsigned nthreads) {
-      auto [start, end] =
-          galois::block_range(size_t{0}, bitset.size(), tid, nthreads);
-      Integer count = 0;
-      Integer tPrefixBitCount;
-      if (tid == 0) {
-        tPrefixBitCount = 0;
-      } else {
-        tPrefixBitCount = tPrefixBitCounts[tid - 1];
-      }
+  std::vector<Integer> offsets(block_starts[num_blocks]);
+  if (offsets.empty()) {
+    return offsets;
+  }
 
-      for (Integer i = start; i < end; ++i) {
-        if (bitset.test(i)) {
-          offsets[tPrefixBitCount + count] = i;
-          ++count;
+  galois::do_all(
+      galois::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        Integer* out = offsets.data() + block_starts[block];
+        size_t begin = block * kBlockWords;
+        size_t end = std::min(num_words, begin + kBlockWords);
+        for (size_t w = begin; w < end; ++w) {
+          for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+            *out++ = w * galois::DynamicBitset::bits_uint64 +
+                     __builtin_ctzll(word);
+          }
         }
-      }
-    });
-  }
+      },
+      galois::no_stats());
 
   return offsets;
 }
-}  //namespace
+}  // namespace
 
 template <>
 std::vector<uint32_t>
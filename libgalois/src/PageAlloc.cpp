@@ -35,10 +35,10 @@ const size_t hugePageSize = 2 * 1024 * 1024;
 static galois::substrate::SimpleLock allocLock;
 
 static void*
-trymmap(size_t size, int flag) {
+trymmap(size_t size, int flag, void* addr = nullptr, int prot = -1) {
   std::lock_guard<galois::substrate::SimpleLock> lg(allocLock);
-  const int _PROT = PROT_READ | PROT_WRITE;
-  void* ptr = mmap(0, size, _PROT, flag, -1, 0);
+  const int _PROT = prot < 0 ? PROT_READ | PROT_WRITE : prot;
+  void* ptr = mmap(addr, size, _PROT, flag, -1, 0);
   if (ptr == MAP_FAILED) {
     ptr = nullptr;
   }
@@ -87,6 +87,13 @@ galois::substrate::allocPages(unsigned num, bool preFault) {
     GALOIS_WARN_ONCE("huge page alloc failed, falling back to regular pages");
 #endif
     ptr = trymmap(num * hugePageSize, preFault ? _MAP_POP : _MAP);
+#ifdef MADV_HUGEPAGE
+    // Ask for transparent huge pages instead; this only helps pages that are
+    // not faulted in yet
+    if (ptr) {
+      madvise(ptr, num * hugePageSize, MADV_HUGEPAGE);
+    }
+#endif
   }
 
   if (!ptr) {
@@ -102,6 +109,63 @@ galois::substrate::allocPages(unsigned num, bool preFault) {
   return ptr;
 }
 
+void*
+galois::substrate::reservePages(unsigned num) {
+  if (num == 0) {
+    return nullptr;
+  }
+
+  // Over-reserve by a page so that the start can be aligned for huge pages
+  size_t size = (size_t(num) + 1) * hugePageSize;
+  void* ptr = trymmap(size, _MAP | MAP_NORESERVE, nullptr, PROT_NONE);
+  if (!ptr) {
+    return nullptr;
+  }
+
+  uintptr_t start = reinterpret_cast<uintptr_t>(ptr);
+  uintptr_t aligned = (start + hugePageSize - 1) & ~(hugePageSize - 1);
+  std::lock_guard<SimpleLock> lg(allocLock);
+  if (aligned != start) {
+    munmap(ptr, aligned - start);
+  }
+  munmap(
+      reinterpret_cast<void*>(aligned + size_t(num) * hugePageSize),
+      hugePageSize - (aligned - start));
+  return reinterpret_cast<void*>(aligned);
+}
+
+void
+galois::substrate::commitPages(void* ptr, unsigned num, bool preFault) {
+  size_t size = size_t(num) * hugePageSize;
+  void* ret = trymmap(
+      size, (preFault ? _MAP_HUGE_POP : _MAP_HUGE) | MAP_FIXED, ptr);
+  if (!ret) {
+    ret = trymmap(size, (preFault ? _MAP_POP : _MAP) | MAP_FIXED, ptr);
+  }
+
+  if (!ret) {
+    GALOIS_LOG_FATAL("failed to commit: {}", errno);
+  }
+
+  if (preFault && doHandMap) {
+    for (size_t x = 0; x < size; x += 4096) {
+      static_cast<char*>(ptr)[x] = 0;
+    }
+  }
+}
+
+void
+galois::substrate::decommitPages(void* ptr, unsigned num) {
+  // Mapping over the pages releases them, including huge pages, which
+  // madvise(MADV_DONTNEED) does not support on older kernels
+  void* ret = trymmap(
+      size_t(num) * hugePageSize, _MAP | MAP_NORESERVE | MAP_FIXED, ptr,
+      PROT_NONE);
+  if (!ret) {
+    GALOIS_LOG_FATAL("failed to decommit: {}", errno);
+  }
+}
+
 void
 galois::substrate::freePages(void* ptr, unsigned num) {
   std::lock_guard<SimpleLock> lg(allocLock);
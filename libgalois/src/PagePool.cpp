@@ -19,8 +19,20 @@
 
 #include "galois/substrate/PagePool.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+
 #include "galois/Logging.h"
 
+namespace {
+
+// Upper bound on the address space reserved for all arenas together. x86-64
+// gives user space 128 TiB.
+constexpr size_t kMaxArenaReservation = size_t{1} << 44;
+
+}  // namespace
+
 static galois::substrate::internal::PageAllocState<>* PA;
 
 void
@@ -29,6 +41,19 @@ galois::substrate::internal::setPagePoolState(PageAllocState<>* pa) {
   PA = pa;
 }
 
+size_t
+galois::substrate::internal::pageArenaSize(unsigned numThreads) {
+  // No thread can use more than physical memory, so that bounds each arena
+  long pages = sysconf(_SC_PHYS_PAGES);
+  long pageSize = sysconf(_SC_PAGESIZE);
+  if (pages <= 0 || pageSize <= 0 || numThreads == 0) {
+    return 0;
+  }
+  size_t bytes = std::min(
+      size_t(pages) * size_t(pageSize), kMaxArenaReservation / numThreads);
+  return bytes / allocSize();
+}
+
 int
 galois::substrate::numPagePoolAllocTotal() {
   return PA->countAll();
@@ -54,3 +79,18 @@ void
 galois::substrate::pagePoolFree(void* ptr) {
   PA->pageFree(ptr);
 }
+
+size_t
+galois::substrate::pagePoolTrim(size_t keepPerThread) {
+  return PA->trimAll(keepPerThread);
+}
+
+void
+galois::substrate::pagePoolSetWatermark(size_t pagesPerThread) {
+  PA->setWatermark(pagesPerThread);
+}
+
+int
+galois::substrate::numPagePoolReleasedTotal() {
+  return PA->countReleased();
+}
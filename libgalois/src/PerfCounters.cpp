@@ -0,0 +1,212 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/runtime/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "galois/Logging.h"
+#include "galois/Statistics.h"
+#include "galois/runtime/Executor_OnEach.h"
+
+namespace {
+
+using galois::runtime::PerfCounters;
+
+#ifdef __linux__
+
+struct CounterConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr std::array<CounterConfig, PerfCounters::kNumCounters> kConfigs{{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+}};
+
+int
+OpenCounter(const CounterConfig& counter) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = counter.type;
+  attr.config = counter.config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Counters are opened individually rather than as a group so that one
+  // unsupported counter does not disable the others; the kernel may then
+  // multiplex them, which the enabled/running times correct for.
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // Count the calling thread on any cpu
+  return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/// The counters of one thread, opened on first use
+struct ThreadCounters {
+  std::array<int, PerfCounters::kNumCounters> fds;
+  bool opened{false};
+  bool any{false};
+
+  ThreadCounters() { fds.fill(-1); }
+
+  ~ThreadCounters() {
+    for (int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  void Open() {
+    opened = true;
+    std::string failed;
+    for (size_t i = 0; i < fds.size(); ++i) {
+      fds[i] = OpenCounter(kConfigs[i]);
+      if (fds[i] >= 0) {
+        any = true;
+        continue;
+      }
+      failed += fmt::format(
+          "{}{} ({})", failed.empty() ? "" : ", ",
+          PerfCounters::Name(static_cast<PerfCounters::Counter>(i)),
+          std::strerror(errno));
+    }
+    // Every thread fails the same way, so only tell the user once
+    if (!failed.empty()) {
+      GALOIS_WARN_ONCE(
+          "hardware counters not available: {}; see "
+          "/proc/sys/kernel/perf_event_paranoid",
+          failed);
+    }
+  }
+};
+
+thread_local ThreadCounters thread_counters;
+
+uint64_t
+ReadCounter(int fd) {
+  uint64_t buf[3];  // value, time enabled, time running
+  if (fd < 0 || read(fd, buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0) {
+    return 0;
+  }
+  if (buf[1] == buf[2]) {
+    return buf[0];
+  }
+  return static_cast<uint64_t>(
+      static_cast<double>(buf[0]) * buf[1] / buf[2]);
+}
+
+#endif
+
+}  // namespace
+
+const char*
+galois::runtime::PerfCounters::Name(Counter counter) {
+  switch (counter) {
+  case kCycles:
+    return "Cycles";
+  case kInstructions:
+    return "Instructions";
+  case kLLCMisses:
+    return "LLCMisses";
+  case kDTLBMisses:
+    return "DTLBMisses";
+  default:
+    return "Unknown";
+  }
+}
+
+bool
+galois::runtime::PerfCounters::Read(Values* values) {
+  values->fill(0);
+#ifdef __linux__
+  ThreadCounters& counters = thread_counters;
+  if (!counters.opened) {
+    counters.Open();
+  }
+  if (!counters.any) {
+    return false;
+  }
+  for (size_t i = 0; i < counters.fds.size(); ++i) {
+    (*values)[i] = ReadCounter(counters.fds[i]);
+  }
+  return true;
+#else
+  GALOIS_WARN_ONCE("hardware counters are only supported on Linux");
+  return false;
+#endif
+}
+
+bool
+galois::runtime::PerfCounters::IsAvailable(Counter counter) {
+#ifdef __linux__
+  ThreadCounters& counters = thread_counters;
+  if (!counters.opened) {
+    counters.Open();
+  }
+  return counters.fds[counter] >= 0;
+#else
+  return false;
+#endif
+}
+
+galois::runtime::PerfCounterRegion::PerfCounterRegion(const char* region)
+    : region_(region ? region : "(NULL)") {}
+
+void
+galois::runtime::PerfCounterRegion::start() {
+  on_each_gen(
+      [&](unsigned, unsigned) { PerfCounters::Read(begin_.getLocal()); },
+      std::make_tuple());
+}
+
+void
+galois::runtime::PerfCounterRegion::stop() {
+  on_each_gen(
+      [&](unsigned, unsigned) {
+        PerfCounters::Values end;
+        if (!PerfCounters::Read(&end)) {
+          return;
+        }
+        const PerfCounters::Values& begin = *begin_.getLocal();
+        for (size_t i = 0; i < end.size(); ++i) {
+          auto counter = static_cast<PerfCounters::Counter>(i);
+          if (PerfCounters::IsAvailable(counter)) {
+            galois::ReportStatSum(
+                region_, PerfCounters::Name(counter), end[i] - begin[i]);
+          }
+        }
+      },
+      std::make_tuple());
+}
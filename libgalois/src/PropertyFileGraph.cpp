@@ -425,37 +425,41 @@ galois::graphs::SortNodesByDegree(galois::graphs::PropertyFileGraph* pfg) {
 
   auto out_dests_view = std::move(view_result_dests.value());
 
-  galois::do_all(
+  // The topology is only updated after all threads are done reading it
+  galois::do_all_fused(
       galois::iterate(uint64_t{0}, num_nodes),
-      [&](uint32_t old_node_id) {
-        uint32_t new_node_id = old_to_new_mapping[old_node_id];
-
-        // get the start location of this reindex'd nodes edges
-        uint64_t new_out_index =
-            (new_node_id == 0) ? 0 : new_prefix_sum[new_node_id - 1];
-
-        // construct the graph, reindexing as it goes along
-        auto node_edge_range = pfg->topology().edge_range(old_node_id);
-        for (auto e = node_edge_range.first; e != node_edge_range.second; ++e) {
-          // get destination, reindex
-          uint32_t old_edge_dest = out_dests_view[e];
-          uint32_t new_edge_dest = old_to_new_mapping[old_edge_dest];
-
-          new_out_dest[new_out_index] = new_edge_dest;
-
-          new_out_index++;
-        }
-        // this assert makes sure reindex was correct + makes sure all edges
-        // are accounted for
-        assert(new_out_index == new_prefix_sum[new_node_id]);
-      },
-      galois::steal());
-
-  //Update the underlying propertyFileGraph topology
-  galois::do_all(
-      galois::iterate(uint64_t{0}, num_nodes), [&](uint32_t node_id) {
-        out_indices_view[node_id] = new_prefix_sum[node_id];
-      });
+      std::make_tuple(
+          galois::phase(
+              [&](uint32_t old_node_id) {
+                uint32_t new_node_id = old_to_new_mapping[old_node_id];
+
+                // get the start location of this reindex'd nodes edges
+                uint64_t new_out_index =
+                    (new_node_id == 0) ? 0 : new_prefix_sum[new_node_id - 1];
+
+                // construct the graph, reindexing as it goes along
+                auto node_edge_range = pfg->topology().edge_range(old_node_id);
+                for (auto e = node_edge_range.first;
+                     e != node_edge_range.second; ++e) {
+                  // get destination, reindex
+                  uint32_t old_edge_dest = out_dests_view[e];
+                  uint32_t new_edge_dest = old_to_new_mapping[old_edge_dest];
+
+                  new_out_dest[new_out_index] = new_edge_dest;
+
+                  new_out_index++;
+                }
+                // this assert makes sure reindex was correct + makes sure all
+                // edges are accounted for
+                assert(new_out_index == new_prefix_sum[new_node_id]);
+              },
+              galois::steal()),
+          //Update the underlying propertyFileGraph topology
+          galois::phase(
+              [&](uint32_t node_id) {
+                out_indices_view[node_id] = new_prefix_sum[node_id];
+              },
+              galois::after_barrier())));
 
   galois::do_all(
       galois::iterate(uint64_t{0}, num_edges), [&](uint32_t edge_id) {
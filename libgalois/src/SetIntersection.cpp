@@ -0,0 +1,269 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/SetIntersection.h"
+
+#include <utility>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define GALOIS_INTERSECT_X86_KERNELS
+#endif
+
+namespace {
+
+uint64_t
+MergeCount(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  uint64_t count = 0;
+  size_t i = 0;
+  size_t j = 0;
+  // Branch-free advance; the compiler turns these into conditional moves
+  while (i < a_size && j < b_size) {
+    uint32_t x = a[i];
+    uint32_t y = b[j];
+    count += x == y;
+    i += x <= y;
+    j += y <= x;
+  }
+  return count;
+}
+
+#ifdef GALOIS_INTERSECT_X86_KERNELS
+
+// Block merge (Schlegel, Willhalm and Lehner, 2011): compare a block of a
+// with every rotation of a block of b, then advance the block with the
+// smaller maximum (or both). An item of a matches at most one item of b, so
+// every common item is counted exactly once.
+__attribute__((target("sse4.2"))) uint64_t
+MergeCountSse(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  uint64_t count = 0;
+  size_t i = 0;
+  size_t j = 0;
+  while (i + 4 <= a_size && j + 4 <= b_size) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    __m128i rot1 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    __m128i rot2 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i rot3 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+    __m128i match = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, rot1)),
+        _mm_or_si128(_mm_cmpeq_epi32(va, rot2), _mm_cmpeq_epi32(va, rot3)));
+    count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(match)));
+    uint32_t a_max = a[i + 3];
+    uint32_t b_max = b[j + 3];
+    i += a_max <= b_max ? 4 : 0;
+    j += b_max <= a_max ? 4 : 0;
+  }
+  return count + MergeCount(a + i, a_size - i, b + j, b_size - j);
+}
+
+__attribute__((target("avx2"))) uint64_t
+MergeCountAvx2(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  uint64_t count = 0;
+  size_t i = 0;
+  size_t j = 0;
+  while (i + 8 <= a_size && j + 8 <= b_size) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    // Rotate within 128-bit lanes and compare against both orders of the
+    // lanes; every rotation is computed from vb so they do not form a chain
+    __m256i vb_swap = _mm256_permute2x128_si256(vb, vb, 1);
+    __m256i match = _mm256_or_si256(
+        _mm256_cmpeq_epi32(va, vb), _mm256_cmpeq_epi32(va, vb_swap));
+    __m256i rot1 = _mm256_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    __m256i rot2 = _mm256_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+    __m256i rot3 = _mm256_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+    match = _mm256_or_si256(
+        match, _mm256_or_si256(
+                   _mm256_cmpeq_epi32(va, rot1), _mm256_cmpeq_epi32(va, rot2)));
+    match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, rot3));
+    rot1 = _mm256_permute2x128_si256(rot1, rot1, 1);
+    rot2 = _mm256_permute2x128_si256(rot2, rot2, 1);
+    rot3 = _mm256_permute2x128_si256(rot3, rot3, 1);
+    match = _mm256_or_si256(
+        match, _mm256_or_si256(
+                   _mm256_cmpeq_epi32(va, rot1), _mm256_cmpeq_epi32(va, rot2)));
+    match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, rot3));
+    count +=
+        __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+    uint32_t a_max = a[i + 7];
+    uint32_t b_max = b[j + 7];
+    i += a_max <= b_max ? 8 : 0;
+    j += b_max <= a_max ? 8 : 0;
+  }
+  return count + MergeCount(a + i, a_size - i, b + j, b_size - j);
+}
+
+// Blocks of 16 items of the larger range against blocks of 4 items of the
+// smaller one, which are broadcast to every 128-bit lane and rotated within
+// lanes. Compared to square blocks, this needs fewer rotations and advances
+// through the larger range faster when the sizes differ.
+__attribute__((target("avx512f"))) uint64_t
+MergeCountAvx512(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  if (a_size < b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  uint64_t count = 0;
+  size_t i = 0;
+  size_t j = 0;
+  while (i + 16 <= a_size && j + 4 <= b_size) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_broadcast_i32x4(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j)));
+    __m512i rot1 = _mm512_shuffle_epi32(vb, _MM_PERM_ADCB);
+    __m512i rot2 = _mm512_shuffle_epi32(vb, _MM_PERM_BADC);
+    __m512i rot3 = _mm512_shuffle_epi32(vb, _MM_PERM_CBAD);
+    __mmask16 match = _mm512_cmpeq_epi32_mask(va, vb) |
+                      _mm512_cmpeq_epi32_mask(va, rot1) |
+                      _mm512_cmpeq_epi32_mask(va, rot2) |
+                      _mm512_cmpeq_epi32_mask(va, rot3);
+    count += __builtin_popcount(match);
+    uint32_t a_max = a[i + 15];
+    uint32_t b_max = b[j + 3];
+    i += a_max <= b_max ? 16 : 0;
+    j += b_max <= a_max ? 4 : 0;
+  }
+  return count + MergeCountAvx2(a + i, a_size - i, b + j, b_size - j);
+}
+
+#endif
+
+using CountFn = uint64_t (*)(const uint32_t*, size_t, const uint32_t*, size_t);
+
+//! Merge kernels for the widest instruction set supported by the running CPU
+struct Kernels {
+  //! For ranges of similar size
+  CountFn merge{MergeCount};
+  //! For ranges whose sizes differ by at least kSkewedRatio
+  CountFn skewed{MergeCount};
+
+  Kernels() {
+#ifdef GALOIS_INTERSECT_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+      merge = MergeCountSse;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      merge = MergeCountAvx2;
+    }
+    skewed = merge;
+    // Square AVX-512 blocks are no faster than AVX2 ones since they need four
+    // times the compares per block, so AVX-512 is only used for skewed sizes
+    if (__builtin_cpu_supports("avx512f")) {
+      skewed = MergeCountAvx512;
+    }
+#endif
+  }
+};
+
+//! Below this ratio of sizes the ranges are merged with square blocks
+constexpr size_t kSkewedRatio = 2;
+
+const Kernels&
+GetKernels() {
+  static Kernels kernels;
+  return kernels;
+}
+
+}  // namespace
+
+uint64_t
+galois::IntersectCountMerge(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  return MergeCount(a, a_size, b, b_size);
+}
+
+uint64_t
+galois::IntersectCountGalloping(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  uint64_t count = 0;
+  IntersectGalloping(a, a_size, b, b_size, [&count](uint32_t) { ++count; });
+  return count;
+}
+
+uint64_t
+galois::IntersectCountSimd(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  const Kernels& kernels = GetKernels();
+  if (a_size * kSkewedRatio <= b_size) {
+    return kernels.skewed(a, a_size, b, b_size);
+  }
+  return kernels.merge(a, a_size, b, b_size);
+}
+
+uint64_t
+galois::IntersectCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  if (a_size == 0) {
+    return 0;
+  }
+  if (a_size * kGallopingRatio <= b_size) {
+    return IntersectCountGalloping(a, a_size, b, b_size);
+  }
+  // Too small to fill a vector block, e.g., the neighbors of low degree nodes
+  // of power-law graphs
+  if (a_size < 4 || b_size < 16) {
+    return MergeCount(a, a_size, b, b_size);
+  }
+  return IntersectCountSimd(a, a_size, b, b_size);
+}
+
+void
+galois::IntersectionBitmap::Resize(size_t universe) {
+  words_.assign((universe + 63) / 64, 0);
+}
+
+void
+galois::IntersectionBitmap::Insert(const uint32_t* a, size_t a_size) {
+  for (size_t i = 0; i < a_size; ++i) {
+    words_[a[i] / 64] |= uint64_t{1} << (a[i] % 64);
+  }
+}
+
+void
+galois::IntersectionBitmap::Erase(const uint32_t* a, size_t a_size) {
+  for (size_t i = 0; i < a_size; ++i) {
+    words_[a[i] / 64] &= ~(uint64_t{1} << (a[i] % 64));
+  }
+}
+
+uint64_t
+galois::IntersectionBitmap::Count(const uint32_t* b, size_t b_size) const {
+  uint64_t count = 0;
+  for (size_t i = 0; i < b_size; ++i) {
+    count += (words_[b[i] / 64] >> (b[i] % 64)) & 1;
+  }
+  return count;
+}
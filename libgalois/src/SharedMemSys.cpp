@@ -19,7 +19,9 @@
 
 #include "galois/SharedMemSys.h"
 
+#include "galois/ArrowMemoryPool.h"
 #include "galois/CommBackend.h"
+#include "galois/Env.h"
 #include "galois/Logging.h"
 #include "galois/Statistics.h"
 #include "galois/substrate/SharedMem.h"
@@ -41,12 +43,22 @@ galois::SharedMemSys::SharedMemSys() : impl_(std::make_unique<Impl>()) {
   if (auto init_good = tsuba::Init(&comm_backend); !init_good) {
     GALOIS_LOG_FATAL("tsuba::Init: {}", init_good.error());
   }
+  // Place loaded properties with the Galois allocators
+  tsuba::SetMemoryPool(galois::GetArrowMemoryPool());
 
   galois::internal::setSysStatManager(&impl_->stat_manager);
 }
 
 galois::SharedMemSys::~SharedMemSys() {
+  // Peak usage over the whole run, along with what is still allocated
+  galois::reportMemoryUsage("MemoryUsage");
   galois::PrintStats();
+
+  if (std::string uri; galois::GetEnv("GALOIS_STATS_JSONL", &uri)) {
+    if (auto res = galois::WriteStatsJsonLines(uri); !res) {
+      GALOIS_LOG_ERROR("writing stats to {}: {}", uri, res.error());
+    }
+  }
   galois::internal::setSysStatManager(nullptr);
 
   if (auto fini_good = tsuba::Fini(); !fini_good) {
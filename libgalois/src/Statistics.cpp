@@ -21,14 +21,26 @@
 
 #include <sys/resource.h>
 #include <sys/time.h>
+#include <unistd.h>
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
 
 #include "galois/Env.h"
+#include "galois/ErrorCode.h"
 #include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
+#include "galois/Threads.h"
+#include "galois/Version.h"
 #include "galois/runtime/Executor_OnEach.h"
 #include "galois/substrate/PerThreadStorage.h"
+#include "tsuba/file.h"
 
 namespace {
 
@@ -37,6 +49,29 @@ CheckPrintingThreadVals() {
   return galois::GetEnv("PRINT_PER_THREAD_STATS");
 }
 
+std::string
+GetHostName() {
+  char name[256] = {};
+  if (gethostname(name, sizeof(name) - 1) != 0) {
+    return "";
+  }
+  return name;
+}
+
+std::string
+GetCommandLine() {
+  std::ifstream in("/proc/self/cmdline", std::ios::binary);
+  std::string cmdline;
+  std::string arg;
+  while (std::getline(in, arg, '\0')) {
+    if (!cmdline.empty()) {
+      cmdline += ' ';
+    }
+    cmdline += arg;
+  }
+  return cmdline;
+}
+
 void
 PrintHeader(std::ostream& out, const char* sep) {
   out << "STAT_TYPE" << sep << "REGION" << sep << "CATEGORY" << sep;
@@ -65,25 +100,71 @@ struct StatImpl {
     perThreadManagers_.getLocal()->addToStat(region, category, val, type);
   }
 
-  void Merge() {
-    if (merged_) {
-      return;
-    }
-
+  void MergeInto(MergedStats* out) const {
     for (unsigned t = 0; t < perThreadManagers_.size(); ++t) {
       const auto* manager = perThreadManagers_.getRemote(t);
 
       for (auto i = manager->cbegin(), end_i = manager->cend(); i != end_i;
            ++i) {
-        result_.addToStat(
+        out->addToStat(
             manager->region(i), manager->category(i), T(manager->stat(i)),
             manager->stat(i).totalTy());
       }
     }
+  }
+
+  void Merge() {
+    if (merged_) {
+      return;
+    }
+
+    MergeInto(&result_);
 
     merged_ = true;
   }
 
+  void Reset() {
+    for (unsigned t = 0; t < perThreadManagers_.size(); ++t) {
+      perThreadManagers_.getRemote(t)->clear();
+    }
+    result_.clear();
+    merged_ = false;
+  }
+
+  static nlohmann::json ToJson(const T& v) {
+    if constexpr (std::is_same<T, galois::gstl::Str>::value) {
+      return std::string(v.begin(), v.end());
+    } else {
+      return v;
+    }
+  }
+
+  /// Writes one JSON object per statistic merged from the per-thread values
+  /// recorded so far, leaving them in place
+  void WriteJsonLines(std::ostream& out, const nlohmann::json& header) const {
+    MergedStats snapshot;
+    MergeInto(&snapshot);
+
+    for (auto i = snapshot.cbegin(), end_i = snapshot.cend(); i != end_i;
+         ++i) {
+      const auto& s = snapshot.stat(i);
+
+      nlohmann::json record = header;
+      record["kind"] = StatKind();
+      record["region"] = std::string(snapshot.region(i).c_str());
+      record["category"] = std::string(snapshot.category(i).c_str());
+      record["total_type"] = galois::StatTotal::str(s.totalTy());
+      record["total"] = ToJson(s.total());
+      nlohmann::json values = nlohmann::json::array();
+      for (const auto& v : s.values()) {
+        values.push_back(ToJson(v));
+      }
+      record["thread_values"] = std::move(values);
+
+      out << record.dump() << "\n";
+    }
+  }
+
   void Read(
       const_iterator i, galois::gstl::Str& region, galois::gstl::Str& category,
       T& total, galois::StatTotal::Type& type,
@@ -133,6 +214,8 @@ public:
   StatImpl<double> fp_stats_;
   StatImpl<Str> str_stats_;
   std::string outfile_;
+  std::map<std::string, std::string> metadata_;
+  uint64_t num_snapshots_{};
 };
 
 galois::StatManager::StatManager() { impl_ = std::make_unique<Impl>(); }
@@ -260,6 +343,38 @@ galois::StatManager::Print() {
   PrintStats(out);
 }
 
+void
+galois::StatManager::SetMetadata(
+    const std::string& key, const std::string& value) {
+  impl_->metadata_[key] = value;
+}
+
+void
+galois::StatManager::WriteJsonLines(std::ostream& out, bool reset) {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+
+  nlohmann::json header;
+  header["host"] = GetHostName();
+  header["threads"] = galois::getActiveThreads();
+  header["version"] = galois::getVersion();
+  header["revision"] = galois::getRevision();
+  header["command_line"] = GetCommandLine();
+  header["metadata"] = impl_->metadata_;
+  header["snapshot"] = impl_->num_snapshots_++;
+  header["timestamp_us"] =
+      std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+
+  impl_->int_stats_.WriteJsonLines(out, header);
+  impl_->fp_stats_.WriteJsonLines(out, header);
+  impl_->str_stats_.WriteJsonLines(out, header);
+
+  // Parameters describe the whole run, so every snapshot repeats them
+  if (reset) {
+    impl_->int_stats_.Reset();
+    impl_->fp_stats_.Reset();
+  }
+}
+
 static galois::StatManager* stat_manager_singleton;
 
 void
@@ -280,11 +395,49 @@ galois::SetStatFile(const std::string& f) {
   internal::sysStatManager()->SetStatFile(f);
 }
 
+static std::atomic<bool> stat_timer_microseconds{false};
+
+void
+galois::SetStatTimerMicroseconds(bool enable) {
+  stat_timer_microseconds = enable;
+}
+
+bool
+galois::StatTimerMicroseconds() {
+  return stat_timer_microseconds;
+}
+
 void
 galois::PrintStats() {
   internal::sysStatManager()->Print();
 }
 
+void
+galois::SetStatMetadata(const std::string& key, const std::string& value) {
+  if (auto* sm = internal::sysStatManager(); sm) {
+    sm->SetMetadata(key, value);
+  }
+}
+
+std::string
+galois::SnapshotStats(bool reset) {
+  std::ostringstream out;
+  if (auto* sm = internal::sysStatManager(); sm) {
+    sm->WriteJsonLines(out, reset);
+  }
+  return out.str();
+}
+
+galois::Result<void>
+galois::WriteStatsJsonLines(const std::string& uri, bool reset) {
+  if (!internal::sysStatManager()) {
+    return galois::ErrorCode::NotFound;
+  }
+  std::string records = SnapshotStats(reset);
+  return tsuba::FileStore(
+      uri, reinterpret_cast<const uint8_t*>(records.data()), records.size());
+}
+
 void
 galois::reportPageAlloc(const char* category) {
   galois::runtime::on_each_gen(
@@ -295,6 +448,21 @@ galois::reportPageAlloc(const char* category) {
       std::make_tuple());
 }
 
+void
+galois::reportMemoryUsage(const std::string& region) {
+  for (int i = 0; i < static_cast<int>(MemoryCategory::kNumCategories); ++i) {
+    auto category = static_cast<MemoryCategory>(i);
+    std::string name = MemoryCategoryName(category);
+    ReportStatSingle(region, name + "Bytes", MemoryAllocated(category));
+    ReportStatSingle(region, name + "PeakBytes", MemoryPeak(category));
+  }
+  ReportStatSingle(region, "TotalBytes", MemoryAllocatedTotal());
+  ReportStatSingle(region, "TotalPeakBytes", MemoryPeakTotal());
+  if (uint64_t budget = MemoryBudget(); budget != kNoMemoryBudget) {
+    ReportStatSingle(region, "BudgetBytes", budget);
+  }
+}
+
 void
 galois::reportRUsage(const std::string& id) {
   // get rusage at this point in time
@@ -21,9 +21,18 @@
 
 #include <algorithm>
 #include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "galois/Env.h"
 #include "galois/Logging.h"
+#include "galois/Trace.h"
+#include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/HWTopo.h"
 
 // Forward declare this to avoid including PerThreadStorage.
@@ -38,11 +47,132 @@ using galois::substrate::ThreadPool;
 
 thread_local ThreadPool::per_signal ThreadPool::my_box;
 
+namespace {
+
+// Bounds of the spin window of IdlePolicy::kAdaptive. Spinning longer than
+// the upper bound costs more CPU time than a futex wake-up costs latency.
+constexpr uint64_t kMinIdleSpinNs = 2000;
+constexpr uint64_t kMaxIdleSpinNs = 500000;
+
+ThreadPool::IdlePolicy
+DefaultIdlePolicy() {
+  std::string policy;
+  if (!galois::GetEnv("GALOIS_IDLE_POLICY", &policy) || policy == "sleep") {
+    return ThreadPool::IdlePolicy::kSleep;
+  }
+  if (policy == "adaptive") {
+    return ThreadPool::IdlePolicy::kAdaptive;
+  }
+  GALOIS_WARN_ONCE("unknown GALOIS_IDLE_POLICY: {}", policy);
+  return ThreadPool::IdlePolicy::kSleep;
+}
+
+}  // namespace
+
+void
+ThreadPool::per_signal::park() {
+#ifdef __linux__
+  syscall(
+      SYS_futex, reinterpret_cast<int*>(&fastRelease), FUTEX_WAIT_PRIVATE,
+      kParked, nullptr, nullptr, 0);
+#else
+  std::unique_lock<std::mutex> lg(m);
+  cv.wait(lg, [=] { return fastRelease.load() != kParked; });
+#endif
+}
+
+void
+ThreadPool::per_signal::unpark() {
+#ifdef __linux__
+  syscall(
+      SYS_futex, reinterpret_cast<int*>(&fastRelease), FUTEX_WAKE_PRIVATE, 1,
+      nullptr, nullptr, 0);
+#else
+  { std::lock_guard<std::mutex> lg(m); }
+  cv.notify_one();
+#endif
+}
+
+void
+ThreadPool::per_signal::wakeup(WaitMode mode) {
+  switch (mode) {
+  case WaitMode::kSpin:
+    done = 0;
+    fastRelease = kReleased;
+    break;
+  case WaitMode::kAdaptive:
+    done = 0;
+    if (fastRelease.exchange(kReleased) == kParked) {
+      unpark();
+    }
+    break;
+  default: {
+    std::lock_guard<std::mutex> lg(m);
+    done = 0;
+    cv.notify_one();
+    break;
+  }
+  }
+}
+
+void
+ThreadPool::per_signal::wait(WaitMode mode, uint64_t spin_ns) {
+  switch (mode) {
+  case WaitMode::kSpin:
+    while (!fastRelease.load(std::memory_order_relaxed)) {
+      asmPause();
+    }
+    fastRelease = kIdle;
+    break;
+  case WaitMode::kAdaptive:
+    waitAdaptive(spin_ns);
+    break;
+  default: {
+    std::unique_lock<std::mutex> lg(m);
+    cv.wait(lg, [=] { return !done; });
+    break;
+  }
+  }
+}
+
+void
+ThreadPool::per_signal::waitAdaptive(uint64_t spin_ns) {
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::nanoseconds(spin_ns);
+  bool spinning = true;
+  for (unsigned i = 1;; ++i) {
+    int state = fastRelease.load(std::memory_order_acquire);
+    if (state == kReleased) {
+      break;
+    }
+    if (spinning) {
+      asmPause();
+      // Reading the clock costs about as much as a few dozen pauses
+      if (i % 64 == 0 && std::chrono::steady_clock::now() >= deadline) {
+        spinning = false;
+      }
+      continue;
+    }
+    // Announce that we are parking so that wakeup issues a futex wake. If the
+    // release races with this, either the exchange fails or the futex wait
+    // returns immediately because the state is no longer kParked.
+    if (state == kIdle &&
+        !fastRelease.compare_exchange_weak(state, kParked)) {
+      continue;
+    }
+    park();
+  }
+  fastRelease.store(kIdle, std::memory_order_relaxed);
+}
+
 ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo),
       reserved(0),
       masterFastmode(false),
-      running(false) {
+      running(false),
+      idlePolicy(DefaultIdlePolicy()),
+      gapEstimateNs(0),
+      idleSpinNs(kMaxIdleSpinNs) {
   signals.resize(mi.maxThreads);
   initThread(0);
 
@@ -94,6 +224,40 @@ ThreadPool::beKind() {
   }
 }
 
+void
+ThreadPool::setIdlePolicy(IdlePolicy policy) {
+  if (policy == idlePolicy) {
+    return;
+  }
+  beKind();
+  // Threads must be woken with the old policy before they switch
+  run(getMaxUsableThreads(), [policy]() { throw idle_policy_ty{policy}; });
+  idlePolicy = policy;
+  gapEstimateNs = 0;
+  lastRunEnd = {};
+  idleSpinNs = kMaxIdleSpinNs;
+}
+
+void
+ThreadPool::updateIdleSpin() {
+  auto now = std::chrono::steady_clock::now();
+  if (lastRunEnd == std::chrono::steady_clock::time_point{}) {
+    return;
+  }
+  uint64_t gap =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastRunEnd)
+          .count();
+  gapEstimateNs = gapEstimateNs ? (3 * gapEstimateNs + gap) / 4 : gap;
+
+  // Spin long enough to cover typical gaps, but if gaps are too long to be
+  // worth covering, park almost immediately
+  uint64_t window = 2 * gapEstimateNs;
+  idleSpinNs.store(
+      window <= kMaxIdleSpinNs ? std::max(window, kMinIdleSpinNs)
+                               : kMinIdleSpinNs,
+      std::memory_order_relaxed);
+}
+
 // inefficient append
 template <typename T>
 static void
@@ -130,6 +294,9 @@ void
 ThreadPool::initThread(unsigned tid) {
   signals[tid] = &my_box;
   my_box.topo = getHWTopo().threadTopoInfo[tid];
+  if (galois::kTraceEnabled) {
+    galois::SetTraceThreadName(fmt::format("galois-{}", tid));
+  }
   // Initialize
   substrate::initPTS(mi.maxThreads);
 
@@ -155,17 +322,26 @@ ThreadPool::initThread(unsigned tid) {
 void
 ThreadPool::threadLoop(unsigned tid) {
   initThread(tid);
-  bool fastmode = false;
+  WaitMode mode = baseWaitMode();
   auto& me = my_box;
   do {
-    me.wait(fastmode);
-    cascade(fastmode);
+    {
+      galois::TraceScope trace("Idle", galois::TraceCategory::kIdle);
+      me.wait(mode, idleSpinNs.load(std::memory_order_relaxed));
+    }
+    {
+      galois::TraceScope trace("Wakeup", galois::TraceCategory::kWakeup);
+      cascade(mode);
+    }
     try {
       work();
     } catch (const shutdown_ty&) {
       return;
     } catch (const fastmode_ty& fm) {
-      fastmode = fm.mode;
+      mode = fm.mode ? WaitMode::kSpin : baseWaitMode();
+    } catch (const idle_policy_ty& ip) {
+      mode = ip.policy == IdlePolicy::kAdaptive ? WaitMode::kAdaptive
+                                                : WaitMode::kSleep;
     } catch (const dedicated_ty dt) {
       me.done = 1;
       dt.fn();
@@ -202,7 +378,7 @@ ThreadPool::decascade() {
 }
 
 void
-ThreadPool::cascade(bool fastmode) {
+ThreadPool::cascade(WaitMode mode) {
   auto& me = my_box;
   assert(me.wbegin <= me.wend);
 
@@ -216,13 +392,13 @@ ThreadPool::cascade(bool fastmode) {
   auto* child1 = signals[me.wbegin];
   child1->wbegin = me.wbegin + 1;
   child1->wend = midpoint;
-  child1->wakeup(fastmode);
+  child1->wakeup(mode);
 
   if (midpoint < me.wend) {
     auto* child2 = signals[midpoint];
     child2->wbegin = midpoint + 1;
     child2->wend = me.wend;
-    child2->wakeup(fastmode);
+    child2->wakeup(mode);
   }
 }
 
@@ -239,20 +415,30 @@ ThreadPool::runInternal(unsigned num) {
   me.wend = num;
 
   assert(!masterFastmode || masterFastmode == num);
+  if (idlePolicy == IdlePolicy::kAdaptive) {
+    updateIdleSpin();
+  }
   // launch threads
-  cascade(masterFastmode);
+  {
+    galois::TraceScope trace("Wakeup", galois::TraceCategory::kWakeup);
+    cascade(masterWaitMode());
+  }
   // Do master thread work
   try {
     work();
   } catch (const shutdown_ty&) {
     return;
-  } catch (const fastmode_ty& fm) {
+  } catch (const fastmode_ty&) {
+  } catch (const idle_policy_ty&) {
   }
   // wait for children
   decascade();
   // Clean up
   work = nullptr;
   running = false;
+  if (idlePolicy == IdlePolicy::kAdaptive) {
+    lastRunEnd = std::chrono::steady_clock::now();
+  }
 }
 
 void
@@ -270,7 +456,7 @@ ThreadPool::runDedicated(std::function<void(void)>& f) {
   child->wbegin = 0;
   child->wend = 0;
   child->done = 0;
-  child->wakeup(masterFastmode);
+  child->wakeup(masterWaitMode());
   while (!child->done) {
     asmPause();
   }
@@ -290,3 +476,8 @@ galois::substrate::GetThreadPool() {
   GALOIS_LOG_VASSERT(TPOOL, "ThreadPool not initialized");
   return *TPOOL;
 }
+
+bool
+galois::substrate::CanRunThreadPool() {
+  return TPOOL && TPOOL->isMasterThread() && !TPOOL->isRunning();
+}
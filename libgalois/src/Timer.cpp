@@ -99,6 +99,11 @@ StatTimer::~StatTimer() {
     galois::ReportStatMax(
         region_.c_str(), name_.c_str(), TimeAccumulator::get());
   }
+  if (StatTimerMicroseconds() && TimeAccumulator::get_usec()) {
+    galois::ReportStatMax(
+        region_.c_str(), (name_ + "Usec").c_str(),
+        TimeAccumulator::get_usec());
+  }
 }
 
 void
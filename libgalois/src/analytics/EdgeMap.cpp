@@ -0,0 +1,136 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/EdgeMap.h"
+
+#include <algorithm>
+
+#include "galois/ParallelSTL.h"
+
+galois::analytics::InEdgeView
+galois::analytics::InEdgeView::Make(const graphs::PropertyFileGraph& pfg) {
+  const graphs::GraphTopology& topology = pfg.topology();
+  const uint64_t num_nodes = topology.num_nodes();
+  const uint64_t num_edges = topology.num_edges();
+
+  InEdgeView view;
+  view.topology_ = &topology;
+  view.in_indices_.allocateBlocked(num_nodes);
+  view.in_sources_.allocateBlocked(num_edges);
+  view.out_edges_.allocateBlocked(num_edges);
+
+  galois::LargeArray<uint64_t> in_degrees;
+  in_degrees.allocateBlocked(num_nodes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t node) { in_degrees[node] = 0; }, galois::no_stats());
+
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t edge) {
+        __sync_fetch_and_add(&in_degrees[topology.out_dests->Value(edge)], 1);
+      },
+      galois::no_stats(), galois::loopname("InEdgeViewCount"));
+
+  galois::ParallelSTL::partial_sum(
+      in_degrees.begin(), in_degrees.end(), view.in_indices_.begin());
+
+  // Reuse the degree array as the insertion cursor of each node
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t node) {
+        in_degrees[node] = node > 0 ? view.in_indices_[node - 1] : 0;
+      },
+      galois::no_stats());
+
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint32_t src) {
+        auto [begin, end] = topology.edge_range(src);
+        for (auto e = begin; e != end; ++e) {
+          uint32_t dst = topology.out_dests->Value(e);
+          uint64_t slot = __sync_fetch_and_add(&in_degrees[dst], 1);
+          view.in_sources_[slot] = src;
+          view.out_edges_[slot] = e;
+        }
+      },
+      galois::steal(), galois::no_stats(), galois::loopname("InEdgeViewFill"));
+
+  // Outgoing edge ids increase with their source, so sorting the sources and
+  // the edge ids of a node independently keeps the two arrays in step.
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint32_t node) {
+        auto [begin, end] = view.edge_range(node);
+        std::sort(&view.in_sources_[begin], &view.in_sources_[end]);
+        std::sort(&view.out_edges_[begin], &view.out_edges_[end]);
+      },
+      galois::steal(), galois::no_stats(), galois::loopname("InEdgeViewSort"));
+
+  return view;
+}
+
+galois::analytics::InEdgeView
+galois::analytics::InEdgeView::MakeSymmetric(
+    const graphs::PropertyFileGraph& pfg) {
+  InEdgeView view;
+  view.topology_ = &pfg.topology();
+  view.symmetric_ = true;
+  return view;
+}
+
+galois::analytics::Frontier
+galois::analytics::Frontier::FromNode(uint64_t num_nodes, uint32_t node) {
+  galois::InsertBag<uint32_t> nodes;
+  nodes.push(node);
+  return Frontier(num_nodes, std::move(nodes), 1);
+}
+
+galois::analytics::Frontier
+galois::analytics::Frontier::All(uint64_t num_nodes) {
+  galois::DynamicBitset nodes;
+  nodes.resize(num_nodes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t node) { nodes.set(node); }, galois::no_stats());
+  return Frontier(num_nodes, std::move(nodes), num_nodes);
+}
+
+void
+galois::analytics::Frontier::ToDense() {
+  if (dense_) {
+    return;
+  }
+  bits_.resize(num_nodes_);
+  galois::do_all(
+      galois::iterate(sparse_), [&](uint32_t node) { bits_.set(node); },
+      galois::no_stats());
+  sparse_.clear();
+  dense_ = true;
+}
+
+void
+galois::analytics::Frontier::ToSparse() {
+  if (!dense_) {
+    return;
+  }
+  bits_.for_each_set_bit([&](size_t node) { sparse_.push(node); });
+  bits_.resize(0);
+  dense_ = false;
+}
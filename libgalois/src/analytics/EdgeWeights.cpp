@@ -0,0 +1,98 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/EdgeWeights.h"
+
+#include <tuple>
+
+#include <arrow/api.h>
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/graphs/PropertyGraph.h"
+
+namespace {
+
+template <typename Weight>
+using EdgeWeight = galois::PODProperty<Weight>;
+
+template <typename Weight>
+galois::Result<void>
+CopyWeights(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    galois::LargeArray<double>* weights) {
+  using WeightGraph = galois::graphs::PropertyGraph<
+      std::tuple<>, std::tuple<EdgeWeight<Weight>>>;
+  auto graph = WeightGraph::Make(pfg, {}, {edge_weight_property_name});
+  if (!graph) {
+    return graph.error();
+  }
+
+  galois::GReduceLogicalOr negative;
+  galois::do_all(
+      galois::iterate(uint64_t{0}, pfg->topology().num_edges()),
+      [&](uint64_t e) {
+        double weight = graph.value().template GetEdgeData<EdgeWeight<Weight>>(
+            typename WeightGraph::edge_iterator(e));
+        negative.update(weight < 0);
+        (*weights)[e] = weight;
+      },
+      galois::no_stats(), galois::loopname("CopyWeights"));
+  if (negative.reduce()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+  return galois::ResultSuccess();
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::ReadEdgeWeights(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    galois::LargeArray<double>* weights) {
+  if (edge_weight_property_name.empty()) {
+    galois::do_all(
+        galois::iterate(uint64_t{0}, pfg->topology().num_edges()),
+        [&](uint64_t e) { (*weights)[e] = 1; }, galois::no_stats());
+    return galois::ResultSuccess();
+  }
+
+  auto property = pfg->EdgeProperty(edge_weight_property_name);
+  if (!property) {
+    return galois::ErrorCode::PropertyNotFound;
+  }
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return CopyWeights<uint32_t>(pfg, edge_weight_property_name, weights);
+  case arrow::Int32Type::type_id:
+    return CopyWeights<int32_t>(pfg, edge_weight_property_name, weights);
+  case arrow::UInt64Type::type_id:
+    return CopyWeights<uint64_t>(pfg, edge_weight_property_name, weights);
+  case arrow::Int64Type::type_id:
+    return CopyWeights<int64_t>(pfg, edge_weight_property_name, weights);
+  case arrow::FloatType::type_id:
+    return CopyWeights<float>(pfg, edge_weight_property_name, weights);
+  case arrow::DoubleType::type_id:
+    return CopyWeights<double>(pfg, edge_weight_property_name, weights);
+  default:
+    return galois::ErrorCode::TypeError;
+  }
+}
@@ -0,0 +1,318 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/betweenness_centrality/betweenness_centrality.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "galois/AtomicHelpers.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/analytics/EdgeMap.h"
+#include "galois/analytics/MultiSourceBfs.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+using namespace galois::analytics;
+
+using Graph = galois::graphs::PropertyGraph<
+    std::tuple<BetweennessCentralityNodeValue>, std::tuple<>>;
+using GNode = Graph::Node;
+
+namespace {
+
+constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+/// The per-thread state of OuterAlgo
+struct OuterScratch {
+  std::vector<double> centrality;
+  std::vector<double> sigma;
+  std::vector<double> delta;
+  std::vector<uint32_t> distance;
+  /// Nodes in the order they are reached, i.e., by distance
+  std::vector<uint32_t> order;
+};
+
+void
+OuterAlgo(Graph* graph, const std::vector<uint32_t>& sources) {
+  const uint64_t num_nodes = graph->size();
+
+  galois::substrate::PerThreadStorage<OuterScratch> scratch;
+  galois::on_each([&](unsigned, unsigned) {
+    OuterScratch& s = *scratch.getLocal();
+    s.centrality.assign(num_nodes, 0);
+    s.sigma.assign(num_nodes, 0);
+    s.delta.assign(num_nodes, 0);
+    s.distance.assign(num_nodes, kInfinity);
+  });
+
+  galois::do_all(
+      galois::iterate(sources),
+      [&](uint32_t source) {
+        OuterScratch& s = *scratch.getLocal();
+
+        s.order.clear();
+        s.order.emplace_back(source);
+        s.sigma[source] = 1;
+        s.distance[source] = 0;
+        for (size_t i = 0; i < s.order.size(); ++i) {
+          uint32_t v = s.order[i];
+          for (auto e : graph->edges(v)) {
+            uint32_t w = *graph->GetEdgeDest(e);
+            if (s.distance[w] == kInfinity) {
+              s.distance[w] = s.distance[v] + 1;
+              s.order.emplace_back(w);
+            }
+            if (s.distance[w] == s.distance[v] + 1) {
+              s.sigma[w] += s.sigma[v];
+            }
+          }
+        }
+
+        // Accumulate dependencies in reverse order of distance, without the
+        // source itself
+        for (size_t i = s.order.size(); i-- > 1;) {
+          uint32_t v = s.order[i];
+          double delta = 0;
+          for (auto e : graph->edges(v)) {
+            uint32_t w = *graph->GetEdgeDest(e);
+            if (s.distance[w] == s.distance[v] + 1) {
+              delta += s.sigma[v] / s.sigma[w] * (1 + s.delta[w]);
+            }
+          }
+          s.delta[v] = delta;
+          s.centrality[v] += delta;
+        }
+
+        for (uint32_t v : s.order) {
+          s.sigma[v] = 0;
+          s.delta[v] = 0;
+          s.distance[v] = kInfinity;
+        }
+      },
+      galois::steal(), galois::loopname("BetweennessCentralityOuter"));
+
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        double centrality = 0;
+        for (unsigned t = 0; t < galois::getActiveThreads(); ++t) {
+          centrality += scratch.getRemote(t)->centrality[node];
+        }
+        graph->GetData<BetweennessCentralityNodeValue>(node) = centrality;
+      },
+      galois::no_stats(), galois::loopname("ReduceCentrality"));
+}
+
+/// Brandes' algorithm on batches of kLanes sources. The shortest path counts
+/// (sigma) are accumulated along the shortest path DAG found by the
+/// MultiSourceBfs, and the dependencies (delta) of the nodes of each level
+/// are computed from the next level, whose searches are scattered into a
+/// dense array so that a node tests its out-neighbors with one lookup each.
+template <size_t kLanes>
+void
+MultiSourceAlgo(
+    Graph* graph, const InEdgeView& in_edges,
+    const std::vector<uint32_t>& sources) {
+  using Bfs = MultiSourceBfs<kLanes>;
+  using Lanes = typename Bfs::Lanes;
+  using Visit = typename Bfs::Visit;
+
+  const galois::graphs::GraphTopology& topology =
+      graph->GetPropertyFileGraph().topology();
+  const uint64_t num_nodes = graph->size();
+
+  auto index = [](uint32_t node, size_t lane) {
+    return static_cast<uint64_t>(node) * kLanes + lane;
+  };
+
+  galois::LargeArray<std::atomic<double>> sigma;
+  galois::LargeArray<double> delta;
+  galois::LargeArray<Lanes> next_level;
+  sigma.allocateBlocked(num_nodes * kLanes);
+  delta.allocateBlocked(num_nodes * kLanes);
+  next_level.allocateBlocked(num_nodes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t node) {
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+          sigma.constructAt(index(node, lane), 0.0);
+          delta[index(node, lane)] = 0;
+        }
+        next_level.constructAt(node);
+        graph->GetData<BetweennessCentralityNodeValue>(node) = 0;
+      },
+      galois::no_stats(), galois::loopname("InitializeMultiSource"));
+
+  Bfs bfs(topology, &in_edges);
+
+  uint64_t num_batches = 0;
+  for (size_t begin = 0; begin < sources.size(); begin += kLanes) {
+    ++num_batches;
+    const uint32_t* batch = &sources[begin];
+    size_t batch_size = std::min(kLanes, sources.size() - begin);
+
+    for (size_t lane = 0; lane < batch_size; ++lane) {
+      sigma[index(batch[lane], lane)].store(1, std::memory_order_relaxed);
+    }
+
+    size_t num_levels = bfs.Run(
+        batch, batch_size, [&](uint32_t src, uint32_t dst, const Lanes& lanes) {
+          lanes.ForEach([&](size_t lane) {
+            galois::atomicAdd(
+                sigma[index(dst, lane)],
+                sigma[index(src, lane)].load(std::memory_order_relaxed));
+          });
+        });
+
+    // The last level has no dependencies and the first only holds the
+    // sources
+    for (size_t d = num_levels - 1; d-- > 1;) {
+      galois::do_all(
+          galois::iterate(bfs.level(d + 1)),
+          [&](const Visit& v) { next_level[v.node] = v.lanes; },
+          galois::no_stats());
+
+      galois::do_all(
+          galois::iterate(bfs.level(d)),
+          [&](const Visit& v) {
+            auto [begin, end] = topology.edge_range(v.node);
+            for (auto e = begin; e != end; ++e) {
+              uint32_t w = topology.out_dests->Value(e);
+              Lanes successor = v.lanes & next_level[w];
+              successor.ForEach([&](size_t lane) {
+                delta[index(v.node, lane)] +=
+                    sigma[index(v.node, lane)].load(std::memory_order_relaxed) /
+                    sigma[index(w, lane)].load(std::memory_order_relaxed) *
+                    (1 + delta[index(w, lane)]);
+              });
+            }
+            double centrality = 0;
+            v.lanes.ForEach(
+                [&](size_t lane) { centrality += delta[index(v.node, lane)]; });
+            graph->GetData<BetweennessCentralityNodeValue>(v.node) +=
+                centrality;
+          },
+          galois::steal(), galois::no_stats(),
+          galois::loopname("MultiSourceDependency"));
+
+      galois::do_all(
+          galois::iterate(bfs.level(d + 1)),
+          [&](const Visit& v) { next_level[v.node] = Lanes(); },
+          galois::no_stats());
+    }
+
+    // Only reset the entries that the batch touched
+    for (size_t d = 0; d < num_levels; ++d) {
+      galois::do_all(
+          galois::iterate(bfs.level(d)),
+          [&](const Visit& v) {
+            v.lanes.ForEach([&](size_t lane) {
+              sigma[index(v.node, lane)].store(0, std::memory_order_relaxed);
+              delta[index(v.node, lane)] = 0;
+            });
+          },
+          galois::no_stats());
+    }
+  }
+
+  galois::ReportStatSingle(
+      "BetweennessCentrality", "Batches", num_batches);
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::BetweennessCentrality(
+    graphs::PropertyGraph<
+        std::tuple<BetweennessCentralityNodeValue>, std::tuple<>>& pg,
+    const std::vector<uint32_t>& sources, BetweennessCentralityPlan plan) {
+  for (uint32_t source : sources) {
+    if (source >= pg.size()) {
+      return galois::ErrorCode::InvalidArgument;
+    }
+  }
+
+  std::vector<uint32_t> all_nodes;
+  if (sources.empty()) {
+    all_nodes.resize(pg.size());
+    std::iota(all_nodes.begin(), all_nodes.end(), 0);
+  }
+  const std::vector<uint32_t>& search_sources =
+      sources.empty() ? all_nodes : sources;
+
+  galois::StatTimer execTime("BetweennessCentrality");
+
+  switch (plan.algorithm()) {
+  case BetweennessCentralityPlan::kOuter:
+    execTime.start();
+    OuterAlgo(&pg, search_sources);
+    execTime.stop();
+    break;
+  case BetweennessCentralityPlan::kMultiSource: {
+    // Each lane needs a shortest path count and a dependency per node. The
+    // arrays are sized for the number of lanes that the batch is rounded up
+    // to, so bound the batch by the largest number of lanes that fits.
+    uint64_t max_lanes = MultiSourceBfsLanesAtMost(ItemsWithinMemoryBudget(
+        pg.size() * 2 * sizeof(double), kMaxMultiSourceBfsLanes));
+    if (max_lanes == 0) {
+      return galois::ErrorCode::OutOfMemory;
+    }
+    uint64_t batch_size =
+        std::min<uint64_t>(std::max<uint32_t>(plan.batch_size(), 1), max_lanes);
+
+    galois::StatTimer transpose_time("Transpose", "BetweennessCentrality");
+    transpose_time.start();
+    InEdgeView in_edges = InEdgeView::Make(pg.GetPropertyFileGraph());
+    transpose_time.stop();
+
+    execTime.start();
+    WithMultiSourceBfsLanes(batch_size, [&](auto lanes) {
+      MultiSourceAlgo<decltype(lanes)::value>(&pg, in_edges, search_sources);
+    });
+    execTime.stop();
+    break;
+  }
+  default:
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::BetweennessCentrality(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::vector<uint32_t>& sources,
+    const std::string& output_property_name, BetweennessCentralityPlan plan) {
+  if (auto result = ConstructNodeProperties<
+          std::tuple<BetweennessCentralityNodeValue>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return BetweennessCentrality(pg_result.value(), sources, plan);
+}
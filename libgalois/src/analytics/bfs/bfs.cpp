@@ -20,6 +20,7 @@
 #include <deque>
 #include <type_traits>
 
+#include "galois/analytics/EdgeMap.h"
 #include "galois/analytics/bfs/bfs_internal.h"
 
 using namespace galois::analytics;
@@ -225,6 +226,43 @@ SyncAlgo(
   }
 }
 
+void
+DirectionOptAlgo(
+    Graph* graph, Graph::Node source, uint32_t alpha, uint32_t beta) {
+  const galois::graphs::PropertyFileGraph& pfg = graph->GetPropertyFileGraph();
+  const galois::graphs::GraphTopology& topology = pfg.topology();
+
+  galois::StatTimer transpose_time("Transpose", "BFS");
+  transpose_time.start();
+  InEdgeView in_edges = InEdgeView::Make(pfg);
+  transpose_time.stop();
+
+  EdgeMapPolicy policy;
+  policy.alpha = alpha;
+  policy.beta = beta;
+
+  graph->GetData<BfsNodeDistance>(source) = 0U;
+  Frontier frontier = Frontier::FromNode(graph->num_nodes(), source);
+  Dist next_level = 0U;
+
+  auto unvisited = [&](uint32_t dst) {
+    return graph->GetData<BfsNodeDistance>(dst) ==
+           BfsImplementation::kDistanceInfinity;
+  };
+
+  while (!frontier.empty()) {
+    ++next_level;
+    frontier = EdgeMap(
+        topology, &in_edges, &frontier,
+        [&](uint32_t, uint32_t dst, uint64_t) {
+          auto& dst_data = graph->GetData<BfsNodeDistance>(dst);
+          return __sync_bool_compare_and_swap(
+              &dst_data, BfsImplementation::kDistanceInfinity, next_level);
+        },
+        unvisited, policy);
+  }
+}
+
 template <bool CONCURRENT>
 void
 RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
@@ -246,6 +284,9 @@ RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
     SyncAlgo<CONCURRENT, Graph::Node>(
         graph, source, NodePushWrap(), OutEdgeRangeFn{graph});
     break;
+  case BfsPlan::kDirectionOpt:
+    DirectionOptAlgo(graph, source, algo.alpha(), algo.beta());
+    break;
   default:
     std::cerr << "ERROR: unkown algo type\n";
   }
@@ -0,0 +1,141 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/closeness_centrality/closeness_centrality.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include "galois/Galois.h"
+#include "galois/analytics/EdgeMap.h"
+#include "galois/analytics/MultiSourceBfs.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+using namespace galois::analytics;
+
+namespace {
+
+struct ClosenessCentralityNodeValue {
+  using ArrowType = arrow::CTypeTraits<double>::ArrowType;
+  using ViewType = galois::PODPropertyView<double>;
+};
+
+using Graph = galois::graphs::PropertyGraph<
+    std::tuple<ClosenessCentralityNodeValue>, std::tuple<>>;
+
+/// Searches from batches of kLanes consecutive nodes and counts, for each
+/// level, how many nodes each search reaches at that distance.
+template <size_t kLanes>
+void
+ClosenessAlgo(
+    Graph* graph, const InEdgeView& in_edges, ClosenessCentralityPlan plan) {
+  using Bfs = MultiSourceBfs<kLanes>;
+  using Visit = typename Bfs::Visit;
+  using Counts = std::array<uint64_t, kLanes>;
+
+  const galois::graphs::GraphTopology& topology =
+      graph->GetPropertyFileGraph().topology();
+  const uint64_t num_nodes = graph->size();
+
+  Bfs bfs(topology, &in_edges);
+  galois::substrate::PerThreadStorage<Counts> counts;
+
+  std::vector<uint32_t> batch(kLanes);
+  for (uint64_t begin = 0; begin < num_nodes; begin += kLanes) {
+    size_t batch_size = std::min<uint64_t>(kLanes, num_nodes - begin);
+    std::iota(batch.begin(), batch.begin() + batch_size, begin);
+
+    size_t num_levels = bfs.Run(batch.data(), batch_size);
+
+    std::array<uint64_t, kLanes> reached{};
+    std::array<uint64_t, kLanes> distance_sum{};
+    std::array<double, kLanes> harmonic{};
+    for (size_t d = 1; d < num_levels; ++d) {
+      galois::on_each(
+          [&](unsigned, unsigned) { counts.getLocal()->fill(0); });
+      galois::do_all(
+          galois::iterate(bfs.level(d)),
+          [&](const Visit& v) {
+            Counts& local = *counts.getLocal();
+            v.lanes.ForEach([&](size_t lane) { ++local[lane]; });
+          },
+          galois::no_stats(), galois::loopname("ClosenessCount"));
+
+      for (unsigned t = 0; t < galois::getActiveThreads(); ++t) {
+        const Counts& remote = *counts.getRemote(t);
+        for (size_t lane = 0; lane < batch_size; ++lane) {
+          reached[lane] += remote[lane];
+          distance_sum[lane] += d * remote[lane];
+          harmonic[lane] += static_cast<double>(remote[lane]) / d;
+        }
+      }
+    }
+
+    for (size_t lane = 0; lane < batch_size; ++lane) {
+      double value = 0;
+      if (plan.metric() == ClosenessCentralityPlan::kHarmonic) {
+        value = harmonic[lane];
+      } else if (distance_sum[lane] > 0) {
+        double r = reached[lane];
+        value = (r / (num_nodes - 1)) * (r / distance_sum[lane]);
+      }
+      graph->GetData<ClosenessCentralityNodeValue>(begin + lane) = value;
+    }
+  }
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::ClosenessCentrality(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name, ClosenessCentralityPlan plan) {
+  if (plan.metric() != ClosenessCentralityPlan::kCloseness &&
+      plan.metric() != ClosenessCentralityPlan::kHarmonic) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  if (auto result = ConstructNodeProperties<
+          std::tuple<ClosenessCentralityNodeValue>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph& graph = pg_result.value();
+
+  galois::StatTimer transpose_time("Transpose", "ClosenessCentrality");
+  transpose_time.start();
+  InEdgeView in_edges = InEdgeView::Make(*pfg);
+  transpose_time.stop();
+
+  galois::StatTimer execTime("ClosenessCentrality");
+  execTime.start();
+  WithMultiSourceBfsLanes(plan.batch_size(), [&](auto lanes) {
+    ClosenessAlgo<decltype(lanes)::value>(&graph, in_edges, plan);
+  });
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
@@ -0,0 +1,955 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/community_detection/community_detection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/ParallelSTL.h"
+#include "galois/Reduction.h"
+#include "galois/analytics/EdgeWeights.h"
+
+using namespace galois::analytics;
+
+using Graph = galois::graphs::PropertyGraph<
+    std::tuple<CommunityDetectionNodeCommunity>, std::tuple<>>;
+
+namespace {
+
+/// A map from community ids to values with open addressing, used to
+/// aggregate edges by the community of their destination without sorting
+/// them. Entries are visited in the order they were inserted and clearing
+/// only visits the entries in use, so each thread can reuse one map for
+/// every node.
+template <typename Value>
+class CommunityMap {
+  constexpr static uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+
+  std::vector<uint32_t> keys_;
+  std::vector<Value> values_;
+  /// The slots in use, in insertion order
+  std::vector<uint64_t> used_;
+  /// 64 minus the log of the capacity, for Fibonacci hashing
+  uint32_t shift_{0};
+
+  uint64_t Find(uint32_t community) const {
+    const uint64_t mask = keys_.size() - 1;
+    uint64_t slot = (community * UINT64_C(0x9E3779B97F4A7C15)) >> shift_;
+    while (keys_[slot] != community && keys_[slot] != kEmpty) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void Grow() {
+    std::vector<uint32_t> keys = std::move(keys_);
+    std::vector<Value> values = std::move(values_);
+    std::vector<uint64_t> used = std::move(used_);
+
+    const uint64_t capacity = std::max<uint64_t>(16, 2 * keys.size());
+    keys_.assign(capacity, kEmpty);
+    values_.resize(capacity);
+    used_.clear();
+    shift_ = 64 - __builtin_ctzll(capacity);
+    for (uint64_t slot : used) {
+      uint64_t new_slot = Find(keys[slot]);
+      keys_[new_slot] = keys[slot];
+      values_[new_slot] = values[slot];
+      used_.emplace_back(new_slot);
+    }
+  }
+
+public:
+  /// Returns the value of community, which is inserted as Value{} if it is
+  /// not in the map
+  Value& operator[](uint32_t community) {
+    if (2 * (used_.size() + 1) > keys_.size()) {
+      Grow();
+    }
+    uint64_t slot = Find(community);
+    if (keys_[slot] == kEmpty) {
+      keys_[slot] = community;
+      values_[slot] = Value{};
+      used_.emplace_back(slot);
+    }
+    return values_[slot];
+  }
+
+  uint64_t size() const { return used_.size(); }
+
+  template <typename F>
+  void ForEach(const F& fn) const {
+    for (uint64_t slot : used_) {
+      fn(keys_[slot], values_[slot]);
+    }
+  }
+
+  void Clear() {
+    for (uint64_t slot : used_) {
+      keys_[slot] = kEmpty;
+    }
+    used_.clear();
+  }
+};
+
+/// The nodes of every community of a graph, in increasing order.
+class Members {
+  galois::LargeArray<uint64_t> ends_;
+  galois::LargeArray<uint32_t> nodes_;
+
+public:
+  /// community must number the communities from 0 to num_communities - 1
+  Members(
+      const galois::LargeArray<uint32_t>& community, uint64_t num_nodes,
+      uint32_t num_communities) {
+    ends_.allocateBlocked(num_communities);
+    nodes_.allocateBlocked(num_nodes);
+
+    galois::do_all(
+        galois::iterate(uint32_t{0}, num_communities),
+        [&](uint32_t c) { ends_[c] = 0; }, galois::no_stats());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t node) {
+          __sync_fetch_and_add(&ends_[community[node]], 1);
+        },
+        galois::no_stats());
+    galois::ParallelSTL::partial_sum(ends_.begin(), ends_.end(), ends_.begin());
+
+    galois::LargeArray<uint64_t> cursors;
+    cursors.allocateBlocked(num_communities);
+    galois::do_all(
+        galois::iterate(uint32_t{0}, num_communities),
+        [&](uint32_t c) { cursors[c] = range(c).first; }, galois::no_stats());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t node) {
+          nodes_[__sync_fetch_and_add(&cursors[community[node]], 1)] = node;
+        },
+        galois::no_stats());
+    galois::do_all(
+        galois::iterate(uint32_t{0}, num_communities),
+        [&](uint32_t c) {
+          auto [begin, end] = range(c);
+          std::sort(&nodes_[begin], &nodes_[end]);
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("GroupMembers"));
+  }
+
+  std::pair<uint64_t, uint64_t> range(uint32_t c) const {
+    return {c > 0 ? ends_[c - 1] : 0, ends_[c]};
+  }
+
+  uint32_t node(uint64_t i) const { return nodes_[i]; }
+
+  uint32_t num_communities() const { return ends_.size(); }
+};
+
+/// A symmetric graph with weighted edges in CSR form. The input is copied
+/// into this form because every level of coarsening needs a new graph that
+/// works the same way.
+class WeightedGraph {
+  uint64_t num_nodes_{0};
+  galois::LargeArray<uint64_t> edge_ends_;
+  galois::LargeArray<uint32_t> dests_;
+  galois::LargeArray<double> weights_;
+  galois::LargeArray<double> degrees_;
+  double total_degree_{0};
+
+  void ComputeDegrees() {
+    degrees_.allocateBlocked(num_nodes_);
+    galois::GAccumulator<double> total;
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t node) {
+          double degree = 0;
+          auto [begin, end] = edge_range(node);
+          for (auto e = begin; e != end; ++e) {
+            degree += weights_[e];
+          }
+          degrees_[node] = degree;
+          total += degree;
+        },
+        galois::steal(), galois::no_stats());
+    total_degree_ = total.reduce();
+  }
+
+public:
+  static galois::Result<WeightedGraph> Make(
+      galois::graphs::PropertyFileGraph* pfg,
+      const std::string& edge_weight_property_name) {
+    const galois::graphs::GraphTopology& topology = pfg->topology();
+    WeightedGraph graph;
+    graph.num_nodes_ = topology.num_nodes();
+    graph.edge_ends_.allocateBlocked(topology.num_nodes());
+    graph.dests_.allocateBlocked(topology.num_edges());
+    graph.weights_.allocateBlocked(topology.num_edges());
+
+    if (auto r =
+            ReadEdgeWeights(pfg, edge_weight_property_name, &graph.weights_);
+        !r) {
+      return r.error();
+    }
+    galois::do_all(
+        galois::iterate(uint64_t{0}, topology.num_nodes()),
+        [&](uint64_t node) {
+          graph.edge_ends_[node] = topology.edge_range(node).second;
+        },
+        galois::no_stats());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, topology.num_edges()),
+        [&](uint64_t e) { graph.dests_[e] = topology.out_dests->Value(e); },
+        galois::no_stats());
+    graph.ComputeDegrees();
+    return graph;
+  }
+
+  uint64_t size() const { return num_nodes_; }
+
+  std::pair<uint64_t, uint64_t> edge_range(uint32_t node) const {
+    return {node > 0 ? edge_ends_[node - 1] : 0, edge_ends_[node]};
+  }
+
+  uint32_t dest(uint64_t e) const { return dests_[e]; }
+
+  double weight(uint64_t e) const { return weights_[e]; }
+
+  /// The sum of the weights of the edges of node, with self loops counted
+  /// once
+  double degree(uint32_t node) const { return degrees_[node]; }
+
+  /// The sum of the degrees of every node, i.e., twice the total weight of
+  /// the edges other than self loops
+  double total_degree() const { return total_degree_; }
+
+  /// Returns the graph with a node for every community of members, with an
+  /// edge between two communities weighing the total weight of the edges
+  /// between their members, and a self loop weighing the total weight of
+  /// the edges within the community. This keeps the modularity of every
+  /// clustering of the communities.
+  ///
+  /// The edges of a community are aggregated in a hash map twice, once to
+  /// count them and once to write them, which avoids keeping the edges of
+  /// every community in memory at once.
+  WeightedGraph Coarsen(
+      const galois::LargeArray<uint32_t>& community, const Members& members,
+      uint32_t num_communities) const {
+    WeightedGraph coarse;
+    coarse.num_nodes_ = num_communities;
+    coarse.edge_ends_.allocateBlocked(num_communities);
+    coarse.degrees_.allocateBlocked(num_communities);
+    coarse.total_degree_ = total_degree_;
+
+    galois::substrate::PerThreadStorage<CommunityMap<double>> maps;
+    auto aggregate = [&](uint32_t c) -> CommunityMap<double>& {
+      CommunityMap<double>& map = *maps.getLocal();
+      map.Clear();
+      auto [begin, end] = members.range(c);
+      for (uint64_t i = begin; i != end; ++i) {
+        auto [edges_begin, edges_end] = edge_range(members.node(i));
+        for (auto e = edges_begin; e != edges_end; ++e) {
+          map[community[dests_[e]]] += weights_[e];
+        }
+      }
+      return map;
+    };
+
+    galois::do_all(
+        galois::iterate(uint32_t{0}, num_communities),
+        [&](uint32_t c) {
+          coarse.edge_ends_[c] = aggregate(c).size();
+          double degree = 0;
+          auto [begin, end] = members.range(c);
+          for (uint64_t i = begin; i != end; ++i) {
+            degree += degrees_[members.node(i)];
+          }
+          coarse.degrees_[c] = degree;
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("CountEdges"));
+    galois::ParallelSTL::partial_sum(
+        coarse.edge_ends_.begin(), coarse.edge_ends_.end(),
+        coarse.edge_ends_.begin());
+
+    const uint64_t num_edges =
+        num_communities > 0 ? coarse.edge_ends_[num_communities - 1] : 0;
+    coarse.dests_.allocateBlocked(num_edges);
+    coarse.weights_.allocateBlocked(num_edges);
+    galois::do_all(
+        galois::iterate(uint32_t{0}, num_communities),
+        [&](uint32_t c) {
+          uint64_t e = coarse.edge_range(c).first;
+          aggregate(c).ForEach([&](uint32_t dest, double weight) {
+            coarse.dests_[e] = dest;
+            coarse.weights_[e] = weight;
+            ++e;
+          });
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("WriteEdges"));
+    return coarse;
+  }
+};
+
+/// The total degree and the number of nodes of every community.
+///
+/// Changes are not applied as nodes move. Instead, each thread records them
+/// in maps of its own, one for the communities owned by each thread, and
+/// after a batch of moves every thread applies the changes to the
+/// communities it owns. Nodes thus choose communities against the weights
+/// before the batch, and no weight is ever updated by two threads.
+class CommunityWeights {
+  struct Change {
+    double degree{0};
+    int64_t size{0};
+  };
+  using ChangeMaps = std::vector<CommunityMap<Change>>;
+
+  galois::LargeArray<double> degree_;
+  galois::LargeArray<int64_t> size_;
+  galois::substrate::PerThreadStorage<ChangeMaps> changes_;
+  unsigned num_threads_;
+
+public:
+  CommunityWeights(
+      const WeightedGraph& graph, const galois::LargeArray<uint32_t>& community)
+      : num_threads_(galois::getActiveThreads()) {
+    degree_.allocateBlocked(graph.size());
+    size_.allocateBlocked(graph.size());
+    galois::on_each([&](unsigned, unsigned) {
+      changes_.getLocal()->resize(num_threads_);
+    });
+    Reset(graph, community);
+  }
+
+  /// Starts over from the communities of the nodes of graph in community,
+  /// which must be numbered below the number of nodes
+  void Reset(
+      const WeightedGraph& graph,
+      const galois::LargeArray<uint32_t>& community) {
+    galois::do_all(
+        galois::iterate(uint64_t{0}, graph.size()),
+        [&](uint64_t c) {
+          degree_[c] = 0;
+          size_[c] = 0;
+        },
+        galois::no_stats());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, graph.size()),
+        [&](uint64_t node) { Join(community[node], graph.degree(node)); },
+        galois::no_stats());
+    Apply();
+  }
+
+  double degree(uint32_t c) const { return degree_[c]; }
+
+  int64_t size(uint32_t c) const { return size_[c]; }
+
+  /// Records that a node of the given degree joins c
+  void Join(uint32_t c, double degree) {
+    Change& change = (*changes_.getLocal())[c % num_threads_][c];
+    change.degree += degree;
+    change.size += 1;
+  }
+
+  /// Records that a node of the given degree leaves c
+  void Leave(uint32_t c, double degree) {
+    Change& change = (*changes_.getLocal())[c % num_threads_][c];
+    change.degree -= degree;
+    change.size -= 1;
+  }
+
+  /// Applies and forgets the recorded changes
+  void Apply() {
+    galois::on_each([&](unsigned tid, unsigned) {
+      for (unsigned t = 0; t < num_threads_; ++t) {
+        CommunityMap<Change>& map = (*changes_.getRemote(t))[tid];
+        map.ForEach([&](uint32_t c, const Change& change) {
+          degree_[c] += change.degree;
+          size_[c] += change.size;
+        });
+        map.Clear();
+      }
+    });
+  }
+};
+
+double
+ComputeModularity(
+    const WeightedGraph& graph, const galois::LargeArray<uint32_t>& community,
+    const CommunityWeights& weights, double resolution) {
+  if (graph.total_degree() == 0) {
+    return 0;
+  }
+
+  galois::GAccumulator<double> internal;
+  galois::GAccumulator<double> squares;
+  galois::do_all(
+      galois::iterate(uint64_t{0}, graph.size()),
+      [&](uint64_t node) {
+        auto [begin, end] = graph.edge_range(node);
+        for (auto e = begin; e != end; ++e) {
+          if (community[graph.dest(e)] == community[node]) {
+            internal += graph.weight(e);
+          }
+        }
+        // Communities are numbered below the number of nodes
+        squares += weights.degree(node) * weights.degree(node);
+      },
+      galois::steal(), galois::no_stats(), galois::loopname("Modularity"));
+  const double total = graph.total_degree();
+  return internal.reduce() / total -
+         resolution * squares.reduce() / (total * total);
+}
+
+/// The number of batches in which nodes move in every round
+constexpr uint64_t kNumBatches = 4;
+
+/// The batch of node in the given round. Batches are hashed anew every
+/// round, so that the same neighbors rarely move at the same time.
+uint64_t
+Batch(uint64_t node, uint64_t round) {
+  uint64_t hash = (node ^ (round << 32)) * UINT64_C(0x9e3779b97f4a7c15);
+  return (hash >> 32) % kNumBatches;
+}
+
+/// Moves the nodes of graph between communities in rounds until a round
+/// gains less than threshold, and returns the final modularity. In every
+/// round, each node moves to the neighboring community that increases
+/// modularity the most, or stays. Nodes move in batches that choose against
+/// the communities left by the previous batch; moving all nodes at once would
+/// let chains of neighbors follow each other around without ever meeting. A
+/// round that lowers modularity is undone.
+double
+MoveNodes(
+    const WeightedGraph& graph, double resolution, double threshold,
+    galois::LargeArray<uint32_t>* community, CommunityWeights* weights,
+    uint64_t* rounds) {
+  double modularity =
+      ComputeModularity(graph, *community, *weights, resolution);
+  if (graph.total_degree() == 0) {
+    return modularity;
+  }
+
+  galois::LargeArray<uint32_t> next;
+  galois::LargeArray<uint32_t> previous;
+  next.allocateBlocked(graph.size());
+  previous.allocateBlocked(graph.size());
+  galois::substrate::PerThreadStorage<CommunityMap<double>> maps;
+
+  for (uint64_t round = 0;; ++round) {
+    ++*rounds;
+    galois::do_all(
+        galois::iterate(uint64_t{0}, graph.size()),
+        [&](uint64_t node) { previous[node] = (*community)[node]; },
+        galois::no_stats());
+
+    galois::GAccumulator<uint64_t> moved;
+    for (uint64_t batch = 0; batch < kNumBatches; ++batch) {
+      galois::do_all(
+          galois::iterate(uint64_t{0}, graph.size()),
+          [&](uint64_t node) {
+            if (Batch(node, round) != batch) {
+              return;
+            }
+            const uint32_t current = (*community)[node];
+            next[node] = current;
+
+            // The weight of the edges of node to each neighboring community,
+            // always including its own
+            CommunityMap<double>& map = *maps.getLocal();
+            map.Clear();
+            map[current] = 0;
+            auto [begin, end] = graph.edge_range(node);
+            for (auto e = begin; e != end; ++e) {
+              uint32_t dest = graph.dest(e);
+              if (dest != node) {
+                map[(*community)[dest]] += graph.weight(e);
+              }
+            }
+
+            // The modularity gain of moving to c, scaled by total_degree / 2,
+            // is the change in the weight of the edges to the community of
+            // node, minus the change in the expected weight of those edges
+            const double degree = graph.degree(node);
+            const double to_current = map[current];
+            const double rest_of_current = weights->degree(current) - degree;
+            const double scale = resolution * degree / graph.total_degree();
+            uint32_t best = current;
+            double best_gain = 0;
+            map.ForEach([&](uint32_t c, double weight) {
+              if (c == current) {
+                return;
+              }
+              double gain = (weight - to_current) -
+                            scale * (weights->degree(c) - rest_of_current);
+              if (gain > best_gain ||
+                  (gain == best_gain && gain > 0 && c < best)) {
+                best = c;
+                best_gain = gain;
+              }
+            });
+
+            // Two singletons of the same batch that would join each other
+            // would only swap communities, so only the one with the larger
+            // community id moves
+            if (best != current && weights->size(best) == 1 &&
+                weights->size(current) == 1 && best > current) {
+              best = current;
+            }
+            if (best != current) {
+              next[node] = best;
+              weights->Leave(current, degree);
+              weights->Join(best, degree);
+              moved += 1;
+            }
+          },
+          galois::steal(), galois::no_stats(), galois::loopname("MoveNodes"));
+
+      weights->Apply();
+      galois::do_all(
+          galois::iterate(uint64_t{0}, graph.size()),
+          [&](uint64_t node) {
+            if (Batch(node, round) == batch) {
+              (*community)[node] = next[node];
+            }
+          },
+          galois::no_stats());
+    }
+    if (moved.reduce() == 0) {
+      break;
+    }
+
+    double next_modularity =
+        ComputeModularity(graph, *community, *weights, resolution);
+    if (next_modularity < modularity) {
+      std::swap(*community, previous);
+      weights->Reset(graph, *community);
+      break;
+    }
+
+    double gain = next_modularity - modularity;
+    modularity = next_modularity;
+    if (gain < threshold) {
+      break;
+    }
+  }
+  return modularity;
+}
+
+/// Splits every community into subcommunities (the refinement phase of
+/// Leiden) and stores the subcommunity of every node in subcommunity, where
+/// subcommunities are labeled by one of their nodes.
+///
+/// Communities are refined in parallel and the nodes of a community one at
+/// a time, in random order. Starting from singletons, each node that is
+/// well connected to the rest of its community and still alone joins one of
+/// the well-connected subcommunities of its community that do not lower
+/// modularity, or stays alone, at random.
+void
+Refine(
+    const WeightedGraph& graph, const galois::LargeArray<uint32_t>& community,
+    const Members& members, uint32_t num_communities, double resolution,
+    double randomness, galois::LargeArray<uint32_t>* subcommunity) {
+  struct Candidate {
+    uint32_t subcommunity;
+    double weight;
+    double gain;
+  };
+  struct Scratch {
+    CommunityMap<double> map;
+    std::vector<uint32_t> order;
+    std::vector<Candidate> candidates;
+  };
+
+  const uint64_t num_nodes = graph.size();
+  galois::LargeArray<double> sub_degree;
+  galois::LargeArray<double> sub_external;
+  galois::LargeArray<uint32_t> sub_size;
+  sub_degree.allocateBlocked(num_nodes);
+  sub_external.allocateBlocked(num_nodes);
+  sub_size.allocateBlocked(num_nodes);
+
+  const double scale = resolution / graph.total_degree();
+  galois::substrate::PerThreadStorage<Scratch> scratch;
+
+  galois::do_all(
+      galois::iterate(uint32_t{0}, num_communities),
+      [&](uint32_t c) {
+        Scratch& s = *scratch.getLocal();
+        auto [begin, end] = members.range(c);
+
+        // Start from singletons, where the external weight of a
+        // subcommunity is the weight of its edges to the rest of c
+        double community_degree = 0;
+        s.order.clear();
+        for (uint64_t i = begin; i != end; ++i) {
+          uint32_t node = members.node(i);
+          double external = 0;
+          auto [edges_begin, edges_end] = graph.edge_range(node);
+          for (auto e = edges_begin; e != edges_end; ++e) {
+            uint32_t dest = graph.dest(e);
+            if (dest != node && community[dest] == c) {
+              external += graph.weight(e);
+            }
+          }
+          (*subcommunity)[node] = node;
+          sub_degree[node] = graph.degree(node);
+          sub_external[node] = external;
+          sub_size[node] = 1;
+          community_degree += graph.degree(node);
+          s.order.emplace_back(node);
+        }
+        if (s.order.size() < 2) {
+          return;
+        }
+
+        auto well_connected = [&](uint32_t sub) {
+          return sub_external[sub] >= scale * sub_degree[sub] *
+                                          (community_degree - sub_degree[sub]);
+        };
+
+        std::mt19937 rng(s.order.front());
+        std::shuffle(s.order.begin(), s.order.end(), rng);
+        for (uint32_t node : s.order) {
+          if (sub_size[node] != 1 || (*subcommunity)[node] != node ||
+              !well_connected(node)) {
+            continue;
+          }
+
+          s.map.Clear();
+          auto [edges_begin, edges_end] = graph.edge_range(node);
+          for (auto e = edges_begin; e != edges_end; ++e) {
+            uint32_t dest = graph.dest(e);
+            if (dest != node && community[dest] == c) {
+              s.map[(*subcommunity)[dest]] += graph.weight(e);
+            }
+          }
+
+          // Staying alone gains nothing
+          const double degree = graph.degree(node);
+          s.candidates.clear();
+          s.candidates.emplace_back(Candidate{node, 0, 0});
+          double max_gain = 0;
+          s.map.ForEach([&](uint32_t sub, double weight) {
+            if (!well_connected(sub)) {
+              return;
+            }
+            double gain = weight - scale * degree * sub_degree[sub];
+            if (gain >= 0) {
+              s.candidates.emplace_back(Candidate{sub, weight, gain});
+              max_gain = std::max(max_gain, gain);
+            }
+          });
+
+          // Choose with probability proportional to exp(gain / randomness),
+          // relative to the best gain to avoid overflow
+          const Candidate* chosen = &s.candidates.front();
+          if (randomness > 0) {
+            double total = 0;
+            for (Candidate& candidate : s.candidates) {
+              total += std::exp((candidate.gain - max_gain) / randomness);
+              candidate.gain = total;
+            }
+            double r = std::uniform_real_distribution<double>(0, total)(rng);
+            for (const Candidate& candidate : s.candidates) {
+              chosen = &candidate;
+              if (r < candidate.gain) {
+                break;
+              }
+            }
+          } else {
+            for (const Candidate& candidate : s.candidates) {
+              if (candidate.gain > chosen->gain) {
+                chosen = &candidate;
+              }
+            }
+          }
+
+          const uint32_t target = chosen->subcommunity;
+          if (target != node) {
+            (*subcommunity)[node] = target;
+            sub_degree[target] += degree;
+            sub_external[target] += sub_external[node] - 2 * chosen->weight;
+            sub_size[target] += 1;
+            sub_size[node] = 0;
+          }
+        }
+      },
+      galois::steal(), galois::no_stats(), galois::loopname("Refine"));
+}
+
+/// Numbers the communities in community from 0, in the order of their
+/// current ids, which must be below num_nodes, and returns their number.
+uint32_t
+Renumber(galois::LargeArray<uint32_t>* community, uint64_t num_nodes) {
+  galois::LargeArray<uint32_t> ids;
+  ids.allocateBlocked(num_nodes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes), [&](uint64_t c) { ids[c] = 0; },
+      galois::no_stats());
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t node) { ids[(*community)[node]] = 1; }, galois::no_stats());
+  galois::ParallelSTL::partial_sum(ids.begin(), ids.end(), ids.begin());
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t node) {
+        (*community)[node] = ids[(*community)[node]] - 1;
+      },
+      galois::no_stats());
+  return num_nodes > 0 ? ids[num_nodes - 1] : 0;
+}
+
+/// Relabels the nodes of every community of graph by the connected part of
+/// the community they are in, where each part is labeled by one of its
+/// nodes. Splitting a community into parts without edges between them never
+/// lowers modularity.
+void
+SplitDisconnected(
+    const WeightedGraph& graph, const Members& members,
+    galois::LargeArray<uint32_t>* community) {
+  constexpr uint32_t kNoPart = std::numeric_limits<uint32_t>::max();
+  galois::LargeArray<uint32_t> part;
+  part.allocateBlocked(graph.size());
+  galois::do_all(
+      galois::iterate(uint64_t{0}, graph.size()),
+      [&](uint64_t node) { part[node] = kNoPart; }, galois::no_stats());
+
+  galois::substrate::PerThreadStorage<std::vector<uint32_t>> stacks;
+  galois::do_all(
+      galois::iterate(uint32_t{0}, members.num_communities()),
+      [&](uint32_t c) {
+        std::vector<uint32_t>& stack = *stacks.getLocal();
+        auto [begin, end] = members.range(c);
+        for (uint64_t i = begin; i != end; ++i) {
+          const uint32_t root = members.node(i);
+          if (part[root] != kNoPart) {
+            continue;
+          }
+          part[root] = root;
+          stack.emplace_back(root);
+          while (!stack.empty()) {
+            uint32_t node = stack.back();
+            stack.pop_back();
+            auto [edges_begin, edges_end] = graph.edge_range(node);
+            for (auto e = edges_begin; e != edges_end; ++e) {
+              uint32_t dest = graph.dest(e);
+              if ((*community)[dest] == c && graph.weight(e) > 0 &&
+                  part[dest] == kNoPart) {
+                part[dest] = root;
+                stack.emplace_back(dest);
+              }
+            }
+          }
+        }
+      },
+      galois::steal(), galois::no_stats(),
+      galois::loopname("SplitDisconnected"));
+
+  std::swap(*community, part);
+}
+
+galois::LargeArray<uint32_t>
+Identity(uint64_t size) {
+  galois::LargeArray<uint32_t> array;
+  array.allocateBlocked(size);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, size),
+      [&](uint64_t node) { array[node] = node; }, galois::no_stats());
+  return array;
+}
+
+/// Maps every node of the input from its node in the current level to the
+/// community of that node
+void
+Project(
+    galois::LargeArray<uint32_t>* node_community,
+    const galois::LargeArray<uint32_t>& community) {
+  galois::do_all(
+      galois::iterate(uint64_t{0}, node_community->size()),
+      [&](uint64_t node) {
+        (*node_community)[node] = community[(*node_community)[node]];
+      },
+      galois::no_stats());
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::CommunityDetection(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name, CommunityDetectionPlan plan) {
+  if (plan.algorithm() != CommunityDetectionPlan::kLouvain &&
+      plan.algorithm() != CommunityDetectionPlan::kLeiden) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+  if (!(plan.resolution() >= 0) || !(plan.randomness() >= 0)) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  galois::StatTimer execTime("CommunityDetection");
+  execTime.start();
+
+  auto graph_result = WeightedGraph::Make(pfg, edge_weight_property_name);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  WeightedGraph graph = std::move(graph_result.value());
+
+  if (auto r = ConstructNodeProperties<
+          std::tuple<CommunityDetectionNodeCommunity>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  // The node of the current level of every node of the input, and the
+  // community of every node of the current level
+  galois::LargeArray<uint32_t> node_community = Identity(graph.size());
+  galois::LargeArray<uint32_t> community = Identity(graph.size());
+
+  double modularity = -std::numeric_limits<double>::infinity();
+  uint32_t levels = 0;
+  uint64_t rounds = 0;
+  while (true) {
+    ++levels;
+    CommunityWeights weights(graph, community);
+    double previous_modularity = modularity;
+    modularity = MoveNodes(
+        graph, plan.resolution(), plan.modularity_threshold_per_round(),
+        &community, &weights, &rounds);
+    uint32_t num_communities = Renumber(&community, graph.size());
+
+    bool done = num_communities == graph.size() ||
+                modularity - previous_modularity <
+                    plan.modularity_threshold_total() ||
+                levels >= plan.max_iterations() ||
+                num_communities <= plan.min_graph_size();
+    Members members(community, graph.size(), num_communities);
+    if (!done && plan.algorithm() == CommunityDetectionPlan::kLouvain) {
+      Project(&node_community, community);
+      graph = graph.Coarsen(community, members, num_communities);
+      community = Identity(graph.size());
+      continue;
+    }
+
+    // Leiden coarsens by subcommunity and starts the next level from the
+    // communities of the subcommunities
+    if (!done) {
+      galois::LargeArray<uint32_t> subcommunity;
+      subcommunity.allocateBlocked(graph.size());
+      Refine(
+          graph, community, members, num_communities, plan.resolution(),
+          plan.randomness(), &subcommunity);
+      uint32_t num_subcommunities = Renumber(&subcommunity, graph.size());
+      if (num_subcommunities < graph.size()) {
+        Members sub_members(subcommunity, graph.size(), num_subcommunities);
+        galois::LargeArray<uint32_t> parent;
+        parent.allocateBlocked(num_subcommunities);
+        galois::do_all(
+            galois::iterate(uint64_t{0}, graph.size()),
+            [&](uint64_t node) {
+              parent[subcommunity[node]] = community[node];
+            },
+            galois::no_stats());
+
+        Project(&node_community, subcommunity);
+        graph = graph.Coarsen(subcommunity, sub_members, num_subcommunities);
+        community = std::move(parent);
+        continue;
+      }
+    }
+
+    // Leiden only guarantees connected communities once no node moves, so
+    // split any that stopping early left disconnected
+    if (plan.algorithm() == CommunityDetectionPlan::kLeiden) {
+      SplitDisconnected(graph, members, &community);
+      Renumber(&community, graph.size());
+      weights.Reset(graph, community);
+      modularity =
+          ComputeModularity(graph, community, weights, plan.resolution());
+    }
+    Project(&node_community, community);
+    break;
+  }
+
+  galois::ReportStatSingle("CommunityDetection", "Levels", levels);
+  galois::ReportStatSingle("CommunityDetection", "Rounds", rounds);
+  galois::ReportStatSingle("CommunityDetection", "Modularity", modularity);
+
+  Graph& pg = pg_result.value();
+  galois::do_all(
+      galois::iterate(pg),
+      [&](uint32_t node) {
+        pg.GetData<CommunityDetectionNodeCommunity>(node) =
+            node_community[node];
+      },
+      galois::no_stats());
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<double>
+galois::analytics::Modularity(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& community_property_name, double resolution) {
+  auto graph_result = WeightedGraph::Make(pfg, edge_weight_property_name);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  const WeightedGraph& graph = graph_result.value();
+
+  auto pg_result = Graph::Make(pfg, {community_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph& pg = pg_result.value();
+
+  galois::LargeArray<uint32_t> community;
+  community.allocateBlocked(graph.size());
+  galois::GReduceLogicalOr invalid;
+  galois::do_all(
+      galois::iterate(pg),
+      [&](uint32_t node) {
+        uint64_t c = pg.GetData<CommunityDetectionNodeCommunity>(node);
+        invalid.update(c >= graph.size());
+        community[node] = c;
+      },
+      galois::no_stats());
+  if (invalid.reduce()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  CommunityWeights weights(graph, community);
+  return ComputeModularity(graph, community, weights, resolution);
+}
@@ -0,0 +1,376 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/connected_components/connected_components.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+#include "galois/Bag.h"
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/analytics/EdgeMap.h"
+
+using namespace galois::analytics;
+
+using Graph = galois::graphs::PropertyGraph<
+    std::tuple<ConnectedComponentsNodeComponent>, std::tuple<>>;
+using GNode = Graph::Node;
+
+// Tiles already bound the work of an item, so steal them one at a time
+constexpr static unsigned kChunkSize = 1U;
+
+namespace {
+
+/// A union-find forest over node ids kept in the output property. Every node
+/// points to a node with a smaller id and roots point to themselves, so once
+/// every node points to its root, the label of a component is its smallest
+/// node.
+class Forest {
+  Graph* graph_;
+
+  std::atomic<uint32_t>& parent(uint32_t node) {
+    return graph_->GetData<ConnectedComponentsNodeComponent>(node);
+  }
+
+public:
+  explicit Forest(Graph* graph) : graph_(graph) {}
+
+  uint32_t Parent(uint32_t node) {
+    return parent(node).load(std::memory_order_relaxed);
+  }
+
+  void Initialize() {
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          parent(node).store(node, std::memory_order_relaxed);
+        },
+        galois::no_stats(), galois::loopname("Initialize"));
+  }
+
+  /// Joins the trees of a and b by hooking the larger of the two roots under
+  /// the smaller one. Lock-free; a failed hook retries from the new parents.
+  void Link(uint32_t a, uint32_t b) {
+    uint32_t p1 = Parent(a);
+    uint32_t p2 = Parent(b);
+    while (p1 != p2) {
+      uint32_t high = std::max(p1, p2);
+      uint32_t low = std::min(p1, p2);
+      uint32_t p_high = Parent(high);
+      if (p_high == low) {
+        return;
+      }
+      if (p_high == high &&
+          parent(high).compare_exchange_strong(
+              p_high, low, std::memory_order_relaxed)) {
+        return;
+      }
+      p1 = Parent(Parent(high));
+      p2 = Parent(low);
+    }
+  }
+
+  /// Points every node directly to its root.
+  void Compress() {
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          uint32_t p = Parent(node);
+          while (p != Parent(p)) {
+            p = Parent(p);
+          }
+          parent(node).store(p, std::memory_order_relaxed);
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("Compress"));
+  }
+
+  /// Returns the most frequent root among num_samples random nodes, which
+  /// approximates the root of the largest component. The forest must be
+  /// compressed, and num_samples and the graph may not be empty.
+  uint32_t SampleLargestRoot(uint32_t num_samples) {
+    // A fixed seed keeps the work done by Afforest reproducible
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<uint32_t> dist(0, graph_->size() - 1);
+    std::unordered_map<uint32_t, uint32_t> frequency;
+    for (uint32_t i = 0; i < num_samples; ++i) {
+      frequency[Parent(dist(rng))] += 1;
+    }
+
+    auto most_frequent = std::max_element(
+        frequency.begin(), frequency.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    galois::gDebug(
+        "Approximate largest intermediate component: ", most_frequent->first,
+        " (hit rate ", 100.0 * most_frequent->second / num_samples, "%)");
+    return most_frequent->first;
+  }
+};
+
+/// A range of the edges of a node
+struct EdgeTile {
+  uint32_t node;
+  uint64_t begin;
+  uint64_t end;
+};
+
+/// Splits the edges of each node for which include holds, as given by
+/// edge_range and without the first skip edges, into tiles of at most
+/// tile_size edges.
+template <typename Include, typename EdgeRange>
+void
+TileEdges(
+    Graph* graph, const Include& include, const EdgeRange& edge_range,
+    uint64_t skip, ptrdiff_t tile_size, galois::InsertBag<EdgeTile>* tiles) {
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        if (!include(node)) {
+          return;
+        }
+        auto [begin, end] = edge_range(node);
+        for (begin += std::min(skip, end - begin); begin < end;
+             begin += tile_size) {
+          tiles->push(EdgeTile{
+              node, begin, std::min<uint64_t>(begin + tile_size, end)});
+        }
+      },
+      galois::steal(), galois::no_stats(), galois::loopname("TileEdges"));
+}
+
+void
+EdgeTiledAsyncAlgo(Graph* graph, const ConnectedComponentsPlan& plan) {
+  const galois::graphs::GraphTopology& topology =
+      graph->GetPropertyFileGraph().topology();
+  Forest forest(graph);
+  forest.Initialize();
+
+  galois::InsertBag<EdgeTile> tiles;
+  TileEdges(
+      graph, [](uint32_t) { return true; },
+      [&](uint32_t node) { return topology.edge_range(node); }, 0,
+      plan.edge_tile_size(), &tiles);
+
+  // With every edge in both directions, linking each pair once is enough
+  const bool symmetric = plan.symmetric();
+  galois::do_all(
+      galois::iterate(tiles),
+      [&](const EdgeTile& tile) {
+        for (uint64_t e = tile.begin; e < tile.end; ++e) {
+          uint32_t dst = topology.out_dests->Value(e);
+          if (symmetric && tile.node >= dst) {
+            continue;
+          }
+          forest.Link(tile.node, dst);
+        }
+      },
+      galois::steal(), galois::chunk_size<kChunkSize>(),
+      galois::loopname("EdgeTiledAsync"));
+
+  forest.Compress();
+}
+
+/// Afforest. The sampling rounds use the outgoing edges only; an edge (u, v)
+/// left after sampling is linked from u unless u is in the skipped
+/// component, in which case it must be linked from v. On symmetric graphs
+/// that happens through the reverse edge (v, u), otherwise through the
+/// incoming edges of v.
+void
+AfforestAlgo(Graph* graph, const ConnectedComponentsPlan& plan) {
+  const galois::graphs::PropertyFileGraph& pfg = graph->GetPropertyFileGraph();
+  const galois::graphs::GraphTopology& topology = pfg.topology();
+  Forest forest(graph);
+  forest.Initialize();
+
+  for (uint32_t r = 0; r < plan.neighbor_samples(); ++r) {
+    galois::do_all(
+        galois::iterate(*graph),
+        [&](const GNode& node) {
+          auto [begin, end] = topology.edge_range(node);
+          if (begin + r < end) {
+            forest.Link(node, topology.out_dests->Value(begin + r));
+          }
+        },
+        galois::steal(), galois::loopname("AfforestSample"));
+    forest.Compress();
+  }
+
+  if (graph->size() == 0) {
+    return;
+  }
+  const uint32_t largest = forest.SampleLargestRoot(plan.component_samples());
+
+  auto not_largest = [&](uint32_t node) {
+    return forest.Parent(node) != largest;
+  };
+
+  galois::InsertBag<EdgeTile> out_tiles;
+  TileEdges(
+      graph, not_largest,
+      [&](uint32_t node) { return topology.edge_range(node); },
+      plan.neighbor_samples(), plan.edge_tile_size(), &out_tiles);
+  galois::do_all(
+      galois::iterate(out_tiles),
+      [&](const EdgeTile& tile) {
+        for (uint64_t e = tile.begin; e < tile.end; ++e) {
+          forest.Link(tile.node, topology.out_dests->Value(e));
+        }
+      },
+      galois::steal(), galois::chunk_size<kChunkSize>(),
+      galois::loopname("AfforestLink"));
+
+  if (!plan.symmetric()) {
+    galois::StatTimer transpose_time("Transpose", "ConnectedComponents");
+    transpose_time.start();
+    InEdgeView in_edges = InEdgeView::Make(pfg);
+    transpose_time.stop();
+
+    galois::InsertBag<EdgeTile> in_tiles;
+    TileEdges(
+        graph, not_largest,
+        [&](uint32_t node) { return in_edges.edge_range(node); }, 0,
+        plan.edge_tile_size(), &in_tiles);
+    galois::do_all(
+        galois::iterate(in_tiles),
+        [&](const EdgeTile& tile) {
+          for (uint64_t e = tile.begin; e < tile.end; ++e) {
+            forest.Link(tile.node, in_edges.GetEdgeSource(e));
+          }
+        },
+        galois::steal(), galois::chunk_size<kChunkSize>(),
+        galois::loopname("AfforestLinkIn"));
+  }
+
+  forest.Compress();
+}
+
+galois::Result<Graph>
+MakeGraph(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name) {
+  if (auto result =
+          ConstructNodeProperties<std::tuple<ConnectedComponentsNodeComponent>>(
+              pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  return Graph::Make(pfg, {output_property_name}, {});
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::ConnectedComponents(
+    graphs::PropertyGraph<
+        std::tuple<ConnectedComponentsNodeComponent>, std::tuple<>>& pg,
+    ConnectedComponentsPlan plan) {
+  if (plan.edge_tile_size() <= 0) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+  if (plan.algorithm() == ConnectedComponentsPlan::kAfforest &&
+      plan.component_samples() == 0) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  galois::StatTimer execTime("ConnectedComponents");
+  execTime.start();
+
+  switch (plan.algorithm()) {
+  case ConnectedComponentsPlan::kAfforest:
+    AfforestAlgo(&pg, plan);
+    break;
+  case ConnectedComponentsPlan::kEdgeTiledAsync:
+    EdgeTiledAsyncAlgo(&pg, plan);
+    break;
+  default:
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::ConnectedComponents(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name, ConnectedComponentsPlan plan) {
+  auto pg_result = MakeGraph(pfg, output_property_name);
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return ConnectedComponents(pg_result.value(), plan);
+}
+
+galois::Result<void>
+galois::analytics::ConnectedComponentsAddEdges(
+    graphs::PropertyGraph<
+        std::tuple<ConnectedComponentsNodeComponent>, std::tuple<>>& pg,
+    const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+  for (const auto& [src, dst] : edges) {
+    if (src >= pg.size() || dst >= pg.size()) {
+      return galois::ErrorCode::InvalidArgument;
+    }
+  }
+
+  // The labels of a finished run are a compressed forest, so the new edges
+  // only need to be linked into it
+  Forest forest(&pg);
+  galois::GReduceLogicalOr not_forest;
+  galois::do_all(
+      galois::iterate(pg),
+      [&](const GNode& node) {
+        uint32_t root = forest.Parent(node);
+        not_forest.update(root > node || forest.Parent(root) != root);
+      },
+      galois::no_stats(), galois::loopname("CheckLabels"));
+  if (not_forest.reduce()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  galois::StatTimer execTime("ConnectedComponentsAddEdges");
+  execTime.start();
+
+  galois::do_all(
+      galois::iterate(edges),
+      [&](const std::pair<uint32_t, uint32_t>& edge) {
+        forest.Link(edge.first, edge.second);
+      },
+      galois::steal(), galois::loopname("LinkNewEdges"));
+  forest.Compress();
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::ConnectedComponentsAddEdges(
+    galois::graphs::PropertyFileGraph* pfg, const std::string& property_name,
+    const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return ConnectedComponentsAddEdges(pg_result.value(), edges);
+}
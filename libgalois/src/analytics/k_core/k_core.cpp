@@ -0,0 +1,204 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/k_core/k_core.h"
+
+#include <vector>
+
+#include "galois/AtomicHelpers.h"
+#include "galois/Galois.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+using namespace galois::analytics;
+
+using Graph =
+    galois::graphs::PropertyGraph<std::tuple<KCoreNodeCoreness>, std::tuple<>>;
+using GNode = Graph::Node;
+
+constexpr static unsigned kChunkSize = 64U;
+
+namespace {
+
+struct PeelItem {
+  GNode node;
+  uint32_t degree;
+};
+
+struct PeelIndexer {
+  uint32_t operator()(const PeelItem& item) const { return item.degree; }
+};
+
+void
+DegreeCounting(Graph* graph) {
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        graph->GetData<KCoreNodeCoreness>(node).store(
+            std::distance(graph->edge_begin(node), graph->edge_end(node)),
+            std::memory_order_relaxed);
+      },
+      galois::no_stats(), galois::loopname("DegreeCounting"));
+}
+
+/// Removes nodes in order of their current degree. The barrier between
+/// priority levels means that every node of degree k is removed before any
+/// node of degree k + 1, so removing a node never lowers a neighbor below the
+/// level being processed, and the degree of a node when it is removed is its
+/// core number.
+void
+PeelAlgo(Graph* graph) {
+  using OBIM = galois::worklists::OrderedByIntegerMetric<
+      PeelIndexer, galois::worklists::PerSocketChunkFIFO<kChunkSize>>::
+      with_barrier<true>::type;
+
+  galois::InsertBag<PeelItem> initial;
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        initial.push(PeelItem{
+            node, graph->GetData<KCoreNodeCoreness>(node).load(
+                      std::memory_order_relaxed)});
+      },
+      galois::no_stats(), galois::loopname("InitialWorklist"));
+
+  galois::for_each(
+      galois::iterate(initial),
+      [&](const PeelItem& item, auto& ctx) {
+        // A node is pushed again each time its degree drops, so only the
+        // entry with its current degree is live
+        if (graph->GetData<KCoreNodeCoreness>(item.node).load(
+                std::memory_order_relaxed) != item.degree) {
+          return;
+        }
+
+        for (auto e : graph->edges(item.node)) {
+          auto& dest_degree =
+              graph->GetData<KCoreNodeCoreness>(graph->GetEdgeDest(e));
+          uint32_t old_degree = dest_degree.load(std::memory_order_relaxed);
+          while (old_degree > item.degree &&
+                 !dest_degree.compare_exchange_weak(
+                     old_degree, old_degree - 1, std::memory_order_relaxed)) {
+          }
+          if (old_degree > item.degree) {
+            ctx.push(PeelItem{*graph->GetEdgeDest(e), old_degree - 1});
+          }
+        }
+      },
+      galois::wl<OBIM>(PeelIndexer{}), galois::disable_conflict_detection(),
+      galois::loopname("KCorePeel"));
+}
+
+/// Lowers the value of every node to the h-index of its neighbors' values
+/// (the largest h such that at least h neighbors have a value of at least h)
+/// until a fixed point is reached. Values only decrease and never drop below
+/// the core number, and the only fixed point at or above the core numbers is
+/// the core numbers themselves, so the order of updates does not matter.
+void
+HIndexAlgo(Graph* graph) {
+  galois::substrate::PerThreadStorage<std::vector<uint32_t>> counts;
+
+  galois::for_each(
+      galois::iterate(*graph),
+      [&](const GNode& node, auto& ctx) {
+        auto& core = graph->GetData<KCoreNodeCoreness>(node);
+        uint32_t old_core = core.load(std::memory_order_relaxed);
+        if (old_core == 0) {
+          return;
+        }
+
+        // Neighbor values above old_core cannot raise the h-index past it
+        std::vector<uint32_t>& count = *counts.getLocal();
+        count.assign(old_core + 1, 0);
+        for (auto e : graph->edges(node)) {
+          uint32_t value = graph->GetData<KCoreNodeCoreness>(
+                                    graph->GetEdgeDest(e))
+                               .load(std::memory_order_relaxed);
+          ++count[std::min(value, old_core)];
+        }
+
+        uint32_t h = old_core;
+        uint32_t at_least_h = 0;
+        for (; h > 0; --h) {
+          at_least_h += count[h];
+          if (at_least_h >= h) {
+            break;
+          }
+        }
+
+        if (h >= galois::atomicMin(core, h)) {
+          return;
+        }
+
+        // Only neighbors with a larger value counted this node above h
+        for (auto e : graph->edges(node)) {
+          auto dest = graph->GetEdgeDest(e);
+          if (graph->GetData<KCoreNodeCoreness>(dest).load(
+                  std::memory_order_relaxed) > h) {
+            ctx.push(*dest);
+          }
+        }
+      },
+      galois::disable_conflict_detection(), galois::chunk_size<kChunkSize>(),
+      galois::loopname("KCoreHIndex"));
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::KCore(
+    graphs::PropertyGraph<std::tuple<KCoreNodeCoreness>, std::tuple<>>& pg,
+    KCorePlan plan) {
+  galois::StatTimer execTime("KCore");
+  execTime.start();
+
+  DegreeCounting(&pg);
+
+  switch (plan.algorithm()) {
+  case KCorePlan::kPeel:
+    PeelAlgo(&pg);
+    break;
+  case KCorePlan::kHIndex:
+    HIndexAlgo(&pg);
+    break;
+  default:
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::KCore(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name, KCorePlan plan) {
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCoreness>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return KCore(pg_result.value(), plan);
+}
@@ -0,0 +1,596 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/k_shortest_paths/k_shortest_paths.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/ArrowMemoryPool.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/analytics/EdgeMap.h"
+#include "galois/analytics/EdgeWeights.h"
+
+using namespace galois::analytics;
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+/// A simple path as its nodes from source to target and the edges between
+/// them.
+struct Path {
+  double length{0};
+  std::vector<uint32_t> nodes;
+  std::vector<uint64_t> edges;
+  //! The index of the node at which the path leaves the path it was found
+  //! from; spur nodes before it only lead to paths that were found before
+  uint32_t deviation{0};
+};
+
+/// The order of paths in the result: by length, then by nodes.
+bool
+Shorter(const Path& lhs, const Path& rhs) {
+  return lhs.length < rhs.length ||
+         (lhs.length == rhs.length && lhs.nodes < rhs.nodes);
+}
+
+/// The shortest path tree into a target, built with Dijkstra's algorithm
+/// along the incoming edges of every node. Removing nodes and edges never
+/// makes a node closer to the target, so its distance in the tree is a
+/// consistent A* heuristic for the spur searches.
+class ReverseTree {
+  const galois::graphs::GraphTopology& topology_;
+  const InEdgeView& in_edges_;
+  const galois::LargeArray<double>& weights_;
+  uint32_t target_{0};
+  galois::LargeArray<double> distance_;
+  galois::LargeArray<uint32_t> next_;
+  //! The outgoing edge that the incoming edge to next_ was built from
+  galois::LargeArray<uint64_t> next_edge_;
+
+public:
+  ReverseTree(
+      const galois::graphs::GraphTopology& topology,
+      const InEdgeView& in_edges, const galois::LargeArray<double>& weights)
+      : topology_(topology), in_edges_(in_edges), weights_(weights) {
+    distance_.allocateBlocked(topology.num_nodes());
+    next_.allocateBlocked(topology.num_nodes());
+    next_edge_.allocateBlocked(topology.num_nodes());
+  }
+
+  void Build(uint32_t target) {
+    target_ = target;
+    galois::do_all(
+        galois::iterate(uint64_t{0}, topology_.num_nodes()),
+        [&](uint64_t node) { distance_[node] = kInfinity; },
+        galois::no_stats());
+
+    using Item = std::pair<double, uint32_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    distance_[target] = 0;
+    queue.emplace(0, target);
+    while (!queue.empty()) {
+      auto [distance, node] = queue.top();
+      queue.pop();
+      if (distance > distance_[node]) {
+        continue;
+      }
+      auto [begin, end] = in_edges_.edge_range(node);
+      for (uint64_t e = begin; e < end; ++e) {
+        uint32_t src = in_edges_.GetEdgeSource(e);
+        uint64_t out_edge = in_edges_.GetOutEdge(e);
+        double new_distance = distance + weights_[out_edge];
+        if (new_distance < distance_[src]) {
+          distance_[src] = new_distance;
+          next_[src] = node;
+          next_edge_[src] = out_edge;
+          queue.emplace(new_distance, src);
+        }
+      }
+    }
+  }
+
+  uint32_t target() const { return target_; }
+
+  /// The distance of node to the target, or infinity if there is no path.
+  double distance(uint32_t node) const { return distance_[node]; }
+
+  /// The node after node on its path to the target.
+  uint32_t next(uint32_t node) const { return next_[node]; }
+
+  /// The edge from node to next(node).
+  uint64_t next_edge(uint32_t node) const {
+    if (!in_edges_.symmetric()) {
+      return next_edge_[node];
+    }
+    // Symmetric views hold the reverse edge, which has the same weight
+    auto [begin, end] = topology_.edge_range(node);
+    for (uint64_t e = begin; e < end; ++e) {
+      if (topology_.out_dests->Value(e) == next_[node] &&
+          weights_[e] == weights_[next_edge_[node]]) {
+        return e;
+      }
+    }
+    return next_edge_[node];
+  }
+};
+
+/// The state of a node in a spur search. Each field is only valid while the
+/// stamp it goes with matches the stamp of the search.
+struct SearchNode {
+  double cost;
+  uint64_t parent_edge;
+  uint32_t parent;
+  uint32_t reached;
+  uint32_t settled;
+  uint32_t on_root;
+  uint32_t checked;
+  uint32_t placed;
+  uint32_t position;
+  bool clean;
+};
+
+/// The memory of a thread for spur searches. Node states are reused across
+/// searches by stamping them rather than clearing them.
+struct SpurScratch {
+  uint32_t stamp{0};
+  std::vector<SearchNode> nodes;
+  std::vector<std::pair<double, uint32_t>> heap;
+  //! The nodes the spur node may not continue to
+  std::vector<uint32_t> blocked;
+  std::vector<uint32_t> chain;
+  std::vector<uint32_t> segment_nodes;
+  std::vector<uint64_t> segment_edges;
+
+  void Begin(uint64_t num_nodes) {
+    if (nodes.size() != num_nodes) {
+      nodes.assign(num_nodes, SearchNode{});
+      stamp = 0;
+    }
+    if (++stamp == 0) {
+      std::fill(nodes.begin(), nodes.end(), SearchNode{});
+      stamp = 1;
+    }
+    heap.clear();
+    blocked.clear();
+  }
+};
+
+/// Yen's algorithm for the queries of the target of a tree.
+class PathFinder {
+  const galois::graphs::GraphTopology& topology_;
+  const galois::LargeArray<double>& weights_;
+  const ReverseTree& tree_;
+  galois::substrate::PerThreadStorage<SpurScratch>& scratch_;
+
+  /// Returns true if the path of node in the tree avoids the root of the
+  /// current search of s. node must reach the target.
+  bool Clean(SpurScratch* s, uint32_t node) const {
+    s->chain.clear();
+    bool clean = true;
+    for (uint32_t n = node;; n = tree_.next(n)) {
+      const SearchNode& state = s->nodes[n];
+      if (state.checked == s->stamp) {
+        clean = state.clean;
+        break;
+      }
+      if (state.on_root == s->stamp) {
+        clean = false;
+        break;
+      }
+      s->chain.push_back(n);
+      if (n == tree_.target()) {
+        break;
+      }
+    }
+    for (uint32_t n : s->chain) {
+      s->nodes[n].checked = s->stamp;
+      s->nodes[n].clean = clean;
+    }
+    return clean;
+  }
+
+  /// Finds the shortest path that follows the last of paths up to its node
+  /// at spur_index and then leaves every path of paths with the same root,
+  /// if it is not longer than bound. shared holds the number of leading
+  /// nodes each path of paths shares with the last one and root_lengths the
+  /// lengths of the prefixes of the last one.
+  bool SpurPath(
+      const std::vector<Path>& paths, const std::vector<uint32_t>& shared,
+      const std::vector<double>& root_lengths, uint32_t spur_index,
+      double bound, Path* spur_path) const {
+    const Path& previous = paths.back();
+    uint32_t spur = previous.nodes[spur_index];
+    double root_length = root_lengths[spur_index];
+    if (root_length + tree_.distance(spur) > bound) {
+      return false;
+    }
+
+    SpurScratch& s = *scratch_.getLocal();
+    s.Begin(topology_.num_nodes());
+    const uint32_t stamp = s.stamp;
+    for (uint32_t i = 0; i <= spur_index; ++i) {
+      s.nodes[previous.nodes[i]].on_root = stamp;
+    }
+    for (size_t i = 0; i < paths.size(); ++i) {
+      if (shared[i] > spur_index) {
+        s.blocked.push_back(paths[i].nodes[spur_index + 1]);
+      }
+    }
+    auto is_blocked = [&s](uint32_t node) {
+      return std::find(s.blocked.begin(), s.blocked.end(), node) !=
+             s.blocked.end();
+    };
+
+    s.nodes[spur].cost = 0;
+    s.nodes[spur].reached = stamp;
+    s.heap.emplace_back(tree_.distance(spur), spur);
+
+    // A* search that ends at the first settled node whose path in the tree
+    // may complete the spur path: estimates of settled nodes never decrease,
+    // so no other spur path is shorter
+    bool found = false;
+    uint32_t last = spur;
+    while (!s.heap.empty()) {
+      std::pop_heap(s.heap.begin(), s.heap.end(), std::greater<>());
+      auto [estimate, node] = s.heap.back();
+      s.heap.pop_back();
+      SearchNode& state = s.nodes[node];
+      if (state.settled == stamp) {
+        continue;
+      }
+      if (root_length + estimate > bound) {
+        return false;
+      }
+      state.settled = stamp;
+
+      bool done = node == spur ? !is_blocked(tree_.next(spur)) &&
+                                     Clean(&s, tree_.next(spur))
+                               : Clean(&s, node);
+      if (done) {
+        found = true;
+        last = node;
+        break;
+      }
+
+      auto [begin, end] = topology_.edge_range(node);
+      for (uint64_t e = begin; e < end; ++e) {
+        uint32_t dst = topology_.out_dests->Value(e);
+        SearchNode& dst_state = s.nodes[dst];
+        if (dst_state.on_root == stamp || tree_.distance(dst) == kInfinity ||
+            (node == spur && is_blocked(dst))) {
+          continue;
+        }
+        double cost = state.cost + weights_[e];
+        if (dst_state.reached != stamp || cost < dst_state.cost) {
+          dst_state.reached = stamp;
+          dst_state.cost = cost;
+          dst_state.parent = node;
+          dst_state.parent_edge = e;
+          s.heap.emplace_back(cost + tree_.distance(dst), dst);
+          std::push_heap(s.heap.begin(), s.heap.end(), std::greater<>());
+        }
+      }
+    }
+    if (!found) {
+      return false;
+    }
+
+    // The spur path is the search path to last and then the path of last in
+    // the tree
+    s.segment_nodes.clear();
+    s.segment_edges.clear();
+    for (uint32_t node = last; node != spur; node = s.nodes[node].parent) {
+      s.segment_nodes.push_back(node);
+      s.segment_edges.push_back(s.nodes[node].parent_edge);
+    }
+    s.segment_nodes.push_back(spur);
+    std::reverse(s.segment_nodes.begin(), s.segment_nodes.end());
+    std::reverse(s.segment_edges.begin(), s.segment_edges.end());
+    for (uint32_t node = last; node != tree_.target();
+         node = tree_.next(node)) {
+      s.segment_edges.push_back(tree_.next_edge(node));
+      s.segment_nodes.push_back(tree_.next(node));
+    }
+
+    // The two parts may cross through edges of weight 0; cutting the cycles
+    // keeps the path simple and as short
+    spur_path->nodes.assign(
+        previous.nodes.begin(), previous.nodes.begin() + spur_index);
+    spur_path->edges.assign(
+        previous.edges.begin(), previous.edges.begin() + spur_index);
+    for (size_t i = 0; i < s.segment_nodes.size(); ++i) {
+      SearchNode& state = s.nodes[s.segment_nodes[i]];
+      if (state.placed == stamp) {
+        for (size_t p = state.position + 1; p < spur_path->nodes.size(); ++p) {
+          s.nodes[spur_path->nodes[p]].placed = 0;
+        }
+        spur_path->nodes.resize(state.position + 1);
+        spur_path->edges.resize(state.position);
+        continue;
+      }
+      state.placed = stamp;
+      state.position = spur_path->nodes.size();
+      if (i > 0) {
+        spur_path->edges.push_back(s.segment_edges[i - 1]);
+      }
+      spur_path->nodes.push_back(s.segment_nodes[i]);
+    }
+
+    spur_path->length = root_length;
+    for (size_t i = spur_index; i < spur_path->edges.size(); ++i) {
+      spur_path->length += weights_[spur_path->edges[i]];
+    }
+    spur_path->deviation = spur_index;
+    return spur_path->length <= bound;
+  }
+
+public:
+  PathFinder(
+      const galois::graphs::GraphTopology& topology,
+      const galois::LargeArray<double>& weights, const ReverseTree& tree,
+      galois::substrate::PerThreadStorage<SpurScratch>& scratch)
+      : topology_(topology),
+        weights_(weights),
+        tree_(tree),
+        scratch_(scratch) {}
+
+  /// The path of source in the tree.
+  Path TreePath(uint32_t source) const {
+    Path path;
+    path.nodes.push_back(source);
+    for (uint32_t node = source; node != tree_.target();
+         node = tree_.next(node)) {
+      uint64_t edge = tree_.next_edge(node);
+      path.edges.push_back(edge);
+      path.nodes.push_back(tree_.next(node));
+      path.length += weights_[edge];
+    }
+    return path;
+  }
+
+  /// Finds the k shortest simple paths from source to the target. The spur
+  /// searches of each path run in parallel if parallel is true.
+  void FindPaths(
+      uint32_t source, uint32_t k, bool parallel,
+      std::vector<Path>* paths) const {
+    if (tree_.distance(source) == kInfinity) {
+      return;
+    }
+    paths->push_back(TreePath(source));
+
+    std::set<std::vector<uint32_t>> seen{paths->back().nodes};
+    std::set<Path, decltype(&Shorter)> candidates(&Shorter);
+    std::vector<uint32_t> shared;
+    std::vector<double> root_lengths;
+    std::vector<Path> spur_paths;
+    std::vector<uint8_t> found;
+
+    while (paths->size() < k) {
+      const Path& previous = paths->back();
+      shared.resize(paths->size());
+      for (size_t i = 0; i < paths->size(); ++i) {
+        const Path& path = (*paths)[i];
+        shared[i] = std::mismatch(
+                        previous.nodes.begin(), previous.nodes.end(),
+                        path.nodes.begin(), path.nodes.end())
+                        .first -
+                    previous.nodes.begin();
+      }
+      root_lengths.resize(previous.nodes.size());
+      root_lengths[0] = 0;
+      for (size_t i = 0; i < previous.edges.size(); ++i) {
+        root_lengths[i + 1] = root_lengths[i] + weights_[previous.edges[i]];
+      }
+
+      // Only the best candidates that are still needed can be chosen, so a
+      // spur path longer than the last of them is not
+      size_t needed = k - paths->size();
+      double bound = candidates.size() < needed
+                         ? kInfinity
+                         : std::prev(candidates.end())->length;
+
+      uint32_t first = previous.deviation;
+      uint32_t last = previous.nodes.size() - 1;
+      spur_paths.assign(last - first, Path{});
+      found.assign(last - first, 0);
+      auto search = [&](uint32_t spur_index) {
+        found[spur_index - first] = SpurPath(
+            *paths, shared, root_lengths, spur_index, bound,
+            &spur_paths[spur_index - first]);
+      };
+      if (parallel) {
+        galois::do_all(
+            galois::iterate(first, last), search, galois::steal(),
+            galois::no_stats(), galois::loopname("SpurPaths"));
+      } else {
+        for (uint32_t spur_index = first; spur_index < last; ++spur_index) {
+          search(spur_index);
+        }
+      }
+
+      for (size_t i = 0; i < spur_paths.size(); ++i) {
+        if (found[i] && seen.insert(spur_paths[i].nodes).second) {
+          candidates.insert(std::move(spur_paths[i]));
+        }
+      }
+      while (candidates.size() > needed) {
+        candidates.erase(std::prev(candidates.end()));
+      }
+      if (candidates.empty()) {
+        break;
+      }
+      paths->push_back(
+          std::move(candidates.extract(candidates.begin()).value()));
+    }
+  }
+};
+
+galois::Result<std::shared_ptr<arrow::Array>>
+MakeListArray(
+    const std::shared_ptr<arrow::Array>& offsets,
+    const std::shared_ptr<arrow::Array>& values) {
+  auto res = arrow::ListArray::FromArrays(
+      *offsets, *values, galois::GetArrowMemoryPool());
+  if (!res.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", res.status());
+    return galois::ErrorCode::ArrowError;
+  }
+  return std::static_pointer_cast<arrow::Array>(res.ValueOrDie());
+}
+
+template <typename Builder, typename T>
+galois::Result<std::shared_ptr<arrow::Array>>
+MakeArray(const std::vector<T>& data) {
+  Builder builder(galois::GetArrowMemoryPool());
+  if (auto r = builder.AppendValues(data); !r.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", r);
+    return galois::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Array> array;
+  if (auto r = builder.Finish(&array); !r.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", r);
+    return galois::ErrorCode::ArrowError;
+  }
+  return array;
+}
+
+}  // namespace
+
+galois::Result<std::shared_ptr<arrow::Table>>
+galois::analytics::KShortestPaths(
+    graphs::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::pair<uint32_t, uint32_t>>& queries, uint32_t k,
+    KShortestPathsPlan plan) {
+  uint64_t num_nodes = pfg->topology().num_nodes();
+  if (k == 0 || plan.algorithm() != KShortestPathsPlan::kYen) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+  for (const auto& [source, target] : queries) {
+    if (source >= num_nodes || target >= num_nodes) {
+      return galois::ErrorCode::InvalidArgument;
+    }
+  }
+
+  galois::LargeArray<double> weights;
+  weights.allocateBlocked(pfg->topology().num_edges());
+  if (auto r = ReadEdgeWeights(pfg, edge_weight_property_name, &weights); !r) {
+    return r.error();
+  }
+
+  galois::StatTimer execTime("KShortestPaths");
+  execTime.start();
+
+  // Queries with the same target share its tree
+  std::vector<uint32_t> order(queries.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return queries[lhs].second < queries[rhs].second;
+  });
+
+  InEdgeView in_edges = plan.symmetric() ? InEdgeView::MakeSymmetric(*pfg)
+                                         : InEdgeView::Make(*pfg);
+  ReverseTree tree(pfg->topology(), in_edges, weights);
+  galois::substrate::PerThreadStorage<SpurScratch> scratch;
+  PathFinder finder(pfg->topology(), weights, tree, scratch);
+  std::vector<std::vector<Path>> paths(queries.size());
+  const unsigned num_threads = galois::getActiveThreads();
+
+  for (size_t begin = 0, end = 0; begin < order.size(); begin = end) {
+    uint32_t target = queries[order[begin]].second;
+    while (end < order.size() && queries[order[end]].second == target) {
+      ++end;
+    }
+    tree.Build(target);
+
+    if (end - begin >= num_threads) {
+      galois::do_all(
+          galois::iterate(begin, end),
+          [&](size_t i) {
+            uint32_t query = order[i];
+            finder.FindPaths(queries[query].first, k, false, &paths[query]);
+          },
+          galois::steal(), galois::loopname("KShortestPaths"));
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        uint32_t query = order[i];
+        finder.FindPaths(queries[query].first, k, true, &paths[query]);
+      }
+    }
+  }
+
+  execTime.stop();
+
+  std::vector<uint32_t> query_ids;
+  std::vector<double> lengths;
+  std::vector<int32_t> offsets{0};
+  std::vector<uint32_t> nodes;
+  for (uint32_t query = 0; query < paths.size(); ++query) {
+    for (const Path& path : paths[query]) {
+      // List offsets are 32-bit
+      if (nodes.size() + path.nodes.size() >
+          std::numeric_limits<int32_t>::max()) {
+        return galois::ErrorCode::InvalidArgument;
+      }
+      query_ids.push_back(query);
+      lengths.push_back(path.length);
+      nodes.insert(nodes.end(), path.nodes.begin(), path.nodes.end());
+      offsets.push_back(nodes.size());
+    }
+  }
+
+  auto query_array = MakeArray<arrow::UInt32Builder>(query_ids);
+  if (!query_array) {
+    return query_array.error();
+  }
+  auto length_array = MakeArray<arrow::DoubleBuilder>(lengths);
+  if (!length_array) {
+    return length_array.error();
+  }
+  auto offsets_array = MakeArray<arrow::Int32Builder>(offsets);
+  if (!offsets_array) {
+    return offsets_array.error();
+  }
+  auto nodes_array = MakeArray<arrow::UInt32Builder>(nodes);
+  if (!nodes_array) {
+    return nodes_array.error();
+  }
+  auto path_list = MakeListArray(offsets_array.value(), nodes_array.value());
+  if (!path_list) {
+    return path_list.error();
+  }
+
+  auto schema = arrow::schema({
+      arrow::field("query", arrow::uint32()),
+      arrow::field("length", arrow::float64()),
+      arrow::field("path", path_list.value()->type()),
+  });
+  return arrow::Table::Make(
+      schema, {query_array.value(), length_array.value(), path_list.value()});
+}
@@ -0,0 +1,420 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/pagerank/pagerank.h"
+
+#include <cmath>
+
+#include "galois/AtomicHelpers.h"
+#include "galois/DynamicBitset.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/analytics/EdgeMap.h"
+
+using namespace galois::analytics;
+
+using Graph =
+    galois::graphs::PropertyGraph<std::tuple<PageRankNodeRank>, std::tuple<>>;
+using GNode = Graph::Node;
+
+using Residual = galois::LargeArray<std::atomic<float>>;
+
+constexpr static unsigned kChunkSize = 64U;
+
+namespace {
+
+/// The distribution that random walks jump to: uniform over every node, or
+/// over the nodes of a source set for personalized PageRank
+class Teleport {
+  galois::DynamicBitset sources_;
+  bool personalized_{false};
+  float probability_{0};
+
+public:
+  explicit Teleport(uint64_t num_nodes)
+      : probability_(num_nodes > 0 ? 1.0f / num_nodes : 0) {}
+
+  Teleport(uint64_t num_nodes, const std::vector<uint32_t>& sources)
+      : personalized_(true) {
+    sources_.resize(num_nodes);
+    for (uint32_t source : sources) {
+      sources_.set(source);
+    }
+    probability_ = 1.0f / sources_.count();
+  }
+
+  float operator()(uint32_t node) const {
+    return !personalized_ || sources_.test(node) ? probability_ : 0;
+  }
+};
+
+uint32_t
+OutDegree(const Graph& graph, GNode node) {
+  return std::distance(graph.edge_begin(node), graph.edge_end(node));
+}
+
+/// Sets the rank of every node to 0 and its residual to its share of the
+/// teleported rank, which is all the rank a node has before any is passed on
+void
+InitializeResidual(
+    Graph* graph, const Teleport& teleport, float damping,
+    Residual* residual) {
+  residual->allocateBlocked(graph->size());
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        graph->GetData<PageRankNodeRank>(node).store(
+            0, std::memory_order_relaxed);
+        residual->constructAt(node, (1 - damping) * teleport(node));
+      },
+      galois::no_stats(), galois::loopname("InitializeResidual"));
+}
+
+/// Adds the residual that is left below the threshold to the ranks
+void
+FoldResidual(Graph* graph, const Residual& residual) {
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        auto& rank = graph->GetData<PageRankNodeRank>(node);
+        rank.store(
+            rank.load(std::memory_order_relaxed) +
+                residual[node].load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+      },
+      galois::no_stats(), galois::loopname("FoldResidual"));
+}
+
+/// The algorithms drop the rank that reaches nodes without outgoing edges.
+/// Jumping from those nodes according to the teleport distribution instead
+/// only scales every rank by the same factor, so normalizing the ranks to
+/// sum to 1 gives the same result.
+void
+Normalize(Graph* graph) {
+  galois::GAccumulator<double> total;
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        total += graph->GetData<PageRankNodeRank>(node).load(
+            std::memory_order_relaxed);
+      },
+      galois::no_stats(), galois::loopname("SumRanks"));
+
+  double sum = total.reduce();
+  if (sum <= 0) {
+    return;
+  }
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        auto& rank = graph->GetData<PageRankNodeRank>(node);
+        rank.store(
+            rank.load(std::memory_order_relaxed) / sum,
+            std::memory_order_relaxed);
+      },
+      galois::no_stats(), galois::loopname("Normalize"));
+}
+
+/// Jacobi iteration over the incoming edges. The contribution of every node
+/// to each of its out-neighbors is computed before the ranks are updated in
+/// place, so every round reads the ranks of the previous one.
+void
+PullAlgo(Graph* graph, const Teleport& teleport, const PageRankPlan& plan) {
+  const float damping = plan.damping();
+
+  galois::StatTimer transpose_time("Transpose", "PageRank");
+  transpose_time.start();
+  InEdgeView in_edges = InEdgeView::Make(graph->GetPropertyFileGraph());
+  transpose_time.stop();
+
+  galois::LargeArray<float> contribution;
+  contribution.allocateBlocked(graph->size());
+
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        graph->GetData<PageRankNodeRank>(node).store(
+            teleport(node), std::memory_order_relaxed);
+      },
+      galois::no_stats(), galois::loopname("InitializeRank"));
+
+  uint32_t iteration = 0;
+  while (iteration < plan.max_iterations()) {
+    ++iteration;
+
+    galois::do_all(
+        galois::iterate(*graph),
+        [&](const GNode& node) {
+          uint32_t degree = OutDegree(*graph, node);
+          contribution[node] =
+              degree > 0 ? graph->GetData<PageRankNodeRank>(node).load(
+                               std::memory_order_relaxed) /
+                               degree
+                         : 0;
+        },
+        galois::no_stats(), galois::loopname("Contribution"));
+
+    galois::GAccumulator<double> change;
+    galois::do_all(
+        galois::iterate(*graph),
+        [&](const GNode& node) {
+          float sum = 0;
+          auto [begin, end] = in_edges.edge_range(node);
+          for (auto e = begin; e != end; ++e) {
+            sum += contribution[in_edges.GetEdgeSource(e)];
+          }
+          auto& rank = graph->GetData<PageRankNodeRank>(node);
+          float new_rank = (1 - damping) * teleport(node) + damping * sum;
+          change += std::fabs(new_rank - rank.load(std::memory_order_relaxed));
+          rank.store(new_rank, std::memory_order_relaxed);
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("PageRankPull"));
+
+    if (change.reduce() <= plan.tolerance()) {
+      break;
+    }
+  }
+
+  galois::ReportStatSingle("PageRank", "Rounds", iteration);
+}
+
+/// Asynchronous push of residuals. A node is pushed to the worklist when its
+/// residual crosses the threshold, so it is usually on the worklist at most
+/// once; the residual is taken with an exchange and ranks are updated
+/// atomically in case it is processed by two threads at once.
+void
+PushAlgo(Graph* graph, const Teleport& teleport, const PageRankPlan& plan) {
+  const float damping = plan.damping();
+  const float threshold = plan.tolerance() / graph->size();
+
+  Residual residual;
+  InitializeResidual(graph, teleport, damping, &residual);
+
+  galois::InsertBag<GNode> initial;
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        if (residual[node].load(std::memory_order_relaxed) > threshold) {
+          initial.push(node);
+        }
+      },
+      galois::no_stats(), galois::loopname("InitialWorklist"));
+
+  galois::for_each(
+      galois::iterate(initial),
+      [&](const GNode& node, auto& ctx) {
+        float node_residual =
+            residual[node].exchange(0, std::memory_order_relaxed);
+        if (node_residual == 0) {
+          return;
+        }
+        galois::atomicAdd(
+            graph->GetData<PageRankNodeRank>(node), node_residual);
+
+        uint32_t degree = OutDegree(*graph, node);
+        if (degree == 0) {
+          return;
+        }
+        float delta = damping * node_residual / degree;
+        for (auto e : graph->edges(node)) {
+          auto dest = *graph->GetEdgeDest(e);
+          float old_residual = galois::atomicAdd(residual[dest], delta);
+          if (old_residual <= threshold && old_residual + delta > threshold) {
+            ctx.push(dest);
+          }
+        }
+      },
+      galois::wl<galois::worklists::PerSocketChunkFIFO<kChunkSize>>(),
+      galois::disable_conflict_detection(), galois::loopname("PageRankPush"));
+
+  FoldResidual(graph, residual);
+}
+
+/// Rounds of pushing the residual of every node above the threshold. A node
+/// not in the frontier has a residual of at most the threshold and the
+/// residuals of the nodes in the frontier are cleared before the updates of
+/// the round, so a node crosses the threshold at most once per round, which
+/// is what EdgeMap needs to build the next frontier without duplicates.
+void
+DeltaAlgo(Graph* graph, const Teleport& teleport, const PageRankPlan& plan) {
+  const float damping = plan.damping();
+  const float threshold = plan.tolerance() / graph->size();
+  const galois::graphs::PropertyFileGraph& pfg = graph->GetPropertyFileGraph();
+
+  galois::StatTimer transpose_time("Transpose", "PageRank");
+  transpose_time.start();
+  InEdgeView in_edges = InEdgeView::Make(pfg);
+  transpose_time.stop();
+
+  Residual residual;
+  InitializeResidual(graph, teleport, damping, &residual);
+
+  galois::LargeArray<float> delta;
+  delta.allocateBlocked(graph->size());
+
+  galois::InsertBag<uint32_t> initial;
+  galois::GAccumulator<uint64_t> initial_size;
+  galois::do_all(
+      galois::iterate(*graph),
+      [&](const GNode& node) {
+        if (residual[node].load(std::memory_order_relaxed) > threshold) {
+          initial.push(node);
+          initial_size += 1;
+        }
+      },
+      galois::no_stats(), galois::loopname("InitialFrontier"));
+  Frontier frontier(graph->size(), std::move(initial), initial_size.reduce());
+
+  uint32_t iteration = 0;
+  while (!frontier.empty() && iteration < plan.max_iterations()) {
+    ++iteration;
+
+    frontier.ForEach([&](uint32_t node) {
+      float node_residual =
+          residual[node].exchange(0, std::memory_order_relaxed);
+      auto& rank = graph->GetData<PageRankNodeRank>(node);
+      rank.store(
+          rank.load(std::memory_order_relaxed) + node_residual,
+          std::memory_order_relaxed);
+      uint32_t degree = OutDegree(*graph, node);
+      delta[node] = degree > 0 ? damping * node_residual / degree : 0;
+    });
+
+    frontier = EdgeMap(
+        pfg.topology(), &in_edges, &frontier,
+        [&](uint32_t src, uint32_t dst, uint64_t) {
+          float old_residual = galois::atomicAdd(residual[dst], delta[src]);
+          return old_residual <= threshold &&
+                 old_residual + delta[src] > threshold;
+        },
+        [](uint32_t) { return true; });
+  }
+
+  galois::ReportStatSingle("PageRank", "Rounds", iteration);
+
+  FoldResidual(graph, residual);
+}
+
+galois::Result<void>
+RunPageRank(Graph* graph, const Teleport& teleport, PageRankPlan plan) {
+  if (!(plan.damping() >= 0 && plan.damping() < 1) ||
+      !(plan.tolerance() >= 0)) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  galois::StatTimer execTime("PageRank");
+  execTime.start();
+
+  switch (plan.algorithm()) {
+  case PageRankPlan::kPull:
+    PullAlgo(graph, teleport, plan);
+    break;
+  case PageRankPlan::kPush:
+    PushAlgo(graph, teleport, plan);
+    break;
+  case PageRankPlan::kDelta:
+    DeltaAlgo(graph, teleport, plan);
+    break;
+  default:
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  Normalize(graph);
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+CheckSources(uint64_t num_nodes, const std::vector<uint32_t>& sources) {
+  if (sources.empty()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+  for (uint32_t source : sources) {
+    if (source >= num_nodes) {
+      return galois::ErrorCode::InvalidArgument;
+    }
+  }
+  return galois::ResultSuccess();
+}
+
+galois::Result<Graph>
+MakeGraph(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name) {
+  if (auto result = ConstructNodeProperties<std::tuple<PageRankNodeRank>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  return Graph::Make(pfg, {output_property_name}, {});
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::PageRank(
+    graphs::PropertyGraph<std::tuple<PageRankNodeRank>, std::tuple<>>& pg,
+    PageRankPlan plan) {
+  return RunPageRank(&pg, Teleport(pg.size()), plan);
+}
+
+galois::Result<void>
+galois::analytics::PageRank(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name, PageRankPlan plan) {
+  auto pg_result = MakeGraph(pfg, output_property_name);
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return PageRank(pg_result.value(), plan);
+}
+
+galois::Result<void>
+galois::analytics::PersonalizedPageRank(
+    graphs::PropertyGraph<std::tuple<PageRankNodeRank>, std::tuple<>>& pg,
+    const std::vector<uint32_t>& sources, PageRankPlan plan) {
+  if (auto result = CheckSources(pg.size(), sources); !result) {
+    return result.error();
+  }
+
+  return RunPageRank(&pg, Teleport(pg.size(), sources), plan);
+}
+
+galois::Result<void>
+galois::analytics::PersonalizedPageRank(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::vector<uint32_t>& sources,
+    const std::string& output_property_name, PageRankPlan plan) {
+  // Check before the output property is created
+  if (auto result = CheckSources(pfg->topology().num_nodes(), sources);
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = MakeGraph(pfg, output_property_name);
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return PersonalizedPageRank(pg_result.value(), sources, plan);
+}
@@ -0,0 +1,410 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/similarity/similarity.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/ArrowMemoryPool.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/SetIntersection.h"
+#include "galois/analytics/EdgeMap.h"
+
+using namespace galois::analytics;
+
+using NodeSimilarity = galois::PODProperty<double>;
+using EdgeSimilarityValue = galois::PODProperty<double>;
+
+namespace {
+
+/// Adjacency lists of a graph sorted by destination. The edge array of the
+/// graph is used directly if it is already sorted, otherwise a sorted copy is
+/// made so that the edge order (and the edge properties) are not changed.
+class SortedAdjacency {
+  const uint64_t* indices_;
+  const uint32_t* dests_;
+  galois::LargeArray<uint32_t> sorted_;
+
+public:
+  explicit SortedAdjacency(const galois::graphs::PropertyFileGraph& pfg)
+      : indices_(pfg.topology().out_indices->raw_values()),
+        dests_(pfg.topology().out_dests->raw_values()) {
+    uint64_t num_nodes = pfg.topology().num_nodes();
+
+    galois::GReduceLogicalOr unsorted;
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          if (!std::is_sorted(neighbors(n), neighbors(n) + degree(n))) {
+            unsorted.update(true);
+          }
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("CheckSorted"));
+    if (!unsorted.reduce()) {
+      return;
+    }
+
+    sorted_.allocateInterleaved(pfg.topology().num_edges());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          uint32_t* begin = sorted_.data() + (n > 0 ? indices_[n - 1] : 0);
+          std::copy(neighbors(n), neighbors(n) + degree(n), begin);
+          std::sort(begin, begin + degree(n));
+        },
+        galois::steal(), galois::no_stats(),
+        galois::loopname("SortAdjacency"));
+    dests_ = sorted_.data();
+  }
+
+  uint32_t degree(uint64_t n) const {
+    return indices_[n] - (n > 0 ? indices_[n - 1] : 0);
+  }
+
+  const uint32_t* neighbors(uint64_t n) const {
+    return dests_ + (n > 0 ? indices_[n - 1] : 0);
+  }
+};
+
+class Scorer {
+  const SortedAdjacency& adj_;
+  SimilarityPlan::Metric metric_;
+
+public:
+  Scorer(const SortedAdjacency& adj, SimilarityPlan::Metric metric)
+      : adj_(adj), metric_(metric) {}
+
+  double operator()(uint32_t u, uint32_t v) const {
+    uint32_t du = adj_.degree(u);
+    uint32_t dv = adj_.degree(v);
+    if (du == 0 || dv == 0) {
+      return 0;
+    }
+
+    if (metric_ == SimilarityPlan::kAdamicAdar) {
+      double score = 0;
+      galois::Intersect(
+          adj_.neighbors(u), du, adj_.neighbors(v), dv, [&](uint32_t w) {
+            uint32_t dw = adj_.degree(w);
+            if (dw > 1) {
+              score += 1.0 / std::log(static_cast<double>(dw));
+            }
+          });
+      return score;
+    }
+
+    double common = galois::IntersectCount(
+        adj_.neighbors(u), du, adj_.neighbors(v), dv);
+    switch (metric_) {
+    case SimilarityPlan::kJaccard:
+      return common / (du + dv - common);
+    case SimilarityPlan::kOverlap:
+      return common / std::min(du, dv);
+    case SimilarityPlan::kCosine:
+      return common / std::sqrt(static_cast<double>(du) * dv);
+    default:
+      return 0;
+    }
+  }
+
+  /// An upper bound of the similarity of two nodes with the given degrees.
+  /// It is computed like the similarity with the largest possible
+  /// intersection so that rounding never makes it smaller than the score.
+  double Bound(uint32_t du, uint32_t dv) const {
+    double common = std::min(du, dv);
+    switch (metric_) {
+    case SimilarityPlan::kJaccard:
+      return common / (du + dv - common);
+    case SimilarityPlan::kOverlap:
+      return 1;
+    case SimilarityPlan::kCosine:
+      return common / std::sqrt(static_cast<double>(du) * dv);
+    default:
+      return std::numeric_limits<double>::infinity();
+    }
+  }
+};
+
+struct ScoredNode {
+  double score;
+  uint32_t node;
+};
+
+/// Higher score first, then smaller node ID, so that results do not depend on
+/// the order in which candidates are scored
+bool
+Better(const ScoredNode& lhs, const ScoredNode& rhs) {
+  return lhs.score > rhs.score ||
+         (lhs.score == rhs.score && lhs.node < rhs.node);
+}
+
+struct TopKScratch {
+  std::vector<uint32_t> candidates;
+  //! Bounded heap with the worst of the best k so far at the front
+  std::vector<ScoredNode> heap;
+};
+
+galois::Result<std::shared_ptr<arrow::Array>>
+MakeListArray(
+    const std::shared_ptr<arrow::Array>& offsets,
+    const std::shared_ptr<arrow::Array>& values) {
+  auto res = arrow::ListArray::FromArrays(
+      *offsets, *values, galois::GetArrowMemoryPool());
+  if (!res.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", res.status());
+    return galois::ErrorCode::ArrowError;
+  }
+  return std::static_pointer_cast<arrow::Array>(res.ValueOrDie());
+}
+
+template <typename Builder, typename T>
+galois::Result<std::shared_ptr<arrow::Array>>
+MakeArray(const std::vector<T>& data) {
+  Builder builder(galois::GetArrowMemoryPool());
+  if (auto r = builder.AppendValues(data); !r.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", r);
+    return galois::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Array> array;
+  if (auto r = builder.Finish(&array); !r.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", r);
+    return galois::ErrorCode::ArrowError;
+  }
+  return array;
+}
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::Similarity(
+    graphs::PropertyFileGraph* pfg, size_t base_node,
+    const std::string& output_property_name, SimilarityPlan plan) {
+  if (base_node >= pfg->topology().num_nodes()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  if (auto r = ConstructNodeProperties<std::tuple<NodeSimilarity>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result =
+      graphs::PropertyGraph<std::tuple<NodeSimilarity>, std::tuple<>>::Make(
+          pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  galois::StatTimer execTime("Similarity");
+  execTime.start();
+
+  SortedAdjacency adj(*pfg);
+  Scorer scorer(adj, plan.metric());
+
+  galois::do_all(
+      galois::iterate(graph),
+      [&](uint32_t n) {
+        graph.GetData<NodeSimilarity>(n) = scorer(base_node, n);
+      },
+      galois::steal(), galois::loopname("Similarity"));
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::EdgeSimilarity(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    SimilarityPlan plan) {
+  if (auto r = ConstructEdgeProperties<std::tuple<EdgeSimilarityValue>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result = graphs::PropertyGraph<
+      std::tuple<>, std::tuple<EdgeSimilarityValue>>::
+      Make(pfg, {}, {output_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  galois::StatTimer execTime("EdgeSimilarity");
+  execTime.start();
+
+  SortedAdjacency adj(*pfg);
+  Scorer scorer(adj, plan.metric());
+
+  galois::do_all(
+      galois::iterate(graph),
+      [&](uint32_t n) {
+        for (auto e : graph.edges(n)) {
+          graph.GetEdgeData<EdgeSimilarityValue>(e) =
+              scorer(n, *graph.GetEdgeDest(e));
+        }
+      },
+      galois::steal(), galois::loopname("EdgeSimilarity"));
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::TopKSimilarity(
+    graphs::PropertyFileGraph* pfg, uint32_t k,
+    const std::string& output_nodes_property_name,
+    const std::string& output_scores_property_name, SimilarityPlan plan) {
+  uint64_t num_nodes = pfg->topology().num_nodes();
+  // List offsets are 32-bit
+  if (k == 0 || num_nodes * k > std::numeric_limits<int32_t>::max()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  galois::StatTimer execTime("TopKSimilarity");
+  execTime.start();
+
+  SortedAdjacency adj(*pfg);
+  Scorer scorer(adj, plan.metric());
+  uint32_t max_hub_degree = plan.max_hub_degree();
+  // The nodes that share neighbor w are the sources of the edges into w
+  InEdgeView in_edges = InEdgeView::Make(*pfg);
+
+  galois::LargeArray<ScoredNode> best;
+  best.allocateInterleaved(num_nodes * k);
+  std::vector<int32_t> offsets(num_nodes + 1);
+
+  galois::substrate::PerThreadStorage<TopKScratch> scratch;
+
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t u) {
+        TopKScratch& s = *scratch.getLocal();
+        s.candidates.clear();
+        s.heap.clear();
+
+        // Candidates are the other nodes with an edge to a non-hub neighbor
+        // of u
+        uint32_t du = adj.degree(u);
+        const uint32_t* u_neighbors = adj.neighbors(u);
+        for (uint32_t i = 0; i < du; ++i) {
+          auto [begin, end] = in_edges.edge_range(u_neighbors[i]);
+          if (max_hub_degree != 0 && end - begin > max_hub_degree) {
+            continue;
+          }
+          for (uint64_t e = begin; e < end; ++e) {
+            uint32_t v = in_edges.GetEdgeSource(e);
+            if (v != u) {
+              s.candidates.push_back(v);
+            }
+          }
+        }
+        std::sort(s.candidates.begin(), s.candidates.end());
+        s.candidates.erase(
+            std::unique(s.candidates.begin(), s.candidates.end()),
+            s.candidates.end());
+
+        // Score candidates with the best degree bound first, so that once the
+        // heap is full the remaining candidates can be skipped as soon as
+        // their bound cannot beat the worst result
+        std::sort(
+            s.candidates.begin(), s.candidates.end(),
+            [&](uint32_t lhs, uint32_t rhs) {
+              double lhs_bound = scorer.Bound(du, adj.degree(lhs));
+              double rhs_bound = scorer.Bound(du, adj.degree(rhs));
+              return lhs_bound > rhs_bound ||
+                     (lhs_bound == rhs_bound && lhs < rhs);
+            });
+
+        for (uint32_t v : s.candidates) {
+          if (s.heap.size() == k &&
+              scorer.Bound(du, adj.degree(v)) < s.heap.front().score) {
+            break;
+          }
+          ScoredNode scored{scorer(u, v), v};
+          if (s.heap.size() < k) {
+            s.heap.push_back(scored);
+            std::push_heap(s.heap.begin(), s.heap.end(), Better);
+          } else if (Better(scored, s.heap.front())) {
+            std::pop_heap(s.heap.begin(), s.heap.end(), Better);
+            s.heap.back() = scored;
+            std::push_heap(s.heap.begin(), s.heap.end(), Better);
+          }
+        }
+
+        std::sort_heap(s.heap.begin(), s.heap.end(), Better);
+        std::copy(s.heap.begin(), s.heap.end(), &best[u * k]);
+        offsets[u + 1] = s.heap.size();
+      },
+      galois::steal(), galois::loopname("TopKSimilarity"));
+
+  for (uint64_t u = 0; u < num_nodes; ++u) {
+    offsets[u + 1] += offsets[u];
+  }
+
+  std::vector<uint32_t> nodes(offsets[num_nodes]);
+  std::vector<double> scores(offsets[num_nodes]);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t u) {
+        for (int32_t i = 0; i < offsets[u + 1] - offsets[u]; ++i) {
+          nodes[offsets[u] + i] = best[u * k + i].node;
+          scores[offsets[u] + i] = best[u * k + i].score;
+        }
+      },
+      galois::no_stats(), galois::loopname("CompactTopK"));
+
+  execTime.stop();
+
+  auto offsets_array = MakeArray<arrow::Int32Builder>(offsets);
+  if (!offsets_array) {
+    return offsets_array.error();
+  }
+  auto nodes_array = MakeArray<arrow::UInt32Builder>(nodes);
+  if (!nodes_array) {
+    return nodes_array.error();
+  }
+  auto scores_array = MakeArray<arrow::DoubleBuilder>(scores);
+  if (!scores_array) {
+    return scores_array.error();
+  }
+  auto nodes_list = MakeListArray(offsets_array.value(), nodes_array.value());
+  if (!nodes_list) {
+    return nodes_list.error();
+  }
+  auto scores_list =
+      MakeListArray(offsets_array.value(), scores_array.value());
+  if (!scores_list) {
+    return scores_list.error();
+  }
+
+  auto schema = arrow::schema({
+      arrow::field(output_nodes_property_name, nodes_list.value()->type()),
+      arrow::field(output_scores_property_name, scores_list.value()->type()),
+  });
+  return pfg->AddNodeProperties(
+      arrow::Table::Make(schema, {nodes_list.value(), scores_list.value()}));
+}
@@ -0,0 +1,418 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/strongly_connected_components/strongly_connected_components.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "galois/AtomicHelpers.h"
+#include "galois/Bag.h"
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+#include "galois/analytics/EdgeMap.h"
+
+using namespace galois::analytics;
+
+using Graph = galois::graphs::PropertyGraph<
+    std::tuple<StronglyConnectedComponentsNodeComponent>, std::tuple<>>;
+using GNode = Graph::Node;
+
+using Nodes = galois::InsertBag<uint32_t>;
+
+constexpr static unsigned kChunkSize = 64U;
+constexpr static uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+constexpr static uint64_t kNoColor = std::numeric_limits<uint64_t>::max();
+
+namespace {
+
+/// Coloring orders nodes by a hash of their id rather than by their id, so
+/// that the number of rounds does not depend on how nodes are numbered: with
+/// ids, a chain of components that only reach components with larger ids
+/// finishes one component per round. The id in the low bits keeps the
+/// priorities distinct.
+uint64_t
+Priority(uint32_t node) {
+  uint32_t hash = node;
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bU;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35U;
+  hash ^= hash >> 16;
+  return (uint64_t{hash} << 32) | node;
+}
+
+/// The state of a run. Until a node is assigned to a component, its node
+/// data is kUnassigned; components are first labeled by a node of their own
+/// and relabeled by their smallest node at the end.
+///
+/// Every assigned node removes its edges from the degrees of its neighbors
+/// exactly once, either when it is trimmed or in Detach, so the degrees only
+/// count edges between unassigned nodes.
+class Scc {
+  Graph* graph_;
+  const galois::graphs::GraphTopology& topology_;
+  InEdgeView in_edges_;
+  galois::LargeArray<std::atomic<uint32_t>> in_degree_;
+  galois::LargeArray<std::atomic<uint32_t>> out_degree_;
+  galois::LargeArray<std::atomic<uint64_t>> color_;
+
+  std::atomic<uint32_t>& component(uint32_t node) {
+    return graph_->GetData<StronglyConnectedComponentsNodeComponent>(node);
+  }
+
+  bool Unassigned(uint32_t node) {
+    return component(node).load(std::memory_order_relaxed) == kUnassigned;
+  }
+
+  bool Claim(uint32_t node, uint32_t id) {
+    uint32_t expected = kUnassigned;
+    return component(node).compare_exchange_strong(
+        expected, id, std::memory_order_relaxed);
+  }
+
+  template <typename F>
+  void ForEachOut(uint32_t node, const F& fn) {
+    auto [begin, end] = topology_.edge_range(node);
+    for (auto e = begin; e != end; ++e) {
+      fn(topology_.out_dests->Value(e));
+    }
+  }
+
+  template <typename F>
+  void ForEachIn(uint32_t node, const F& fn) {
+    auto [begin, end] = in_edges_.edge_range(node);
+    for (auto e = begin; e != end; ++e) {
+      fn(in_edges_.GetEdgeSource(e));
+    }
+  }
+
+  /// Removes the edges of node from the degrees of its neighbors and calls
+  /// trimmable(neighbor) for every unassigned neighbor left without incoming
+  /// or outgoing edges.
+  template <typename F>
+  void RemoveEdges(uint32_t node, const F& trimmable) {
+    ForEachOut(node, [&](uint32_t dst) {
+      if (in_degree_[dst].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+          Unassigned(dst)) {
+        trimmable(dst);
+      }
+    });
+    ForEachIn(node, [&](uint32_t src) {
+      if (out_degree_[src].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+          Unassigned(src)) {
+        trimmable(src);
+      }
+    });
+  }
+
+public:
+  explicit Scc(Graph* graph)
+      : graph_(graph),
+        topology_(graph->GetPropertyFileGraph().topology()) {
+    galois::StatTimer transpose_time(
+        "Transpose", "StronglyConnectedComponents");
+    transpose_time.start();
+    in_edges_ = InEdgeView::Make(graph->GetPropertyFileGraph());
+    transpose_time.stop();
+
+    in_degree_.allocateBlocked(graph->size());
+    out_degree_.allocateBlocked(graph->size());
+    color_.allocateBlocked(graph->size());
+  }
+
+  /// Marks every node as unassigned and returns the nodes without incoming
+  /// or outgoing edges in trimmable.
+  void Initialize(Nodes* trimmable) {
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          component(node).store(kUnassigned, std::memory_order_relaxed);
+          color_[node].store(kNoColor, std::memory_order_relaxed);
+          auto [out_begin, out_end] = topology_.edge_range(node);
+          auto [in_begin, in_end] = in_edges_.edge_range(node);
+          out_degree_[node].store(
+              out_end - out_begin, std::memory_order_relaxed);
+          in_degree_[node].store(in_end - in_begin, std::memory_order_relaxed);
+          if (out_end == out_begin || in_end == in_begin) {
+            trimmable->push(node);
+          }
+        },
+        galois::no_stats(), galois::loopname("Initialize"));
+  }
+
+  /// Assigns the nodes in trimmable, and the nodes left without incoming or
+  /// outgoing edges by removing them, to components of their own. Returns
+  /// the number of nodes assigned.
+  uint64_t Trim(Nodes* trimmable) {
+    galois::GAccumulator<uint64_t> trimmed;
+    galois::for_each(
+        galois::iterate(*trimmable),
+        [&](uint32_t node, auto& ctx) {
+          if (!Claim(node, node)) {
+            return;
+          }
+          trimmed += 1;
+          RemoveEdges(node, [&](uint32_t neighbor) { ctx.push(neighbor); });
+        },
+        galois::wl<galois::worklists::PerSocketChunkFIFO<kChunkSize>>(),
+        galois::disable_conflict_detection(), galois::loopname("Trim"));
+    trimmable->clear();
+    return trimmed.reduce();
+  }
+
+  /// Removes the nodes assigned by a search from the degrees of their
+  /// neighbors and collects the nodes this leaves trimmable.
+  void Detach(Nodes* assigned, Nodes* trimmable) {
+    galois::do_all(
+        galois::iterate(*assigned),
+        [&](uint32_t node) {
+          RemoveEdges(
+              node, [&](uint32_t neighbor) { trimmable->push(neighbor); });
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("Detach"));
+    assigned->clear();
+  }
+
+  /// Finds the component of the unassigned node with the largest product of
+  /// in and out degree, which is likely in the largest component, as the
+  /// nodes reached both by a forward search from it and by a backward search
+  /// within the forward reachable set.
+  void ForwardBackward(Nodes* assigned) {
+    galois::GReduceMax<uint64_t> best;
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          if (!Unassigned(node)) {
+            return;
+          }
+          uint64_t product =
+              uint64_t{in_degree_[node].load(std::memory_order_relaxed)} *
+              out_degree_[node].load(std::memory_order_relaxed);
+          // Ties and overflows resolve to the largest node
+          best.update(
+              (std::min<uint64_t>(product, kUnassigned) << 32) | node);
+        },
+        galois::no_stats(), galois::loopname("SelectPivot"));
+    // After trimming, every unassigned node has a positive product
+    if (best.reduce() == 0) {
+      return;
+    }
+    const uint32_t pivot = best.reduce() & kUnassigned;
+
+    Nodes roots;
+    roots.push(pivot);
+    color_[pivot].store(Priority(pivot), std::memory_order_relaxed);
+    galois::for_each(
+        galois::iterate(roots),
+        [&](uint32_t node, auto& ctx) {
+          ForEachOut(node, [&](uint32_t dst) {
+            uint64_t expected = kNoColor;
+            if (Unassigned(dst) &&
+                color_[dst].compare_exchange_strong(
+                    expected, Priority(pivot), std::memory_order_relaxed)) {
+              ctx.push(dst);
+            }
+          });
+        },
+        galois::wl<galois::worklists::PerSocketChunkFIFO<kChunkSize>>(),
+        galois::disable_conflict_detection(), galois::loopname("Forward"));
+
+    Claim(pivot, pivot);
+    assigned->push(pivot);
+    Backward(&roots, assigned);
+  }
+
+  /// Collects the component of each root, i.e., the unassigned nodes of the
+  /// same color that reach it. The roots must already be assigned.
+  void Backward(Nodes* roots, Nodes* assigned) {
+    galois::for_each(
+        galois::iterate(*roots),
+        [&](uint32_t node, auto& ctx) {
+          uint32_t id = component(node).load(std::memory_order_relaxed);
+          uint64_t color = Priority(id);
+          ForEachIn(node, [&](uint32_t src) {
+            if (color_[src].load(std::memory_order_relaxed) == color &&
+                Claim(src, id)) {
+              assigned->push(src);
+              ctx.push(src);
+            }
+          });
+        },
+        galois::wl<galois::worklists::PerSocketChunkFIFO<kChunkSize>>(),
+        galois::disable_conflict_detection(), galois::loopname("Backward"));
+  }
+
+  /// One round of coloring over the unassigned nodes in remaining. Every
+  /// node that keeps its own color is the node of largest priority in its
+  /// component, because any node of larger priority in the component would
+  /// reach it.
+  void Coloring(Nodes& remaining, Nodes* assigned) {
+    galois::do_all(
+        galois::iterate(remaining),
+        [&](uint32_t node) {
+          color_[node].store(Priority(node), std::memory_order_relaxed);
+        },
+        galois::no_stats(), galois::loopname("ResetColors"));
+
+    galois::for_each(
+        galois::iterate(remaining),
+        [&](uint32_t node, auto& ctx) {
+          uint64_t color = color_[node].load(std::memory_order_relaxed);
+          ForEachOut(node, [&](uint32_t dst) {
+            if (Unassigned(dst) &&
+                galois::atomicMax(color_[dst], color) < color) {
+              ctx.push(dst);
+            }
+          });
+        },
+        galois::wl<galois::worklists::PerSocketChunkFIFO<kChunkSize>>(),
+        galois::disable_conflict_detection(), galois::loopname("Color"));
+
+    Nodes roots;
+    galois::do_all(
+        galois::iterate(remaining),
+        [&](uint32_t node) {
+          uint64_t color = color_[node].load(std::memory_order_relaxed);
+          if (color == Priority(node)) {
+            Claim(node, node);
+            assigned->push(node);
+            roots.push(node);
+          }
+        },
+        galois::no_stats(), galois::loopname("FindRoots"));
+
+    Backward(&roots, assigned);
+  }
+
+  /// Returns the unassigned nodes of graph, or of remaining if given.
+  Nodes Remaining(Nodes* remaining = nullptr) {
+    Nodes next;
+    auto keep = [&](uint32_t node) {
+      if (Unassigned(node)) {
+        next.push(node);
+      }
+    };
+    if (remaining) {
+      galois::do_all(
+          galois::iterate(*remaining), keep, galois::no_stats(),
+          galois::loopname("Remaining"));
+    } else {
+      galois::do_all(
+          galois::iterate(*graph_), keep, galois::no_stats(),
+          galois::loopname("Remaining"));
+    }
+    return next;
+  }
+
+  /// Relabels every component by its smallest node.
+  void Relabel() {
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          color_[node].store(kNoColor, std::memory_order_relaxed);
+        },
+        galois::no_stats(), galois::loopname("ResetSmallest"));
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          galois::atomicMin(
+              color_[component(node).load(std::memory_order_relaxed)],
+              uint64_t{node});
+        },
+        galois::no_stats(), galois::loopname("FindSmallest"));
+    galois::do_all(
+        galois::iterate(*graph_),
+        [&](const GNode& node) {
+          component(node).store(
+              color_[component(node).load(std::memory_order_relaxed)].load(
+                  std::memory_order_relaxed),
+              std::memory_order_relaxed);
+        },
+        galois::no_stats(), galois::loopname("Relabel"));
+  }
+};
+
+}  // namespace
+
+galois::Result<void>
+galois::analytics::StronglyConnectedComponents(
+    graphs::PropertyGraph<
+        std::tuple<StronglyConnectedComponentsNodeComponent>, std::tuple<>>& pg,
+    StronglyConnectedComponentsPlan plan) {
+  if (plan.algorithm() != StronglyConnectedComponentsPlan::kMultistep &&
+      plan.algorithm() != StronglyConnectedComponentsPlan::kColoring) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  galois::StatTimer execTime("StronglyConnectedComponents");
+  execTime.start();
+
+  Scc scc(&pg);
+  Nodes trimmable;
+  Nodes assigned;
+  scc.Initialize(&trimmable);
+  uint64_t trimmed = scc.Trim(&trimmable);
+
+  if (plan.algorithm() == StronglyConnectedComponentsPlan::kMultistep) {
+    scc.ForwardBackward(&assigned);
+    scc.Detach(&assigned, &trimmable);
+    trimmed += scc.Trim(&trimmable);
+  }
+
+  Nodes remaining = scc.Remaining();
+  uint32_t rounds = 0;
+  while (!remaining.empty()) {
+    ++rounds;
+    scc.Coloring(remaining, &assigned);
+    scc.Detach(&assigned, &trimmable);
+    trimmed += scc.Trim(&trimmable);
+    remaining = scc.Remaining(&remaining);
+  }
+  galois::ReportStatSingle("StronglyConnectedComponents", "Trimmed", trimmed);
+  galois::ReportStatSingle(
+      "StronglyConnectedComponents", "ColoringRounds", rounds);
+
+  scc.Relabel();
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::StronglyConnectedComponents(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan) {
+  if (auto result = ConstructNodeProperties<
+          std::tuple<StronglyConnectedComponentsNodeComponent>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  return StronglyConnectedComponents(pg_result.value(), plan);
+}
@@ -0,0 +1,575 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/analytics/triangle_count/triangle_count.h"
+
+#include <algorithm>
+
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/ParallelSTL.h"
+#include "galois/Reduction.h"
+#include "galois/SetIntersection.h"
+#include "galois/analytics/EdgeMap.h"
+
+using namespace galois::analytics;
+
+using NodeTriangles = galois::PODProperty<uint64_t>;
+using EdgeTriangles = galois::PODProperty<uint32_t>;
+using NodeCoefficient = galois::PODProperty<double>;
+
+constexpr static unsigned kChunkSize = 64U;
+//! Nodes with at least this many neighbors of lower rank are intersected with
+//! their neighbors through a bitmap rather than by merging
+constexpr static uint32_t kBitmapMinDegree = 8;
+
+namespace {
+
+/// The undirected graph underlying a PropertyFileGraph, without self loops
+/// or duplicate edges, whose nodes are ranked by degree with ties broken by
+/// node id. Nodes are identified by their rank and the neighbors of each node
+/// are sorted, so its neighbors of lower rank come first.
+class RankedGraph {
+  galois::LargeArray<uint32_t> node_;
+  galois::LargeArray<uint32_t> rank_;
+  /// The end of the space for the neighbors of each rank, which may hold
+  /// fewer neighbors once duplicates are removed
+  galois::LargeArray<uint64_t> ends_;
+  galois::LargeArray<uint32_t> degree_;
+  galois::LargeArray<uint32_t> lower_degree_;
+  galois::LargeArray<uint32_t> dests_;
+
+public:
+  /// Builds the ranked graph of pfg, which must contain the reverse of every
+  /// edge if symmetric is true
+  RankedGraph(const galois::graphs::PropertyFileGraph& pfg, bool symmetric) {
+    const galois::graphs::GraphTopology& topology = pfg.topology();
+    const uint64_t num_nodes = topology.num_nodes();
+    InEdgeView in_edges = symmetric ? InEdgeView::MakeSymmetric(pfg)
+                                    : InEdgeView::Make(pfg);
+
+    // Bounds on the number of neighbors, counting the incoming edges of
+    // graphs that are not symmetric, which are good enough for ranking
+    auto max_degree = [&](uint32_t node) {
+      auto [begin, end] = topology.edge_range(node);
+      if (symmetric) {
+        return end - begin;
+      }
+      auto [in_begin, in_end] = in_edges.edge_range(node);
+      return end - begin + in_end - in_begin;
+    };
+
+    node_.allocateBlocked(num_nodes);
+    rank_.allocateBlocked(num_nodes);
+    ends_.allocateBlocked(num_nodes);
+    degree_.allocateBlocked(num_nodes);
+    lower_degree_.allocateBlocked(num_nodes);
+
+    galois::LargeArray<uint64_t> capacities;
+    capacities.allocateBlocked(num_nodes);
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t node) {
+          node_[node] = node;
+          capacities[node] = max_degree(node);
+        },
+        galois::no_stats());
+    galois::ParallelSTL::sort(
+        node_.begin(), node_.end(), [&](uint32_t a, uint32_t b) {
+          return capacities[a] < capacities[b] ||
+                 (capacities[a] == capacities[b] && a < b);
+        });
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t rank) {
+          rank_[node_[rank]] = rank;
+          ends_[rank] = capacities[node_[rank]];
+        },
+        galois::no_stats());
+    galois::ParallelSTL::partial_sum(ends_.begin(), ends_.end(), ends_.begin());
+
+    dests_.allocateBlocked(capacity());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t rank) {
+          const uint32_t node = node_[rank];
+          uint32_t* begin = dests_.data() + (rank > 0 ? ends_[rank - 1] : 0);
+          uint32_t* end = begin;
+          auto [out_begin, out_end] = topology.edge_range(node);
+          for (auto e = out_begin; e != out_end; ++e) {
+            uint32_t dest = topology.out_dests->Value(e);
+            if (dest != node) {
+              *end++ = rank_[dest];
+            }
+          }
+          if (!symmetric) {
+            auto [in_begin, in_end] = in_edges.edge_range(node);
+            for (auto e = in_begin; e != in_end; ++e) {
+              uint32_t source = in_edges.GetEdgeSource(e);
+              if (source != node) {
+                *end++ = rank_[source];
+              }
+            }
+          }
+          std::sort(begin, end);
+          end = std::unique(begin, end);
+          degree_[rank] = end - begin;
+          lower_degree_[rank] = std::lower_bound(begin, end, rank) - begin;
+        },
+        galois::steal(), galois::no_stats(), galois::loopname("RankGraph"));
+  }
+
+  uint64_t size() const { return node_.size(); }
+
+  /// The space for the neighbors of all ranks
+  uint64_t capacity() const { return size() > 0 ? ends_[size() - 1] : 0; }
+
+  uint32_t node(uint32_t rank) const { return node_[rank]; }
+
+  uint32_t rank(uint32_t node) const { return rank_[node]; }
+
+  /// The index of the first neighbor of rank in the neighbors of every rank
+  uint64_t begin(uint32_t rank) const {
+    return rank > 0 ? ends_[rank - 1] : 0;
+  }
+
+  const uint32_t* neighbors(uint32_t rank) const {
+    return dests_.data() + begin(rank);
+  }
+
+  uint32_t degree(uint32_t rank) const { return degree_[rank]; }
+
+  uint32_t lower_degree(uint32_t rank) const { return lower_degree_[rank]; }
+
+  /// Returns the index of neighbor, which must be a neighbor of rank, in the
+  /// neighbors of every rank
+  uint64_t Find(uint32_t rank, uint32_t neighbor) const {
+    const uint32_t* begin = neighbors(rank);
+    return this->begin(rank) +
+           (std::lower_bound(begin, begin + degree(rank), neighbor) - begin);
+  }
+};
+
+/// A RankedGraph over the topology of a PropertyFileGraph that is symmetric,
+/// has no self loops or duplicate edges and has the edges of every node
+/// sorted by destination. Nodes are ranked by their ids and their neighbors
+/// are the destinations of their edges, so only the number of neighbors of
+/// lower rank of every node is stored.
+class SortedGraph {
+  const galois::graphs::GraphTopology& topology_;
+  galois::LargeArray<uint32_t> lower_degree_;
+
+public:
+  explicit SortedGraph(const galois::graphs::PropertyFileGraph& pfg)
+      : topology_(pfg.topology()) {
+    lower_degree_.allocateBlocked(size());
+    galois::do_all(
+        galois::iterate(uint64_t{0}, size()),
+        [&](uint64_t rank) {
+          const uint32_t* begin = neighbors(rank);
+          lower_degree_[rank] =
+              std::lower_bound(begin, begin + degree(rank), rank) - begin;
+        },
+        galois::no_stats());
+  }
+
+  uint64_t size() const { return topology_.num_nodes(); }
+
+  uint64_t capacity() const { return topology_.num_edges(); }
+
+  uint32_t node(uint32_t rank) const { return rank; }
+
+  uint32_t rank(uint32_t node) const { return node; }
+
+  uint64_t begin(uint32_t rank) const {
+    return topology_.edge_range(rank).first;
+  }
+
+  const uint32_t* neighbors(uint32_t rank) const {
+    return topology_.out_dests->raw_values() + begin(rank);
+  }
+
+  uint32_t degree(uint32_t rank) const {
+    auto [begin, end] = topology_.edge_range(rank);
+    return end - begin;
+  }
+
+  uint32_t lower_degree(uint32_t rank) const { return lower_degree_[rank]; }
+
+  uint64_t Find(uint32_t rank, uint32_t neighbor) const {
+    const uint32_t* begin = neighbors(rank);
+    return this->begin(rank) +
+           (std::lower_bound(begin, begin + degree(rank), neighbor) - begin);
+  }
+};
+
+/// Calls fn with the graph whose triangles plan counts, without copying the
+/// topology if it is sorted
+template <typename Fn>
+auto
+WithGraph(
+    const galois::graphs::PropertyFileGraph& pfg, TriangleCountPlan plan,
+    const Fn& fn) {
+  if (plan.sorted()) {
+    return fn(SortedGraph(pfg));
+  }
+  return fn(RankedGraph(pfg, plan.symmetric()));
+}
+
+/// The ordered count, which the triangle counting app runs as well: every
+/// triangle (a, b, c) with a < b < c is found from c, as a neighbor a of b
+/// that is also a neighbor of c, where both are neighbors of lower rank.
+/// Returns the number of triangles and, if kVisit, calls visit(a, b, c) for
+/// every triangle.
+template <bool kVisit, typename Graph, typename Visit>
+uint64_t
+OrderedCount(const Graph& graph, const Visit& visit) {
+  galois::GAccumulator<uint64_t> num_triangles;
+  galois::substrate::PerThreadStorage<galois::IntersectionBitmap> bitmaps;
+  galois::do_all(
+      galois::iterate(uint64_t{0}, graph.size()),
+      [&](uint32_t c) {
+        const uint32_t* c_lower = graph.neighbors(c);
+        const uint32_t c_lower_size = graph.lower_degree(c);
+
+        // Many neighbors of lower rank: probe a bitmap of them rather than
+        // merging with a prefix of them for every neighbor
+        galois::IntersectionBitmap* bitmap = bitmaps.getLocal();
+        const bool use_bitmap = c_lower_size >= kBitmapMinDegree;
+        if (use_bitmap) {
+          // Every probe is below the largest neighbor of lower rank, so the
+          // bitmap only grows to the ranks this thread has needed so far
+          const uint64_t universe = c_lower[c_lower_size - 1] + 1;
+          if (bitmap->universe() < universe) {
+            bitmap->Resize(std::min(
+                graph.size(),
+                std::max<uint64_t>(universe, 2 * bitmap->universe())));
+          }
+          bitmap->Insert(c_lower, c_lower_size);
+        }
+
+        uint64_t c_triangles = 0;
+        for (uint32_t i = 0; i < c_lower_size; ++i) {
+          const uint32_t b = c_lower[i];
+          const uint32_t* b_lower = graph.neighbors(b);
+          const uint32_t b_lower_size = graph.lower_degree(b);
+          // Neighbors of b of lower rank can only match neighbors of c below b
+          if constexpr (kVisit) {
+            auto found = [&](uint32_t a) {
+              visit(a, b, c);
+              ++c_triangles;
+            };
+            if (use_bitmap) {
+              for (uint32_t j = 0; j < b_lower_size; ++j) {
+                if (bitmap->Contains(b_lower[j])) {
+                  found(b_lower[j]);
+                }
+              }
+            } else {
+              galois::Intersect(c_lower, i, b_lower, b_lower_size, found);
+            }
+          } else {
+            c_triangles +=
+                use_bitmap
+                    ? bitmap->Count(b_lower, b_lower_size)
+                    : galois::IntersectCount(c_lower, i, b_lower, b_lower_size);
+          }
+        }
+
+        if (use_bitmap) {
+          bitmap->Erase(c_lower, c_lower_size);
+        }
+        num_triangles += c_triangles;
+      },
+      galois::chunk_size<kChunkSize>(), galois::steal(), galois::no_stats(),
+      galois::loopname("OrderedCount"));
+  return num_triangles.reduce();
+}
+
+/// Counts the common neighbors of the endpoints of every edge of graph into
+/// counts, which is indexed like the neighbors of graph. Each edge is counted
+/// from its endpoint of higher rank, which also writes the count of the
+/// reverse edge, so every count is written by a single thread.
+template <typename Graph>
+void
+EdgeIteration(const Graph& graph, galois::LargeArray<uint32_t>* counts) {
+  counts->allocateBlocked(graph.capacity());
+  galois::substrate::PerThreadStorage<galois::IntersectionBitmap> bitmaps;
+  galois::do_all(
+      galois::iterate(uint64_t{0}, graph.size()),
+      [&](uint32_t c) {
+        const uint32_t* c_neighbors = graph.neighbors(c);
+        const uint32_t c_degree = graph.degree(c);
+
+        // As in OrderedCount, but with all neighbors of c, whose neighbors of
+        // lower rank have no more neighbors than c
+        galois::IntersectionBitmap* bitmap = bitmaps.getLocal();
+        const bool use_bitmap = graph.lower_degree(c) >= kBitmapMinDegree;
+        if (use_bitmap) {
+          if (bitmap->universe() < graph.size()) {
+            bitmap->Resize(graph.size());
+          }
+          bitmap->Insert(c_neighbors, c_degree);
+        }
+
+        for (uint32_t i = 0; i < graph.lower_degree(c); ++i) {
+          const uint32_t b = c_neighbors[i];
+          const uint32_t* b_neighbors = graph.neighbors(b);
+          const uint32_t b_degree = graph.degree(b);
+          const uint32_t count =
+              use_bitmap ? bitmap->Count(b_neighbors, b_degree)
+                         : galois::IntersectCount(
+                               c_neighbors, c_degree, b_neighbors, b_degree);
+          (*counts)[graph.begin(c) + i] = count;
+          (*counts)[graph.Find(b, c)] = count;
+        }
+
+        if (use_bitmap) {
+          bitmap->Erase(c_neighbors, c_degree);
+        }
+      },
+      galois::chunk_size<kChunkSize>(), galois::steal(), galois::no_stats(),
+      galois::loopname("EdgeIteration"));
+}
+
+/// Counts the triangles of every rank of graph into triangles
+template <typename Graph>
+galois::Result<void>
+CountNodeTriangles(
+    const Graph& graph, TriangleCountPlan plan,
+    galois::LargeArray<uint64_t>* triangles) {
+  triangles->allocateBlocked(graph.size());
+
+  switch (plan.algorithm()) {
+  case TriangleCountPlan::kOrderedCount: {
+    // Every thread counts the triangles it finds in an array of its own,
+    // which avoids atomic updates of the counts of other nodes
+    galois::substrate::PerThreadStorage<galois::LargeArray<uint64_t>> counts;
+    const unsigned num_threads = galois::getActiveThreads();
+    galois::on_each([&](unsigned, unsigned) {
+      galois::LargeArray<uint64_t>& local = *counts.getLocal();
+      local.allocateLocal(graph.size());
+      std::fill(local.begin(), local.end(), 0);
+    });
+    OrderedCount<true>(graph, [&](uint32_t a, uint32_t b, uint32_t c) {
+      galois::LargeArray<uint64_t>& local = *counts.getLocal();
+      ++local[a];
+      ++local[b];
+      ++local[c];
+    });
+    galois::do_all(
+        galois::iterate(uint64_t{0}, graph.size()),
+        [&](uint64_t rank) {
+          uint64_t sum = 0;
+          for (unsigned t = 0; t < num_threads; ++t) {
+            sum += (*counts.getRemote(t))[rank];
+          }
+          (*triangles)[rank] = sum;
+        },
+        galois::no_stats(), galois::loopname("SumCounts"));
+    return galois::ResultSuccess();
+  }
+
+  case TriangleCountPlan::kEdgeIteration: {
+    galois::LargeArray<uint32_t> counts;
+    EdgeIteration(graph, &counts);
+    // Every triangle of a node is counted by both of its edges in it
+    galois::do_all(
+        galois::iterate(uint64_t{0}, graph.size()),
+        [&](uint64_t rank) {
+          uint64_t sum = 0;
+          for (uint32_t i = 0; i < graph.degree(rank); ++i) {
+            sum += counts[graph.begin(rank) + i];
+          }
+          (*triangles)[rank] = sum / 2;
+        },
+        galois::no_stats(), galois::loopname("SumCounts"));
+    return galois::ResultSuccess();
+  }
+
+  default:
+    return galois::ErrorCode::InvalidArgument;
+  }
+}
+
+}  // namespace
+
+galois::Result<uint64_t>
+galois::analytics::TriangleCount(
+    graphs::PropertyFileGraph* pfg, TriangleCountPlan plan) {
+  galois::StatTimer execTime("TriangleCount");
+  execTime.start();
+
+  auto num_triangles =
+      WithGraph(*pfg, plan, [&](const auto& graph) -> Result<uint64_t> {
+        switch (plan.algorithm()) {
+        case TriangleCountPlan::kOrderedCount:
+          return OrderedCount<false>(
+              graph, [](uint32_t, uint32_t, uint32_t) {});
+
+        case TriangleCountPlan::kEdgeIteration: {
+          // Every triangle is counted by its three edges
+          galois::LargeArray<uint32_t> counts;
+          EdgeIteration(graph, &counts);
+          galois::GAccumulator<uint64_t> sum;
+          galois::do_all(
+              galois::iterate(uint64_t{0}, graph.size()),
+              [&](uint64_t rank) {
+                for (uint32_t i = 0; i < graph.lower_degree(rank); ++i) {
+                  sum += counts[graph.begin(rank) + i];
+                }
+              },
+              galois::no_stats());
+          return sum.reduce() / 3;
+        }
+
+        default:
+          return galois::ErrorCode::InvalidArgument;
+        }
+      });
+
+  execTime.stop();
+
+  return num_triangles;
+}
+
+galois::Result<void>
+galois::analytics::NodeTriangleCount(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    TriangleCountPlan plan) {
+  if (auto r = ConstructNodeProperties<std::tuple<NodeTriangles>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result =
+      graphs::PropertyGraph<std::tuple<NodeTriangles>, std::tuple<>>::Make(
+          pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto pg = pg_result.value();
+
+  galois::StatTimer execTime("NodeTriangleCount");
+  execTime.start();
+
+  auto result = WithGraph(*pfg, plan, [&](const auto& graph) -> Result<void> {
+    galois::LargeArray<uint64_t> triangles;
+    if (auto r = CountNodeTriangles(graph, plan, &triangles); !r) {
+      return r.error();
+    }
+
+    galois::do_all(
+        galois::iterate(pg),
+        [&](uint32_t node) {
+          pg.GetData<NodeTriangles>(node) = triangles[graph.rank(node)];
+        },
+        galois::no_stats());
+    return galois::ResultSuccess();
+  });
+
+  execTime.stop();
+
+  return result;
+}
+
+galois::Result<void>
+galois::analytics::EdgeTriangleCount(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    TriangleCountPlan plan) {
+  if (auto r = ConstructEdgeProperties<std::tuple<EdgeTriangles>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result =
+      graphs::PropertyGraph<std::tuple<>, std::tuple<EdgeTriangles>>::Make(
+          pfg, {}, {output_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto pg = pg_result.value();
+
+  galois::StatTimer execTime("EdgeTriangleCount");
+  execTime.start();
+
+  WithGraph(*pfg, plan, [&](const auto& graph) {
+    galois::LargeArray<uint32_t> counts;
+    EdgeIteration(graph, &counts);
+
+    galois::do_all(
+        galois::iterate(pg),
+        [&](uint32_t node) {
+          const uint32_t rank = graph.rank(node);
+          for (auto e : pg.edges(node)) {
+            const uint32_t dest = *pg.GetEdgeDest(e);
+            pg.GetEdgeData<EdgeTriangles>(e) =
+                dest == node ? 0 : counts[graph.Find(rank, graph.rank(dest))];
+          }
+        },
+        galois::steal(), galois::no_stats());
+  });
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::LocalClusteringCoefficient(
+    graphs::PropertyFileGraph* pfg, const std::string& output_property_name,
+    TriangleCountPlan plan) {
+  if (auto r = ConstructNodeProperties<std::tuple<NodeCoefficient>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+  auto pg_result =
+      graphs::PropertyGraph<std::tuple<NodeCoefficient>, std::tuple<>>::Make(
+          pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto pg = pg_result.value();
+
+  galois::StatTimer execTime("LocalClusteringCoefficient");
+  execTime.start();
+
+  auto result = WithGraph(*pfg, plan, [&](const auto& graph) -> Result<void> {
+    galois::LargeArray<uint64_t> triangles;
+    if (auto r = CountNodeTriangles(graph, plan, &triangles); !r) {
+      return r.error();
+    }
+
+    galois::do_all(
+        galois::iterate(pg),
+        [&](uint32_t node) {
+          const uint32_t rank = graph.rank(node);
+          const double degree = graph.degree(rank);
+          pg.GetData<NodeCoefficient>(node) =
+              degree < 2 ? 0 : 2 * triangles[rank] / (degree * (degree - 1));
+        },
+        galois::no_stats());
+    return galois::ResultSuccess();
+  });
+
+  execTime.stop();
+
+  return result;
+}
@@ -0,0 +1,93 @@
+#include <cstring>
+
+#include <arrow/api.h>
+
+#include "galois/ArrowMemoryPool.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/Properties.h"
+
+namespace {
+
+void
+TestGrowAndShrink(galois::ArrowMemoryPool* pool) {
+  constexpr int64_t kSmall = 100;
+  constexpr int64_t kLarge =
+      3 * galois::ArrowMemoryPool::kLargeAllocation + 1;
+
+  uint8_t* buf{};
+  GALOIS_LOG_ASSERT(pool->Allocate(kSmall, &buf).ok());
+  std::memset(buf, 1, kSmall);
+
+  // Small to large moves the buffer onto huge pages
+  GALOIS_LOG_ASSERT(pool->Reallocate(kSmall, kLarge, &buf).ok());
+  GALOIS_LOG_ASSERT(buf[kSmall - 1] == 1);
+  std::memset(buf, 2, kLarge);
+
+  // Growing within the last huge page keeps the buffer in place
+  uint8_t* before = buf;
+  GALOIS_LOG_ASSERT(pool->Reallocate(kLarge, kLarge + 1, &buf).ok());
+  GALOIS_LOG_ASSERT(buf == before);
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == kLarge + 1);
+
+  GALOIS_LOG_ASSERT(pool->Reallocate(kLarge + 1, 2 * kLarge, &buf).ok());
+  GALOIS_LOG_ASSERT(buf[kLarge - 1] == 2);
+  std::memset(buf, 3, 2 * kLarge);
+
+  GALOIS_LOG_ASSERT(pool->Reallocate(2 * kLarge, kSmall, &buf).ok());
+  GALOIS_LOG_ASSERT(buf[kSmall - 1] == 3);
+  pool->Free(buf, kSmall);
+
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+  GALOIS_LOG_ASSERT(pool->max_memory() >= 2 * kLarge);
+}
+
+void
+TestParallelAllocate(galois::ArrowMemoryPool* pool) {
+  constexpr int64_t kSize = 2 * galois::ArrowMemoryPool::kLargeAllocation;
+
+  // Allocations inside a loop cannot interleave and fault pages in locally
+  galois::do_all(galois::iterate(0, 8), [&](int) {
+    uint8_t* buf{};
+    GALOIS_LOG_ASSERT(pool->Allocate(kSize, &buf).ok());
+    std::memset(buf, 0, kSize);
+    pool->Free(buf, kSize);
+  });
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+}
+
+void
+TestAllocateTable() {
+  int64_t before = galois::GetArrowMemoryPool()->bytes_allocated();
+  constexpr uint64_t kRows = 1 << 20;
+
+  using Props = std::tuple<galois::UInt64Property>;
+  auto res = galois::AllocateTable<Props>(kRows, {"value"});
+  GALOIS_LOG_ASSERT(res);
+  std::shared_ptr<arrow::Table> table = res.value();
+  GALOIS_LOG_ASSERT(table->num_rows() == int64_t(kRows));
+  GALOIS_LOG_ASSERT(
+      galois::GetArrowMemoryPool()->bytes_allocated() - before >=
+      int64_t(kRows * sizeof(uint64_t)));
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+  galois::SharedMemSys sys;
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  galois::ArrowMemoryPool interleaved;
+  TestGrowAndShrink(&interleaved);
+  TestParallelAllocate(&interleaved);
+
+  galois::ArrowMemoryPool blocked(galois::ArrowMemoryPool::Placement::kBlocked);
+  TestGrowAndShrink(&blocked);
+
+  TestAllocateTable();
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "TestPropertyGraph.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/analytics/betweenness_centrality/betweenness_centrality.h"
+#include "galois/graphs/PropertyFileGraph.h"
+#include "galois/graphs/PropertyGraph.h"
+
+namespace ga = galois::analytics;
+namespace gg = galois::graphs;
+
+namespace {
+
+using Graph = gg::PropertyGraph<
+    std::tuple<ga::BetweennessCentralityNodeValue>, std::tuple<>>;
+
+constexpr uint32_t kNumSources = 512;
+
+/// Random graphs with range(0) nodes and range(1) out-edges per node
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 12, 1 << 16, 1 << 20}) {
+    for (long degree : {4, 16}) {
+      b->Args({num_nodes, degree});
+    }
+  }
+}
+
+std::vector<uint32_t>
+MakeSources(size_t num_nodes) {
+  std::vector<uint32_t> sources;
+  for (size_t i = 0; i < kNumSources; ++i) {
+    sources.emplace_back(i * num_nodes / kNumSources);
+  }
+  return sources;
+}
+
+std::vector<double>
+Compute(
+    gg::PropertyFileGraph* pfg, const std::vector<uint32_t>& sources,
+    ga::BetweennessCentralityPlan plan) {
+  const std::string name = "betweenness";
+  if (auto r = ga::BetweennessCentrality(pfg, sources, name, plan); !r) {
+    GALOIS_LOG_FATAL("could not compute betweenness: {}", r.error());
+  }
+
+  auto graph = Graph::Make(pfg, {name}, {});
+  if (!graph) {
+    GALOIS_LOG_FATAL("could not make property graph: {}", graph.error());
+  }
+  std::vector<double> values;
+  for (auto node : graph.value()) {
+    values.emplace_back(
+        graph.value().GetData<ga::BetweennessCentralityNodeValue>(node));
+  }
+
+  if (auto r = pfg->RemoveNodeProperty(name); !r) {
+    GALOIS_LOG_FATAL("could not remove property: {}", r.error());
+  }
+  return values;
+}
+
+void
+Betweenness(benchmark::State& state, ga::BetweennessCentralityPlan plan) {
+  auto [num_nodes, degree] = std::make_tuple(state.range(0), state.range(1));
+
+  RandomPolicy policy{static_cast<size_t>(degree)};
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 1, &policy);
+  std::vector<uint32_t> sources = MakeSources(num_nodes);
+
+  // Check against the per-source searches once, outside of the timed loop
+  std::vector<double> expected =
+      Compute(g.get(), sources, ga::BetweennessCentralityPlan::Outer());
+  std::vector<double> found = Compute(g.get(), sources, plan);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    GALOIS_LOG_VASSERT(
+        std::abs(found[i] - expected[i]) <=
+            1e-6 * std::max(1.0, std::abs(expected[i])),
+        "node {}: expected {} found {}", i, expected[i], found[i]);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Compute(g.get(), sources, plan));
+  }
+  state.SetItemsProcessed(state.iterations() * sources.size());
+}
+
+void
+Outer(benchmark::State& state) {
+  Betweenness(state, ga::BetweennessCentralityPlan::Outer());
+}
+
+template <uint32_t batch_size>
+void
+MultiSource(benchmark::State& state) {
+  Betweenness(state, ga::BetweennessCentralityPlan::MultiSource(batch_size));
+}
+
+BENCHMARK(Outer)->Apply(MakeArguments)->UseRealTime();
+BENCHMARK_TEMPLATE(MultiSource, 64)->Apply(MakeArguments)->UseRealTime();
+BENCHMARK_TEMPLATE(MultiSource, 256)->Apply(MakeArguments)->UseRealTime();
+BENCHMARK_TEMPLATE(MultiSource, 512)->Apply(MakeArguments)->UseRealTime();
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(std::numeric_limits<unsigned int>::max());
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
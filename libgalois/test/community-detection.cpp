@@ -0,0 +1,151 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestPropertyGraph.h"
+#include "galois/ArrowInterchange.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/analytics/community_detection/community_detection.h"
+#include "galois/graphs/PropertyFileGraph.h"
+#include "galois/graphs/PropertyGraph.h"
+
+namespace ga = galois::analytics;
+namespace gg = galois::graphs;
+
+namespace {
+
+using Graph = gg::PropertyGraph<
+    std::tuple<ga::CommunityDetectionNodeCommunity>, std::tuple<>>;
+
+constexpr size_t kNumCliques = 8;
+constexpr size_t kCliqueSize = 6;
+constexpr size_t kNumNodes = kNumCliques * kCliqueSize;
+
+/// A ring of cliques: every node has an edge to every other node of its
+/// clique, and the first and last node of each clique have an edge to the
+/// last node of the previous clique and the first node of the next one.
+class RingOfCliquesPolicy : public Policy {
+public:
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    std::vector<uint32_t> r;
+    size_t first = node_id / kCliqueSize * kCliqueSize;
+    for (size_t i = first; i < first + kCliqueSize; ++i) {
+      if (i != node_id) {
+        r.emplace_back(i);
+      }
+    }
+    if (node_id == first) {
+      r.emplace_back((node_id + num_nodes - 1) % num_nodes);
+    }
+    if (node_id == first + kCliqueSize - 1) {
+      r.emplace_back((node_id + 1) % num_nodes);
+    }
+    return r;
+  }
+};
+
+/// The modularity of the partition into cliques: each clique has
+/// s * (s - 1) edges inside it and 2 edges out of it, so its total degree is
+/// d = s * (s - 1) + 2 and Q = n * (s - 1) / m - c * d^2 / m^2.
+double
+CliqueModularity() {
+  double m = kNumNodes * (kCliqueSize - 1) + 2 * kNumCliques;
+  double d = kCliqueSize * (kCliqueSize - 1) + 2;
+  return kNumNodes * (kCliqueSize - 1) / m - kNumCliques * d * d / (m * m);
+}
+
+std::unique_ptr<gg::PropertyFileGraph>
+MakeRingOfCliques() {
+  RingOfCliquesPolicy policy;
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<int64_t>(kNumNodes, 1, &policy);
+
+  std::vector<ga::CommunityDetectionNodeCommunity> cliques;
+  for (size_t i = 0; i < kNumNodes; ++i) {
+    cliques.emplace_back(i / kCliqueSize);
+  }
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("clique", arrow::uint64())}),
+      {galois::BuildArray(cliques)});
+  if (auto r = g->AddNodeProperties(table); !r) {
+    GALOIS_LOG_FATAL("could not add node property: {}", r.error());
+  }
+  return g;
+}
+
+void
+TestKnownPartition(gg::PropertyFileGraph* g) {
+  auto modularity = ga::Modularity(g, "", "clique");
+  GALOIS_LOG_ASSERT(modularity);
+  GALOIS_LOG_VASSERT(
+      std::abs(modularity.value() - CliqueModularity()) < 1e-9,
+      "modularity {} of the cliques, expected {}", modularity.value(),
+      CliqueModularity());
+}
+
+/// Every plan should find the cliques and at least their modularity.
+void
+TestFindsCliques(gg::PropertyFileGraph* g, ga::CommunityDetectionPlan plan) {
+  const std::string name = "community";
+  if (auto r = ga::CommunityDetection(g, "", name, plan); !r) {
+    GALOIS_LOG_FATAL("could not detect communities: {}", r.error());
+  }
+
+  auto modularity = ga::Modularity(g, "", name);
+  GALOIS_LOG_ASSERT(modularity);
+  GALOIS_LOG_VASSERT(
+      modularity.value() >= CliqueModularity() - 1e-9,
+      "modularity {} below that of the cliques {}", modularity.value(),
+      CliqueModularity());
+
+  auto graph = Graph::Make(g, {name}, {});
+  if (!graph) {
+    GALOIS_LOG_FATAL("could not make property graph: {}", graph.error());
+  }
+  for (size_t u = 0; u < kNumNodes; ++u) {
+    for (size_t v = 0; v < kNumNodes; ++v) {
+      bool same_community =
+          graph.value().GetData<ga::CommunityDetectionNodeCommunity>(u) ==
+          graph.value().GetData<ga::CommunityDetectionNodeCommunity>(v);
+      GALOIS_LOG_VASSERT(
+          same_community == (u / kCliqueSize == v / kCliqueSize),
+          "nodes {} and {} are split from their cliques", u, v);
+    }
+  }
+
+  if (auto r = g->RemoveNodeProperty(name); !r) {
+    GALOIS_LOG_FATAL("could not remove property: {}", r.error());
+  }
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys G;
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  std::unique_ptr<gg::PropertyFileGraph> g = MakeRingOfCliques();
+  TestKnownPartition(g.get());
+
+  // Coarsen down to a single node so that the later levels run as well
+  constexpr uint32_t kMinGraphSize = 1;
+  TestFindsCliques(g.get(), ga::CommunityDetectionPlan::Louvain());
+  TestFindsCliques(
+      g.get(),
+      ga::CommunityDetectionPlan::Louvain(1.0, 0.01, 0.01, 10, kMinGraphSize));
+  TestFindsCliques(g.get(), ga::CommunityDetectionPlan::Leiden());
+  TestFindsCliques(
+      g.get(),
+      ga::CommunityDetectionPlan::Leiden(1.0, 0.01, 0.01, 10, kMinGraphSize));
+
+  return 0;
+}
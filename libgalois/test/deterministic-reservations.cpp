@@ -0,0 +1,208 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Reservation.h"
+
+// Greedy maximal matching and maximal independent set with deterministic
+// reservations must give the same result as the serial greedy algorithms,
+// independently of the number of threads. The number of rounds each item
+// takes part in depends on how the window evolves, so it must not depend on
+// the number of threads either.
+
+constexpr size_t kNumNodes = 10000;
+constexpr size_t kNumEdges = 50000;
+
+using Edge = std::pair<uint32_t, uint32_t>;
+
+std::vector<Edge>
+MakeEdges() {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> dist(0, kNumNodes - 1);
+  std::vector<Edge> edges;
+  while (edges.size() < kNumEdges) {
+    Edge e{dist(gen), dist(gen)};
+    if (e.first != e.second) {
+      edges.emplace_back(e);
+    }
+  }
+  return edges;
+}
+
+std::vector<uint8_t>
+SerialMatching(const std::vector<Edge>& edges) {
+  std::vector<uint8_t> matched_node(kNumNodes);
+  std::vector<uint8_t> in_matching(edges.size());
+  for (size_t e = 0; e < edges.size(); ++e) {
+    auto [u, v] = edges[e];
+    if (!matched_node[u] && !matched_node[v]) {
+      matched_node[u] = matched_node[v] = 1;
+      in_matching[e] = 1;
+    }
+  }
+  return in_matching;
+}
+
+std::vector<uint8_t>
+ReservationMatching(const std::vector<Edge>& edges) {
+  std::vector<uint8_t> matched_node(kNumNodes);
+  std::vector<uint8_t> in_matching(edges.size());
+  std::vector<galois::Reservation> reservations(kNumNodes);
+
+  galois::deterministic_for(
+      galois::iterate(size_t{0}, edges.size()),
+      [&](size_t e) {
+        auto [u, v] = edges[e];
+        if (matched_node[u] || matched_node[v]) {
+          return false;
+        }
+        reservations[u].Reserve(e);
+        reservations[v].Reserve(e);
+        return true;
+      },
+      [&](size_t e) {
+        auto [u, v] = edges[e];
+        bool won = reservations[u].IsReservedBy(e) &&
+                   reservations[v].IsReservedBy(e);
+        if (won) {
+          matched_node[u] = matched_node[v] = 1;
+          in_matching[e] = 1;
+        }
+        reservations[u].Release(e);
+        reservations[v].Release(e);
+        return won;
+      },
+      galois::loopname("Matching"));
+
+  for (const auto& r : reservations) {
+    GALOIS_ASSERT(r.IsFree());
+  }
+  return in_matching;
+}
+
+enum : uint8_t { kUndecided, kIn, kOut };
+
+struct Adjacency {
+  std::vector<uint64_t> offsets;
+  std::vector<uint32_t> neighbors;
+};
+
+Adjacency
+MakeAdjacency(const std::vector<Edge>& edges) {
+  std::vector<std::vector<uint32_t>> lists(kNumNodes);
+  for (auto [u, v] : edges) {
+    lists[u].push_back(v);
+    lists[v].push_back(u);
+  }
+  Adjacency adj;
+  adj.offsets.push_back(0);
+  for (const auto& l : lists) {
+    adj.neighbors.insert(adj.neighbors.end(), l.begin(), l.end());
+    adj.offsets.push_back(adj.neighbors.size());
+  }
+  return adj;
+}
+
+std::vector<uint8_t>
+SerialMIS(const Adjacency& adj) {
+  std::vector<uint8_t> state(kNumNodes, kUndecided);
+  for (size_t n = 0; n < kNumNodes; ++n) {
+    if (state[n] != kUndecided) {
+      continue;
+    }
+    state[n] = kIn;
+    for (uint64_t i = adj.offsets[n]; i < adj.offsets[n + 1]; ++i) {
+      state[adj.neighbors[i]] = kOut;
+    }
+  }
+  return state;
+}
+
+std::vector<uint8_t>
+ReservationMIS(const Adjacency& adj, std::vector<uint32_t>* attempts) {
+  std::vector<uint8_t> state(kNumNodes, kUndecided);
+  std::vector<uint8_t> decision(kNumNodes);
+  attempts->assign(kNumNodes, 0);
+
+  // A node is in the set iff no earlier neighbor is, so it is decided once
+  // all of its earlier neighbors are
+  galois::deterministic_for(
+      galois::iterate(size_t{0}, kNumNodes),
+      [&](size_t n) {
+        // Each item runs on a single thread per round
+        ++(*attempts)[n];
+        decision[n] = kIn;
+        for (uint64_t i = adj.offsets[n]; i < adj.offsets[n + 1]; ++i) {
+          uint32_t m = adj.neighbors[i];
+          if (m < n) {
+            if (state[m] == kIn) {
+              decision[n] = kOut;
+              break;
+            }
+            if (state[m] == kUndecided) {
+              decision[n] = kUndecided;
+            }
+          }
+        }
+        return true;
+      },
+      [&](size_t n) {
+        state[n] = decision[n];
+        return state[n] != kUndecided;
+      },
+      galois::loopname("MIS"));
+
+  return state;
+}
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys G;
+
+  auto edges = MakeEdges();
+  auto adj = MakeAdjacency(edges);
+  auto expected_matching = SerialMatching(edges);
+  auto expected_mis = SerialMIS(adj);
+
+  std::vector<uint32_t> expected_attempts;
+  std::vector<uint32_t> attempts;
+  unsigned max_threads = argc > 1 ? std::stoul(argv[1]) : 2;
+  for (unsigned threads = 1; threads <= max_threads; ++threads) {
+    galois::setActiveThreads(threads);
+    GALOIS_ASSERT(ReservationMatching(edges) == expected_matching);
+    GALOIS_ASSERT(ReservationMIS(adj, &attempts) == expected_mis);
+    if (threads == 1) {
+      expected_attempts = attempts;
+      // Some nodes wait for earlier neighbors, so the window matters
+      GALOIS_ASSERT(
+          std::any_of(attempts.begin(), attempts.end(), [](uint32_t a) {
+            return a > 1;
+          }));
+    }
+    GALOIS_ASSERT(attempts == expected_attempts);
+  }
+
+  return 0;
+}
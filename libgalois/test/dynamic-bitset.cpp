@@ -0,0 +1,203 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "galois/DynamicBitset.h"
+#include "galois/Galois.h"
+#include "galois/Timer.h"
+
+// Checks the bulk DynamicBitset operations against a per-bit reference and
+// times the frontier operations of a direction-optimizing BFS round (count to
+// pick a direction, and-not to find unvisited nodes, and enumeration or
+// conversion of the frontier to a sparse list) against per-bit loops.
+
+size_t num_bits = (1 << 24) + 17;
+
+void
+Fill(galois::DynamicBitset* bitset, std::vector<bool>* ref, double density) {
+  std::mt19937 gen(num_bits);
+  std::bernoulli_distribution coin(density);
+  bitset->resize(num_bits);
+  ref->assign(num_bits, false);
+  for (size_t i = 0; i < num_bits; ++i) {
+    if (coin(gen)) {
+      bitset->set(i);
+      (*ref)[i] = true;
+    }
+  }
+}
+
+void
+CheckEqual(const galois::DynamicBitset& bitset, const std::vector<bool>& ref) {
+  GALOIS_ASSERT(bitset.size() == ref.size());
+  for (size_t i = 0; i < ref.size(); ++i) {
+    GALOIS_ASSERT(bitset.test(i) == ref[i], "mismatch at bit ", i);
+  }
+}
+
+void
+TestOps() {
+  galois::DynamicBitset a;
+  galois::DynamicBitset b;
+  std::vector<bool> ref_a;
+  std::vector<bool> ref_b;
+  Fill(&a, &ref_a, 0.3);
+  std::mt19937 gen(7);
+  std::bernoulli_distribution coin(0.5);
+  b.resize(num_bits);
+  ref_b.assign(num_bits, false);
+  for (size_t i = 0; i < num_bits; ++i) {
+    if (coin(gen)) {
+      b.set(i);
+      ref_b[i] = true;
+    }
+  }
+
+  uint64_t expected = std::count(ref_a.begin(), ref_a.end(), true);
+  GALOIS_ASSERT(a.count() == expected);
+
+  std::vector<uint64_t> offsets = a.getOffsets<uint64_t>();
+  GALOIS_ASSERT(offsets.size() == expected);
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    GALOIS_ASSERT(ref_a[offsets[i]]);
+    GALOIS_ASSERT(i == 0 || offsets[i - 1] < offsets[i]);
+  }
+
+  galois::GAccumulator<uint64_t> visited;
+  a.for_each_set_bit([&](size_t i) {
+    GALOIS_ASSERT(ref_a[i]);
+    visited += 1;
+  });
+  GALOIS_ASSERT(visited.reduce() == expected);
+
+  galois::DynamicBitset c;
+  c.resize(num_bits);
+  c.bitwise_andnot(a, b);
+  std::vector<bool> ref_c(num_bits);
+  for (size_t i = 0; i < num_bits; ++i) {
+    ref_c[i] = ref_a[i] && !ref_b[i];
+  }
+  CheckEqual(c, ref_c);
+
+  c.bitwise_or(b);
+  for (size_t i = 0; i < num_bits; ++i) {
+    ref_c[i] = ref_c[i] || ref_b[i];
+  }
+  CheckEqual(c, ref_c);
+
+  c.bitwise_xor(a);
+  for (size_t i = 0; i < num_bits; ++i) {
+    ref_c[i] = ref_c[i] != ref_a[i];
+  }
+  CheckEqual(c, ref_c);
+
+  c.bitwise_and(a, b);
+  for (size_t i = 0; i < num_bits; ++i) {
+    ref_c[i] = ref_a[i] && ref_b[i];
+  }
+  CheckEqual(c, ref_c);
+
+  c.reset(3, num_bits - 70);
+  for (size_t i = 3; i <= num_bits - 70; ++i) {
+    ref_c[i] = false;
+  }
+  CheckEqual(c, ref_c);
+
+  c.reset();
+  GALOIS_ASSERT(c.count() == 0);
+}
+
+template <typename F>
+void
+Time(const char* name, F fn) {
+  galois::Timer t;
+  t.start();
+  fn();
+  t.stop();
+  std::cout << name << "," << galois::getActiveThreads() << "," << t.get()
+            << "\n";
+}
+
+void
+BenchFrontier() {
+  galois::DynamicBitset frontier;
+  galois::DynamicBitset visited;
+  std::vector<bool> ref;
+  Fill(&frontier, &ref, 0.05);
+  Fill(&visited, &ref, 0.5);
+
+  galois::GAccumulator<uint64_t> sink;
+
+  Time("count-per-bit", [&] {
+    galois::do_all(
+        galois::iterate(size_t{0}, num_bits),
+        [&](size_t i) { sink += frontier.test(i); }, galois::no_stats());
+  });
+  Time("count", [&] { sink += frontier.count(); });
+
+  Time("andnot-per-bit", [&] {
+    galois::do_all(
+        galois::iterate(size_t{0}, num_bits),
+        [&](size_t i) {
+          if (visited.test(i)) {
+            frontier.reset(i);
+          }
+        },
+        galois::no_stats());
+  });
+  Time("andnot", [&] { frontier.bitwise_andnot(visited); });
+
+  Time("enumerate-per-bit", [&] {
+    galois::do_all(
+        galois::iterate(size_t{0}, num_bits),
+        [&](size_t i) {
+          if (frontier.test(i)) {
+            sink += i;
+          }
+        },
+        galois::no_stats());
+  });
+  Time("enumerate", [&] {
+    frontier.for_each_set_bit([&](size_t i) { sink += i; });
+  });
+  Time("offsets", [&] { sink += frontier.getOffsets<uint32_t>().size(); });
+
+  Time("reset", [&] { frontier.reset(); });
+  std::cout << "checksum," << sink.reduce() << "\n";
+}
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys Galois_runtime;
+  if (argc > 1)
+    num_bits = atol(argv[1]);
+  if (argc > 2)
+    galois::setActiveThreads(atoi(argv[2]));
+  else
+    galois::setActiveThreads(2);
+
+  TestOps();
+  BenchFrontier();
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestPropertyGraph.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/analytics/k_core/k_core.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace ga = galois::analytics;
+namespace gg = galois::graphs;
+
+namespace {
+
+using Adjacency = std::vector<std::vector<uint32_t>>;
+
+/// Returns the neighbors of each node from a given adjacency
+class AdjacencyPolicy : public Policy {
+  Adjacency neighbors_;
+
+public:
+  AdjacencyPolicy(Adjacency neighbors) : neighbors_(std::move(neighbors)) {}
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, [[maybe_unused]] size_t num_nodes) override {
+    return neighbors_[node_id];
+  }
+};
+
+/// A symmetric random graph without self loops or duplicate edges, with a
+/// denser part among the first nodes so that core numbers vary
+Adjacency
+MakeSymmetric(size_t num_nodes, size_t num_edges, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<uint32_t> any(0, num_nodes - 1);
+  std::uniform_int_distribution<uint32_t> dense(0, num_nodes / 10);
+  std::set<std::pair<uint32_t, uint32_t>> edges;
+  for (size_t i = 0; i < num_edges; ++i) {
+    uint32_t u = any(gen);
+    uint32_t v = i % 3 == 0 ? dense(gen) : any(gen);
+    if (u != v) {
+      edges.emplace(u, v);
+      edges.emplace(v, u);
+    }
+  }
+  Adjacency adj(num_nodes);
+  for (auto [u, v] : edges) {
+    adj[u].emplace_back(v);
+  }
+  return adj;
+}
+
+/// Core numbers by removing a node of minimum degree at a time
+std::vector<uint32_t>
+SerialCores(const Adjacency& adj) {
+  std::vector<uint32_t> degree;
+  for (const auto& neighbors : adj) {
+    degree.emplace_back(neighbors.size());
+  }
+  std::vector<uint32_t> cores(adj.size());
+  std::vector<bool> removed(adj.size());
+  uint32_t core = 0;
+  for (size_t i = 0; i < adj.size(); ++i) {
+    size_t min = adj.size();
+    for (size_t n = 0; n < adj.size(); ++n) {
+      if (!removed[n] && (min == adj.size() || degree[n] < degree[min])) {
+        min = n;
+      }
+    }
+    core = std::max(core, degree[min]);
+    cores[min] = core;
+    removed[min] = true;
+    for (uint32_t neighbor : adj[min]) {
+      if (!removed[neighbor]) {
+        --degree[neighbor];
+      }
+    }
+  }
+  return cores;
+}
+
+/// Both plans must find the core numbers of the serial algorithm
+void
+TestCores(const Adjacency& adj) {
+  std::vector<uint32_t> expected = SerialCores(adj);
+  AdjacencyPolicy policy{adj};
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<int64_t>(adj.size(), 1, &policy);
+
+  for (ga::KCorePlan plan : {ga::KCorePlan::Peel(), ga::KCorePlan::HIndex()}) {
+    const std::string name = "core";
+    if (auto r = ga::KCore(g.get(), name, plan); !r) {
+      GALOIS_LOG_FATAL("could not compute cores: {}", r.error());
+    }
+
+    std::shared_ptr<arrow::ChunkedArray> column = g->NodeProperty(name);
+    GALOIS_LOG_ASSERT(column->num_chunks() == 1);
+    auto cores = std::static_pointer_cast<arrow::UInt32Array>(column->chunk(0));
+    for (size_t n = 0; n < adj.size(); ++n) {
+      GALOIS_LOG_VASSERT(
+          cores->Value(n) == expected[n],
+          "algorithm {} found core {} for node {}, expected {}",
+          static_cast<int>(plan.algorithm()), cores->Value(n), n,
+          expected[n]);
+    }
+
+    if (auto r = g->RemoveNodeProperty(name); !r) {
+      GALOIS_LOG_FATAL("could not remove property: {}", r.error());
+    }
+  }
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys G;
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  // A single edge in both directions
+  TestCores({{1}, {0}});
+  for (unsigned seed = 0; seed < 3; ++seed) {
+    TestCores(MakeSymmetric(1000, 6000, seed));
+  }
+
+  return 0;
+}
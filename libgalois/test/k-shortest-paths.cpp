@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestPropertyGraph.h"
+#include "galois/ArrowInterchange.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/analytics/k_shortest_paths/k_shortest_paths.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace ga = galois::analytics;
+namespace gg = galois::graphs;
+
+namespace {
+
+using Query = std::pair<uint32_t, uint32_t>;
+
+/// Returns the weight of every edge, which is 1 for unweighted graphs
+std::vector<double>
+EdgeWeights(gg::PropertyFileGraph* g, const std::string& weight_name) {
+  std::vector<double> weights(g->topology().num_edges(), 1);
+  if (weight_name.empty()) {
+    return weights;
+  }
+  auto property = std::static_pointer_cast<arrow::UInt32Array>(
+      g->EdgeProperty(weight_name)->chunk(0));
+  for (size_t e = 0; e < weights.size(); ++e) {
+    weights[e] = property->Value(e);
+  }
+  return weights;
+}
+
+/// Returns the length of the lightest edge from src to dst, or a negative
+/// length if there is none
+double
+EdgeLength(
+    gg::PropertyFileGraph* g, const std::vector<double>& weights, uint32_t src,
+    uint32_t dst) {
+  double length = -1;
+  auto [begin, end] = g->topology().edge_range(src);
+  for (auto e = begin; e != end; ++e) {
+    if (g->topology().out_dests->Value(e) == dst &&
+        (length < 0 || weights[e] < length)) {
+      length = weights[e];
+    }
+  }
+  return length;
+}
+
+/// Enumerates the lengths of all simple paths from node to target that avoid
+/// the nodes on_path, for graphs without parallel edges
+void
+EnumeratePaths(
+    gg::PropertyFileGraph* g, const std::vector<double>& weights,
+    uint32_t node, uint32_t target, double length, std::vector<bool>* on_path,
+    std::vector<double>* lengths) {
+  if (node == target) {
+    lengths->emplace_back(length);
+    return;
+  }
+  (*on_path)[node] = true;
+  auto [begin, end] = g->topology().edge_range(node);
+  for (auto e = begin; e != end; ++e) {
+    uint32_t dst = g->topology().out_dests->Value(e);
+    if (!(*on_path)[dst]) {
+      EnumeratePaths(
+          g, weights, dst, target, length + weights[e], on_path, lengths);
+    }
+  }
+  (*on_path)[node] = false;
+}
+
+/// Compares the k shortest paths of every query with the lengths of all
+/// simple paths between its nodes, found by brute force
+void
+CheckQueries(
+    gg::PropertyFileGraph* g, const std::string& weight_name,
+    const std::vector<Query>& queries, uint32_t k) {
+  auto table = ga::KShortestPaths(g, weight_name, queries, k);
+  if (!table) {
+    GALOIS_LOG_FATAL("could not find paths: {}", table.error());
+  }
+  std::shared_ptr<arrow::ChunkedArray> query_column =
+      table.value()->GetColumnByName("query");
+  std::shared_ptr<arrow::ChunkedArray> length_column =
+      table.value()->GetColumnByName("length");
+  std::shared_ptr<arrow::ChunkedArray> path_column =
+      table.value()->GetColumnByName("path");
+  GALOIS_LOG_ASSERT(query_column->num_chunks() == 1);
+  GALOIS_LOG_ASSERT(length_column->num_chunks() == 1);
+  GALOIS_LOG_ASSERT(path_column->num_chunks() == 1);
+  auto query_ids =
+      std::static_pointer_cast<arrow::UInt32Array>(query_column->chunk(0));
+  auto lengths =
+      std::static_pointer_cast<arrow::DoubleArray>(length_column->chunk(0));
+  auto paths =
+      std::static_pointer_cast<arrow::ListArray>(path_column->chunk(0));
+  auto path_nodes =
+      std::static_pointer_cast<arrow::UInt32Array>(paths->values());
+
+  std::vector<double> weights = EdgeWeights(g, weight_name);
+  std::vector<std::vector<double>> found(queries.size());
+  std::vector<std::vector<std::vector<uint32_t>>> found_paths(queries.size());
+  for (int64_t row = 0; row < table.value()->num_rows(); ++row) {
+    uint32_t query = query_ids->Value(row);
+    GALOIS_LOG_ASSERT(query < queries.size());
+    GALOIS_LOG_ASSERT(row == 0 || query_ids->Value(row - 1) <= query);
+
+    std::vector<uint32_t> path;
+    for (int32_t i = 0; i < paths->value_length(row); ++i) {
+      path.emplace_back(path_nodes->Value(paths->value_offset(row) + i));
+    }
+    auto [source, target] = queries[query];
+    GALOIS_LOG_ASSERT(path.front() == source && path.back() == target);
+
+    double length = 0;
+    std::vector<bool> on_path(g->topology().num_nodes());
+    for (size_t i = 0; i < path.size(); ++i) {
+      GALOIS_LOG_VASSERT(!on_path[path[i]], "path is not simple");
+      on_path[path[i]] = true;
+      if (i > 0) {
+        double edge = EdgeLength(g, weights, path[i - 1], path[i]);
+        GALOIS_LOG_VASSERT(
+            edge >= 0, "no edge from {} to {}", path[i - 1], path[i]);
+        length += edge;
+      }
+    }
+    GALOIS_LOG_ASSERT(std::abs(length - lengths->Value(row)) < 1e-9);
+    GALOIS_LOG_VASSERT(
+        std::find(
+            found_paths[query].begin(), found_paths[query].end(), path) ==
+            found_paths[query].end(),
+        "query {} has the same path twice", query);
+    found[query].emplace_back(length);
+    found_paths[query].emplace_back(std::move(path));
+  }
+
+  for (size_t query = 0; query < queries.size(); ++query) {
+    auto [source, target] = queries[query];
+    std::vector<double> expected;
+    std::vector<bool> on_path(g->topology().num_nodes());
+    EnumeratePaths(g, weights, source, target, 0, &on_path, &expected);
+    std::sort(expected.begin(), expected.end());
+    expected.resize(std::min<size_t>(expected.size(), k));
+
+    GALOIS_LOG_VASSERT(
+        found[query].size() == expected.size(),
+        "query {} from {} to {} has {} paths, expected {}", query, source,
+        target, found[query].size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      GALOIS_LOG_VASSERT(
+          std::abs(found[query][i] - expected[i]) < 1e-9,
+          "path {} of query {} has length {}, expected {}", i, query,
+          found[query][i], expected[i]);
+    }
+  }
+}
+
+/// Every pair of nodes among a few sources and all targets, including the
+/// sources themselves
+std::vector<Query>
+MakeQueries(size_t num_nodes) {
+  std::vector<Query> queries;
+  for (uint32_t source : {uint32_t{0}, uint32_t(num_nodes / 2)}) {
+    for (uint32_t target = 0; target < num_nodes; ++target) {
+      queries.emplace_back(source, target);
+    }
+  }
+  return queries;
+}
+
+void
+AddWeights(gg::PropertyFileGraph* g, const std::string& name) {
+  std::vector<uint32_t> weights;
+  for (uint64_t e = 0; e < g->topology().num_edges(); ++e) {
+    weights.emplace_back((e * 7) % 5 + 1);
+  }
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::uint32())}),
+      {galois::BuildArray(weights)});
+  if (auto r = g->AddEdgeProperties(table); !r) {
+    GALOIS_LOG_FATAL("could not add edge property: {}", r.error());
+  }
+}
+
+/// Each node has edges to the next width nodes of a ring, so a ring
+/// (width 1) has a single path between any two nodes and wider rings have
+/// many
+void
+TestRing(size_t num_nodes, size_t width, uint32_t k) {
+  LinePolicy policy{width};
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 1, &policy);
+  std::vector<Query> queries = MakeQueries(num_nodes);
+
+  CheckQueries(g.get(), "", queries, k);
+
+  AddWeights(g.get(), "weight");
+  CheckQueries(g.get(), "weight", queries, k);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys G;
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  TestRing(8, 1, 3);
+  TestRing(9, 3, 1);
+  TestRing(9, 3, 10);
+  TestRing(10, 4, 40);
+
+  return 0;
+}
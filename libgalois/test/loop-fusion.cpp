@@ -0,0 +1,107 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <string>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+
+void
+TestLocalPhases(size_t size) {
+  std::vector<size_t> a(size);
+  std::vector<size_t> twice(size);
+
+  galois::do_all_fused(
+      galois::iterate(size_t{0}, size),
+      std::make_tuple(
+          galois::phase([&](size_t i) { a[i] = i; }),
+          galois::phase([&](size_t i) { twice[i] = a[i] * 2; })),
+      galois::loopname("LocalPhases"));
+
+  for (size_t i = 0; i < size; ++i) {
+    GALOIS_ASSERT(a[i] == i && twice[i] == 2 * i);
+  }
+}
+
+void
+TestBarrierPhases(size_t size) {
+  std::vector<size_t> a(size);
+  std::vector<size_t> reversed(size);
+  galois::GAccumulator<size_t> sum;
+
+  // Each phase reads an item written by another block in the previous phase
+  galois::do_all_fused(
+      galois::iterate(size_t{0}, size),
+      std::make_tuple(
+          galois::phase([&](size_t i) { a[i] = i; }),
+          galois::phase(
+              [&](size_t i) { reversed[i] = a[size - 1 - i]; },
+              galois::after_barrier(), galois::steal()),
+          galois::phase(
+              [&](size_t i) { sum += reversed[(i + size / 2) % size]; },
+              galois::after_barrier())),
+      galois::chunk_size<16>(), galois::loopname("BarrierPhases"));
+
+  for (size_t i = 0; i < size; ++i) {
+    GALOIS_ASSERT(reversed[i] == size - 1 - i);
+  }
+  GALOIS_ASSERT(sum.reduce() == size * (size - 1) / 2);
+}
+
+void
+TestStealing(size_t size) {
+  std::vector<int> visits(size);
+
+  // Make one block much more expensive than the others so that threads steal
+  galois::do_all_fused(
+      galois::iterate(size_t{0}, size),
+      std::make_tuple(galois::phase(
+          [&](size_t i) {
+            if (i < size / 8) {
+              volatile size_t sink = 0;
+              for (size_t j = 0; j < 10000; ++j) {
+                sink = sink + j;
+              }
+            }
+            ++visits[i];
+          },
+          galois::steal())),
+      galois::chunk_size<4>());
+
+  for (size_t i = 0; i < size; ++i) {
+    GALOIS_ASSERT(visits[i] == 1);
+  }
+}
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys G;
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  for (size_t size : {size_t{0}, size_t{1}, size_t{7}, size_t{10000}}) {
+    TestLocalPhases(size);
+    TestBarrierPhases(size);
+    TestStealing(size);
+  }
+
+  return 0;
+}
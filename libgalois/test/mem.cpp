@@ -19,8 +19,15 @@
 
 #include "galois/runtime/Mem.h"
 
+#include <cstring>
+#include <limits>
+#include <vector>
+
 #include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/gIO.h"
+#include "galois/substrate/PagePool.h"
 
 using namespace galois::runtime;
 using namespace galois::substrate;
@@ -31,9 +38,126 @@ struct element {
   element(int i) : val(i), next(0) {}
 };
 
+void
+TestPagePool() {
+  constexpr unsigned kPagesPerThread = 4;
+  size_t pageSize = allocSize();
+  unsigned numThreads = galois::getActiveThreads();
+  // Keep freed pages regardless of GALOIS_PAGE_POOL_WATERMARK
+  pagePoolSetWatermark(std::numeric_limits<size_t>::max());
+
+  // Pages freed by another thread go back to the pool of their owner
+  std::vector<void*> pages(numThreads * kPagesPerThread);
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < kPagesPerThread; ++i) {
+      void* page = pagePoolAlloc();
+      std::memset(page, tid, pageSize);
+      pages[tid * kPagesPerThread + i] = page;
+    }
+  });
+  galois::on_each([&](unsigned tid, unsigned num) {
+    unsigned other = (tid + 1) % num;
+    for (unsigned i = 0; i < kPagesPerThread; ++i) {
+      char* page = static_cast<char*>(pages[other * kPagesPerThread + i]);
+      GALOIS_ASSERT(page[0] == char(other));
+      GALOIS_ASSERT(page[pageSize - 1] == char(other));
+      pagePoolFree(page);
+    }
+  });
+
+  // Trimming returns every free page and trimmed pages can be allocated again
+  int released = numPagePoolReleasedTotal();
+  uint64_t accounted =
+      galois::MemoryAllocated(galois::MemoryCategory::kWorklists);
+  size_t numTrimmed = pagePoolTrim(0);
+  GALOIS_ASSERT(numTrimmed >= pages.size());
+  GALOIS_ASSERT(size_t(numPagePoolReleasedTotal() - released) == numTrimmed);
+  GALOIS_ASSERT(
+      accounted -
+          galois::MemoryAllocated(galois::MemoryCategory::kWorklists) ==
+      numTrimmed * pageSize);
+  GALOIS_ASSERT(pagePoolTrim(0) == 0);
+
+  // Above the watermark, freed pages are returned immediately
+  pagePoolSetWatermark(1);
+  released = numPagePoolReleasedTotal();
+  galois::on_each([&](unsigned tid, unsigned) {
+    for (unsigned i = 0; i < kPagesPerThread; ++i) {
+      void* page = pagePoolAlloc();
+      std::memset(page, tid, pageSize);
+      pages[tid * kPagesPerThread + i] = page;
+    }
+    for (unsigned i = 0; i < kPagesPerThread; ++i) {
+      pagePoolFree(pages[tid * kPagesPerThread + i]);
+    }
+  });
+  GALOIS_ASSERT(
+      unsigned(numPagePoolReleasedTotal() - released) ==
+      numThreads * (kPagesPerThread - 1));
+  pagePoolSetWatermark(std::numeric_limits<size_t>::max());
+}
+
+// LargeArray memory is accounted to the category chosen by its owner
+void
+TestLargeArrayCategory() {
+  using galois::MemoryAllocated;
+  using galois::MemoryCategory;
+  constexpr size_t kSize = 1 << 16;
+
+  uint64_t topology = MemoryAllocated(MemoryCategory::kTopology);
+  uint64_t scratch = MemoryAllocated(MemoryCategory::kScratch);
+
+  galois::LargeArray<uint64_t> array(MemoryCategory::kTopology);
+  array.allocateInterleaved(kSize);
+  GALOIS_ASSERT(
+      MemoryAllocated(MemoryCategory::kTopology) ==
+      topology + kSize * sizeof(uint64_t));
+  GALOIS_ASSERT(MemoryAllocated(MemoryCategory::kScratch) == scratch);
+
+  array.set_memory_category(MemoryCategory::kScratch);
+  GALOIS_ASSERT(MemoryAllocated(MemoryCategory::kTopology) == topology);
+  GALOIS_ASSERT(
+      MemoryAllocated(MemoryCategory::kScratch) ==
+      scratch + kSize * sizeof(uint64_t));
+
+  array.deallocate();
+  GALOIS_ASSERT(MemoryAllocated(MemoryCategory::kScratch) == scratch);
+}
+
+// Bursts of page allocations and frees from all threads, as InsertBag and
+// per-iteration allocators do
+void
+BenchPagePool() {
+  constexpr unsigned kRounds = 1024;
+  constexpr unsigned kBurst = 16;
+
+  galois::StatTimer timer("PagePoolAllocFree");
+  timer.start();
+  galois::on_each([&](unsigned, unsigned) {
+    void* burst[kBurst];
+    for (unsigned r = 0; r < kRounds; ++r) {
+      for (unsigned i = 0; i < kBurst; ++i) {
+        burst[i] = pagePoolAlloc();
+      }
+      for (unsigned i = 0; i < kBurst; ++i) {
+        pagePoolFree(burst[i]);
+      }
+    }
+  });
+  timer.stop();
+}
+
 int
-main() {
+main(int argc, char* argv[]) {
   galois::SharedMemSys Galois_runtime;
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  TestPagePool();
+  TestLargeArrayCategory();
+  BenchPagePool();
+
   unsigned baseAllocSize = SystemHeap::AllocSize;
 
   FixedSizeAllocator<element> falloc;
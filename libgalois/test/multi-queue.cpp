@@ -0,0 +1,184 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/gIO.h"
+#include "galois/worklists/MultiQueue.h"
+
+namespace {
+
+using Item = std::pair<uint32_t, uint32_t>;  // (distance, node)
+
+struct Edge {
+  uint32_t dst;
+  uint32_t weight;
+};
+
+using AdjList = std::vector<std::vector<Edge>>;
+
+AdjList
+MakeGrid(uint32_t width) {
+  AdjList graph(width * width);
+  auto add = [&](uint32_t u, uint32_t v) {
+    uint32_t w = 1 + (u * 7919 + v * 104729) % 100;
+    graph[u].push_back(Edge{v, w});
+    graph[v].push_back(Edge{u, w});
+  };
+  for (uint32_t r = 0; r < width; ++r) {
+    for (uint32_t c = 0; c < width; ++c) {
+      uint32_t u = r * width + c;
+      if (c + 1 < width) {
+        add(u, u + 1);
+      }
+      if (r + 1 < width) {
+        add(u, u + width);
+      }
+    }
+  }
+  return graph;
+}
+
+std::vector<uint32_t>
+SerialDijkstra(const AdjList& graph, uint32_t source) {
+  std::vector<uint32_t> dist(
+      graph.size(), std::numeric_limits<uint32_t>::max());
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  dist[source] = 0;
+  queue.push(Item{0, source});
+  while (!queue.empty()) {
+    auto [d, u] = queue.top();
+    queue.pop();
+    if (d > dist[u]) {
+      continue;
+    }
+    for (const Edge& e : graph[u]) {
+      if (d + e.weight < dist[e.dst]) {
+        dist[e.dst] = d + e.weight;
+        queue.push(Item{dist[e.dst], e.dst});
+      }
+    }
+  }
+  return dist;
+}
+
+void
+TestSerial() {
+  constexpr int kNum = 10000;
+
+  galois::worklists::MultiQueue<std::less<>, int> wl(2);
+  std::vector<int> pushed;
+  for (int i = 0; i < kNum; ++i) {
+    pushed.push_back((i * 7919) % kNum);
+  }
+  wl.push(pushed.begin(), pushed.end());
+  GALOIS_ASSERT(!wl.empty());
+
+  std::vector<int> popped;
+  while (auto item = wl.pop()) {
+    popped.push_back(*item);
+  }
+  GALOIS_ASSERT(wl.empty());
+  GALOIS_ASSERT(wl.numPops() == kNum);
+  GALOIS_ASSERT(wl.numInversions() < kNum);
+
+  std::sort(pushed.begin(), pushed.end());
+  std::vector<int> sorted = popped;
+  std::sort(sorted.begin(), sorted.end());
+  GALOIS_ASSERT(sorted == pushed);
+
+  // The relaxed order should still be close to sorted: no item is popped
+  // after many smaller ones
+  size_t displaced = 0;
+  for (int i = 0; i < kNum; ++i) {
+    if (std::abs(popped[i] - i) > 64 * int(wl.numQueues())) {
+      ++displaced;
+    }
+  }
+  GALOIS_ASSERT(displaced == 0);
+
+  // A single heap is an exact priority queue
+  galois::worklists::MultiQueue<std::greater<>, int, false> exact(1);
+  exact.push(pushed.begin(), pushed.end());
+  for (int i = kNum - 1; i >= 0; --i) {
+    GALOIS_ASSERT(*exact.pop() == i);
+  }
+  GALOIS_ASSERT(exact.numInversions() == 0);
+}
+
+void
+TestDijkstra() {
+  AdjList graph = MakeGrid(100);
+  std::vector<uint32_t> expected = SerialDijkstra(graph, 0);
+
+  std::vector<std::atomic<uint32_t>> dist(graph.size());
+  for (auto& d : dist) {
+    d = std::numeric_limits<uint32_t>::max();
+  }
+  dist[0] = 0;
+
+  std::vector<Item> initial{Item{0, 0}};
+  galois::for_each(
+      galois::iterate(initial),
+      [&](const Item& item, auto& ctx) {
+        auto [d, u] = item;
+        if (d > dist[u]) {
+          return;
+        }
+        for (const Edge& e : graph[u]) {
+          uint32_t nd = d + e.weight;
+          uint32_t old = dist[e.dst];
+          while (nd < old && !dist[e.dst].compare_exchange_weak(old, nd)) {
+          }
+          if (nd < old) {
+            ctx.push(Item{nd, e.dst});
+          }
+        }
+      },
+      galois::wl<galois::worklists::MultiQueue<>>(),
+      galois::disable_conflict_detection(), galois::loopname("Dijkstra"));
+
+  for (size_t i = 0; i < graph.size(); ++i) {
+    GALOIS_ASSERT(dist[i] == expected[i]);
+  }
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys sys;
+
+  unsigned num_threads = 2;
+  if (argc > 1) {
+    num_threads = std::atoi(argv[1]);
+  }
+  galois::setActiveThreads(num_threads);
+
+  TestSerial();
+  TestDijkstra();
+
+  return 0;
+}
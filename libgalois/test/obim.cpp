@@ -0,0 +1,166 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+#include "galois/Galois.h"
+#include "galois/Timer.h"
+
+// Stresses OrderedByIntegerMetric with many distinct priorities, similar to
+// fine-grained delta-stepping (ascending priorities) and k-core peeling
+// (descending priorities), and prints a scaling curve as
+// workload,threads,priority span,time.
+
+struct Item {
+  uint32_t node;
+  int priority;
+};
+
+struct Indexer {
+  int operator()(const Item& item) const { return item.priority; }
+};
+
+uint32_t num_nodes = 1 << 20;
+
+int
+Step(uint32_t node) {
+  return static_cast<int>((node * 2654435761U) >> 26) + 1;
+}
+
+template <typename WL, bool Descending>
+void
+Run(const char* name, unsigned threads) {
+  galois::setActiveThreads(threads);
+
+  galois::GAccumulator<size_t> visited;
+  galois::GReduceMax<int> max_span;
+  int root = Descending ? std::numeric_limits<int>::max() / 2 : 0;
+  std::array<Item, 1> init{Item{0, root}};
+
+  galois::Timer t;
+  t.start();
+  galois::for_each(
+      galois::iterate(init.begin(), init.end()),
+      [&](const Item& item, auto& ctx) {
+        visited += 1;
+        max_span.update(
+            Descending ? root - item.priority : item.priority - root);
+        for (uint32_t c = 2 * item.node + 1;
+             c <= 2 * item.node + 2 && c < num_nodes; ++c) {
+          int next =
+              Descending ? item.priority - Step(c) : item.priority + Step(c);
+          ctx.push(Item{c, next});
+        }
+      },
+      galois::wl<WL>(), galois::disable_conflict_detection(),
+      galois::no_stats());
+  t.stop();
+
+  GALOIS_ASSERT(visited.reduce() == num_nodes);
+  std::cout << name << "," << threads << "," << max_span.reduce() << ","
+            << t.get() << "\n";
+}
+
+// Drains a bucket before pushing to the next priority, as a delta-stepping
+// sweep does; drained buckets must be reused instead of one bucket being
+// allocated per priority.
+template <typename WL, bool Descending>
+void
+RunRecycle(int span) {
+  galois::setActiveThreads(1);
+
+  typename WL::template retype<Item> wl;
+  for (int i = 0; i < span; ++i) {
+    int priority = Descending ? -i : i;
+    wl.push(Item{0, priority});
+    auto popped = wl.pop();
+    GALOIS_ASSERT(popped && popped->priority == priority);
+  }
+  GALOIS_ASSERT(!wl.pop());
+  GALOIS_ASSERT(wl.num_buckets() <= 2);
+}
+
+// Threads sweep the priorities together, each pushing the next priority and
+// popping any item, so buckets are retired by one thread while others may
+// still push to them. No item may be lost, and the time is printed as a
+// scaling curve of bucket retirement and reuse.
+template <typename WL, bool Descending>
+void
+RunRecycleParallel(const char* name, int span, unsigned threads) {
+  galois::setActiveThreads(threads);
+
+  typename WL::template retype<Item> wl;
+  std::atomic<int> next{0};
+  std::atomic<int> popped{0};
+
+  galois::Timer t;
+  t.start();
+  galois::on_each([&](unsigned, unsigned) {
+    for (;;) {
+      int i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i < span) {
+        wl.push(Item{0, Descending ? -i : i});
+      }
+      if (wl.pop()) {
+        popped.fetch_add(1, std::memory_order_relaxed);
+      } else if (popped.load(std::memory_order_relaxed) == span) {
+        break;
+      }
+    }
+  });
+  t.stop();
+
+  GALOIS_ASSERT(popped.load() == span);
+  std::cout << name << "," << threads << "," << span << "," << t.get()
+            << "\n";
+}
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys Galois_runtime;
+  if (argc > 1)
+    num_nodes = atoi(argv[1]);
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+  if (argc > 2)
+    max_threads = atoi(argv[2]);
+
+  using Chunk = galois::worklists::PerSocketChunkFIFO<64>;
+  using Ascending = galois::worklists::OrderedByIntegerMetric<Indexer, Chunk>;
+  using Descending = Ascending::with_descending<true>::type;
+  using AscendingBarrier = Ascending::with_barrier<true>::type;
+
+  RunRecycle<Ascending, false>(num_nodes);
+  RunRecycle<Descending, true>(num_nodes);
+
+  for (unsigned threads = max_threads; threads; threads /= 2) {
+    RunRecycleParallel<Ascending, false>(
+        "obim-recycle-ascending", num_nodes, threads);
+    RunRecycleParallel<Descending, true>(
+        "obim-recycle-descending", num_nodes, threads);
+    Run<Ascending, false>("obim-ascending", threads);
+    Run<Descending, true>("obim-descending", threads);
+    Run<AscendingBarrier, false>("obim-ascending-barrier", threads);
+  }
+
+  return 0;
+}
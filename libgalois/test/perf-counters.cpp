@@ -0,0 +1,105 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Reduction.h"
+#include "galois/runtime/PerfCounters.h"
+#include "galois/runtime/Profile.h"
+
+// Exercises the perf_event_open counters through the profile_counters loop
+// trait and the profilePerf region API. Counters may legitimately be
+// unavailable (e.g., in containers), in which case only the fallback is
+// checked.
+
+using galois::runtime::PerfCounters;
+
+void
+CheckThreadCounters() {
+  PerfCounters::Values before;
+  if (!PerfCounters::Read(&before)) {
+    std::cout << "hardware counters not available\n";
+    return;
+  }
+
+  volatile uint64_t sink = 0;
+  for (uint64_t i = 0; i < (1 << 20); ++i) {
+    sink = sink + i;
+  }
+
+  PerfCounters::Values after;
+  GALOIS_ASSERT(PerfCounters::Read(&after));
+  for (size_t i = 0; i < before.size(); ++i) {
+    GALOIS_ASSERT(after[i] >= before[i]);
+  }
+  if (PerfCounters::IsAvailable(PerfCounters::kInstructions)) {
+    GALOIS_ASSERT(
+        after[PerfCounters::kInstructions] -
+            before[PerfCounters::kInstructions] >=
+        (1 << 20));
+  }
+}
+
+int
+main(int argc, char* argv[]) {
+  galois::SharedMemSys G;
+
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+
+  CheckThreadCounters();
+
+  size_t size = 1 << 22;
+  std::vector<size_t> vec(size);
+
+  galois::runtime::profilePerf(
+      [&]() {
+        galois::do_all(
+            galois::iterate(size_t{0}, size), [&](size_t i) { vec[i] = i; });
+      },
+      "vecInit");
+
+  galois::GAccumulator<size_t> sum;
+  galois::do_all(
+      galois::iterate(size_t{0}, size), [&](size_t i) { sum += vec[i]; },
+      galois::loopname("vecSum"), galois::profile_counters());
+  GALOIS_ASSERT(sum.reduce() == size * (size - 1) / 2);
+
+  galois::GAccumulator<size_t> count;
+  galois::for_each(
+      galois::iterate(size_t{0}, size_t{1024}),
+      [&](size_t i, auto& ctx) {
+        count += 1;
+        if (i % 2 == 0) {
+          ctx.push(i + 1);
+        }
+      },
+      galois::loopname("forEach"), galois::profile_counters(),
+      galois::disable_conflict_detection());
+  GALOIS_ASSERT(count.reduce() == 1024 + 512);
+
+  galois::on_each(
+      [&](unsigned, unsigned) {}, galois::loopname("onEach"),
+      galois::profile_counters());
+
+  return 0;
+}
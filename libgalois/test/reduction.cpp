@@ -1,8 +1,10 @@
 #include "galois/Reduction.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <vector>
 
 #include "galois/Galois.h"
 #include "galois/SharedMemSys.h"
@@ -87,10 +89,88 @@ test_accum() {
   GALOIS_ASSERT(accum.reduce() == num);
 }
 
+void
+test_combine() {
+  galois::GAccumulator<int> accum;
+  galois::GReduceMax<int> max;
+
+  constexpr int num = 123456;
+
+  for (int round = 0; round < 3; ++round) {
+    galois::do_all(
+        galois::iterate(0, num),
+        [&](int i) {
+          accum += 1;
+          max.update(i);
+        },
+        galois::steal(), galois::combine_reducers(accum, max));
+
+    GALOIS_ASSERT(accum.reduce() == num);
+    GALOIS_ASSERT(max.reduce() == num - 1);
+    accum.reset();
+  }
+
+  // Without combine_reducers after a combined loop
+  galois::do_all(galois::iterate(0, num), [&](int) { accum += 2; });
+  GALOIS_ASSERT(accum.reduce() == 2 * num);
+}
+
+void
+test_vector() {
+  constexpr size_t num_buckets = 10;
+  constexpr int num = 12345;
+
+  galois::GVectorAccumulator<size_t> hist(num_buckets);
+  GALOIS_ASSERT(hist.size() == num_buckets);
+
+  galois::do_all(
+      galois::iterate(0, num), [&](int i) { hist.update(i % num_buckets, 1); },
+      galois::combine_reducers(hist));
+
+  std::vector<size_t>& counts = hist.reduce();
+  GALOIS_ASSERT(counts.size() == num_buckets);
+  for (size_t i = 0; i < num_buckets; ++i) {
+    size_t expected = num / num_buckets + (i < num % num_buckets ? 1 : 0);
+    GALOIS_ASSERT(counts[i] == expected);
+  }
+
+  auto mins = galois::make_vector_reducible<int>(
+      2, galois::gmin<int>(), galois::identity_value_max<int>());
+  galois::do_all(galois::iterate(0, num), [&](int i) {
+    mins.update(i % 2, i);
+  });
+  GALOIS_ASSERT(mins.reduce() == std::vector<int>({0, 1}));
+}
+
+void
+test_topk() {
+  constexpr int num = 12345;
+  constexpr size_t k = 5;
+
+  galois::GReduceTopK<int> largest(k);
+  galois::do_all(galois::iterate(0, num), [&](int i) {
+    largest.update((i * 7919) % num);
+  });
+  std::vector<int> top = largest.reduce();
+  GALOIS_ASSERT(
+      top == std::vector<int>({num - 1, num - 2, num - 3, num - 4, num - 5}));
+
+  galois::GReduceTopK<int, std::greater<int>> smallest(k);
+  galois::do_all(
+      galois::iterate(0, 3), [&](int i) { smallest.update(i); },
+      galois::combine_reducers(smallest));
+  GALOIS_ASSERT(smallest.reduce() == std::vector<int>({0, 1, 2}));
+}
+
 int
-main() {
+main(int argc, char** argv) {
   galois::SharedMemSys sys;
-  galois::setActiveThreads(2);
+
+  unsigned num_threads = 2;
+  if (argc > 1) {
+    num_threads = std::atoi(argv[1]);
+  }
+  galois::setActiveThreads(num_threads);
 
   static_assert(
       sizeof(galois::GAccumulator<int>) <=
@@ -100,6 +180,9 @@ main() {
   test_move();
   test_max();
   test_accum();
+  test_combine();
+  test_vector();
+  test_topk();
 
   return 0;
 }
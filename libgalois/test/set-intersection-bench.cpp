@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "galois/Logging.h"
+#include "galois/SetIntersection.h"
+
+namespace {
+
+enum Kernel {
+  kMerge,
+  kGalloping,
+  kSimd,
+  kBitmap,
+  kAuto,
+};
+
+using Set = std::vector<uint32_t>;
+
+Set
+RandomSet(std::mt19937* rng, size_t size, uint32_t universe) {
+  std::uniform_int_distribution<uint32_t> dist(0, universe - 1);
+  Set ret(size);
+  for (auto& x : ret) {
+    x = dist(*rng);
+  }
+  std::sort(ret.begin(), ret.end());
+  ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+  return ret;
+}
+
+template <Kernel kernel>
+uint64_t
+Count(galois::IntersectionBitmap* bitmap, const Set& a, const Set& b) {
+  switch (kernel) {
+  case kMerge:
+    return galois::IntersectCountMerge(a.data(), a.size(), b.data(), b.size());
+  case kGalloping:
+    return galois::IntersectCountGalloping(
+        a.data(), a.size(), b.data(), b.size());
+  case kSimd:
+    return galois::IntersectCountSimd(a.data(), a.size(), b.data(), b.size());
+  case kBitmap: {
+    // Includes building the bitmap; reusing it for many sets of b amortizes
+    // this in practice
+    bitmap->Insert(a.data(), a.size());
+    uint64_t count = bitmap->Count(b.data(), b.size());
+    bitmap->Erase(a.data(), a.size());
+    return count;
+  }
+  default:
+    return galois::IntersectCount(a.data(), a.size(), b.data(), b.size());
+  }
+}
+
+/// Pairs of sets whose sizes differ by a fixed ratio: range(0) is the size of
+/// the smaller set and range(1) the ratio. A quarter of the smaller set is
+/// also in the larger one.
+void
+MakeRatioArguments(benchmark::internal::Benchmark* b) {
+  for (long small_size : {16, 256, 4096, 65536}) {
+    for (long ratio : {1, 2, 4, 16, 32, 64, 128, 256}) {
+      b->Args({small_size, ratio});
+    }
+  }
+}
+
+template <Kernel kernel>
+void
+IntersectRatio(benchmark::State& state) {
+  auto [small_size, ratio] = std::make_tuple(state.range(0), state.range(1));
+  size_t large_size = small_size * ratio;
+
+  std::mt19937 rng(small_size * 31 + ratio);
+  // Sample a quarter of the smaller set from the larger one, so the size of
+  // the intersection does not depend on the ratio
+  Set large = RandomSet(&rng, large_size, 4 * large_size);
+  Set small;
+  std::sample(
+      large.begin(), large.end(), std::back_inserter(small), small_size / 4,
+      rng);
+  Set rest = RandomSet(&rng, small_size - small.size(), 4 * large_size);
+  small.insert(small.end(), rest.begin(), rest.end());
+  std::sort(small.begin(), small.end());
+  small.erase(std::unique(small.begin(), small.end()), small.end());
+
+  galois::IntersectionBitmap bitmap(4 * large_size);
+  uint64_t expected = galois::IntersectCountMerge(
+      small.data(), small.size(), large.data(), large.size());
+
+  for (auto _ : state) {
+    uint64_t count = Count<kernel>(&bitmap, large, small);
+    GALOIS_LOG_VASSERT(
+        count == expected, "expected {} found {}", expected, count);
+  }
+  state.SetItemsProcessed(state.iterations() * (small.size() + large.size()));
+}
+
+/// Neighbor lists of a graph whose degrees follow a power law with exponent
+/// range(0) / 10, intersected pairwise as in triangle counting
+void
+MakePowerLawArguments(benchmark::internal::Benchmark* b) {
+  for (long exponent : {15, 20, 25, 30}) {
+    b->Args({exponent});
+  }
+}
+
+template <Kernel kernel>
+void
+IntersectPowerLaw(benchmark::State& state) {
+  constexpr size_t kNumSets = 1024;
+  constexpr uint32_t kUniverse = 1 << 20;
+  constexpr double kMaxDegree = 1 << 16;
+  double exponent = state.range(0) / 10.0;
+
+  // Inverse transform sampling of a continuous power law with minimum 1
+  std::mt19937 rng(state.range(0));
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::vector<Set> sets;
+  size_t total_size = 0;
+  for (size_t i = 0; i < kNumSets; ++i) {
+    double degree = std::pow(1 - uniform(rng), -1 / (exponent - 1));
+    sets.emplace_back(RandomSet(
+        &rng, static_cast<size_t>(std::min(degree, kMaxDegree)), kUniverse));
+    total_size += sets.back().size();
+  }
+
+  std::vector<std::pair<size_t, size_t>> pairs;
+  std::uniform_int_distribution<size_t> pick(0, kNumSets - 1);
+  for (size_t i = 0; i < kNumSets; ++i) {
+    pairs.emplace_back(pick(rng), pick(rng));
+  }
+
+  galois::IntersectionBitmap bitmap(kUniverse);
+
+  for (auto _ : state) {
+    uint64_t count = 0;
+    for (const auto& [x, y] : pairs) {
+      count += Count<kernel>(&bitmap, sets[x], sets[y]);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["MeanDegree"] = static_cast<double>(total_size) / kNumSets;
+  state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+
+BENCHMARK_TEMPLATE(IntersectRatio, kMerge)->Apply(MakeRatioArguments);
+BENCHMARK_TEMPLATE(IntersectRatio, kGalloping)->Apply(MakeRatioArguments);
+BENCHMARK_TEMPLATE(IntersectRatio, kSimd)->Apply(MakeRatioArguments);
+BENCHMARK_TEMPLATE(IntersectRatio, kBitmap)->Apply(MakeRatioArguments);
+BENCHMARK_TEMPLATE(IntersectRatio, kAuto)->Apply(MakeRatioArguments);
+
+BENCHMARK_TEMPLATE(IntersectPowerLaw, kMerge)->Apply(MakePowerLawArguments);
+BENCHMARK_TEMPLATE(IntersectPowerLaw, kGalloping)
+    ->Apply(MakePowerLawArguments);
+BENCHMARK_TEMPLATE(IntersectPowerLaw, kSimd)->Apply(MakePowerLawArguments);
+BENCHMARK_TEMPLATE(IntersectPowerLaw, kAuto)->Apply(MakePowerLawArguments);
+
+}  // namespace
+
+BENCHMARK_MAIN();
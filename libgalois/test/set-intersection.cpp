@@ -0,0 +1,117 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "galois/SetIntersection.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "galois/Logging.h"
+
+namespace {
+
+std::vector<uint32_t>
+RandomSet(std::mt19937* rng, size_t size, uint32_t universe) {
+  std::uniform_int_distribution<uint32_t> dist(0, universe - 1);
+  std::vector<uint32_t> ret(size);
+  for (auto& x : ret) {
+    x = dist(*rng);
+  }
+  std::sort(ret.begin(), ret.end());
+  ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+  return ret;
+}
+
+void
+TestSizes(size_t a_size, size_t b_size, uint32_t universe) {
+  std::mt19937 rng(a_size * 7919 + b_size);
+  galois::IntersectionBitmap bitmap(universe);
+  for (int trial = 0; trial < 20; ++trial) {
+    std::vector<uint32_t> a = RandomSet(&rng, a_size, universe);
+    std::vector<uint32_t> c = RandomSet(&rng, b_size, universe);
+
+    std::vector<uint32_t> expected;
+    std::set_intersection(
+        a.begin(), a.end(), c.begin(), c.end(), std::back_inserter(expected));
+
+    std::vector<uint32_t> merged;
+    galois::IntersectMerge(
+        a.data(), a.size(), c.data(), c.size(),
+        [&](uint32_t x) { merged.push_back(x); });
+    GALOIS_LOG_ASSERT(merged == expected);
+
+    std::vector<uint32_t> galloped;
+    galois::IntersectGalloping(
+        a.data(), a.size(), c.data(), c.size(),
+        [&](uint32_t x) { galloped.push_back(x); });
+    GALOIS_LOG_ASSERT(galloped == expected);
+
+    uint64_t count = expected.size();
+    GALOIS_LOG_ASSERT(
+        galois::IntersectCount(a.data(), a.size(), c.data(), c.size()) ==
+        count);
+    GALOIS_LOG_ASSERT(
+        galois::IntersectCount(c.data(), c.size(), a.data(), a.size()) ==
+        count);
+    GALOIS_LOG_ASSERT(
+        galois::IntersectCountMerge(a.data(), a.size(), c.data(), c.size()) ==
+        count);
+    GALOIS_LOG_ASSERT(
+        galois::IntersectCountGalloping(
+            a.data(), a.size(), c.data(), c.size()) == count);
+    GALOIS_LOG_ASSERT(
+        galois::IntersectCountSimd(a.data(), a.size(), c.data(), c.size()) ==
+        count);
+
+    bitmap.Insert(a.data(), a.size());
+    GALOIS_LOG_ASSERT(bitmap.Count(c.data(), c.size()) == count);
+    for (uint32_t x : expected) {
+      GALOIS_LOG_ASSERT(bitmap.Contains(x));
+    }
+    bitmap.Erase(a.data(), a.size());
+    // The bitmap is empty again, so it can be reused for the next set
+    GALOIS_LOG_ASSERT(bitmap.Count(a.data(), a.size()) == 0);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  // Dense and sparse overlaps, sizes around the vector widths and tails, and
+  // skewed sizes that take the galloping path
+  for (size_t a_size : {0, 1, 3, 4, 7, 8, 9, 16, 33, 100, 1000}) {
+    for (size_t b_size : {0, 1, 5, 8, 17, 64, 1000, 50000}) {
+      TestSizes(a_size, b_size, 2 * std::max<size_t>(a_size, b_size) + 1);
+      TestSizes(a_size, b_size, 1 << 20);
+    }
+  }
+
+  // Identical sets
+  std::vector<uint32_t> all(1000);
+  for (size_t i = 0; i < all.size(); ++i) {
+    all[i] = i * 3;
+  }
+  GALOIS_LOG_ASSERT(
+      galois::IntersectCount(all.data(), all.size(), all.data(), all.size()) ==
+      all.size());
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "galois/Galois.h"
+#include "galois/Statistics.h"
+
+// Checks the JSON Lines export of statistics: records carry the run metadata,
+// snapshots can be taken repeatedly during a run and reset clears what has
+// been reported, except for parameters.
+
+std::vector<nlohmann::json>
+ParseRecords(const std::string& lines) {
+  std::vector<nlohmann::json> records;
+  std::istringstream in(lines);
+  std::string line;
+  while (std::getline(in, line)) {
+    records.emplace_back(nlohmann::json::parse(line));
+  }
+  return records;
+}
+
+const nlohmann::json*
+FindRecord(
+    const std::vector<nlohmann::json>& records, const std::string& region,
+    const std::string& category) {
+  for (const auto& r : records) {
+    if (r["region"] == region && r["category"] == category) {
+      return &r;
+    }
+  }
+  return nullptr;
+}
+
+void
+ReportIteration(int value) {
+  galois::on_each([&](unsigned, unsigned) {
+    galois::ReportStatSum("Query", "Work", value);
+  });
+}
+
+int
+main(int argc, char* argv[]) {
+  // Without a runtime there are no statistics to snapshot
+  GALOIS_ASSERT(galois::SnapshotStats().empty());
+  GALOIS_ASSERT(!galois::WriteStatsJsonLines("unused.jsonl"));
+
+  galois::SharedMemSys G;
+
+  if (argc > 1) {
+    galois::setActiveThreads(std::stoul(argv[1]));
+  }
+  unsigned num_threads = galois::getActiveThreads();
+
+  galois::SetStatMetadata("graph", "test-graph");
+  galois::SetStatMetadata("graph_version", "1");
+
+  ReportIteration(1);
+  galois::ReportParam("Query", "Name", "first");
+  {
+    galois::StatTimer timer("Time", "Query");
+    timer.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    timer.stop();
+  }
+
+  auto records = ParseRecords(galois::SnapshotStats());
+  GALOIS_ASSERT(!records.empty());
+  for (const auto& r : records) {
+    GALOIS_ASSERT(r["threads"] == num_threads);
+    GALOIS_ASSERT(r["snapshot"] == 0);
+    GALOIS_ASSERT(r["metadata"]["graph"] == "test-graph");
+    GALOIS_ASSERT(r["metadata"]["graph_version"] == "1");
+    GALOIS_ASSERT(r.contains("host"));
+    GALOIS_ASSERT(r.contains("version"));
+    GALOIS_ASSERT(r.contains("command_line"));
+  }
+
+  const auto* work = FindRecord(records, "Query", "Work");
+  GALOIS_ASSERT(work);
+  GALOIS_ASSERT((*work)["kind"] == "STAT");
+  GALOIS_ASSERT((*work)["total_type"] == "TSUM");
+  GALOIS_ASSERT((*work)["total"] == num_threads);
+  GALOIS_ASSERT((*work)["thread_values"].size() == num_threads);
+
+  const auto* name = FindRecord(records, "Query", "Name");
+  GALOIS_ASSERT(name);
+  GALOIS_ASSERT((*name)["kind"] == "PARAM");
+  GALOIS_ASSERT((*name)["total"] == "first");
+
+  // Timers report microseconds only when asked to
+  GALOIS_ASSERT(FindRecord(records, "Query", "Time"));
+  GALOIS_ASSERT(!FindRecord(records, "Query", "TimeUsec"));
+
+  // Snapshots do not consume statistics unless asked to
+  ReportIteration(2);
+  records = ParseRecords(galois::SnapshotStats(true));
+  work = FindRecord(records, "Query", "Work");
+  GALOIS_ASSERT(work);
+  GALOIS_ASSERT((*work)["snapshot"] == 1);
+  GALOIS_ASSERT((*work)["total"] == 3 * num_threads);
+
+  // Parameters describe the run and outlive resets
+  ReportIteration(4);
+  records = ParseRecords(galois::SnapshotStats(true));
+  name = FindRecord(records, "Query", "Name");
+  GALOIS_ASSERT(name);
+  GALOIS_ASSERT((*name)["total"] == "first");
+  work = FindRecord(records, "Query", "Work");
+  GALOIS_ASSERT(work);
+  GALOIS_ASSERT((*work)["total"] == 4 * num_threads);
+
+  records = ParseRecords(galois::SnapshotStats());
+  for (const auto& r : records) {
+    GALOIS_ASSERT(r["kind"] == "PARAM");
+  }
+
+  galois::SetStatTimerMicroseconds(true);
+  {
+    galois::StatTimer timer("Time", "Query");
+    timer.start();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    timer.stop();
+  }
+  records = ParseRecords(galois::SnapshotStats(true));
+  const auto* usec = FindRecord(records, "Query", "TimeUsec");
+  GALOIS_ASSERT(usec);
+  GALOIS_ASSERT((*usec)["total"] >= 100);
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <cstdlib>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/gIO.h"
+#include "galois/runtime/Context.h"
+
+namespace {
+
+struct Node : public galois::runtime::Lockable {
+  int value{0};
+};
+
+constexpr size_t kNumNodes = 64;
+constexpr int kNumItems = 100000;
+
+//! Every item updates two nodes without atomics; a missed conflict shows up
+//! as a lost update
+void
+TestExclusive() {
+  std::vector<Node> nodes(kNumNodes);
+
+  galois::for_each(
+      galois::iterate(0, kNumItems),
+      [&](int item, auto&) {
+        Node& src = nodes[item % kNumNodes];
+        Node& dst = nodes[(item * 7919 + 1) % kNumNodes];
+        galois::runtime::acquire(&src, galois::MethodFlag::WRITE);
+        galois::runtime::acquire(&dst, galois::MethodFlag::WRITE);
+        src.value += 1;
+        dst.value += 1;
+      },
+      galois::striped_locks(), galois::loopname("StripedLocks"));
+
+  int total = 0;
+  for (const Node& n : nodes) {
+    total += n.value;
+  }
+  GALOIS_ASSERT(total == 2 * kNumItems);
+
+  auto& table = galois::runtime::GetStripedLockTable();
+  GALOIS_ASSERT(table.NumCommits() == kNumItems);
+  // Every abort comes from a conflict on some stripe
+  bool contended = false;
+  for (const Node& n : nodes) {
+    contended = contended || table.Contention(&n) > 0;
+  }
+  GALOIS_ASSERT(contended || table.NumAborts() == 0);
+}
+
+void
+TestTable() {
+  galois::runtime::StripedLockTable table(1000);
+  GALOIS_ASSERT(table.NumStripes() == 1024);
+
+  std::vector<Node> nodes(kNumNodes);
+  std::vector<int> hits(table.NumStripes());
+  for (const Node& n : nodes) {
+    uint32_t stripe = table.StripeOf(&n);
+    GALOIS_ASSERT(stripe < table.NumStripes());
+    ++hits[stripe];
+    GALOIS_ASSERT(table.Contention(&n) == 0);
+  }
+  // Consecutive objects should spread over the table
+  for (int h : hits) {
+    GALOIS_ASSERT(h <= 2);
+  }
+
+  galois::runtime::StripedRuntimeContext ctx(table);
+  ctx.startIteration();
+  galois::runtime::setThreadContext(&ctx);
+  galois::runtime::acquire(&nodes[0], galois::MethodFlag::WRITE);
+  galois::runtime::acquire(&nodes[0], galois::MethodFlag::WRITE);
+  galois::runtime::acquire(&nodes[1], galois::MethodFlag::WRITE);
+  galois::runtime::setThreadContext(nullptr);
+  GALOIS_ASSERT(ctx.commitIteration() == 2);
+  GALOIS_ASSERT(table.NumCommits() == 1);
+  GALOIS_ASSERT(table.NumAborts() == 0);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  galois::SharedMemSys sys;
+
+  unsigned num_threads = 2;
+  if (argc > 1) {
+    num_threads = std::atoi(argv[1]);
+  }
+  galois::setActiveThreads(num_threads);
+
+  TestTable();
+  TestExclusive();
+
+  return 0;
+}
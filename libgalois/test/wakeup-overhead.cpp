@@ -17,9 +17,12 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <sys/resource.h>
+
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
@@ -41,27 +44,57 @@ static cll::opt<int> trials(
     "trials", cll::desc("number of trials"), cll::init(1));
 static cll::opt<unsigned> threads(
     "threads", cll::desc("number of threads"), cll::init(2));
+static cll::opt<int> gap(
+    "gap",
+    cll::desc("microseconds the master thread sleeps between rounds, e.g., "
+              "to model a service waiting for requests"),
+    cll::init(0));
+
+using Clock = std::chrono::steady_clock;
+
+//! total time spent in the rounds of a run, excluding gaps
+static Clock::duration roundTime;
 
 void
-runDoAllBurn(int num) {
-  galois::substrate::GetThreadPool().burnPower(galois::getActiveThreads());
+waitGap() {
+  if (gap > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(gap));
+  }
+}
 
+void
+doAllRounds(int num) {
   for (int r = 0; r < rounds; ++r) {
+    waitGap();
+    auto begin = Clock::now();
     galois::do_all(galois::iterate(0, num), [&](int) {
       asm volatile("" ::: "memory");
     });
+    roundTime += Clock::now() - begin;
   }
+}
 
+void
+runDoAllBurn(int num) {
+  galois::substrate::GetThreadPool().burnPower(galois::getActiveThreads());
+  doAllRounds(num);
   galois::substrate::GetThreadPool().beKind();
 }
 
 void
 runDoAll(int num) {
-  for (int r = 0; r < rounds; ++r) {
-    galois::do_all(galois::iterate(0, num), [&](int) {
-      asm volatile("" ::: "memory");
-    });
-  }
+  doAllRounds(num);
+}
+
+void
+runDoAllAdaptive(int num) {
+  auto& pool = galois::substrate::GetThreadPool();
+  auto old = pool.getIdlePolicy();
+  pool.setIdlePolicy(galois::substrate::ThreadPool::IdlePolicy::kAdaptive);
+  doAllRounds(num);
+  std::cout << "DoAllAdaptive spin window (us): "
+            << pool.getIdleSpinNs() / 1000.0 << "\n";
+  pool.setIdlePolicy(old);
 }
 
 void
@@ -74,6 +107,9 @@ runExplicitThread(int num) {
         boost::counting_iterator<int>(0), boost::counting_iterator<int>(num),
         tid, total);
     for (int r = 0; r < rounds; ++r) {
+      if (tid == 0) {
+        waitGap();
+      }
       for (auto ii = range.first, ei = range.second; ii != ei; ++ii) {
         asm volatile("" ::: "memory");
       }
@@ -82,13 +118,32 @@ runExplicitThread(int num) {
   });
 }
 
+double
+cpuSeconds() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
 void
 run(std::function<void(int)> fn, std::string name) {
+  roundTime = Clock::duration::zero();
+  double cpuBegin = cpuSeconds();
   galois::Timer t;
   t.start();
   fn(size);
   t.stop();
-  std::cout << name << " time: " << t.get() << "\n";
+  double cpu = cpuSeconds() - cpuBegin;
+
+  std::cout << name << " time: " << t.get() << " cpu time (ms): " << cpu * 1e3;
+  // Rounds of explicit threads are not timed separately
+  if (roundTime != Clock::duration::zero()) {
+    std::cout << " round latency (us): "
+              << std::chrono::duration<double, std::micro>(roundTime).count() /
+                     rounds;
+  }
+  std::cout << "\n";
 }
 
 std::atomic<int> EXIT;
@@ -111,6 +166,7 @@ main(int argc, char* argv[]) {
 
   for (int t = 0; t < trials; ++t) {
     run(runDoAll, "DoAll");
+    run(runDoAllAdaptive, "DoAllAdaptive");
     run(runDoAllBurn, "DoAllBurn");
     run(runExplicitThread, "ExplicitThread");
   }
@@ -118,7 +174,8 @@ main(int argc, char* argv[]) {
 
   std::cout << "threads: " << galois::getActiveThreads() << " usable threads: "
             << galois::substrate::GetThreadPool().getMaxUsableThreads()
-            << " rounds: " << rounds << " size: " << size << "\n";
+            << " rounds: " << rounds << " size: " << size
+            << " gap (us): " << gap << "\n";
 
   return 0;
 }
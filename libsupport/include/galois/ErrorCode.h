@@ -24,6 +24,7 @@ enum class ErrorCode {
   PropertyNotFound = 9,
   AlreadyExists = 10,
   TypeError = 11,
+  OutOfMemory = 12,
 };
 
 }  // namespace galois
@@ -58,6 +59,8 @@ public:
       return "already exists";
     case ErrorCode::TypeError:
       return "type error";
+    case ErrorCode::OutOfMemory:
+      return "out of memory";
     default:
       return "unknown error";
     }
@@ -81,6 +84,8 @@ public:
       return make_error_condition(std::errc::no_such_file_or_directory);
     case ErrorCode::HttpError:
       return make_error_condition(std::errc::io_error);
+    case ErrorCode::OutOfMemory:
+      return make_error_condition(std::errc::not_enough_memory);
     default:
       return std::error_condition(c, *this);
     }
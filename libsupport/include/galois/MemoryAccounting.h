@@ -0,0 +1,86 @@
+#ifndef GALOIS_LIBSUPPORT_GALOIS_MEMORYACCOUNTING_H_
+#define GALOIS_LIBSUPPORT_GALOIS_MEMORYACCOUNTING_H_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+#include "galois/Result.h"
+#include "galois/config.h"
+
+/// \file MemoryAccounting.h
+///
+/// Process-wide accounting of the memory Galois allocates, by subsystem, with
+/// an optional budget. Allocators that can report failure reserve memory with
+/// MemoryReserve, which fails with ErrorCode::OutOfMemory rather than
+/// exceeding the budget; allocators that cannot fail record their
+/// allocations with MemoryAdd, which counts toward the budget but is never
+/// refused.
+///
+/// The budget is unlimited unless set with SetMemoryBudget or the environment
+/// variable GALOIS_MEMORY_BUDGET (bytes, optionally with a K, M, G or T
+/// suffix).
+
+namespace galois {
+
+enum class MemoryCategory : uint8_t {
+  /// Graph topology
+  kTopology = 0,
+  /// Node and edge property tables
+  kProperties,
+  /// Worklists, bags and per-iteration allocators backed by the page pool
+  kWorklists,
+  /// Temporary arrays of algorithms
+  kScratch,
+  /// File views and I/O buffers
+  kStorage,
+  kNumCategories,
+};
+
+constexpr uint64_t kNoMemoryBudget = std::numeric_limits<uint64_t>::max();
+
+GALOIS_EXPORT const char* MemoryCategoryName(MemoryCategory category);
+
+/// Reserves bytes in category. If the budget would be exceeded, the eviction
+/// callbacks are asked to free memory first. If that does not free enough,
+/// nothing is reserved and ErrorCode::OutOfMemory is returned.
+GALOIS_EXPORT Result<void> MemoryReserve(
+    MemoryCategory category, uint64_t bytes);
+
+/// Records bytes allocated in category without checking the budget.
+GALOIS_EXPORT void MemoryAdd(MemoryCategory category, uint64_t bytes);
+
+/// Releases bytes previously reserved or added in category.
+GALOIS_EXPORT void MemoryRelease(MemoryCategory category, uint64_t bytes);
+
+GALOIS_EXPORT uint64_t MemoryAllocated(MemoryCategory category);
+GALOIS_EXPORT uint64_t MemoryAllocatedTotal();
+GALOIS_EXPORT uint64_t MemoryPeak(MemoryCategory category);
+GALOIS_EXPORT uint64_t MemoryPeakTotal();
+
+/// Resets peaks to the current allocation, e.g., between queries
+GALOIS_EXPORT void ResetMemoryPeaks();
+
+GALOIS_EXPORT void SetMemoryBudget(uint64_t bytes);
+GALOIS_EXPORT uint64_t MemoryBudget();
+
+/// Returns the bytes that can still be allocated within the budget, or
+/// kNoMemoryBudget if there is no budget. Use this to size tiles and chunk
+/// buffers.
+GALOIS_EXPORT uint64_t MemoryRemaining();
+
+/// An eviction callback is asked to free at least the given number of bytes,
+/// e.g., by dropping lazily loaded data that can be loaded again, and returns
+/// the number of bytes it released with MemoryRelease.
+using MemoryEvictionCallback = std::function<uint64_t(uint64_t bytes)>;
+
+/// Returns an id for UnregisterMemoryEvictionCallback. Callbacks are called
+/// in the order they were registered until enough memory is freed. They must
+/// not reserve memory themselves.
+GALOIS_EXPORT uint64_t
+RegisterMemoryEvictionCallback(MemoryEvictionCallback callback);
+GALOIS_EXPORT void UnregisterMemoryEvictionCallback(uint64_t id);
+
+}  // namespace galois
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef GALOIS_LIBSUPPORT_GALOIS_TRACE_H_
+#define GALOIS_LIBSUPPORT_GALOIS_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "galois/Result.h"
+#include "galois/config.h"
+
+/// \file Trace.h
+///
+/// A timeline trace of what each thread is doing: which loop it is running,
+/// when it steals, waits at a barrier, sleeps in the thread pool or waits on
+/// storage. Events are kept in bounded per-thread ring buffers and written
+/// out in the Chrome trace event format, which chrome://tracing and
+/// https://ui.perfetto.dev can display.
+///
+/// Instrumentation is compiled in only when GALOIS_ENABLE_TRACE is defined
+/// (cmake -DGALOIS_ENABLE_TRACE=ON); otherwise TraceScope is empty and costs
+/// nothing. When enabled, the trace is written at exit to the file named by
+/// the environment variable GALOIS_TRACE_FILE (default galois-trace.json).
+/// GALOIS_TRACE_EVENTS sets the number of events kept per thread (default
+/// 65536); older events are overwritten first.
+
+namespace galois {
+
+enum class TraceCategory : uint8_t {
+  kLoop,
+  kSteal,
+  kBarrier,
+  kIdle,
+  kWakeup,
+  kIO,
+};
+
+#ifdef GALOIS_ENABLE_TRACE
+constexpr bool kTraceEnabled = true;
+#else
+constexpr bool kTraceEnabled = false;
+#endif
+
+/// Returns the current time in nanoseconds on the clock used by the trace.
+inline uint64_t
+TraceNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+namespace internal {
+
+/// Records a complete event on the calling thread. name must outlive the
+/// trace, e.g., be a string literal or a loopname.
+GALOIS_EXPORT void TraceRecord(
+    const char* name, TraceCategory category, uint64_t begin_ns,
+    uint64_t end_ns, uint64_t arg);
+
+}  // namespace internal
+
+/// Records an event that spans the lifetime of the scope. arg is shown with
+/// the event, e.g., the number of bytes of an I/O request.
+#ifdef GALOIS_ENABLE_TRACE
+class TraceScope {
+  const char* name_;
+  uint64_t begin_;
+  uint64_t arg_;
+  TraceCategory category_;
+
+public:
+  TraceScope(const char* name, TraceCategory category, uint64_t arg = 0)
+      : name_(name), begin_(TraceNow()), arg_(arg), category_(category) {}
+
+  ~TraceScope() {
+    internal::TraceRecord(name_, category_, begin_, TraceNow(), arg_);
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+};
+#else
+class TraceScope {
+public:
+  TraceScope(const char*, TraceCategory, uint64_t = 0) {}
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+};
+#endif
+
+/// Names the calling thread in the trace.
+GALOIS_EXPORT void SetTraceThreadName(const std::string& name);
+
+/// Writes the events recorded so far to path as Chrome trace JSON. Threads
+/// must not record events concurrently, i.e., call this outside of parallel
+/// sections.
+GALOIS_EXPORT Result<void> WriteTrace(const std::string& path);
+
+/// Discards the events recorded so far.
+GALOIS_EXPORT void ClearTrace();
+
+}  // namespace galois
+
+#endif
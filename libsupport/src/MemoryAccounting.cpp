@@ -0,0 +1,261 @@
+#include "galois/MemoryAccounting.h"
+
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "galois/Env.h"
+#include "galois/ErrorCode.h"
+#include "galois/Logging.h"
+
+namespace {
+
+constexpr size_t kNumCategories =
+    static_cast<size_t>(galois::MemoryCategory::kNumCategories);
+
+void
+UpdatePeak(std::atomic<uint64_t>* peak, uint64_t value) {
+  uint64_t prev = peak->load(std::memory_order_relaxed);
+  while (value > prev && !peak->compare_exchange_weak(prev, value)) {
+  }
+}
+
+uint64_t
+ParseBytes(const std::string& str) {
+  size_t pos = 0;
+  uint64_t value = std::stoull(str, &pos);
+  if (pos < str.size()) {
+    switch (std::toupper(str[pos])) {
+    case 'T':
+      value <<= 10;
+      [[fallthrough]];
+    case 'G':
+      value <<= 10;
+      [[fallthrough]];
+    case 'M':
+      value <<= 10;
+      [[fallthrough]];
+    case 'K':
+      value <<= 10;
+      break;
+    default:
+      GALOIS_LOG_WARN("ignoring unknown suffix in memory budget: {}", str);
+    }
+  }
+  return value;
+}
+
+class MemoryAccountant {
+  std::array<std::atomic<uint64_t>, kNumCategories> allocated_{};
+  std::array<std::atomic<uint64_t>, kNumCategories> peak_{};
+  std::atomic<uint64_t> total_{0};
+  std::atomic<uint64_t> total_peak_{0};
+  std::atomic<uint64_t> budget_{galois::kNoMemoryBudget};
+
+  // Serializes eviction so that concurrent reservations do not all evict
+  std::mutex evict_mutex_;
+  std::map<uint64_t, galois::MemoryEvictionCallback> callbacks_;
+  uint64_t next_callback_id_{0};
+
+  bool TryAdd(uint64_t bytes) {
+    uint64_t budget = budget_.load(std::memory_order_relaxed);
+    uint64_t total = total_.load(std::memory_order_relaxed);
+    do {
+      if (budget != galois::kNoMemoryBudget &&
+          (total > budget || bytes > budget - total)) {
+        return false;
+      }
+    } while (!total_.compare_exchange_weak(total, total + bytes));
+    UpdatePeak(&total_peak_, total + bytes);
+    return true;
+  }
+
+  void AddToCategory(galois::MemoryCategory category, uint64_t bytes) {
+    auto c = static_cast<size_t>(category);
+    UpdatePeak(&peak_[c], allocated_[c] += bytes);
+  }
+
+  uint64_t Evict(uint64_t bytes) {
+    uint64_t freed = 0;
+    for (auto& [id, cb] : callbacks_) {
+      if (freed >= bytes) {
+        break;
+      }
+      freed += cb(bytes - freed);
+    }
+    return freed;
+  }
+
+public:
+  MemoryAccountant() {
+    std::string budget;
+    if (galois::GetEnv("GALOIS_MEMORY_BUDGET", &budget)) {
+      try {
+        budget_ = ParseBytes(budget);
+      } catch (const std::exception& e) {
+        GALOIS_LOG_ERROR(
+            "invalid GALOIS_MEMORY_BUDGET {}: {}", budget, e.what());
+      }
+    }
+  }
+
+  galois::Result<void> Reserve(
+      galois::MemoryCategory category, uint64_t bytes) {
+    if (!TryAdd(bytes)) {
+      std::lock_guard<std::mutex> lock(evict_mutex_);
+      // Another thread may have evicted enough already
+      if (!TryAdd(bytes)) {
+        uint64_t budget = budget_.load(std::memory_order_relaxed);
+        uint64_t total = total_.load(std::memory_order_relaxed);
+        uint64_t available = total < budget ? budget - total : 0;
+        Evict(bytes > available ? bytes - available : 0);
+        if (!TryAdd(bytes)) {
+          return galois::ErrorCode::OutOfMemory;
+        }
+      }
+    }
+    AddToCategory(category, bytes);
+    return galois::ResultSuccess();
+  }
+
+  void Add(galois::MemoryCategory category, uint64_t bytes) {
+    UpdatePeak(&total_peak_, total_ += bytes);
+    AddToCategory(category, bytes);
+  }
+
+  void Release(galois::MemoryCategory category, uint64_t bytes) {
+    allocated_[static_cast<size_t>(category)] -= bytes;
+    total_ -= bytes;
+  }
+
+  uint64_t Allocated(galois::MemoryCategory category) const {
+    return allocated_[static_cast<size_t>(category)];
+  }
+  uint64_t Peak(galois::MemoryCategory category) const {
+    return peak_[static_cast<size_t>(category)];
+  }
+  uint64_t Total() const { return total_; }
+  uint64_t TotalPeak() const { return total_peak_; }
+
+  void ResetPeaks() {
+    for (size_t c = 0; c < kNumCategories; ++c) {
+      peak_[c] = allocated_[c].load();
+    }
+    total_peak_ = total_.load();
+  }
+
+  uint64_t budget() const { return budget_; }
+  void set_budget(uint64_t bytes) { budget_ = bytes; }
+
+  uint64_t RegisterCallback(galois::MemoryEvictionCallback cb) {
+    std::lock_guard<std::mutex> lock(evict_mutex_);
+    uint64_t id = next_callback_id_++;
+    callbacks_.emplace(id, std::move(cb));
+    return id;
+  }
+
+  void UnregisterCallback(uint64_t id) {
+    std::lock_guard<std::mutex> lock(evict_mutex_);
+    callbacks_.erase(id);
+  }
+};
+
+// Never destroyed so that memory can be released during static destruction
+MemoryAccountant&
+GetAccountant() {
+  static MemoryAccountant* accountant = new MemoryAccountant();
+  return *accountant;
+}
+
+}  // namespace
+
+const char*
+galois::MemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+  case MemoryCategory::kTopology:
+    return "Topology";
+  case MemoryCategory::kProperties:
+    return "Properties";
+  case MemoryCategory::kWorklists:
+    return "Worklists";
+  case MemoryCategory::kScratch:
+    return "Scratch";
+  case MemoryCategory::kStorage:
+    return "Storage";
+  default:
+    return "Unknown";
+  }
+}
+
+galois::Result<void>
+galois::MemoryReserve(MemoryCategory category, uint64_t bytes) {
+  return GetAccountant().Reserve(category, bytes);
+}
+
+void
+galois::MemoryAdd(MemoryCategory category, uint64_t bytes) {
+  GetAccountant().Add(category, bytes);
+}
+
+void
+galois::MemoryRelease(MemoryCategory category, uint64_t bytes) {
+  GetAccountant().Release(category, bytes);
+}
+
+uint64_t
+galois::MemoryAllocated(MemoryCategory category) {
+  return GetAccountant().Allocated(category);
+}
+
+uint64_t
+galois::MemoryAllocatedTotal() {
+  return GetAccountant().Total();
+}
+
+uint64_t
+galois::MemoryPeak(MemoryCategory category) {
+  return GetAccountant().Peak(category);
+}
+
+uint64_t
+galois::MemoryPeakTotal() {
+  return GetAccountant().TotalPeak();
+}
+
+void
+galois::ResetMemoryPeaks() {
+  GetAccountant().ResetPeaks();
+}
+
+void
+galois::SetMemoryBudget(uint64_t bytes) {
+  GetAccountant().set_budget(bytes);
+}
+
+uint64_t
+galois::MemoryBudget() {
+  return GetAccountant().budget();
+}
+
+uint64_t
+galois::MemoryRemaining() {
+  uint64_t budget = MemoryBudget();
+  if (budget == kNoMemoryBudget) {
+    return kNoMemoryBudget;
+  }
+  uint64_t total = MemoryAllocatedTotal();
+  return total < budget ? budget - total : 0;
+}
+
+uint64_t
+galois::RegisterMemoryEvictionCallback(MemoryEvictionCallback callback) {
+  return GetAccountant().RegisterCallback(std::move(callback));
+}
+
+void
+galois::UnregisterMemoryEvictionCallback(uint64_t id) {
+  GetAccountant().UnregisterCallback(id);
+}
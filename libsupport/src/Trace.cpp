@@ -0,0 +1,268 @@
+#include "galois/Trace.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "galois/Env.h"
+#include "galois/Logging.h"
+
+namespace {
+
+constexpr size_t kDefaultEventsPerThread = 1 << 16;
+
+struct TraceEvent {
+  const char* name;
+  uint64_t begin;
+  uint64_t end;
+  uint64_t arg;
+  galois::TraceCategory category;
+};
+
+/// The events of one thread. The buffer grows on demand up to capacity and
+/// then wraps around, so short-lived threads (e.g., std::async workers doing
+/// I/O) do not pay for a full buffer.
+struct ThreadBuffer {
+  uint32_t tid;
+  std::string name;
+  std::vector<TraceEvent> events;
+  uint64_t num_recorded{0};
+
+  void Push(const TraceEvent& event, size_t capacity) {
+    if (events.size() < capacity) {
+      events.push_back(event);
+    } else {
+      events[num_recorded % capacity] = event;
+    }
+    ++num_recorded;
+  }
+
+  template <typename F>
+  void ForEach(const F& fn) const {
+    size_t first = events.size() < num_recorded ? num_recorded % events.size()
+                                                : 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+      fn(events[(first + i) % events.size()]);
+    }
+  }
+};
+
+const char*
+CategoryName(galois::TraceCategory category) {
+  switch (category) {
+  case galois::TraceCategory::kLoop:
+    return "loop";
+  case galois::TraceCategory::kSteal:
+    return "steal";
+  case galois::TraceCategory::kBarrier:
+    return "barrier";
+  case galois::TraceCategory::kIdle:
+    return "idle";
+  case galois::TraceCategory::kWakeup:
+    return "wakeup";
+  case galois::TraceCategory::kIO:
+    return "io";
+  default:
+    return "unknown";
+  }
+}
+
+std::string
+EscapeJson(const char* s) {
+  std::string ret;
+  for (; *s; ++s) {
+    char c = *s;
+    if (c == '"' || c == '\\') {
+      ret.push_back('\\');
+      ret.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      ret += fmt::format("\\u{:04x}", static_cast<int>(c));
+    } else {
+      ret.push_back(c);
+    }
+  }
+  return ret;
+}
+
+/// Owns the buffers of all threads. When a thread exits, its buffer keeps
+/// its events and is handed to the next thread that registers, so the number
+/// of buffers is bounded by the number of threads alive at once rather than
+/// growing with every short-lived thread.
+class TraceRegistry {
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::vector<ThreadBuffer*> free_;
+  size_t capacity_{kDefaultEventsPerThread};
+
+public:
+  TraceRegistry() {
+    int capacity{};
+    if (galois::GetEnv("GALOIS_TRACE_EVENTS", &capacity) && capacity > 0) {
+      capacity_ = capacity;
+    }
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  ThreadBuffer* Register() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_.empty()) {
+      ThreadBuffer* buffer = free_.back();
+      free_.pop_back();
+      buffer->name.clear();
+      return buffer;
+    }
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->tid = buffers_.size();
+    buffers_.emplace_back(std::move(buffer));
+    return buffers_.back().get();
+  }
+
+  void Release(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.emplace_back(buffer);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& buffer : buffers_) {
+      buffer->events.clear();
+      buffer->num_recorded = 0;
+    }
+  }
+
+  galois::Result<void> Write(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+      return galois::ResultErrno();
+    }
+
+    // Report times relative to the first event
+    uint64_t start = UINT64_MAX;
+    for (const auto& buffer : buffers_) {
+      buffer->ForEach([&](const TraceEvent& event) {
+        start = std::min(start, event.begin);
+      });
+    }
+
+    int pid = getpid();
+    bool first = true;
+    auto emit = [&](const std::string& event) {
+      fmt::print(out, "{}\n{}", first ? "" : ",", event);
+      first = false;
+    };
+
+    fmt::print(out, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (const auto& buffer : buffers_) {
+      if (!buffer->name.empty()) {
+        emit(fmt::format(
+            "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+            "\"args\":{{\"name\":\"{}\"}}}}",
+            pid, buffer->tid, EscapeJson(buffer->name.c_str())));
+      }
+      buffer->ForEach([&](const TraceEvent& event) {
+        // Chrome trace timestamps are in microseconds
+        emit(fmt::format(
+            "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},"
+            "\"dur\":{:.3f},\"pid\":{},\"tid\":{},\"args\":{{\"value\":{}}}}}",
+            EscapeJson(event.name ? event.name : "(NULL)"),
+            CategoryName(event.category),
+            static_cast<double>(event.begin - start) / 1e3,
+            static_cast<double>(event.end - event.begin) / 1e3, pid,
+            buffer->tid, event.arg));
+      });
+    }
+    fmt::print(out, "\n]}}\n");
+
+    if (std::fclose(out) != 0) {
+      return galois::ResultErrno();
+    }
+    return galois::ResultSuccess();
+  }
+};
+
+void WriteTraceAtExit();
+
+// The registry is never destroyed so that threads may record events during
+// static destruction; the trace is written by an atexit handler instead.
+TraceRegistry&
+GetRegistry() {
+  static TraceRegistry* registry = [] {
+    auto* r = new TraceRegistry();
+    if (galois::kTraceEnabled) {
+      std::atexit(WriteTraceAtExit);
+    }
+    return r;
+  }();
+  return *registry;
+}
+
+void
+WriteTraceAtExit() {
+  std::string path = "galois-trace.json";
+  galois::GetEnv("GALOIS_TRACE_FILE", &path);
+  if (auto res = GetRegistry().Write(path); !res) {
+    GALOIS_LOG_ERROR("writing trace to {}: {}", path, res.error());
+  }
+}
+
+thread_local ThreadBuffer* local_buffer = nullptr;
+thread_local bool local_buffer_released = false;
+
+/// Returns the buffer of a thread to the registry when the thread exits
+struct BufferOwner {
+  ~BufferOwner() {
+    if (local_buffer) {
+      GetRegistry().Release(local_buffer);
+      local_buffer = nullptr;
+    }
+    local_buffer_released = true;
+  }
+};
+
+ThreadBuffer*
+GetLocalBuffer() {
+  if (!local_buffer) {
+    local_buffer = GetRegistry().Register();
+    // Events recorded by thread-local destructors that run after the owner
+    // go to a buffer of their own, which is not recycled.
+    if (!local_buffer_released) {
+      thread_local BufferOwner owner;
+    }
+  }
+  return local_buffer;
+}
+
+}  // namespace
+
+void
+galois::internal::TraceRecord(
+    const char* name, TraceCategory category, uint64_t begin_ns,
+    uint64_t end_ns, uint64_t arg) {
+  GetLocalBuffer()->Push(
+      TraceEvent{name, begin_ns, end_ns, arg, category},
+      GetRegistry().capacity());
+}
+
+void
+galois::SetTraceThreadName(const std::string& name) {
+  GetLocalBuffer()->name = name;
+}
+
+galois::Result<void>
+galois::WriteTrace(const std::string& path) {
+  return GetRegistry().Write(path);
+}
+
+void
+galois::ClearTrace() {
+  GetRegistry().Clear();
+}
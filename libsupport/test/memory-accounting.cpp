@@ -0,0 +1,113 @@
+#include "galois/MemoryAccounting.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "galois/Env.h"
+#include "galois/ErrorCode.h"
+#include "galois/Logging.h"
+
+namespace {
+
+using galois::MemoryCategory;
+
+constexpr uint64_t kMB = 1 << 20;
+
+void
+TestCounters() {
+  galois::MemoryAdd(MemoryCategory::kTopology, 3 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryReserve(MemoryCategory::kScratch, 2 * kMB));
+  GALOIS_LOG_ASSERT(
+      galois::MemoryAllocated(MemoryCategory::kTopology) == 3 * kMB);
+  GALOIS_LOG_ASSERT(
+      galois::MemoryAllocated(MemoryCategory::kScratch) == 2 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocatedTotal() == 5 * kMB);
+
+  galois::MemoryRelease(MemoryCategory::kScratch, 2 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocated(MemoryCategory::kScratch) == 0);
+  GALOIS_LOG_ASSERT(galois::MemoryPeak(MemoryCategory::kScratch) == 2 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryPeakTotal() == 5 * kMB);
+
+  galois::ResetMemoryPeaks();
+  GALOIS_LOG_ASSERT(galois::MemoryPeak(MemoryCategory::kScratch) == 0);
+  GALOIS_LOG_ASSERT(galois::MemoryPeakTotal() == 3 * kMB);
+
+  galois::MemoryRelease(MemoryCategory::kTopology, 3 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocatedTotal() == 0);
+}
+
+void
+TestBudget() {
+  GALOIS_LOG_ASSERT(galois::MemoryRemaining() == 8 * kMB);
+
+  GALOIS_LOG_ASSERT(
+      galois::MemoryReserve(MemoryCategory::kProperties, 6 * kMB));
+  GALOIS_LOG_ASSERT(galois::MemoryRemaining() == 2 * kMB);
+
+  auto res = galois::MemoryReserve(MemoryCategory::kProperties, 4 * kMB);
+  GALOIS_LOG_ASSERT(!res);
+  GALOIS_LOG_ASSERT(res.error() == galois::ErrorCode::OutOfMemory);
+  GALOIS_LOG_ASSERT(
+      galois::MemoryAllocated(MemoryCategory::kProperties) == 6 * kMB);
+
+  // Allocations that cannot fail are still counted
+  galois::MemoryAdd(MemoryCategory::kWorklists, 4 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryRemaining() == 0);
+  galois::MemoryRelease(MemoryCategory::kWorklists, 4 * kMB);
+
+  // Eviction makes room for a reservation that would not fit
+  uint64_t evictable = 6 * kMB;
+  int num_calls = 0;
+  uint64_t id = galois::RegisterMemoryEvictionCallback([&](uint64_t bytes) {
+    ++num_calls;
+    uint64_t freed = std::min(bytes, evictable);
+    evictable -= freed;
+    galois::MemoryRelease(MemoryCategory::kProperties, freed);
+    return freed;
+  });
+  GALOIS_LOG_ASSERT(galois::MemoryReserve(MemoryCategory::kScratch, 4 * kMB));
+  GALOIS_LOG_ASSERT(num_calls == 1);
+  GALOIS_LOG_ASSERT(
+      galois::MemoryAllocated(MemoryCategory::kProperties) == 4 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocatedTotal() == 8 * kMB);
+
+  // Not even evicting everything makes room for more than the budget
+  GALOIS_LOG_ASSERT(!galois::MemoryReserve(MemoryCategory::kScratch, 9 * kMB));
+  GALOIS_LOG_ASSERT(num_calls == 2);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocated(MemoryCategory::kProperties) == 0);
+
+  // Sizes near the top of the range do not wrap around
+  GALOIS_LOG_ASSERT(!galois::MemoryReserve(
+      MemoryCategory::kScratch, std::numeric_limits<uint64_t>::max() - kMB));
+  GALOIS_LOG_ASSERT(num_calls == 3);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocatedTotal() == 4 * kMB);
+
+  galois::UnregisterMemoryEvictionCallback(id);
+  GALOIS_LOG_ASSERT(!galois::MemoryReserve(MemoryCategory::kScratch, 5 * kMB));
+  GALOIS_LOG_ASSERT(num_calls == 3);
+
+  galois::MemoryRelease(MemoryCategory::kScratch, 4 * kMB);
+  GALOIS_LOG_ASSERT(galois::MemoryAllocatedTotal() == 0);
+
+  galois::SetMemoryBudget(galois::kNoMemoryBudget);
+  GALOIS_LOG_ASSERT(galois::MemoryRemaining() == galois::kNoMemoryBudget);
+  GALOIS_LOG_ASSERT(galois::MemoryReserve(MemoryCategory::kScratch, 9 * kMB));
+  galois::MemoryRelease(MemoryCategory::kScratch, 9 * kMB);
+}
+
+}  // namespace
+
+int
+main() {
+  // Read on first use
+  GALOIS_LOG_ASSERT(galois::SetEnv("GALOIS_MEMORY_BUDGET", "8M", true));
+  GALOIS_LOG_ASSERT(galois::MemoryBudget() == 8 * kMB);
+
+  galois::SetMemoryBudget(galois::kNoMemoryBudget);
+  TestCounters();
+
+  galois::SetMemoryBudget(8 * kMB);
+  TestBudget();
+
+  return 0;
+}
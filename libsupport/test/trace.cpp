@@ -0,0 +1,176 @@
+#include "galois/Trace.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "galois/Env.h"
+#include "galois/Logging.h"
+
+namespace {
+
+constexpr int kCapacity = 100;
+
+nlohmann::json
+WriteAndParse() {
+  char path[] = "/tmp/galois-trace-XXXXXX";
+  int fd = mkstemp(path);
+  GALOIS_LOG_ASSERT(fd >= 0);
+  close(fd);
+
+  auto res = galois::WriteTrace(path);
+  GALOIS_LOG_ASSERT(res);
+
+  std::ifstream in(path);
+  nlohmann::json trace = nlohmann::json::parse(in);
+  unlink(path);
+  return trace;
+}
+
+std::vector<nlohmann::json>
+CompleteEvents(const nlohmann::json& trace) {
+  std::vector<nlohmann::json> events;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "X") {
+      events.emplace_back(event);
+    }
+  }
+  return events;
+}
+
+void
+TestThreads() {
+  constexpr int kThreads = 4;
+  constexpr int kEventsPerThread = 10;
+
+  // Keep all threads alive at once so that each gets a buffer of its own
+  std::atomic<int> started{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t, &started]() {
+      galois::SetTraceThreadName(fmt::format("worker-{}", t));
+      ++started;
+      while (started < kThreads) {
+        std::this_thread::yield();
+      }
+      for (int i = 0; i < kEventsPerThread; ++i) {
+        uint64_t begin = galois::TraceNow();
+        galois::internal::TraceRecord(
+            "work", galois::TraceCategory::kLoop, begin, begin + 1000, i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  nlohmann::json trace = WriteAndParse();
+  auto events = CompleteEvents(trace);
+  GALOIS_LOG_ASSERT(events.size() == kThreads * kEventsPerThread);
+  for (const auto& event : events) {
+    GALOIS_LOG_ASSERT(event["name"] == "work");
+    GALOIS_LOG_ASSERT(event["cat"] == "loop");
+    GALOIS_LOG_ASSERT(event["dur"].get<double>() == 1.0);
+    GALOIS_LOG_ASSERT(event["ts"].get<double>() >= 0.0);
+  }
+
+  int num_names = 0;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "M") {
+      ++num_names;
+    }
+  }
+  GALOIS_LOG_ASSERT(num_names == kThreads);
+}
+
+void
+TestWrapAround() {
+  galois::ClearTrace();
+
+  std::thread t([]() {
+    for (int i = 0; i < kCapacity + kCapacity / 2; ++i) {
+      uint64_t begin = galois::TraceNow();
+      galois::internal::TraceRecord(
+          "wrap \"quoted\"", galois::TraceCategory::kIO, begin, begin, i);
+    }
+  });
+  t.join();
+
+  auto events = CompleteEvents(WriteAndParse());
+  GALOIS_LOG_ASSERT(events.size() == kCapacity);
+  // Only the newest events are kept, oldest first
+  for (int i = 0; i < kCapacity; ++i) {
+    GALOIS_LOG_ASSERT(events[i]["name"] == "wrap \"quoted\"");
+    GALOIS_LOG_ASSERT(events[i]["args"]["value"] == i + kCapacity / 2);
+  }
+}
+
+void
+TestRecycle() {
+  galois::ClearTrace();
+
+  constexpr int kThreads = kCapacity / 2;
+
+  // Threads that run one after another, like std::async workers, reuse the
+  // buffer of the thread before them and keep its events.
+  for (int i = 0; i < kThreads; ++i) {
+    std::thread t([i]() {
+      uint64_t begin = galois::TraceNow();
+      galois::internal::TraceRecord(
+          "short", galois::TraceCategory::kIO, begin, begin, i);
+    });
+    t.join();
+  }
+
+  auto events = CompleteEvents(WriteAndParse());
+  GALOIS_LOG_ASSERT(events.size() == kThreads);
+  std::set<int> tids;
+  for (int i = 0; i < kThreads; ++i) {
+    GALOIS_LOG_ASSERT(events[i]["args"]["value"] == i);
+    tids.emplace(events[i]["tid"].get<int>());
+  }
+  GALOIS_LOG_ASSERT(tids.size() == 1);
+}
+
+void
+TestScope() {
+  galois::ClearTrace();
+
+  { galois::TraceScope scope("scope", galois::TraceCategory::kBarrier, 7); }
+
+  auto events = CompleteEvents(WriteAndParse());
+  if (galois::kTraceEnabled) {
+    GALOIS_LOG_ASSERT(events.size() == 1);
+    GALOIS_LOG_ASSERT(events[0]["cat"] == "barrier");
+    GALOIS_LOG_ASSERT(events[0]["args"]["value"] == 7);
+  } else {
+    GALOIS_LOG_ASSERT(events.empty());
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  // Must be set before the first event is recorded
+  GALOIS_LOG_ASSERT(galois::SetEnv(
+      "GALOIS_TRACE_EVENTS", std::to_string(kCapacity), true));
+  // Do not leave a trace file behind when tracing is compiled in
+  GALOIS_LOG_ASSERT(
+      galois::SetEnv("GALOIS_TRACE_FILE", "/dev/null", true));
+
+  TestThreads();
+  TestWrapAround();
+  TestRecycle();
+  TestScope();
+
+  return 0;
+}
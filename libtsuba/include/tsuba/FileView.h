@@ -8,6 +8,7 @@
 #include <parquet/arrow/reader.h>
 
 #include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/Result.h"
 #include "galois/config.h"
 
@@ -29,6 +30,9 @@ class GALOIS_EXPORT FileView : public arrow::io::RandomAccessFile {
   bool valid_ = false;
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
+  // Bytes of the file in memory, for galois::MemoryRelease
+  uint64_t filled_bytes_{0};
+  galois::MemoryCategory memory_category_{galois::MemoryCategory::kStorage};
 
 public:
   FileView() = default;
@@ -44,8 +48,11 @@ public:
         filename_(std::move(other.filename_)),
         valid_(other.valid_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        filled_bytes_(other.filled_bytes_),
+        memory_category_(other.memory_category_) {
     other.valid_ = false;
+    other.filled_bytes_ = 0;
   }
 
   FileView& operator=(FileView&& other) noexcept {
@@ -63,7 +70,10 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      filled_bytes_ = other.filled_bytes_;
+      memory_category_ = other.memory_category_;
       other.valid_ = false;
+      other.filled_bytes_ = 0;
     }
     return *this;
   }
@@ -94,6 +104,12 @@ public:
 
   bool Valid() const { return valid_; }
 
+  /// Sets the category that the memory of the view is accounted to (see
+  /// galois/MemoryAccounting.h). The default is MemoryCategory::kStorage.
+  void set_memory_category(galois::MemoryCategory category) {
+    memory_category_ = category;
+  }
+
   galois::Result<void> Unbind();
 
   /// Be very careful with this function. It is the caller's responsibility to
@@ -146,6 +162,9 @@ private:
   // Given the size of some region, how many pages does it take up?
   uint64_t page_number(uint64_t size);
 
+  // Bytes of the pages in [first_page, last_page] that are not filled yet
+  uint64_t UnfilledBytes(uint64_t first_page, uint64_t last_page);
+
   // helper functions for MustFill
   /// These functions do not validate their input. In particular, if
   /// bitmap[block_num] contains no zeroes, they may never terminate
@@ -7,6 +7,10 @@
 #include "galois/Result.h"
 #include "galois/config.h"
 
+namespace arrow {
+class MemoryPool;
+}  // namespace arrow
+
 namespace tsuba {
 
 class RDGHandleImpl;
@@ -84,6 +88,14 @@ GALOIS_EXPORT galois::Result<void> Init();
 
 GALOIS_EXPORT galois::Result<void> Fini();
 
+/// SetMemoryPool sets the pool that tables loaded from storage are allocated
+/// from. By default, or if pool is null, arrow::default_memory_pool() is used.
+/// The pool must outlive every table loaded with it.
+GALOIS_EXPORT void SetMemoryPool(arrow::MemoryPool* pool);
+
+/// Returns the pool that tables loaded from storage are allocated from
+GALOIS_EXPORT arrow::MemoryPool* GetMemoryPool();
+
 }  // namespace tsuba
 
 #endif
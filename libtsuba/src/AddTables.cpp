@@ -2,6 +2,7 @@
 
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
+#include "tsuba/tsuba.h"
 
 template <typename T>
 using Result = galois::Result<T>;
@@ -18,7 +19,7 @@ DoLoadTable(const std::string& expected_name, const galois::Uri& file_path) {
   std::unique_ptr<parquet::arrow::FileReader> reader;
 
   auto open_file_result =
-      parquet::arrow::OpenFile(fv, arrow::default_memory_pool(), &reader);
+      parquet::arrow::OpenFile(fv, tsuba::GetMemoryPool(), &reader);
   if (!open_file_result.ok()) {
     GALOIS_LOG_DEBUG("arrow error: {}", open_file_result);
     return tsuba::ErrorCode::ArrowError;
@@ -36,7 +37,7 @@ DoLoadTable(const std::string& expected_name, const galois::Uri& file_path) {
   // combined into a single chunk due to the fact the offset type for these
   // columns is int32_t and thus the maximum size of an arrow::Array for these
   // types is 2^31.
-  auto combine_result = out->CombineChunks(arrow::default_memory_pool());
+  auto combine_result = out->CombineChunks(tsuba::GetMemoryPool());
   if (!combine_result.ok()) {
     GALOIS_LOG_DEBUG("arrow error: {}", combine_result.status());
     return tsuba::ErrorCode::ArrowError;
@@ -75,7 +76,7 @@ DoLoadTableSlice(
   std::unique_ptr<parquet::arrow::FileReader> reader;
 
   auto open_file_result =
-      parquet::arrow::OpenFile(fv, arrow::default_memory_pool(), &reader);
+      parquet::arrow::OpenFile(fv, tsuba::GetMemoryPool(), &reader);
   if (!open_file_result.ok()) {
     GALOIS_LOG_DEBUG("arrow error: {}", open_file_result);
     return tsuba::ErrorCode::ArrowError;
@@ -113,7 +114,7 @@ DoLoadTableSlice(
     return tsuba::ErrorCode::ArrowError;
   }
 
-  auto combine_result = out->CombineChunks(arrow::default_memory_pool());
+  auto combine_result = out->CombineChunks(tsuba::GetMemoryPool());
   if (!combine_result.ok()) {
     GALOIS_LOG_DEBUG("arrow error: {}", combine_result.status());
     return tsuba::ErrorCode::ArrowError;
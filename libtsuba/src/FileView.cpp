@@ -9,6 +9,7 @@
 
 #include "galois/Logging.h"
 #include "galois/Result.h"
+#include "galois/Trace.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
 
@@ -54,6 +55,10 @@ FileView::Unbind() {
     }
     valid_ = false;
   }
+  if (filled_bytes_ != 0) {
+    galois::MemoryRelease(memory_category_, filled_bytes_);
+    filled_bytes_ = 0;
+  }
   return res;
 }
 
@@ -105,6 +110,8 @@ FileView::Bind(
 
 galois::Result<void>
 FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
+  galois::TraceScope trace(
+      "FileView::Fill", galois::TraceCategory::kIO, end - begin);
   uint64_t in_end = std::min<uint64_t>(end, file_size_);
   uint64_t in_begin = std::min<uint64_t>(begin, in_end);
   uint64_t first_page = 0;
@@ -131,13 +138,21 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         (last_page + 1) * (1UL << page_shift_) - file_off,
         file_size_ - file_off);
     if (found_empty) {
+      uint64_t new_bytes = UnfilledBytes(first_page, last_page);
+      if (auto res = galois::MemoryReserve(memory_category_, new_bytes);
+          !res) {
+        return res.error();
+      }
+
       // Get physical pages for the region we are about to write
       int err =
           mprotect(map_start_ + file_off, map_size, PROT_READ | PROT_WRITE);
       if (err == -1) {
         GALOIS_LOG_ERROR("mprotect: {}", std::strerror(errno));
+        galois::MemoryRelease(memory_category_, new_bytes);
         return galois::ResultErrno();
       }
+      filled_bytes_ += new_bytes;
 
       auto peek_fut =
           FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
@@ -298,6 +313,20 @@ FileView::page_number(uint64_t size) {
   return size >> page_shift_;
 }
 
+uint64_t
+FileView::UnfilledBytes(uint64_t first_page, uint64_t last_page) {
+  uint64_t bytes = 0;
+  for (uint64_t p = first_page; p <= last_page; ++p) {
+    if (filling_[p / 64] & (UINT64_C(1) << (63 - p % 64))) {
+      continue;
+    }
+    uint64_t begin = p << page_shift_;
+    uint64_t end = std::min<uint64_t>((p + 1) << page_shift_, file_size_);
+    bytes += end - begin;
+  }
+  return bytes;
+}
+
 inline uint64_t
 FileView::FirstPage(
     uint64_t* bitmap, uint64_t block_num, uint64_t start, uint64_t end) {
@@ -453,6 +482,8 @@ FileView::MarkFilled(uint64_t* bitmap, uint64_t begin, uint64_t end) {
 
 galois::Result<void>
 FileView::Resolve(int64_t start, int64_t size) {
+  galois::TraceScope trace(
+      "FileView::Resolve", galois::TraceCategory::kIO, size);
   // This loop could do less work by sorting the vector or storing an
   // interval tree, but that seems like overkill unless this becomes a
   // bottleneck
@@ -387,6 +387,8 @@ tsuba::RDG::DoMake(const galois::Uri& metadata_dir) {
   }
 
   galois::Uri t_path = metadata_dir.Join(core_->part_header().topology_path());
+  core_->topology_file_storage().set_memory_category(
+      galois::MemoryCategory::kTopology);
   if (auto res = core_->topology_file_storage().Bind(t_path.string(), true);
       !res) {
     return res.error();
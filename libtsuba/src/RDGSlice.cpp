@@ -12,6 +12,8 @@ galois::Result<void>
 RDGSlice::DoMake(const galois::Uri& metadata_dir, const SliceArg& slice) {
   galois::Uri t_path = metadata_dir.Join(core_->part_header().topology_path());
 
+  core_->topology_file_storage().set_memory_category(
+      galois::MemoryCategory::kTopology);
   if (auto res = core_->topology_file_storage().Bind(
           t_path.string(), slice.topo_off, slice.topo_off + slice.topo_size,
           true);
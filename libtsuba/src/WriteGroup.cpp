@@ -2,6 +2,7 @@
 
 #include "GlobalState.h"
 #include "galois/Random.h"
+#include "galois/Trace.h"
 
 template <typename T>
 using Result = galois::Result<T>;
@@ -27,6 +28,8 @@ WriteGroup::Make() {
 
 Result<void>
 WriteGroup::Finish() {
+  galois::TraceScope trace(
+      "WriteGroup::Finish", galois::TraceCategory::kIO, pending_ops_.size());
   Result<void> return_val = galois::ResultSuccess();
   uint32_t errors = 0;
 
@@ -65,6 +68,9 @@ WriteGroup::StartStore(std::shared_ptr<FileFrame> ff) {
 
   // wrap future to hold onto FileFrame, but free it as soon as possible
   auto future = std::async(std::launch::async, [ff = std::move(ff)]() mutable {
+    galois::TraceScope trace(
+        "WriteGroup::Store", galois::TraceCategory::kIO,
+        ff->Tell().ValueOr(0));
     return ff->PersistAsync().get();
   });
   AddOp(std::move(future), file);
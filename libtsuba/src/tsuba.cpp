@@ -1,5 +1,9 @@
 #include "tsuba/tsuba.h"
 
+#include <atomic>
+
+#include <arrow/memory_pool.h>
+
 #include "GlobalState.h"
 #include "RDGHandleImpl.h"
 #include "galois/Backtrace.h"
@@ -14,6 +18,7 @@ namespace {
 
 galois::NullCommBackend default_comm_backend;
 std::unique_ptr<tsuba::NameServerClient> default_ns_client;
+std::atomic<arrow::MemoryPool*> memory_pool{nullptr};
 
 galois::Result<std::vector<std::string>>
 FileList(const std::string& dir) {
@@ -255,3 +260,14 @@ tsuba::Fini() {
   tsuba::PreloadFini();
   return r;
 }
+
+void
+tsuba::SetMemoryPool(arrow::MemoryPool* pool) {
+  memory_pool = pool;
+}
+
+arrow::MemoryPool*
+tsuba::GetMemoryPool() {
+  arrow::MemoryPool* pool = memory_pool;
+  return pool ? pool : arrow::default_memory_pool();
+}
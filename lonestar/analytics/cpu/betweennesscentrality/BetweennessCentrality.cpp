@@ -26,7 +26,7 @@
 
 constexpr static const char* const REGION_NAME = "BC";
 
-enum Algo { Level = 0, Async, Outer, AutoAlgo };
+enum Algo { Level = 0, Async, Outer, MultiSource, AutoAlgo };
 
 //TODO (gill): Reintroduce AutoAlgo when porting to propertyGraph
 // const char* const ALGO_NAMES[] = {"Level", "Async", "Outer", "Auto"};
@@ -70,11 +70,17 @@ static cll::opt<uint64_t> startSource(
               "singleSource flag only"),
     cll::init(0));
 
+static cll::opt<unsigned int> batchSize(
+    "batchSize",
+    cll::desc("MultiSource: Number of sources searched at once; rounded up "
+              "to 64, 128, 256 or 512 (default 64)"),
+    cll::init(64));
+
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm (default value AutoAlgo):"),
     cll::values(
         clEnumVal(Level, "Level"), clEnumVal(Async, "Async"),
-        clEnumVal(Outer, "Outer"),
+        clEnumVal(Outer, "Outer"), clEnumVal(MultiSource, "MultiSource"),
         clEnumVal(AutoAlgo, "Auto: choose among the algorithms automatically")),
     cll::init(AutoAlgo));
 
@@ -94,6 +100,7 @@ static const char* desc =
 
 #include "AsyncStructs.h"
 #include "LevelStructs.h"
+#include "MultiSourceStructs.h"
 #include "OuterStructs.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,6 +146,11 @@ main(int argc, char** argv) {
     galois::gInfo("Running outer BC");
     DoOuterBC();
     break;
+  case MultiSource:
+    // see MultiSourceStructs.h
+    galois::gInfo("Running multi-source BC");
+    DoMultiSourceBC();
+    break;
   default:
     GALOIS_DIE("Unknown BC algorithm type");
   }
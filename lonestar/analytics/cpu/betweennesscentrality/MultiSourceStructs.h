@@ -0,0 +1,114 @@
+#ifndef GALOIS_BC_MULTI_SOURCE
+#define GALOIS_BC_MULTI_SOURCE
+
+#include <cmath>
+#include <iomanip>
+
+#include "Lonestar/BoilerPlate.h"
+#include "galois/Galois.h"
+#include "galois/analytics/betweenness_centrality/betweenness_centrality.h"
+
+using MultiSourceGraph = galois::graphs::PropertyGraph<
+    std::tuple<galois::analytics::BetweennessCentralityNodeValue>,
+    std::tuple<>>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Runs BetweennessCentrality of the analytics library with the given plan and
+ * returns the centrality of every node.
+ */
+std::vector<double>
+RunLibraryBC(
+    galois::graphs::PropertyFileGraph* pfg,
+    const std::vector<uint32_t>& sources, const std::string& property_name,
+    galois::analytics::BetweennessCentralityPlan plan) {
+  if (auto r = galois::analytics::BetweennessCentrality(
+          pfg, sources, property_name, plan);
+      !r) {
+    GALOIS_LOG_FATAL("could not compute betweenness centrality: {}", r.error());
+  }
+
+  auto pg_result = MultiSourceGraph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    GALOIS_LOG_FATAL("could not make property graph: {}", pg_result.error());
+  }
+  MultiSourceGraph graph = pg_result.value();
+
+  std::vector<double> results;
+  results.reserve(graph.num_nodes());
+  for (auto node : graph) {
+    results.push_back(
+        graph.GetData<galois::analytics::BetweennessCentralityNodeValue>(node));
+  }
+  return results;
+}
+
+void
+DoMultiSourceBC() {
+  std::cout << "Reading from file: " << inputFile << "\n";
+  std::unique_ptr<galois::graphs::PropertyFileGraph> pfg =
+      MakeFileGraph(inputFile, edge_property_name);
+
+  size_t num_nodes = pfg->topology().num_nodes();
+  std::cout << "Read " << num_nodes << " nodes, "
+            << pfg->topology().num_edges() << " edges\n";
+
+  // An empty vector of sources means every node
+  std::vector<uint32_t> sources;
+  if (numOfSources > 0) {
+    for (uint32_t i = 0; i < std::min<size_t>(numOfSources, num_nodes); ++i) {
+      sources.push_back(i);
+    }
+  } else if (iterLimit > 0) {
+    const auto& indices = *pfg->topology().out_indices;
+    for (uint32_t i = 0; i < num_nodes && sources.size() < iterLimit; ++i) {
+      uint64_t begin = i == 0 ? 0 : indices.Value(i - 1);
+      if (indices.Value(i) != begin) {
+        sources.push_back(i);
+      }
+    }
+  }
+  galois::gPrint(
+      "Num Nodes: ", num_nodes,
+      " Sources: ", sources.empty() ? num_nodes : sources.size(),
+      " Batch size: ", batchSize, "\n");
+
+  galois::reportPageAlloc("MeminfoPre");
+
+  galois::StatTimer execTime("Timer_0");
+  execTime.start();
+  std::vector<double> results = RunLibraryBC(
+      pfg.get(), sources, "betweenness_centrality",
+      galois::analytics::BetweennessCentralityPlan::MultiSource(batchSize));
+  execTime.stop();
+
+  galois::reportPageAlloc("MeminfoPost");
+
+  for (size_t i = 0; i < std::min<size_t>(10, num_nodes); ++i) {
+    std::cout << i << " " << std::setiosflags(std::ios::fixed)
+              << std::setprecision(6) << results[i] << "\n";
+  }
+
+  if (output) {
+    assert(results.size() == num_nodes);
+    writeOutput(outputLocation, results.data(), results.size());
+  }
+
+  if (!skipVerify) {
+    // Check against the per-source searches of the Outer algorithm
+    std::vector<double> expected = RunLibraryBC(
+        pfg.get(), sources, "betweenness_centrality_outer",
+        galois::analytics::BetweennessCentralityPlan::Outer());
+    for (size_t i = 0; i < num_nodes; ++i) {
+      if (std::abs(results[i] - expected[i]) >
+          1e-6 * std::max(1.0, std::abs(expected[i]))) {
+        GALOIS_DIE(
+            "verification failed at node ", i, ": expected ", expected[i],
+            " found ", results[i]);
+      }
+    }
+    std::cout << "Verification successful.\n";
+  }
+}
+#endif
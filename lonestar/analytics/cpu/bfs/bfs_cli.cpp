@@ -46,10 +46,13 @@ static cll::opt<unsigned int> reportNode(
 static cll::opt<BfsPlan::Algorithm> algo(
     "algo", cll::desc("Choose an algorithm (default value SyncTile):"),
     cll::values(
-        clEnumVal(BfsPlan::kAsyncTile, "AsyncTile"),
-        clEnumVal(BfsPlan::kAsync, "Async"),
-        clEnumVal(BfsPlan::kSyncTile, "SyncTile"),
-        clEnumVal(BfsPlan::kSync, "Sync")),
+        clEnumValN(BfsPlan::kAsyncTile, "AsyncTile", "Asynchronous tiled"),
+        clEnumValN(BfsPlan::kAsync, "Async", "Asynchronous"),
+        clEnumValN(BfsPlan::kSyncTile, "SyncTile", "Bulk-synchronous tiled"),
+        clEnumValN(BfsPlan::kSync, "Sync", "Bulk-synchronous"),
+        clEnumValN(
+            BfsPlan::kDirectionOpt, "DirectionOpt",
+            "Bulk-synchronous direction-optimizing")),
     cll::init(BfsPlan::kSyncTile));
 
 std::string
@@ -63,6 +66,8 @@ AlgorithmName(BfsPlan::Algorithm algorithm) {
     return "SyncTile";
   case BfsPlan::kSync:
     return "Sync";
+  case BfsPlan::kDirectionOpt:
+    return "DirectionOpt";
   default:
     return "Unknown";
   }
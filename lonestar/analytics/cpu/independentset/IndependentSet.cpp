@@ -29,6 +29,7 @@
 #include "Lonestar/BoilerPlate.h"
 #include "galois/Bag.h"
 #include "galois/Galois.h"
+#include "galois/LargeArray.h"
 #include "galois/ParallelSTL.h"
 #include "galois/Reduction.h"
 #include "galois/Timer.h"
@@ -40,7 +41,7 @@ const char* desc =
     "Computes a maximal independent set (not maximum) of nodes in a graph";
 const char* url = "independent_set";
 
-enum Algo { serial, pull, nondet, detBase, prio, edgetiledprio };
+enum Algo { serial, pull, nondet, detBase, detRes, prio, edgetiledprio };
 
 namespace cll = llvm::cl;
 static cll::opt<std::string> inputFile(
@@ -54,6 +55,10 @@ static cll::opt<Algo> algo(
             pull, "Pull-based (node 0 is initially in the independent set)"),
         clEnumVal(nondet, "Non-deterministic, use bulk synchronous worklist"),
         clEnumVal(detBase, "use deterministic worklist"),
+        clEnumVal(
+            detRes,
+            "deterministic reservations (same result as serial for any "
+            "number of threads)"),
         clEnumVal(
             prio,
             "prio algo based on Martin's GPU ECL-MIS algorithm (default)"),
@@ -204,6 +209,59 @@ struct DefaultAlgo {
   }
 };
 
+//! Greedy algorithm run with deterministic reservations: a node is IN iff no
+//! earlier neighbor is IN, so it can be decided once all of its earlier
+//! neighbors are. The result is the same as SerialAlgo's.
+struct ReservationAlgo {
+  struct NodeFlag {
+    using ArrowType = arrow::CTypeTraits<uint8_t>::ArrowType;
+    using ViewType = galois::PODPropertyView<MatchFlag>;
+  };
+  using NodeData = std::tuple<NodeFlag>;
+  using EdgeData = std::tuple<>;
+
+  typedef galois::graphs::PropertyGraph<NodeData, EdgeData> Graph;
+  typedef typename Graph::Node GNode;
+
+  void Initialize(Graph* graph) {
+    galois::do_all(galois::iterate(*graph), [&](const GNode& n) {
+      graph->GetData<NodeFlag>(n) = MatchFlag::KUnMatched;
+    });
+  }
+
+  void operator()(Graph* graph) {
+    galois::LargeArray<MatchFlag> decision;
+    decision.allocateBlocked(graph->size());
+
+    galois::deterministic_for(
+        galois::iterate(*graph),
+        // Only reads flags, which change during the commit step
+        [&](const GNode& src) {
+          decision[src] = MatchFlag::Matched;
+          for (auto ii : graph->edges(src)) {
+            auto dest = graph->GetEdgeDest(ii);
+            if (*dest >= src) {
+              continue;
+            }
+            auto dest_flag = graph->GetData<NodeFlag>(dest);
+            if (dest_flag == MatchFlag::Matched) {
+              decision[src] = MatchFlag::KOtherMatched;
+              break;
+            }
+            if (dest_flag == MatchFlag::KUnMatched) {
+              decision[src] = MatchFlag::KUnMatched;
+            }
+          }
+          return true;
+        },
+        [&](const GNode& src) {
+          graph->GetData<NodeFlag>(src) = decision[src];
+          return decision[src] != MatchFlag::KUnMatched;
+        },
+        galois::loopname("ReservationAlgo"));
+  }
+};
+
 struct PullAlgo {
   struct NodeFlag {
     using ArrowType = arrow::CTypeTraits<uint8_t>::ArrowType;
@@ -762,6 +820,9 @@ main(int argc, char** argv) {
         "the moment. Please try a different algorithm.");
     run<DefaultAlgo<detBase>>();
     break;
+  case detRes:
+    run<ReservationAlgo>();
+    break;
   case pull:
     run<PullAlgo>();
     break;
@@ -17,15 +17,15 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
-#include <deque>
 #include <iostream>
-#include <type_traits>
-#include <unordered_set>
 
 #include "Lonestar/BoilerPlate.h"
+#include "galois/analytics/similarity/similarity.h"
 
 namespace cll = llvm::cl;
 
+using namespace galois::analytics;
+
 static const char* name = "Jaccard Similarity";
 
 static const char* desc =
@@ -52,42 +52,6 @@ using EdgeData = std::tuple<>;
 typedef galois::graphs::PropertyGraph<NodeData, EdgeData> Graph;
 typedef typename Graph::Node GNode;
 
-void
-algo(Graph* graph, const GNode& base) {
-  std::unordered_set<GNode> base_neighbors;
-
-  // Collect all the neighbors of the base node into a hash set.
-  for (const auto& e : graph->edges(base)) {
-    auto dest = graph->GetEdgeDest(e);
-    base_neighbors.emplace(*dest);
-  }
-
-  // Compute the similarity for each node
-  galois::do_all(
-      galois::iterate(*graph),
-      [&](const GNode& n2) {
-        double& n2_data = graph->GetData<NodeValue>(n2);
-        uint32_t n2_size = 0, intersection_size = 0;
-        // TODO: Using a sorted edge list would allow a much faster intersection
-        // operation. Use that here.
-        // Count the number of neighbors of n2 and the number that are shared
-        // with base
-        for (const auto& e : graph->edges(n2)) {
-          auto neighbor = graph->GetEdgeDest(e);
-          if (base_neighbors.count(*neighbor) > 0)
-            intersection_size++;
-          n2_size++;
-        }
-        uint32_t union_size =
-            base_neighbors.size() + n2_size - intersection_size;
-        double similarity =
-            union_size > 0 ? (double)intersection_size / union_size : 1;
-        // Store the similarity back into the graph.
-        n2_data = similarity;
-      },
-      galois::steal(), galois::loopname("jaccard"));
-}
-
 int
 main(int argc, char** argv) {
   std::unique_ptr<galois::SharedMemSys> G =
@@ -100,43 +64,42 @@ main(int argc, char** argv) {
   std::unique_ptr<galois::graphs::PropertyFileGraph> pfg =
       MakeFileGraph(inputFile, edge_property_name);
 
-  auto result = ConstructNodeProperties<NodeData>(pfg.get());
-  if (!result) {
-    GALOIS_LOG_FATAL("failed to construct node properties: {}", result.error());
-  }
+  std::cout << "Read " << pfg->topology().num_nodes() << " nodes, "
+            << pfg->topology().num_edges() << " edges\n";
 
-  auto pg_result =
-      galois::graphs::PropertyGraph<NodeData, EdgeData>::Make(pfg.get());
-  if (!pg_result) {
-    GALOIS_LOG_FATAL("could not make property graph: {}", pg_result.error());
-  }
-  Graph graph = pg_result.value();
-
-  std::cout << "Read " << graph.num_nodes() << " nodes, " << graph.num_edges()
-            << " edges\n";
-
-  if (base_node >= graph.size() || report_node >= graph.size()) {
+  if (base_node >= pfg->topology().num_nodes() ||
+      report_node >= pfg->topology().num_nodes()) {
     std::cerr << "failed to set report: " << report_node
               << " or failed to set base: " << base_node << "\n";
     abort();
   }
 
-  auto it = graph.begin();
-  std::advance(it, base_node.getValue());
-  GNode base = *it;
-  it = graph.begin();
-  std::advance(it, report_node.getValue());
-  GNode report = *it;
-
   galois::reportPageAlloc("MeminfoPre");
 
   galois::StatTimer execTime("Timer_0");
   execTime.start();
 
-  algo(&graph, base);
+  if (auto r = Similarity(
+          pfg.get(), base_node, "similarity", SimilarityPlan::Jaccard());
+      !r) {
+    GALOIS_LOG_FATAL("failed to run algorithm: {}", r.error());
+  }
 
   execTime.stop();
 
+  auto pg_result = Graph::Make(pfg.get(), {"similarity"}, {});
+  if (!pg_result) {
+    GALOIS_LOG_FATAL("could not make property graph: {}", pg_result.error());
+  }
+  Graph graph = pg_result.value();
+
+  auto it = graph.begin();
+  std::advance(it, base_node.getValue());
+  GNode base = *it;
+  it = graph.begin();
+  std::advance(it, report_node.getValue());
+  GNode report = *it;
+
   galois::reportPageAlloc("MeminfoPost");
 
   std::cout << "Node " << report_node << " has similarity "
@@ -164,10 +127,11 @@ main(int argc, char** argv) {
   galois::gInfo("Minimum similarity is ", min_similarity.reduce());
   galois::gInfo("Base similarity is ", graph.GetData<NodeValue>(base));
 
-  // TODO: Verify?
-
   if (!skipVerify) {
-    if (graph.GetData<NodeValue>(base) == 1.0) {
+    // A node without neighbors is not similar to any node, not even itself
+    auto [begin, end] = pfg->topology().edge_range(base_node);
+    double expected = begin != end ? 1.0 : 0.0;
+    if (graph.GetData<NodeValue>(base) == expected) {
       std::cout << "Verification successful.\n";
     } else {
       GALOIS_LOG_FATAL(
@@ -50,15 +50,17 @@ static cll::opt<unsigned int> numPaths(
               "value 10)"),
     cll::init(10));
 
-enum Algo { deltaTile = 0, deltaStep, deltaStepBarrier };
+enum Algo { deltaTile = 0, deltaStep, deltaStepBarrier, multiQueue };
 
-const char* const ALGO_NAMES[] = {"deltaTile", "deltaStep", "deltaStepBarrier"};
+const char* const ALGO_NAMES[] = {
+    "deltaTile", "deltaStep", "deltaStepBarrier", "multiQueue"};
 
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm:"),
     cll::values(
         clEnumVal(deltaTile, "deltaTile"), clEnumVal(deltaStep, "deltaStep"),
-        clEnumVal(deltaStepBarrier, "deltaStepBarrier")),
+        clEnumVal(deltaStepBarrier, "deltaStepBarrier"),
+        clEnumVal(multiQueue, "multiQueue")),
     cll::init(deltaTile));
 
 struct Path {
@@ -105,6 +107,7 @@ using PSchunk = gwl::PerSocketChunkFIFO<kChunkSize>;
 using OBIM = gwl::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
 using OBIM_Barrier = gwl::OrderedByIntegerMetric<
     UpdateRequestIndexer, PSchunk>::with_barrier<true>::type;
+using MQ = gwl::MultiQueue<std::less<>>;
 
 //delta stepping implementation for finding a shortest path from source to report node
 template <typename Item, typename OBIMTy, typename PushWrap, typename EdgeRange>
@@ -167,6 +170,15 @@ DeltaStepAlgo(
     }
   }
 
+  // The MultiQueue orders items by Item itself and takes no indexer
+  auto wl = []() {
+    if constexpr (std::is_same_v<OBIMTy, MQ>) {
+      return galois::wl<OBIMTy>();
+    } else {
+      return galois::wl<OBIMTy>(UpdateRequestIndexer{stepShift});
+    }
+  }();
+
   //find shortest distances from source to every node
   galois::for_each(
       galois::iterate(init_bag),
@@ -221,8 +233,7 @@ DeltaStepAlgo(
           }
         }
       },
-      galois::wl<OBIM>(UpdateRequestIndexer{stepShift}),
-      galois::disable_conflict_detection(), galois::loopname("SSSP"));
+      wl, galois::disable_conflict_detection(), galois::loopname("SSSP"));
 
   if (kTrackWork) {
     //! [report self-defined stats]
@@ -292,6 +303,11 @@ FindShortestPath(
         graph, source, report, ReqPushWrap(), OutEdgeRangeFn{graph},
         shortest_path, prefix_wt, remove_edges);
     break;
+  case multiQueue:
+    path_exists = DeltaStepAlgo<UpdateRequest, MQ>(
+        graph, source, report, ReqPushWrap(), OutEdgeRangeFn{graph},
+        shortest_path, prefix_wt, remove_edges);
+    break;
 
   default:
     std::abort();
@@ -24,6 +24,8 @@
 #include <memory>
 
 #include "Lonestar/BoilerPlate.h"
+#include "galois/LargeArray.h"
+#include "galois/SetIntersection.h"
 
 enum Algo {
   bspJacobi,
@@ -149,10 +151,52 @@ isValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
   return numValid >= j;
 }
 
+/**
+ * The sorted destinations of the edges that are not removed, packed at the
+ * front of the edge range of each node so that supports can be counted with
+ * the vectorized kernels of galois/SetIntersection.h.
+ *
+ * Edges are removed while a round runs, so this is refreshed at the start of
+ * every round. A round may then keep an edge that lost its support to an
+ * edge removed in the same round; the next round removes it, so the result
+ * is the same.
+ */
+class ValidNeighbors {
+  const Graph& g_;
+  galois::LargeArray<GNode> dests_;
+  galois::LargeArray<uint32_t> degrees_;
+
+public:
+  explicit ValidNeighbors(const Graph& g) : g_(g) {
+    dests_.allocateInterleaved(g.num_edges());
+    degrees_.allocateInterleaved(g.num_nodes());
+  }
+
+  void Refresh() {
+    galois::do_all(
+        galois::iterate(g_),
+        [&](GNode n) {
+          GNode* out = &dests_[*g_.edge_begin(n)];
+          uint32_t degree = 0;
+          for (auto e : g_.edges(n)) {
+            if (!(g_.GetEdgeData<EdgeFlag>(e) & removed)) {
+              out[degree++] = *g_.GetEdgeDest(e);
+            }
+          }
+          degrees_[n] = degree;
+        },
+        galois::steal(), galois::loopname("RefreshValidNeighbors"));
+  }
+
+  const GNode* begin(GNode n) const { return &dests_[*g_.edge_begin(n)]; }
+
+  uint32_t degree(GNode n) const { return degrees_[n]; }
+};
+
 /**
  * Measure the number of intersected edges between the src and the dest nodes.
  *
- * @param g
+ * @param neighbors the edges that are not removed
  * @param src the source node
  * @param dest the destination node
  * @param j the number of the target triangles
@@ -160,41 +204,11 @@ isValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
  * @return true if the src and the dest are included in more than j triangles
  */
 bool
-isSupportNoLessThanJ(const Graph& g, GNode src, GNode dest, unsigned int j) {
-  size_t numValidEqual = 0;
-  auto srcI = g.edge_begin(src), srcE = g.edge_end(src),
-       dstI = g.edge_begin(dest), dstE = g.edge_end(dest);
-
-  while (true) {
-    //! Find the first valid edge.
-    while (srcI != srcE && (g.GetEdgeData<EdgeFlag>(srcI) & removed)) {
-      ++srcI;
-    }
-    while (dstI != dstE && (g.GetEdgeData<EdgeFlag>(dstI) & removed)) {
-      ++dstI;
-    }
-
-    if (srcI == srcE || dstI == dstE) {
-      return numValidEqual >= j;
-    }
-
-    //! Check for intersection.
-    auto sN = *g.GetEdgeDest(srcI), dN = *g.GetEdgeDest(dstI);
-    if (sN < dN) {
-      ++srcI;
-    } else if (dN < sN) {
-      ++dstI;
-    } else {
-      numValidEqual += 1;
-      if (numValidEqual >= j) {
-        return true;
-      }
-      ++srcI;
-      ++dstI;
-    }
-  }
-
-  return numValidEqual >= j;
+isSupportNoLessThanJ(
+    const ValidNeighbors& neighbors, GNode src, GNode dest, unsigned int j) {
+  return galois::IntersectCount(
+             neighbors.begin(src), neighbors.degree(src), neighbors.begin(dest),
+             neighbors.degree(dest)) >= j;
 }
 
 /**
@@ -209,16 +223,18 @@ struct BSPTrussJacobiAlgo {
   std::string name() { return "bsp"; }
 
   struct PickUnsupportedEdges {
-    Graph* g;
+    const ValidNeighbors& neighbors;
     unsigned int j;
     EdgeVec& r;  ///< unsupported
     EdgeVec& s;  ///< next
 
-    PickUnsupportedEdges(Graph* g, unsigned int j, EdgeVec& r, EdgeVec& s)
-        : g(g), j(j), r(r), s(s) {}
+    PickUnsupportedEdges(
+        const ValidNeighbors& neighbors, unsigned int j, EdgeVec& r, EdgeVec& s)
+        : neighbors(neighbors), j(j), r(r), s(s) {}
 
     void operator()(Edge e) {
-      EdgeVec& w = isSupportNoLessThanJ(*g, e.first, e.second, j) ? s : r;
+      EdgeVec& w =
+          isSupportNoLessThanJ(neighbors, e.first, e.second, j) ? s : r;
       w.push_back(e);
     }
   };
@@ -245,10 +261,14 @@ struct BSPTrussJacobiAlgo {
         },
         galois::steal());
 
+    ValidNeighbors neighbors(*g);
+
     while (true) {
+      neighbors.Refresh();
       galois::do_all(
           galois::iterate(*cur),
-          PickUnsupportedEdges{g, k - 2, unsupported, *next}, galois::steal());
+          PickUnsupportedEdges{neighbors, k - 2, unsupported, *next},
+          galois::steal());
 
       if (std::distance(unsupported.begin(), unsupported.end()) == 0) {
         break;
@@ -283,14 +303,16 @@ struct BSPTrussAlgo {
 
   struct KeepSupportedEdges {
     Graph* g;
+    const ValidNeighbors& neighbors;
     unsigned int j;
     EdgeVec& s;
 
-    KeepSupportedEdges(Graph* g, unsigned int j, EdgeVec& s)
-        : g(g), j(j), s(s) {}
+    KeepSupportedEdges(
+        Graph* g, const ValidNeighbors& neighbors, unsigned int j, EdgeVec& s)
+        : g(g), neighbors(neighbors), j(j), s(s) {}
 
     void operator()(Edge e) {
-      if (isSupportNoLessThanJ(*g, e.first, e.second, j)) {
+      if (isSupportNoLessThanJ(neighbors, e.first, e.second, j)) {
         s.push_back(e);
       } else {
         g->GetEdgeData<EdgeFlag>(galois::graphs::FindEdgeSortedByDest(
@@ -325,10 +347,13 @@ struct BSPTrussAlgo {
         galois::steal());
     curSize = std::distance(cur->begin(), cur->end());
 
+    ValidNeighbors neighbors(*g);
+
     //! Remove unsupported edges until no more edges can be removed.
     while (true) {
+      neighbors.Refresh();
       galois::do_all(
-          galois::iterate(*cur), KeepSupportedEdges{g, k - 2, *next},
+          galois::iterate(*cur), KeepSupportedEdges{g, neighbors, k - 2, *next},
           galois::steal());
       nextSize = std::distance(next->begin(), next->end());
 
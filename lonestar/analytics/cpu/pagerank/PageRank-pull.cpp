@@ -92,30 +92,27 @@ computeOutDeg(Graph* graph) {
   galois::LargeArray<std::atomic<size_t>> vec;
   vec.allocateInterleaved(graph->size());
 
-  galois::do_all(
-      galois::iterate(*graph),
-      [&](const GNode& src) { vec.constructAt(src, 0ul); }, galois::no_stats(),
-      galois::loopname("InitDegVec"));
-
-  galois::do_all(
+  galois::do_all_fused(
       galois::iterate(*graph),
-      [&](const GNode& src) {
-        for (auto nbr : graph->edges(src)) {
-          auto dest = graph->GetEdgeDest(nbr);
-          vec[*dest].fetch_add(1ul);
-        };
-      },
-      galois::steal(), galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
+      std::make_tuple(
+          galois::phase([&](const GNode& src) { vec.constructAt(src, 0ul); }),
+          galois::phase(
+              [&](const GNode& src) {
+                for (auto nbr : graph->edges(src)) {
+                  auto dest = graph->GetEdgeDest(nbr);
+                  vec[*dest].fetch_add(1ul);
+                };
+              },
+              galois::after_barrier(), galois::steal()),
+          galois::phase(
+              [&](const GNode& src) {
+                auto& src_nout = graph->GetData<NodeNout>(src);
+                src_nout = vec[src];
+              },
+              galois::after_barrier())),
+      galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
       galois::loopname("computeOutDeg"));
 
-  galois::do_all(
-      galois::iterate(*graph),
-      [&](const GNode& src) {
-        auto& src_nout = graph->GetData<NodeNout>(src);
-        src_nout = vec[src];
-      },
-      galois::no_stats(), galois::loopname("CopyDeg"));
-
   outDegreeTimer.stop();
 }
 
@@ -133,43 +130,43 @@ computePRResidual(Graph* graph, DeltaArray& delta, ResidualArray& residual) {
   galois::GAccumulator<unsigned int> accum;
 
   while (true) {
-    galois::do_all(
+    galois::do_all_fused(
         galois::iterate(*graph),
-        [&](const GNode& src) {
-          auto& sdata_value = graph->GetData<NodeValue>(src);
-          auto& sdata_nout = graph->GetData<NodeNout>(src);
-          delta[src] = 0;
-
-          //! Only the residual higher than tolerance will be reflected
-          //! to the pagerank.
-          if (residual[src] > tolerance) {
-            PRTy old_residual = residual[src];
-            residual[src] = 0.0;
-            sdata_value += old_residual;
-            if (sdata_nout > 0) {
-              delta[src] = old_residual * ALPHA / sdata_nout;
-              accum += 1;
-            }
-          }
-        },
-        galois::no_stats(), galois::loopname("PageRank_delta"));
-
-    galois::do_all(
-        galois::iterate(*graph),
-        [&](const GNode& src) {
-          float sum = 0;
-          for (auto nbr : graph->edges(src)) {
-            auto dest = graph->GetEdgeDest(nbr);
-            if (delta[*dest] > 0) {
-              sum += delta[*dest];
-            }
-          }
-          if (sum > 0) {
-            residual[src] = sum;
-          }
-        },
-        galois::steal(), galois::chunk_size<CHUNK_SIZE>(), galois::no_stats(),
-        galois::loopname("PageRank"));
+        std::make_tuple(
+            galois::phase([&](const GNode& src) {
+              auto& sdata_value = graph->GetData<NodeValue>(src);
+              auto& sdata_nout = graph->GetData<NodeNout>(src);
+              delta[src] = 0;
+
+              //! Only the residual higher than tolerance will be reflected
+              //! to the pagerank.
+              if (residual[src] > tolerance) {
+                PRTy old_residual = residual[src];
+                residual[src] = 0.0;
+                sdata_value += old_residual;
+                if (sdata_nout > 0) {
+                  delta[src] = old_residual * ALPHA / sdata_nout;
+                  accum += 1;
+                }
+              }
+            }),
+            //! Pulls the deltas of all neighbors, so they must be complete
+            galois::phase(
+                [&](const GNode& src) {
+                  float sum = 0;
+                  for (auto nbr : graph->edges(src)) {
+                    auto dest = graph->GetEdgeDest(nbr);
+                    if (delta[*dest] > 0) {
+                      sum += delta[*dest];
+                    }
+                  }
+                  if (sum > 0) {
+                    residual[src] = sum;
+                  }
+                },
+                galois::after_barrier(), galois::steal())),
+        galois::chunk_size<CHUNK_SIZE>(), galois::combine_reducers(accum),
+        galois::no_stats(), galois::loopname("PageRank"));
 
 #if DEBUG
     std::cout << "iteration: " << iterations << "\n";
@@ -224,7 +221,7 @@ computePRTopological(Graph* graph) {
           accum += diff;
         },
         galois::no_stats(), galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
-        galois::loopname("PageRank"));
+        galois::combine_reducers(accum), galois::loopname("PageRank"));
 
 #if DEBUG
     std::cout << "iteration: " << iteration << " max delta: " << delta << "\n";
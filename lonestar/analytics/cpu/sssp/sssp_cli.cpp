@@ -56,6 +56,7 @@ static cll::opt<SsspPlan::Algorithm> algo(
         clEnumVal(SsspPlan::kDijkstra, "Dijkstra"),
         clEnumVal(SsspPlan::kTopo, "Topo"),
         clEnumVal(SsspPlan::kTopoTile, "TopoTile"),
+        clEnumVal(SsspPlan::kMultiQueue, "MultiQueue"),
         clEnumVal(
             SsspPlan::kAutomatic,
             "Automatic: choose among the algorithms automatically")),
@@ -173,6 +174,8 @@ AlgorithmName(SsspPlan::Algorithm algorithm) {
     return "Topo";
   case SsspPlan::kTopoTile:
     return "TopoTile";
+  case SsspPlan::kMultiQueue:
+    return "MultiQueue";
   case SsspPlan::kAutomatic:
     return "Automatic";
   default:
@@ -243,6 +246,9 @@ main(int argc, char** argv) {
   case SsspPlan::kTopoTile:
     plan = SsspPlan::TopoTile();
     break;
+  case SsspPlan::kMultiQueue:
+    plan = SsspPlan::MultiQueue();
+    break;
   case SsspPlan::kAutomatic:
     plan = SsspPlan::Automatic();
     break;
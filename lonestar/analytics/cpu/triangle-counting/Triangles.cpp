@@ -26,6 +26,8 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include "Lonestar/BoilerPlate.h"
+#include "galois/SetIntersection.h"
+#include "galois/analytics/triangle_count/triangle_count.h"
 #include "galois/runtime/Profile.h"
 
 const char* name = "Triangles";
@@ -89,28 +91,18 @@ LowerBound(Iterator first, Iterator last, Compare comp) {
 }
 
 /**
- * std::set_intersection over edge_iterators.
+ * Returns the destinations of the edges of n, which are sorted by
+ * SortAllEdgesByDest.
  */
-template <typename G>
+const uint32_t*
+EdgeDests(const Graph& graph, GNode n) {
+  return graph.GetPropertyFileGraph().topology().out_dests->raw_values() +
+         *graph.edge_begin(n);
+}
+
 size_t
-CountEqual(
-    const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
-    typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = *g.GetEdgeDest(aa);
-    typename G::Node b = *g.GetEdgeDest(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+Degree(const Graph& graph, GNode n) {
+  return *graph.edge_end(n) - *graph.edge_begin(n);
 }
 
 template <typename G>
@@ -229,46 +221,19 @@ NodeIteratingAlgo(const Graph& graph) {
   std::cout << "Num Triangles: " << numTriangles.reduce() << "\n";
 }
 
-/**
- * Lambda function to count triangles
- */
-void
-OrderedCountFunc(
-    const Graph& graph, GNode n, galois::GAccumulator<size_t>& numTriangles) {
-  size_t numTriangles_local = 0;
-  for (auto it_v : graph.edges(n)) {
-    auto v = *graph.GetEdgeDest(it_v);
-    if (v > n)
-      break;
-    Graph::edge_iterator it_n = graph.edge_begin(n);
-
-    for (auto it_vv : graph.edges(v)) {
-      auto vv = *graph.GetEdgeDest(it_vv);
-      if (vv > v)
-        break;
-      while (*graph.GetEdgeDest(it_n) < vv)
-        it_n++;
-      if (vv == *graph.GetEdgeDest(it_n)) {
-        numTriangles_local += 1;
-      }
-    }
-  }
-  numTriangles += numTriangles_local;
-}
-
 /*
- * Simple counting loop, instead of binary searching.
+ * Simple counting loop, instead of binary searching, from the analytics
+ * library, on the topology that main has already sorted.
  */
 void
-OrderedCountAlgo(const Graph& graph) {
-  galois::GAccumulator<size_t> numTriangles;
-  galois::do_all(
-      galois::iterate(graph),
-      [&](const GNode& n) { OrderedCountFunc(graph, n, numTriangles); },
-      galois::chunk_size<CHUNK_SIZE>(), galois::steal(),
-      galois::loopname("OrderedCountAlgo"));
+OrderedCountAlgo(galois::graphs::PropertyFileGraph* pfg) {
+  auto num_triangles = galois::analytics::TriangleCount(
+      pfg, galois::analytics::TriangleCountPlan::OrderedCount(true, true));
+  if (!num_triangles) {
+    GALOIS_LOG_FATAL("could not count triangles: {}", num_triangles.error());
+  }
 
-  galois::gPrint("Num Triangles: ", numTriangles.reduce(), "\n");
+  galois::gPrint("Num Triangles: ", num_triangles.value(), "\n");
 }
 
 /**
@@ -315,21 +280,17 @@ EdgeIteratingAlgo(const Graph& graph) {
             [&](const WorkItem& w) {
               // Compute intersection of range (w.src, w.dst) in neighbors of
               // w.src and w.dst
-              Graph::edge_iterator abegin = graph.edge_begin(w.src);
-              Graph::edge_iterator aend = graph.edge_end(w.src);
-              Graph::edge_iterator bbegin = graph.edge_begin(w.dst);
-              Graph::edge_iterator bend = graph.edge_end(w.dst);
+              const uint32_t* a = EdgeDests(graph, w.src);
+              const uint32_t* a_end = a + Degree(graph, w.src);
+              const uint32_t* b = EdgeDests(graph, w.dst);
+              const uint32_t* b_end = b + Degree(graph, w.dst);
 
-              Graph::edge_iterator aa = LowerBound(
-                  abegin, aend, GreaterThanOrEqual<Graph>(graph, w.src));
-              Graph::edge_iterator ea =
-                  LowerBound(abegin, aend, LessThan<Graph>(graph, w.dst));
-              Graph::edge_iterator bb = LowerBound(
-                  bbegin, bend, GreaterThanOrEqual<Graph>(graph, w.src));
-              Graph::edge_iterator eb =
-                  LowerBound(bbegin, bend, LessThan<Graph>(graph, w.dst));
+              const uint32_t* aa = std::upper_bound(a, a_end, w.src);
+              const uint32_t* ea = std::lower_bound(aa, a_end, w.dst);
+              const uint32_t* bb = std::upper_bound(b, b_end, w.src);
+              const uint32_t* eb = std::lower_bound(bb, b_end, w.dst);
 
-              numTriangles += CountEqual(graph, aa, ea, bb, eb);
+              numTriangles += galois::IntersectCount(aa, ea - aa, bb, eb - bb);
             },
             galois::loopname("EdgeIteratingAlgo"),
             galois::chunk_size<CHUNK_SIZE>(), galois::steal());
@@ -415,7 +376,7 @@ main(int argc, char** argv) {
     break;
 
   case orderedCount:
-    OrderedCountAlgo(graph);
+    OrderedCountAlgo(pfg.get());
     break;
 
   default:
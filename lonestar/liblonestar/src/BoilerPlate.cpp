@@ -111,6 +111,7 @@ LonestarStart(
   galois::ReportParam("(NULL)", "Hosts", 1);
   if (input) {
     galois::ReportParam("(NULL)", "Input", input->getValue());
+    galois::SetStatMetadata("graph", input->getValue());
   }
 
   char name[256];
@@ -1,2 +1,12 @@
+from galois.analytics._wrappers import betweenness_centrality, BetweennessCentralityPlan
 from galois.analytics._wrappers import bfs, BfsPlan
+from galois.analytics._wrappers import closeness_centrality, ClosenessCentralityPlan
+from galois.analytics._wrappers import community_detection, modularity, CommunityDetectionPlan
+from galois.analytics._wrappers import connected_components, connected_components_add_edges, ConnectedComponentsPlan
+from galois.analytics._wrappers import k_core, KCorePlan
+from galois.analytics._wrappers import k_shortest_paths, KShortestPathsPlan
+from galois.analytics._wrappers import page_rank, personalized_page_rank, PageRankPlan
+from galois.analytics._wrappers import similarity, edge_similarity, top_k_similarity, SimilarityPlan
 from galois.analytics._wrappers import sssp, SsspPlan
+from galois.analytics._wrappers import strongly_connected_components, StronglyConnectedComponentsPlan
+from galois.analytics._wrappers import triangle_count, edge_triangle_count, local_clustering_coefficient, node_triangle_count, TriangleCountPlan
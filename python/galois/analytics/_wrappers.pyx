@@ -1,8 +1,14 @@
-from galois.cpp.libstd.boost cimport std_result, handle_result_void
+from galois.cpp.libstd.boost cimport std_result, handle_result_void, handle_result_double, handle_result_uint64, \
+    raise_error_code
 from libc.stddef cimport ptrdiff_t
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.memory cimport shared_ptr
 from libcpp.string cimport string
+from libcpp.utility cimport pair
+from libcpp.vector cimport vector
 from galois.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
 from galois.property_graph cimport PropertyGraph
+from pyarrow.lib cimport CTable, pyarrow_wrap_table
 
 from enum import Enum
 
@@ -24,9 +30,12 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
             kAsync "galois::analytics::BfsPlan::kAsync"
             kSyncTile "galois::analytics::BfsPlan::kSyncTile"
             kSync "galois::analytics::BfsPlan::kSync"
+            kDirectionOpt "galois::analytics::BfsPlan::kDirectionOpt"
 
         _BfsPlan.Algorithm algorithm() const
         ptrdiff_t edge_tile_size() const
+        uint32_t alpha() const
+        uint32_t beta() const
 
         @staticmethod
         _BfsPlan AsyncTile()
@@ -44,6 +53,9 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
         @staticmethod
         _BfsPlan Sync()
 
+        @staticmethod
+        _BfsPlan DirectionOpt(uint32_t alpha, uint32_t beta)
+
         @staticmethod
         _BfsPlan Automatic()
 
@@ -60,6 +72,7 @@ class _BfsAlgorithm(Enum):
     Async = _BfsPlan.Algorithm.kAsync
     SyncTile = _BfsPlan.Algorithm.kSyncTile
     Sync = _BfsPlan.Algorithm.kSync
+    DirectionOpt = _BfsPlan.Algorithm.kDirectionOpt
 
 
 cdef class BfsPlan:
@@ -82,6 +95,14 @@ cdef class BfsPlan:
     def edge_tile_size(self) -> int:
         return self.underlying.edge_tile_size()
 
+    @property
+    def alpha(self) -> int:
+        return self.underlying.alpha()
+
+    @property
+    def beta(self) -> int:
+        return self.underlying.beta()
+
     @staticmethod
     def async_tile(edge_tile_size=None):
         if edge_tile_size is not None:
@@ -102,6 +123,10 @@ cdef class BfsPlan:
     def sync():
         return BfsPlan.make(_BfsPlan.Sync())
 
+    @staticmethod
+    def direction_opt(uint32_t alpha=15, uint32_t beta=18):
+        return BfsPlan.make(_BfsPlan.DirectionOpt(alpha, beta))
+
     @staticmethod
     def automatic():
         return BfsPlan.make(_BfsPlan.Automatic())
@@ -117,6 +142,676 @@ def bfs(PropertyGraph pg, size_t start_node, str output_property_name, BfsPlan p
     with nogil:
         handle_result_void(Bfs(pg.underlying.get(), start_node, output_property_name_cstr, plan.underlying))
 
+# Betweenness centrality
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _BetweennessCentralityPlan "galois::analytics::BetweennessCentralityPlan":
+        enum Algorithm:
+            kOuter "galois::analytics::BetweennessCentralityPlan::kOuter"
+            kMultiSource "galois::analytics::BetweennessCentralityPlan::kMultiSource"
+
+        _BetweennessCentralityPlan.Algorithm algorithm() const
+        uint32_t batch_size() const
+
+        @staticmethod
+        _BetweennessCentralityPlan Outer()
+
+        @staticmethod
+        _BetweennessCentralityPlan MultiSource(uint32_t batch_size)
+
+        @staticmethod
+        _BetweennessCentralityPlan Automatic()
+
+        @staticmethod
+        _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
+
+    std_result[void] BetweennessCentrality(PropertyFileGraph* pfg, vector[uint32_t] sources,
+                                           string output_property_name, _BetweennessCentralityPlan plan)
+
+class _BetweennessCentralityAlgorithm(Enum):
+    Outer = _BetweennessCentralityPlan.Algorithm.kOuter
+    MultiSource = _BetweennessCentralityPlan.Algorithm.kMultiSource
+
+
+cdef class BetweennessCentralityPlan:
+    cdef:
+        _BetweennessCentralityPlan underlying
+
+    @staticmethod
+    cdef BetweennessCentralityPlan make(_BetweennessCentralityPlan u):
+        f = <BetweennessCentralityPlan>BetweennessCentralityPlan.__new__(BetweennessCentralityPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _BetweennessCentralityAlgorithm
+
+    @property
+    def algorithm(self) -> _BetweennessCentralityAlgorithm:
+        return _BetweennessCentralityAlgorithm(self.underlying.algorithm())
+
+    @property
+    def batch_size(self) -> int:
+        return self.underlying.batch_size()
+
+    @staticmethod
+    def outer():
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Outer())
+
+    @staticmethod
+    def multi_source(uint32_t batch_size=64):
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.MultiSource(batch_size))
+
+    @staticmethod
+    def automatic():
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.FromAlgorithm(int(algorithm)))
+
+
+def betweenness_centrality(PropertyGraph pg, str output_property_name, sources=None,
+                           BetweennessCentralityPlan plan = BetweennessCentralityPlan.automatic()):
+    cdef vector[uint32_t] sources_vec
+    if sources is not None:
+        sources_vec = sources
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(BetweennessCentrality(pg.underlying.get(), sources_vec, output_property_name_cstr,
+                                                 plan.underlying))
+
+# Closeness centrality
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _ClosenessCentralityPlan "galois::analytics::ClosenessCentralityPlan":
+        enum Metric:
+            kCloseness "galois::analytics::ClosenessCentralityPlan::kCloseness"
+            kHarmonic "galois::analytics::ClosenessCentralityPlan::kHarmonic"
+
+        _ClosenessCentralityPlan.Metric metric() const
+        uint32_t batch_size() const
+
+        @staticmethod
+        _ClosenessCentralityPlan Closeness(uint32_t batch_size)
+
+        @staticmethod
+        _ClosenessCentralityPlan Harmonic(uint32_t batch_size)
+
+        @staticmethod
+        _ClosenessCentralityPlan Automatic()
+
+    std_result[void] ClosenessCentrality(PropertyFileGraph* pfg, string output_property_name,
+                                         _ClosenessCentralityPlan plan)
+
+class _ClosenessCentralityMetric(Enum):
+    Closeness = _ClosenessCentralityPlan.Metric.kCloseness
+    Harmonic = _ClosenessCentralityPlan.Metric.kHarmonic
+
+
+cdef class ClosenessCentralityPlan:
+    cdef:
+        _ClosenessCentralityPlan underlying
+
+    @staticmethod
+    cdef ClosenessCentralityPlan make(_ClosenessCentralityPlan u):
+        f = <ClosenessCentralityPlan>ClosenessCentralityPlan.__new__(ClosenessCentralityPlan)
+        f.underlying = u
+        return f
+
+    Metric = _ClosenessCentralityMetric
+
+    @property
+    def metric(self) -> _ClosenessCentralityMetric:
+        return _ClosenessCentralityMetric(self.underlying.metric())
+
+    @property
+    def batch_size(self) -> int:
+        return self.underlying.batch_size()
+
+    @staticmethod
+    def closeness(uint32_t batch_size=256):
+        return ClosenessCentralityPlan.make(_ClosenessCentralityPlan.Closeness(batch_size))
+
+    @staticmethod
+    def harmonic(uint32_t batch_size=256):
+        return ClosenessCentralityPlan.make(_ClosenessCentralityPlan.Harmonic(batch_size))
+
+    @staticmethod
+    def automatic():
+        return ClosenessCentralityPlan.make(_ClosenessCentralityPlan.Automatic())
+
+
+def closeness_centrality(PropertyGraph pg, str output_property_name,
+                         ClosenessCentralityPlan plan = ClosenessCentralityPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(ClosenessCentrality(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+# Community detection
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _CommunityDetectionPlan "galois::analytics::CommunityDetectionPlan":
+        enum Algorithm:
+            kLouvain "galois::analytics::CommunityDetectionPlan::kLouvain"
+            kLeiden "galois::analytics::CommunityDetectionPlan::kLeiden"
+
+        _CommunityDetectionPlan.Algorithm algorithm() const
+        double resolution() const
+        double modularity_threshold_per_round() const
+        double modularity_threshold_total() const
+        uint32_t max_iterations() const
+        uint32_t min_graph_size() const
+        double randomness() const
+
+        @staticmethod
+        _CommunityDetectionPlan Louvain(double resolution, double modularity_threshold_per_round,
+                                        double modularity_threshold_total, uint32_t max_iterations,
+                                        uint32_t min_graph_size)
+
+        @staticmethod
+        _CommunityDetectionPlan Leiden(double resolution, double modularity_threshold_per_round,
+                                       double modularity_threshold_total, uint32_t max_iterations,
+                                       uint32_t min_graph_size, double randomness)
+
+        @staticmethod
+        _CommunityDetectionPlan Automatic()
+
+        @staticmethod
+        _CommunityDetectionPlan FromAlgorithm(_CommunityDetectionPlan.Algorithm algo)
+
+    std_result[void] CommunityDetection(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                        string output_property_name, _CommunityDetectionPlan plan)
+
+    std_result[double] Modularity(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                  string community_property_name, double resolution)
+
+class _CommunityDetectionAlgorithm(Enum):
+    Louvain = _CommunityDetectionPlan.Algorithm.kLouvain
+    Leiden = _CommunityDetectionPlan.Algorithm.kLeiden
+
+
+cdef class CommunityDetectionPlan:
+    cdef:
+        _CommunityDetectionPlan underlying
+
+    @staticmethod
+    cdef CommunityDetectionPlan make(_CommunityDetectionPlan u):
+        f = <CommunityDetectionPlan>CommunityDetectionPlan.__new__(CommunityDetectionPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _CommunityDetectionAlgorithm
+
+    @property
+    def algorithm(self) -> _CommunityDetectionAlgorithm:
+        return _CommunityDetectionAlgorithm(self.underlying.algorithm())
+
+    @property
+    def resolution(self) -> float:
+        return self.underlying.resolution()
+
+    @property
+    def modularity_threshold_per_round(self) -> float:
+        return self.underlying.modularity_threshold_per_round()
+
+    @property
+    def modularity_threshold_total(self) -> float:
+        return self.underlying.modularity_threshold_total()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying.max_iterations()
+
+    @property
+    def min_graph_size(self) -> int:
+        return self.underlying.min_graph_size()
+
+    @property
+    def randomness(self) -> float:
+        return self.underlying.randomness()
+
+    @staticmethod
+    def louvain(double resolution=1.0, double modularity_threshold_per_round=0.01,
+                double modularity_threshold_total=0.01, uint32_t max_iterations=10, uint32_t min_graph_size=100):
+        return CommunityDetectionPlan.make(
+            _CommunityDetectionPlan.Louvain(resolution, modularity_threshold_per_round, modularity_threshold_total,
+                                            max_iterations, min_graph_size))
+
+    @staticmethod
+    def leiden(double resolution=1.0, double modularity_threshold_per_round=0.01,
+               double modularity_threshold_total=0.01, uint32_t max_iterations=10, uint32_t min_graph_size=100,
+               double randomness=0.01):
+        return CommunityDetectionPlan.make(
+            _CommunityDetectionPlan.Leiden(resolution, modularity_threshold_per_round, modularity_threshold_total,
+                                           max_iterations, min_graph_size, randomness))
+
+    @staticmethod
+    def automatic():
+        return CommunityDetectionPlan.make(_CommunityDetectionPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return CommunityDetectionPlan.make(_CommunityDetectionPlan.FromAlgorithm(int(algorithm)))
+
+
+def community_detection(PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+                        CommunityDetectionPlan plan = CommunityDetectionPlan.automatic()):
+    edge_weight_property_name_bytes = bytes(edge_weight_property_name, "utf-8")
+    edge_weight_property_name_cstr = <string>edge_weight_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(CommunityDetection(pg.underlying.get(), edge_weight_property_name_cstr,
+                                              output_property_name_cstr, plan.underlying))
+
+
+def modularity(PropertyGraph pg, str edge_weight_property_name, str community_property_name,
+               double resolution=1.0) -> float:
+    cdef double result
+    edge_weight_property_name_bytes = bytes(edge_weight_property_name, "utf-8")
+    edge_weight_property_name_cstr = <string>edge_weight_property_name_bytes
+    community_property_name_bytes = bytes(community_property_name, "utf-8")
+    community_property_name_cstr = <string>community_property_name_bytes
+    with nogil:
+        result = handle_result_double(Modularity(pg.underlying.get(), edge_weight_property_name_cstr,
+                                                 community_property_name_cstr, resolution))
+    return result
+
+# Connected components
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _ConnectedComponentsPlan "galois::analytics::ConnectedComponentsPlan":
+        enum Algorithm:
+            kAfforest "galois::analytics::ConnectedComponentsPlan::kAfforest"
+            kEdgeTiledAsync "galois::analytics::ConnectedComponentsPlan::kEdgeTiledAsync"
+
+        _ConnectedComponentsPlan.Algorithm algorithm() const
+        bint symmetric() const
+        uint32_t neighbor_samples() const
+        uint32_t component_samples() const
+        ptrdiff_t edge_tile_size() const
+
+        @staticmethod
+        _ConnectedComponentsPlan Afforest(bint symmetric, uint32_t neighbor_samples, uint32_t component_samples,
+                                          ptrdiff_t edge_tile_size)
+
+        @staticmethod
+        _ConnectedComponentsPlan EdgeTiledAsync(bint symmetric, ptrdiff_t edge_tile_size)
+
+        @staticmethod
+        _ConnectedComponentsPlan Automatic()
+
+        @staticmethod
+        _ConnectedComponentsPlan FromAlgorithm(_ConnectedComponentsPlan.Algorithm algo)
+
+    std_result[void] ConnectedComponents(PropertyFileGraph* pfg, string output_property_name,
+                                         _ConnectedComponentsPlan plan)
+
+    std_result[void] ConnectedComponentsAddEdges(PropertyFileGraph* pfg, string property_name,
+                                                 vector[pair[uint32_t, uint32_t]] edges)
+
+class _ConnectedComponentsAlgorithm(Enum):
+    Afforest = _ConnectedComponentsPlan.Algorithm.kAfforest
+    EdgeTiledAsync = _ConnectedComponentsPlan.Algorithm.kEdgeTiledAsync
+
+
+cdef class ConnectedComponentsPlan:
+    cdef:
+        _ConnectedComponentsPlan underlying
+
+    @staticmethod
+    cdef ConnectedComponentsPlan make(_ConnectedComponentsPlan u):
+        f = <ConnectedComponentsPlan>ConnectedComponentsPlan.__new__(ConnectedComponentsPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _ConnectedComponentsAlgorithm
+
+    @property
+    def algorithm(self) -> _ConnectedComponentsAlgorithm:
+        return _ConnectedComponentsAlgorithm(self.underlying.algorithm())
+
+    @property
+    def symmetric(self) -> bool:
+        return self.underlying.symmetric()
+
+    @property
+    def neighbor_samples(self) -> int:
+        return self.underlying.neighbor_samples()
+
+    @property
+    def component_samples(self) -> int:
+        return self.underlying.component_samples()
+
+    @property
+    def edge_tile_size(self) -> int:
+        return self.underlying.edge_tile_size()
+
+    @staticmethod
+    def afforest(bint symmetric=False, uint32_t neighbor_samples=2, uint32_t component_samples=1024,
+                 ptrdiff_t edge_tile_size=512):
+        return ConnectedComponentsPlan.make(
+            _ConnectedComponentsPlan.Afforest(symmetric, neighbor_samples, component_samples, edge_tile_size))
+
+    @staticmethod
+    def edge_tiled_async(bint symmetric=False, ptrdiff_t edge_tile_size=512):
+        return ConnectedComponentsPlan.make(_ConnectedComponentsPlan.EdgeTiledAsync(symmetric, edge_tile_size))
+
+    @staticmethod
+    def automatic():
+        return ConnectedComponentsPlan.make(_ConnectedComponentsPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return ConnectedComponentsPlan.make(_ConnectedComponentsPlan.FromAlgorithm(int(algorithm)))
+
+
+def connected_components(PropertyGraph pg, str output_property_name,
+                         ConnectedComponentsPlan plan = ConnectedComponentsPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(ConnectedComponents(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+
+def connected_components_add_edges(PropertyGraph pg, str property_name, edges):
+    cdef vector[pair[uint32_t, uint32_t]] edges_vec = edges
+    property_name_bytes = bytes(property_name, "utf-8")
+    property_name_cstr = <string>property_name_bytes
+    with nogil:
+        handle_result_void(ConnectedComponentsAddEdges(pg.underlying.get(), property_name_cstr, edges_vec))
+
+# k-core
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _KCorePlan "galois::analytics::KCorePlan":
+        enum Algorithm:
+            kPeel "galois::analytics::KCorePlan::kPeel"
+            kHIndex "galois::analytics::KCorePlan::kHIndex"
+
+        _KCorePlan.Algorithm algorithm() const
+
+        @staticmethod
+        _KCorePlan Peel()
+
+        @staticmethod
+        _KCorePlan HIndex()
+
+        @staticmethod
+        _KCorePlan Automatic()
+
+        @staticmethod
+        _KCorePlan FromAlgorithm(_KCorePlan.Algorithm algo)
+
+    std_result[void] KCore(PropertyFileGraph * pfg,
+                           string output_property_name,
+                           _KCorePlan plan)
+
+class _KCoreAlgorithm(Enum):
+    Peel = _KCorePlan.Algorithm.kPeel
+    HIndex = _KCorePlan.Algorithm.kHIndex
+
+
+cdef class KCorePlan:
+    cdef:
+        _KCorePlan underlying
+
+    @staticmethod
+    cdef KCorePlan make(_KCorePlan u):
+        f = <KCorePlan>KCorePlan.__new__(KCorePlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _KCoreAlgorithm
+
+    @property
+    def algorithm(self) -> _KCoreAlgorithm:
+        return _KCoreAlgorithm(self.underlying.algorithm())
+
+    @staticmethod
+    def peel():
+        return KCorePlan.make(_KCorePlan.Peel())
+
+    @staticmethod
+    def h_index():
+        return KCorePlan.make(_KCorePlan.HIndex())
+
+    @staticmethod
+    def automatic():
+        return KCorePlan.make(_KCorePlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return KCorePlan.make(_KCorePlan.FromAlgorithm(int(algorithm)))
+
+
+def k_core(PropertyGraph pg, str output_property_name, KCorePlan plan = KCorePlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(KCore(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+# PageRank
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _PageRankPlan "galois::analytics::PageRankPlan":
+        enum Algorithm:
+            kPull "galois::analytics::PageRankPlan::kPull"
+            kPush "galois::analytics::PageRankPlan::kPush"
+            kDelta "galois::analytics::PageRankPlan::kDelta"
+
+        _PageRankPlan.Algorithm algorithm() const
+        float tolerance() const
+        uint32_t max_iterations() const
+        float damping() const
+
+        @staticmethod
+        _PageRankPlan Pull(float tolerance, uint32_t max_iterations, float damping)
+
+        @staticmethod
+        _PageRankPlan Push(float tolerance, float damping)
+
+        @staticmethod
+        _PageRankPlan Delta(float tolerance, uint32_t max_iterations, float damping)
+
+        @staticmethod
+        _PageRankPlan Automatic()
+
+        @staticmethod
+        _PageRankPlan FromAlgorithm(_PageRankPlan.Algorithm algo)
+
+    std_result[void] PageRank(PropertyFileGraph* pfg, string output_property_name, _PageRankPlan plan)
+
+    std_result[void] PersonalizedPageRank(PropertyFileGraph* pfg, vector[uint32_t] sources,
+                                          string output_property_name, _PageRankPlan plan)
+
+class _PageRankAlgorithm(Enum):
+    Pull = _PageRankPlan.Algorithm.kPull
+    Push = _PageRankPlan.Algorithm.kPush
+    Delta = _PageRankPlan.Algorithm.kDelta
+
+
+cdef class PageRankPlan:
+    cdef:
+        _PageRankPlan underlying
+
+    @staticmethod
+    cdef PageRankPlan make(_PageRankPlan u):
+        f = <PageRankPlan>PageRankPlan.__new__(PageRankPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _PageRankAlgorithm
+
+    @property
+    def algorithm(self) -> _PageRankAlgorithm:
+        return _PageRankAlgorithm(self.underlying.algorithm())
+
+    @property
+    def tolerance(self) -> float:
+        return self.underlying.tolerance()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying.max_iterations()
+
+    @property
+    def damping(self) -> float:
+        return self.underlying.damping()
+
+    @staticmethod
+    def pull(float tolerance=1.0e-6, uint32_t max_iterations=1000, float damping=0.85):
+        return PageRankPlan.make(_PageRankPlan.Pull(tolerance, max_iterations, damping))
+
+    @staticmethod
+    def push(float tolerance=1.0e-6, float damping=0.85):
+        return PageRankPlan.make(_PageRankPlan.Push(tolerance, damping))
+
+    @staticmethod
+    def delta(float tolerance=1.0e-6, uint32_t max_iterations=1000, float damping=0.85):
+        return PageRankPlan.make(_PageRankPlan.Delta(tolerance, max_iterations, damping))
+
+    @staticmethod
+    def automatic():
+        return PageRankPlan.make(_PageRankPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return PageRankPlan.make(_PageRankPlan.FromAlgorithm(int(algorithm)))
+
+
+def page_rank(PropertyGraph pg, str output_property_name, PageRankPlan plan = PageRankPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(PageRank(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+
+def personalized_page_rank(PropertyGraph pg, sources, str output_property_name,
+                           PageRankPlan plan = PageRankPlan.automatic()):
+    cdef vector[uint32_t] sources_vec = sources
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(PersonalizedPageRank(pg.underlying.get(), sources_vec, output_property_name_cstr,
+                                                plan.underlying))
+
+# Similarity
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _SimilarityPlan "galois::analytics::SimilarityPlan":
+        enum Metric:
+            kJaccard "galois::analytics::SimilarityPlan::kJaccard"
+            kOverlap "galois::analytics::SimilarityPlan::kOverlap"
+            kCosine "galois::analytics::SimilarityPlan::kCosine"
+            kAdamicAdar "galois::analytics::SimilarityPlan::kAdamicAdar"
+
+        _SimilarityPlan.Metric metric() const
+        uint32_t max_hub_degree() const
+
+        @staticmethod
+        _SimilarityPlan Jaccard(uint32_t max_hub_degree)
+
+        @staticmethod
+        _SimilarityPlan Overlap(uint32_t max_hub_degree)
+
+        @staticmethod
+        _SimilarityPlan Cosine(uint32_t max_hub_degree)
+
+        @staticmethod
+        _SimilarityPlan AdamicAdar(uint32_t max_hub_degree)
+
+        @staticmethod
+        _SimilarityPlan Automatic()
+
+    std_result[void] Similarity(PropertyFileGraph* pfg, size_t base_node,
+                                string output_property_name,
+                                _SimilarityPlan plan)
+
+    std_result[void] EdgeSimilarity(PropertyFileGraph* pfg,
+                                    string output_property_name,
+                                    _SimilarityPlan plan)
+
+    std_result[void] TopKSimilarity(PropertyFileGraph* pfg, uint32_t k,
+                                    string output_nodes_property_name,
+                                    string output_scores_property_name,
+                                    _SimilarityPlan plan)
+
+class _SimilarityMetric(Enum):
+    Jaccard = _SimilarityPlan.Metric.kJaccard
+    Overlap = _SimilarityPlan.Metric.kOverlap
+    Cosine = _SimilarityPlan.Metric.kCosine
+    AdamicAdar = _SimilarityPlan.Metric.kAdamicAdar
+
+
+cdef class SimilarityPlan:
+    cdef:
+        _SimilarityPlan underlying
+
+    @staticmethod
+    cdef SimilarityPlan make(_SimilarityPlan u):
+        f = <SimilarityPlan>SimilarityPlan.__new__(SimilarityPlan)
+        f.underlying = u
+        return f
+
+    Metric = _SimilarityMetric
+
+    @property
+    def metric(self) -> _SimilarityMetric:
+        return _SimilarityMetric(self.underlying.metric())
+
+    @property
+    def max_hub_degree(self) -> int:
+        return self.underlying.max_hub_degree()
+
+    @staticmethod
+    def jaccard(uint32_t max_hub_degree=0):
+        return SimilarityPlan.make(_SimilarityPlan.Jaccard(max_hub_degree))
+
+    @staticmethod
+    def overlap(uint32_t max_hub_degree=0):
+        return SimilarityPlan.make(_SimilarityPlan.Overlap(max_hub_degree))
+
+    @staticmethod
+    def cosine(uint32_t max_hub_degree=0):
+        return SimilarityPlan.make(_SimilarityPlan.Cosine(max_hub_degree))
+
+    @staticmethod
+    def adamic_adar(uint32_t max_hub_degree=0):
+        return SimilarityPlan.make(_SimilarityPlan.AdamicAdar(max_hub_degree))
+
+    @staticmethod
+    def automatic():
+        return SimilarityPlan.make(_SimilarityPlan.Automatic())
+
+
+def similarity(PropertyGraph pg, size_t base_node, str output_property_name,
+               SimilarityPlan plan = SimilarityPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(Similarity(pg.underlying.get(), base_node, output_property_name_cstr, plan.underlying))
+
+
+def edge_similarity(PropertyGraph pg, str output_property_name, SimilarityPlan plan = SimilarityPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(EdgeSimilarity(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+
+def top_k_similarity(PropertyGraph pg, uint32_t k, str output_nodes_property_name, str output_scores_property_name,
+                     SimilarityPlan plan = SimilarityPlan.automatic()):
+    output_nodes_property_name_bytes = bytes(output_nodes_property_name, "utf-8")
+    output_nodes_property_name_cstr = <string>output_nodes_property_name_bytes
+    output_scores_property_name_bytes = bytes(output_scores_property_name, "utf-8")
+    output_scores_property_name_cstr = <string>output_scores_property_name_bytes
+    with nogil:
+        handle_result_void(TopKSimilarity(pg.underlying.get(), k, output_nodes_property_name_cstr,
+                                          output_scores_property_name_cstr, plan.underlying))
+
 # SSSP
 
 cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
@@ -131,6 +826,7 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
             kDijkstra "galois::analytics::SsspPlan::kDijkstra"
             kTopo "galois::analytics::SsspPlan::kTopo"
             kTopoTile "galois::analytics::SsspPlan::kTopoTile"
+            kMultiQueue "galois::analytics::SsspPlan::kMultiQueue"
             kAutomatic "galois::analytics::SsspPlan::kAutomatic"
 
         _SsspPlan.Algorithm algorithm() const
@@ -175,6 +871,9 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
         @staticmethod
         _SsspPlan TopoTile_1 "TopoTile"(ptrdiff_t edge_tile_size)
 
+        @staticmethod
+        _SsspPlan MultiQueue()
+
         @staticmethod
         _SsspPlan Automatic()
         @staticmethod
@@ -196,6 +895,7 @@ class _SsspAlgorithm(Enum):
     Dijkstra = _SsspPlan.Algorithm.kDijkstra
     Topo = _SsspPlan.Algorithm.kTopo
     TopoTile = _SsspPlan.Algorithm.kTopoTile
+    MultiQueue = _SsspPlan.Algorithm.kMultiQueue
     Automatic = _SsspPlan.Algorithm.kAutomatic
 
 
@@ -287,6 +987,10 @@ cdef class SsspPlan:
     def topo():
         return SsspPlan.make(_SsspPlan.Topo())
 
+    @staticmethod
+    def multi_queue():
+        return SsspPlan.make(_SsspPlan.MultiQueue())
+
     @staticmethod
     def automatic(graph = None):
         if graph is None:
@@ -303,3 +1007,262 @@ def sssp(PropertyGraph pg, size_t start_node, str edge_weight_property_name, str
     with nogil:
         handle_result_void(Sssp(pg.underlying.get(), start_node, edge_weight_property_name_cstr,
                                 output_property_name_cstr, plan.underlying))
+
+# Strongly connected components
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _StronglyConnectedComponentsPlan "galois::analytics::StronglyConnectedComponentsPlan":
+        enum Algorithm:
+            kMultistep "galois::analytics::StronglyConnectedComponentsPlan::kMultistep"
+            kColoring "galois::analytics::StronglyConnectedComponentsPlan::kColoring"
+
+        _StronglyConnectedComponentsPlan.Algorithm algorithm() const
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan Multistep()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan Coloring()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan Automatic()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan FromAlgorithm(_StronglyConnectedComponentsPlan.Algorithm algo)
+
+    std_result[void] StronglyConnectedComponents(PropertyFileGraph* pfg, string output_property_name,
+                                                 _StronglyConnectedComponentsPlan plan)
+
+class _StronglyConnectedComponentsAlgorithm(Enum):
+    Multistep = _StronglyConnectedComponentsPlan.Algorithm.kMultistep
+    Coloring = _StronglyConnectedComponentsPlan.Algorithm.kColoring
+
+
+cdef class StronglyConnectedComponentsPlan:
+    cdef:
+        _StronglyConnectedComponentsPlan underlying
+
+    @staticmethod
+    cdef StronglyConnectedComponentsPlan make(_StronglyConnectedComponentsPlan u):
+        f = <StronglyConnectedComponentsPlan>StronglyConnectedComponentsPlan.__new__(StronglyConnectedComponentsPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _StronglyConnectedComponentsAlgorithm
+
+    @property
+    def algorithm(self) -> _StronglyConnectedComponentsAlgorithm:
+        return _StronglyConnectedComponentsAlgorithm(self.underlying.algorithm())
+
+    @staticmethod
+    def multistep():
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Multistep())
+
+    @staticmethod
+    def coloring():
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Coloring())
+
+    @staticmethod
+    def automatic():
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.FromAlgorithm(int(algorithm)))
+
+
+def strongly_connected_components(PropertyGraph pg, str output_property_name,
+                                  StronglyConnectedComponentsPlan plan = StronglyConnectedComponentsPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(StronglyConnectedComponents(pg.underlying.get(), output_property_name_cstr,
+                                                       plan.underlying))
+
+# Triangle count
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _TriangleCountPlan "galois::analytics::TriangleCountPlan":
+        enum Algorithm:
+            kOrderedCount "galois::analytics::TriangleCountPlan::kOrderedCount"
+            kEdgeIteration "galois::analytics::TriangleCountPlan::kEdgeIteration"
+
+        _TriangleCountPlan.Algorithm algorithm() const
+        bint symmetric() const
+        bint sorted() const
+
+        @staticmethod
+        _TriangleCountPlan OrderedCount(bint symmetric, bint sorted)
+
+        @staticmethod
+        _TriangleCountPlan EdgeIteration(bint symmetric, bint sorted)
+
+        @staticmethod
+        _TriangleCountPlan Automatic()
+
+        @staticmethod
+        _TriangleCountPlan FromAlgorithm(_TriangleCountPlan.Algorithm algo)
+
+    std_result[uint64_t] TriangleCount(PropertyFileGraph* pfg, _TriangleCountPlan plan)
+
+    std_result[void] NodeTriangleCount(PropertyFileGraph* pfg, string output_property_name, _TriangleCountPlan plan)
+
+    std_result[void] EdgeTriangleCount(PropertyFileGraph* pfg, string output_property_name, _TriangleCountPlan plan)
+
+    std_result[void] LocalClusteringCoefficient(PropertyFileGraph* pfg, string output_property_name,
+                                                _TriangleCountPlan plan)
+
+class _TriangleCountAlgorithm(Enum):
+    OrderedCount = _TriangleCountPlan.Algorithm.kOrderedCount
+    EdgeIteration = _TriangleCountPlan.Algorithm.kEdgeIteration
+
+
+cdef class TriangleCountPlan:
+    cdef:
+        _TriangleCountPlan underlying
+
+    @staticmethod
+    cdef TriangleCountPlan make(_TriangleCountPlan u):
+        f = <TriangleCountPlan>TriangleCountPlan.__new__(TriangleCountPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _TriangleCountAlgorithm
+
+    @property
+    def algorithm(self) -> _TriangleCountAlgorithm:
+        return _TriangleCountAlgorithm(self.underlying.algorithm())
+
+    @property
+    def symmetric(self) -> bool:
+        return self.underlying.symmetric()
+
+    @property
+    def sorted(self) -> bool:
+        return self.underlying.sorted()
+
+    @staticmethod
+    def ordered_count(bint symmetric=False, bint sorted=False):
+        return TriangleCountPlan.make(_TriangleCountPlan.OrderedCount(symmetric, sorted))
+
+    @staticmethod
+    def edge_iteration(bint symmetric=False, bint sorted=False):
+        return TriangleCountPlan.make(_TriangleCountPlan.EdgeIteration(symmetric, sorted))
+
+    @staticmethod
+    def automatic():
+        return TriangleCountPlan.make(_TriangleCountPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return TriangleCountPlan.make(_TriangleCountPlan.FromAlgorithm(int(algorithm)))
+
+
+def triangle_count(PropertyGraph pg, TriangleCountPlan plan = TriangleCountPlan.automatic()) -> int:
+    cdef uint64_t result
+    with nogil:
+        result = handle_result_uint64(TriangleCount(pg.underlying.get(), plan.underlying))
+    return result
+
+
+def node_triangle_count(PropertyGraph pg, str output_property_name,
+                        TriangleCountPlan plan = TriangleCountPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(NodeTriangleCount(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+
+def edge_triangle_count(PropertyGraph pg, str output_property_name,
+                        TriangleCountPlan plan = TriangleCountPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(EdgeTriangleCount(pg.underlying.get(), output_property_name_cstr, plan.underlying))
+
+
+def local_clustering_coefficient(PropertyGraph pg, str output_property_name,
+                                 TriangleCountPlan plan = TriangleCountPlan.automatic()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(LocalClusteringCoefficient(pg.underlying.get(), output_property_name_cstr,
+                                                      plan.underlying))
+
+# k shortest paths
+
+cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
+    cppclass _KShortestPathsPlan "galois::analytics::KShortestPathsPlan":
+        enum Algorithm:
+            kYen "galois::analytics::KShortestPathsPlan::kYen"
+
+        _KShortestPathsPlan.Algorithm algorithm() const
+        bint symmetric() const
+
+        @staticmethod
+        _KShortestPathsPlan Yen(bint symmetric)
+
+        @staticmethod
+        _KShortestPathsPlan Automatic()
+
+        @staticmethod
+        _KShortestPathsPlan FromAlgorithm(_KShortestPathsPlan.Algorithm algo)
+
+    std_result[shared_ptr[CTable]] KShortestPaths(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                                  vector[pair[uint32_t, uint32_t]] queries, uint32_t k,
+                                                  _KShortestPathsPlan plan)
+
+class _KShortestPathsAlgorithm(Enum):
+    Yen = _KShortestPathsPlan.Algorithm.kYen
+
+
+cdef class KShortestPathsPlan:
+    cdef:
+        _KShortestPathsPlan underlying
+
+    @staticmethod
+    cdef KShortestPathsPlan make(_KShortestPathsPlan u):
+        f = <KShortestPathsPlan>KShortestPathsPlan.__new__(KShortestPathsPlan)
+        f.underlying = u
+        return f
+
+    Algorithm = _KShortestPathsAlgorithm
+
+    @property
+    def algorithm(self) -> _KShortestPathsAlgorithm:
+        return _KShortestPathsAlgorithm(self.underlying.algorithm())
+
+    @property
+    def symmetric(self) -> bool:
+        return self.underlying.symmetric()
+
+    @staticmethod
+    def yen(bint symmetric=False):
+        return KShortestPathsPlan.make(_KShortestPathsPlan.Yen(symmetric))
+
+    @staticmethod
+    def automatic():
+        return KShortestPathsPlan.make(_KShortestPathsPlan.Automatic())
+
+    @staticmethod
+    def from_algorithm(algorithm):
+        return KShortestPathsPlan.make(_KShortestPathsPlan.FromAlgorithm(int(algorithm)))
+
+
+cdef shared_ptr[CTable] handle_result_table(std_result[shared_ptr[CTable]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def k_shortest_paths(PropertyGraph pg, str edge_weight_property_name, queries, uint32_t k,
+                     KShortestPathsPlan plan = KShortestPathsPlan.automatic()):
+    cdef vector[pair[uint32_t, uint32_t]] queries_vec = queries
+    cdef shared_ptr[CTable] table
+    edge_weight_property_name_bytes = bytes(edge_weight_property_name, "utf-8")
+    edge_weight_property_name_cstr = <string>edge_weight_property_name_bytes
+    with nogil:
+        table = handle_result_table(KShortestPaths(pg.underlying.get(), edge_weight_property_name_cstr, queries_vec, k,
+                                                   plan.underlying))
+    return pyarrow_wrap_table(table)
@@ -1,3 +1,4 @@
+from libc.stdint cimport uint64_t
 from libcpp.string cimport string
 
 cdef extern from "<system_error>" namespace "std" nogil:
@@ -34,3 +35,15 @@ cdef inline int handle_result_void(std_result[void] res) nogil except 0:
             raise_error_code(res.error())
     return 1
 
+
+cdef inline double handle_result_double(std_result[double] res) nogil except? -1:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+cdef inline uint64_t handle_result_uint64(std_result[uint64_t] res) nogil except? 0:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
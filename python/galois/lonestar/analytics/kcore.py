@@ -1,6 +1,7 @@
 import numpy as np
 import pyarrow
 
+from galois.analytics import k_core, KCorePlan
 from galois.atomic import GAccumulator, atomic_sub
 from galois.datastructures import LargeArray, AllocationPolicy, InsertBag
 from galois.loops import do_all, do_all_operator, for_each, for_each_operator
@@ -71,6 +72,17 @@ def kcore_async(graph: PropertyGraph, k_core_num, property_name):
     graph.add_node_property(pyarrow.table({property_name: current_degree}))
 
 
+def kcore_decomposition(graph: PropertyGraph, property_name, plan: KCorePlan = KCorePlan.automatic()):
+    """
+    Compute the core number of every node with the C++ analytics library. The nodes in the
+    k-core are those with a core number of at least k, so verify_kcore applies to the result.
+    """
+    timer = StatTimer("Kcore: Property Graph C++: " + property_name)
+    timer.start()
+    k_core(graph, property_name, plan)
+    timer.stop()
+
+
 @do_all_operator()
 def sanity_check_operator(alive_nodes: GAccumulator[int], data, k_core_num, nid):
     val = data[nid]
@@ -102,6 +114,13 @@ def main():
     parser.add_argument("--threads", "-t", type=int, default=1)
     parser.add_argument("--kcore", "-k", type=int, default=100)
     parser.add_argument("--reportNode", type=int, default=0)
+    parser.add_argument(
+        "--algo",
+        type=str,
+        choices=["numba", "peel", "hindex"],
+        default="numba",
+        help="numba computes the k-core for --kcore only; peel and hindex compute the core number of every node",
+    )
     parser.add_argument("input", type=str)
     args = parser.parse_args()
 
@@ -109,7 +128,12 @@ def main():
 
     graph = PropertyGraph(args.input)
 
-    kcore_async(graph, args.kcore, args.propertyName)
+    if args.algo == "peel":
+        kcore_decomposition(graph, args.propertyName, KCorePlan.peel())
+    elif args.algo == "hindex":
+        kcore_decomposition(graph, args.propertyName, KCorePlan.h_index())
+    else:
+        kcore_async(graph, args.kcore, args.propertyName)
 
     print("Node {}: {}".format(args.reportNode, graph.get_node_property(args.propertyName)[args.reportNode]))
 
@@ -1,8 +1,44 @@
-from galois.analytics import bfs, sssp
+import heapq
+
+import pyarrow
+from galois.analytics import (
+    betweenness_centrality,
+    BetweennessCentralityPlan,
+    bfs,
+    BfsPlan,
+    closeness_centrality,
+    ClosenessCentralityPlan,
+    community_detection,
+    CommunityDetectionPlan,
+    connected_components,
+    connected_components_add_edges,
+    ConnectedComponentsPlan,
+    edge_triangle_count,
+    k_core,
+    k_shortest_paths,
+    KCorePlan,
+    KShortestPathsPlan,
+    local_clustering_coefficient,
+    modularity,
+    node_triangle_count,
+    page_rank,
+    PageRankPlan,
+    personalized_page_rank,
+    similarity,
+    SimilarityPlan,
+    sssp,
+    SsspPlan,
+    strongly_connected_components,
+    StronglyConnectedComponentsPlan,
+    top_k_similarity,
+    triangle_count,
+    TriangleCountPlan,
+)
 from galois.property_graph import PropertyGraph
 from pyarrow import Schema
 
 from galois.lonestar.analytics.bfs import verify_bfs
+from galois.lonestar.analytics.kcore import kcore_async
 from galois.lonestar.analytics.sssp import verify_sssp
 
 
@@ -25,6 +61,242 @@ def test_bfs(property_graph: PropertyGraph):
     # TODO: This should assert that the results are correct.
 
 
+def test_bfs_direction_opt(property_graph: PropertyGraph):
+    property_name = "NewProp"
+    start_node = 0
+
+    bfs(property_graph, start_node, property_name, BfsPlan.direction_opt())
+
+    node_schema: Schema = property_graph.node_schema()
+    new_property_id = len(node_schema) - 1
+    assert node_schema.names[new_property_id] == property_name
+
+    assert property_graph.get_node_property(property_name)[start_node].as_py() == 0
+
+    verify_bfs(property_graph, start_node, new_property_id)
+
+
+def bfs_distances(property_graph: PropertyGraph, start_node):
+    """Returns the BFS distance from start_node of every node it reaches"""
+    distances = {start_node: 0}
+    frontier = [start_node]
+    while frontier:
+        next_frontier = []
+        for nid in frontier:
+            for e in property_graph.edges(nid):
+                dst = property_graph.get_edge_dst(e)
+                if dst not in distances:
+                    distances[dst] = distances[nid] + 1
+                    next_frontier.append(dst)
+        frontier = next_frontier
+    return distances
+
+
+def test_betweenness_centrality(property_graph: PropertyGraph):
+    sources = list(range(0, property_graph.num_nodes(), 997))
+    betweenness_centrality(property_graph, "BCOuter", sources, BetweennessCentralityPlan.outer())
+    betweenness_centrality(property_graph, "BCMultiSource", sources, BetweennessCentralityPlan.multi_source())
+
+    node_schema: Schema = property_graph.node_schema()
+    assert node_schema.names[len(node_schema) - 1] == "BCMultiSource"
+
+    outer = property_graph.get_node_property("BCOuter").to_pylist()
+    multi_source = property_graph.get_node_property("BCMultiSource").to_pylist()
+    for a, b in zip(outer, multi_source):
+        assert abs(a - b) <= 1e-6 * max(1, abs(a))
+
+    # Every shortest path from s to t passes through d(s, t) - 1 other nodes
+    expected = sum(d - 1 for s in sources for d in bfs_distances(property_graph, s).values() if d > 0)
+    assert abs(sum(outer) - expected) <= 1e-6 * expected
+
+
+def test_closeness_centrality(property_graph: PropertyGraph):
+    num_nodes = property_graph.num_nodes()
+    closeness_centrality(property_graph, "Closeness", ClosenessCentralityPlan.closeness())
+    closeness_centrality(property_graph, "Harmonic", ClosenessCentralityPlan.harmonic())
+
+    closeness = property_graph.get_node_property("Closeness").to_pylist()
+    harmonic = property_graph.get_node_property("Harmonic").to_pylist()
+
+    for nid in range(0, num_nodes, 997):
+        distances = [d for d in bfs_distances(property_graph, nid).values() if d > 0]
+        expected = 0
+        if distances:
+            expected = len(distances) / (num_nodes - 1) * len(distances) / sum(distances)
+        assert abs(closeness[nid] - expected) < 1e-9
+        assert abs(harmonic[nid] - sum(1 / d for d in distances)) < 1e-9
+
+
+def unit_modularity(property_graph: PropertyGraph, communities):
+    """Returns the modularity of communities where every edge has weight 1"""
+    num_edges = 0
+    internal = 0
+    degrees = {}
+    for nid in range(property_graph.num_nodes()):
+        for e in property_graph.edges(nid):
+            num_edges += 1
+            degrees[communities[nid]] = degrees.get(communities[nid], 0) + 1
+            if communities[property_graph.get_edge_dst(e)] == communities[nid]:
+                internal += 1
+    if num_edges == 0:
+        return 0
+    return internal / num_edges - sum(d * d for d in degrees.values()) / num_edges ** 2
+
+
+def test_community_detection(property_graph: PropertyGraph):
+    singletons = unit_modularity(property_graph, list(range(property_graph.num_nodes())))
+    for plan in [CommunityDetectionPlan.louvain(), CommunityDetectionPlan.leiden()]:
+        property_name = "Community" + plan.algorithm.name
+        community_detection(property_graph, "", property_name, plan)
+
+        node_schema: Schema = property_graph.node_schema()
+        assert node_schema.names[len(node_schema) - 1] == property_name
+
+        communities = property_graph.get_node_property(property_name).to_pylist()
+        assert set(communities) == set(range(max(communities) + 1))
+
+        expected = unit_modularity(property_graph, communities)
+        assert abs(modularity(property_graph, "", property_name) - expected) < 1e-9
+        assert expected >= singletons
+
+        if plan.algorithm == CommunityDetectionPlan.Algorithm.Leiden:
+            assert all(is_connected_within(property_graph, communities))
+
+
+def is_connected_within(property_graph: PropertyGraph, communities):
+    """Returns whether every community is connected by the undirected edges
+    between its own nodes, in the order of the communities"""
+    members = {}
+    neighbors = [[] for _ in range(property_graph.num_nodes())]
+    for nid in range(property_graph.num_nodes()):
+        members.setdefault(communities[nid], []).append(nid)
+        for e in property_graph.edges(nid):
+            dst = property_graph.get_edge_dst(e)
+            if communities[dst] == communities[nid]:
+                neighbors[nid].append(dst)
+                neighbors[dst].append(nid)
+    connected = []
+    for community in sorted(members):
+        reached = {members[community][0]}
+        frontier = [members[community][0]]
+        while frontier:
+            nid = frontier.pop()
+            for neighbor in neighbors[nid]:
+                if neighbor not in reached:
+                    reached.add(neighbor)
+                    frontier.append(neighbor)
+        connected.append(len(reached) == len(members[community]))
+    return connected
+
+
+def component_labels(property_graph: PropertyGraph, extra_edges=()):
+    """Returns the smallest node of the weakly connected component of every
+    node, also counting extra_edges"""
+    parent = list(range(property_graph.num_nodes()))
+
+    def find(nid):
+        while parent[nid] != nid:
+            parent[nid] = parent[parent[nid]]
+            nid = parent[nid]
+        return nid
+
+    def union(a, b):
+        a, b = find(a), find(b)
+        parent[max(a, b)] = min(a, b)
+
+    for nid in range(property_graph.num_nodes()):
+        for e in property_graph.edges(nid):
+            union(nid, property_graph.get_edge_dst(e))
+    for src, dst in extra_edges:
+        union(src, dst)
+    return [find(nid) for nid in range(property_graph.num_nodes())]
+
+
+def test_connected_components(property_graph: PropertyGraph):
+    expected = component_labels(property_graph)
+    for plan in [ConnectedComponentsPlan.afforest(), ConnectedComponentsPlan.edge_tiled_async()]:
+        property_name = "Component" + plan.algorithm.name
+        connected_components(property_graph, property_name, plan)
+
+        node_schema: Schema = property_graph.node_schema()
+        assert node_schema.names[len(node_schema) - 1] == property_name
+
+        assert property_graph.get_node_property(property_name).to_pylist() == expected
+
+
+def test_connected_components_add_edges(property_graph: PropertyGraph):
+    connected_components(property_graph, "Component")
+
+    num_nodes = property_graph.num_nodes()
+    new_edges = [(nid, (nid * 7919) % num_nodes) for nid in range(0, num_nodes, 101)]
+    connected_components_add_edges(property_graph, "Component", new_edges)
+
+    labels = property_graph.get_node_property("Component").to_pylist()
+    assert labels == component_labels(property_graph, new_edges)
+
+
+def strong_component_labels(property_graph: PropertyGraph):
+    """Returns the smallest node of the strongly connected component of every
+    node, computed with an iterative version of Tarjan's algorithm"""
+    num_nodes = property_graph.num_nodes()
+    index = [None] * num_nodes
+    low = [0] * num_nodes
+    on_stack = [False] * num_nodes
+    stack = []
+    labels = [None] * num_nodes
+    counter = 0
+    for root in range(num_nodes):
+        if index[root] is not None:
+            continue
+        index[root] = low[root] = counter
+        counter += 1
+        stack.append(root)
+        on_stack[root] = True
+        calls = [(root, iter(property_graph.edges(root)))]
+        while calls:
+            nid, edges = calls[-1]
+            e = next(edges, None)
+            if e is not None:
+                dst = property_graph.get_edge_dst(e)
+                if index[dst] is None:
+                    index[dst] = low[dst] = counter
+                    counter += 1
+                    stack.append(dst)
+                    on_stack[dst] = True
+                    calls.append((dst, iter(property_graph.edges(dst))))
+                elif on_stack[dst]:
+                    low[nid] = min(low[nid], index[dst])
+                continue
+            calls.pop()
+            if calls:
+                parent = calls[-1][0]
+                low[parent] = min(low[parent], low[nid])
+            if low[nid] == index[nid]:
+                component = []
+                while True:
+                    member = stack.pop()
+                    on_stack[member] = False
+                    component.append(member)
+                    if member == nid:
+                        break
+                smallest = min(component)
+                for member in component:
+                    labels[member] = smallest
+    return labels
+
+
+def test_strongly_connected_components(property_graph: PropertyGraph):
+    expected = strong_component_labels(property_graph)
+    for plan in [StronglyConnectedComponentsPlan.multistep(), StronglyConnectedComponentsPlan.coloring()]:
+        property_name = "StrongComponent" + plan.algorithm.name
+        strongly_connected_components(property_graph, property_name, plan)
+
+        node_schema: Schema = property_graph.node_schema()
+        assert node_schema.names[len(node_schema) - 1] == property_name
+
+        assert property_graph.get_node_property(property_name).to_pylist() == expected
+
+
 def test_sssp(property_graph: PropertyGraph):
     property_name = "NewProp"
     start_node = 0
@@ -41,7 +313,285 @@ def test_sssp(property_graph: PropertyGraph):
     # Verify with numba implementation of verifier
     verify_sssp(property_graph, start_node, new_property_id)
 
+    # The multi-queue plan relaxes the priority order but must reach the same
+    # distances
+    sssp(property_graph, start_node, "workFrom", "MultiQueueDistance", SsspPlan.multi_queue())
+    assert (
+        property_graph.get_node_property("MultiQueueDistance").to_pylist()
+        == property_graph.get_node_property(property_name).to_pylist()
+    )
+
     # TODO: This should assert that the results are correct.
 
 
+def dijkstra_distances(property_graph: PropertyGraph, start_node, weights):
+    """Returns the distance from start_node of every node it reaches, where
+    every edge e has length weights[e]"""
+    distances = {}
+    heap = [(0, start_node)]
+    while heap:
+        distance, nid = heapq.heappop(heap)
+        if nid in distances:
+            continue
+        distances[nid] = distance
+        for e in property_graph.edges(nid):
+            dst = property_graph.get_edge_dst(e)
+            if dst not in distances:
+                heapq.heappush(heap, (distance + weights[e], dst))
+    return distances
+
+
+def simple_path_lower_bound(property_graph: PropertyGraph, source, target):
+    """Returns a lower bound on the number of simple paths from source to
+    target: one through each in-neighbor of target that source reaches without
+    passing through target"""
+    if source == target:
+        return 1
+    reached = {source}
+    frontier = [source]
+    while frontier:
+        nid = frontier.pop()
+        for e in property_graph.edges(nid):
+            dst = property_graph.get_edge_dst(e)
+            if dst != target and dst not in reached:
+                reached.add(dst)
+                frontier.append(dst)
+    return sum(any(property_graph.get_edge_dst(e) == target for e in property_graph.edges(nid)) for nid in reached)
+
+
+def check_k_shortest_paths(property_graph: PropertyGraph, weight_property, queries, k):
+    if weight_property:
+        weights = property_graph.get_edge_property(weight_property).to_pylist()
+    else:
+        weights = [1] * property_graph.num_edges()
+
+    table = k_shortest_paths(property_graph, weight_property, queries, k, KShortestPathsPlan.yen())
+    assert table.column_names == ["query", "length", "path"]
+
+    rows = table.to_pydict()
+    assert rows["query"] == sorted(rows["query"])
+    paths = {}
+    for query, length, path in zip(rows["query"], rows["length"], rows["path"]):
+        source, target = queries[query]
+        assert path[0] == source and path[-1] == target
+        assert len(set(path)) == len(path)
+        expected = 0
+        for src, dst in zip(path, path[1:]):
+            edge_weights = [weights[e] for e in property_graph.edges(src) if property_graph.get_edge_dst(e) == dst]
+            assert edge_weights
+            expected += min(edge_weights)
+        assert abs(length - expected) < 1e-9
+        paths.setdefault(query, []).append((length, tuple(path)))
+
+    distances = {source: dijkstra_distances(property_graph, source, weights) for source in {s for s, _ in queries}}
+    for query, (source, target) in enumerate(queries):
+        found = paths.get(query, [])
+        if target not in distances[source]:
+            assert not found
+            continue
+        assert min(k, simple_path_lower_bound(property_graph, source, target)) <= len(found) <= k
+        assert abs(found[0][0] - distances[source][target]) < 1e-9
+        assert [length for length, _ in found] == sorted(length for length, _ in found)
+        assert len(set(path for _, path in found)) == len(found)
+    return paths
+
+
+def test_k_shortest_paths(property_graph: PropertyGraph):
+    k = 5
+    start_node = 0
+    distances = bfs_distances(property_graph, start_node)
+    targets = sorted(nid for nid, d in distances.items() if d > 0)
+    queries = [(start_node, target) for target in targets[:: max(1, len(targets) // 8)]]
+    queries.append((start_node, start_node))
+
+    paths = check_k_shortest_paths(property_graph, "", queries, k)
+    assert paths[len(queries) - 1] == [(0, (start_node,))]
+
+    weights = pyarrow.array([e % 7 + 1 for e in range(property_graph.num_edges())], pyarrow.uint32())
+    property_graph.add_edge_property(pyarrow.table(dict(KShortestPathsWeight=weights)))
+    paths = check_k_shortest_paths(property_graph, "KShortestPathsWeight", queries, k)
+    assert paths[len(queries) - 1] == [(0, (start_node,))]
+
+
+def test_k_core(property_graph: PropertyGraph):
+    k = 10
+    kcore_async(property_graph, k, "InKCore")
+    in_k_core = [d >= k for d in property_graph.get_node_property("InKCore").to_pylist()]
+
+    k_core(property_graph, "CorePeel", KCorePlan.peel())
+
+    node_schema: Schema = property_graph.node_schema()
+    assert node_schema.names[len(node_schema) - 1] == "CorePeel"
+
+    # The nodes of the k-core are those with a core number of at least k
+    cores = property_graph.get_node_property("CorePeel").to_pylist()
+    assert [c >= k for c in cores] == in_k_core
+
+
+def check_page_rank(property_graph: PropertyGraph, ranks, teleport, damping=0.85):
+    """Checks that ranks sum to 1 and are a fixed point of PageRank at a sample
+    of nodes, where teleport(nid) is the probability of jumping to nid"""
+    assert abs(sum(ranks) - 1) < 1e-4
+
+    sample = set(range(0, property_graph.num_nodes(), 97))
+    pulled = {nid: 0.0 for nid in sample}
+    dangling = 0.0
+    for nid in range(property_graph.num_nodes()):
+        edges = property_graph.edges(nid)
+        if len(edges) == 0:
+            dangling += ranks[nid]
+        for e in edges:
+            dst = property_graph.get_edge_dst(e)
+            if dst in sample:
+                pulled[dst] += ranks[nid] / len(edges)
+
+    for nid in sample:
+        expected = damping * pulled[nid] + (1 - damping + damping * dangling) * teleport(nid)
+        assert abs(ranks[nid] - expected) < 1e-5
+
+
+def test_page_rank(property_graph: PropertyGraph):
+    num_nodes = property_graph.num_nodes()
+    for plan in [PageRankPlan.pull(), PageRankPlan.push(), PageRankPlan.delta()]:
+        property_name = "PageRank" + plan.algorithm.name
+        page_rank(property_graph, property_name, plan)
+
+        node_schema: Schema = property_graph.node_schema()
+        assert node_schema.names[len(node_schema) - 1] == property_name
+
+        ranks = property_graph.get_node_property(property_name).to_pylist()
+        check_page_rank(property_graph, ranks, lambda nid: 1 / num_nodes)
+
+
+def test_personalized_page_rank(property_graph: PropertyGraph):
+    sources = [0, 1, 2]
+    personalized_page_rank(property_graph, sources, "PersonalizedPageRank")
+
+    ranks = property_graph.get_node_property("PersonalizedPageRank").to_pylist()
+    check_page_rank(property_graph, ranks, lambda nid: 1 / len(sources) if nid in sources else 0)
+
+
+def neighbor_set(property_graph: PropertyGraph, nid):
+    """Returns the neighbors of nid, or None if nid has duplicate edges, which
+    the similarity metrics do not support"""
+    neighbors = [property_graph.get_edge_dst(e) for e in property_graph.edges(nid)]
+    if len(set(neighbors)) != len(neighbors):
+        return None
+    return set(neighbors)
+
+
+def test_similarity(property_graph: PropertyGraph):
+    base_node = 0
+    similarity(property_graph, base_node, "Jaccard", SimilarityPlan.jaccard())
+
+    values = property_graph.get_node_property("Jaccard").to_pylist()
+
+    base_neighbors = neighbor_set(property_graph, base_node)
+    if base_neighbors is None:
+        return
+    for nid in range(0, property_graph.num_nodes(), 97):
+        neighbors = neighbor_set(property_graph, nid)
+        if neighbors is None:
+            continue
+        expected = 0
+        if base_neighbors and neighbors:
+            expected = len(base_neighbors & neighbors) / len(base_neighbors | neighbors)
+        assert abs(values[nid] - expected) < 1e-9
+
+
+def test_top_k_similarity(property_graph: PropertyGraph):
+    k = 5
+    top_k_similarity(property_graph, k, "TopKNodes", "TopKScores", SimilarityPlan.overlap())
+
+    nodes = property_graph.get_node_property("TopKNodes").to_pylist()
+    scores = property_graph.get_node_property("TopKScores").to_pylist()
+
+    num_nodes = property_graph.num_nodes()
+    neighbors = [neighbor_set(property_graph, nid) for nid in range(num_nodes)]
+    in_neighbors = [[] for _ in range(num_nodes)]
+    for nid in range(num_nodes):
+        for e in property_graph.edges(nid):
+            in_neighbors[property_graph.get_edge_dst(e)].append(nid)
+
+    # Compare with the best k of all nodes that share a neighbor, i.e., have
+    # an edge to the same node
+    for nid in range(0, num_nodes, 97):
+        assert len(nodes[nid]) == len(scores[nid]) <= k
+        if neighbors[nid] is None:
+            continue
+        candidates = {other for w in neighbors[nid] for other in in_neighbors[w] if other != nid}
+        if any(neighbors[other] is None for other in candidates):
+            continue
+        expected = sorted(
+            (
+                -len(neighbors[nid] & neighbors[other]) / min(len(neighbors[nid]), len(neighbors[other])),
+                other,
+            )
+            for other in candidates
+        )[:k]
+        assert nodes[nid] == [other for _, other in expected]
+        for score, (negated, _) in zip(scores[nid], expected):
+            assert abs(score + negated) < 1e-9
+
+
+def undirected_neighbor_sets(property_graph: PropertyGraph):
+    """Returns the neighbors of every node in the undirected graph underlying
+    property_graph, without self loops"""
+    neighbors = [set() for _ in range(property_graph.num_nodes())]
+    for nid in range(property_graph.num_nodes()):
+        for e in property_graph.edges(nid):
+            dst = property_graph.get_edge_dst(e)
+            if dst != nid:
+                neighbors[nid].add(dst)
+                neighbors[dst].add(nid)
+    return neighbors
+
+
+def node_triangles(neighbors):
+    """Returns the number of edges among the neighbors of every node"""
+    return [
+        sum(len(neighbors[nid] & neighbors[other]) for other in neighbors[nid]) // 2 for nid in range(len(neighbors))
+    ]
+
+
+def test_triangle_count(property_graph: PropertyGraph):
+    expected = node_triangles(undirected_neighbor_sets(property_graph))
+    for plan in [TriangleCountPlan.ordered_count(), TriangleCountPlan.edge_iteration()]:
+        assert triangle_count(property_graph, plan) == sum(expected) // 3
+
+        property_name = "Triangles" + plan.algorithm.name
+        node_triangle_count(property_graph, property_name, plan)
+
+        node_schema: Schema = property_graph.node_schema()
+        assert node_schema.names[len(node_schema) - 1] == property_name
+
+        assert property_graph.get_node_property(property_name).to_pylist() == expected
+
+
+def test_edge_triangle_count(property_graph: PropertyGraph):
+    edge_triangle_count(property_graph, "EdgeTriangles")
+
+    edge_schema: Schema = property_graph.edge_schema()
+    assert edge_schema.names[len(edge_schema) - 1] == "EdgeTriangles"
+
+    neighbors = undirected_neighbor_sets(property_graph)
+    counts = property_graph.get_edge_property("EdgeTriangles").to_pylist()
+    for nid in range(property_graph.num_nodes()):
+        for e in property_graph.edges(nid):
+            dst = property_graph.get_edge_dst(e)
+            assert counts[e] == (0 if dst == nid else len(neighbors[nid] & neighbors[dst]))
+
+
+def test_local_clustering_coefficient(property_graph: PropertyGraph):
+    local_clustering_coefficient(property_graph, "Clustering")
+
+    neighbors = undirected_neighbor_sets(property_graph)
+    triangles = node_triangles(neighbors)
+    values = property_graph.get_node_property("Clustering").to_pylist()
+    for nid in range(property_graph.num_nodes()):
+        degree = len(neighbors[nid])
+        expected = 0 if degree < 2 else 2 * triangles[nid] / (degree * (degree - 1))
+        assert abs(values[nid] - expected) < 1e-9
+
+
 # TODO: Add more tests.